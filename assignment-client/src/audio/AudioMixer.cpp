@@ -9,6 +9,7 @@
 //  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
 //
 
+#include <algorithm>
 #include <errno.h>
 #include <fcntl.h>
 #include <fstream>
@@ -60,16 +61,23 @@
 const float LOUDNESS_TO_DISTANCE_RATIO = 0.00001f;
 const float DEFAULT_ATTENUATION_PER_DOUBLING_IN_DISTANCE = 0.18f;
 const float DEFAULT_NOISE_MUTING_THRESHOLD = 0.003f;
+const int DEFAULT_HRTF_SOURCES_PER_LISTENER = 16;
+const int DEFAULT_MAX_SOURCES_PER_LISTENER = 32;
 const QString AUDIO_MIXER_LOGGING_TARGET_NAME = "audio-mixer";
 const QString AUDIO_ENV_GROUP_KEY = "audio_env";
 const QString AUDIO_BUFFER_GROUP_KEY = "audio_buffer";
 
+// the audio environment is sent whenever it changes, and refreshed this often in case a packet was lost
+const quint64 AUDIO_ENVIRONMENT_REFRESH_USECS = 5 * USECS_PER_SECOND;
+
 InboundAudioStream::Settings AudioMixer::_streamSettings;
 
 bool AudioMixer::_printStreamStats = false;
 
 bool AudioMixer::_enableFilter = true;
 
+bool AudioMixer::_enableHRTF = true;
+
 bool AudioMixer::shouldMute(float quietestFrame) {
     return (quietestFrame > _noiseMutingThreshold);
 }
@@ -84,6 +92,12 @@ AudioMixer::AudioMixer(NLPacket& packet) :
     _numStatFrames(0),
     _sumListeners(0),
     _sumMixes(0),
+    _sumHRTFMixes(0),
+    _hrtfBudgetPerListener(DEFAULT_HRTF_SOURCES_PER_LISTENER * AudioHRTF::getFrameCost()),
+    _hrtfBudgetRemaining(0),
+    _sumAudibleStreams(0),
+    _maxSourcesPerListener(DEFAULT_MAX_SOURCES_PER_LISTENER),
+    _minAttenuationPerDoublingInDistance(DEFAULT_ATTENUATION_PER_DOUBLING_IN_DISTANCE),
     _lastPerSecondCallbackTime(usecTimestampNow()),
     _sendAudioStreamStats(false),
     _datagramsReadPerCallStats(0, READ_DATAGRAMS_STATS_WINDOW_SECONDS),
@@ -110,10 +124,51 @@ AudioMixer::AudioMixer(NLPacket& packet) :
 const float ATTENUATION_BEGINS_AT_DISTANCE = 1.0f;
 const float RADIUS_OF_HEAD = 0.076f;
 
+static float computeDistanceCoefficient(float distanceBetween, float attenuationPerDoublingInDistance) {
+    if (distanceBetween < ATTENUATION_BEGINS_AT_DISTANCE) {
+        return 1.0f;
+    }
+
+    // calculate the distance coefficient using the distance to this node
+    float distanceCoefficient = 1 - (logf(distanceBetween / ATTENUATION_BEGINS_AT_DISTANCE) / logf(2.0f)
+                                     * attenuationPerDoublingInDistance);
+
+    return (distanceCoefficient < 0) ? 0.0f : distanceCoefficient;
+}
+
+float AudioMixer::computeAudibility(PositionalAudioStream* streamToAdd, AvatarAudioStream* listeningNodeStream) {
+    // skip streams that have nothing to mix this frame (see addStreamToMixForListeningNodeWithStream)
+    bool canRepeatLastFrame = _streamSettings._repetitionWithFade && !streamToAdd->getLastPopOutput().isNull();
+    if ((!streamToAdd->lastPopSucceeded() && !canRepeatLastFrame) || streamToAdd->getLastPopOutputLoudness() == 0.0f) {
+        return 0.0f;
+    }
+
+    float distanceBetween = glm::length(streamToAdd->getPosition() - listeningNodeStream->getPosition());
+    if (distanceBetween < EPSILON) {
+        distanceBetween = EPSILON;
+    }
+
+    float trailingLoudness = streamToAdd->getLastPopOutputTrailingLoudness();
+    if (trailingLoudness / distanceBetween <= _minAudibilityThreshold) {
+        // according to mixer performance we have decided this does not get to be mixed in
+        return 0.0f;
+    }
+
+    // off-axis attenuation only ever makes a stream quieter, so it is left out of this estimate
+    float attenuationCoefficient = computeDistanceCoefficient(distanceBetween, _minAttenuationPerDoublingInDistance);
+    if (streamToAdd->getType() == PositionalAudioStream::Injector) {
+        attenuationCoefficient *= reinterpret_cast<InjectedAudioStream*>(streamToAdd)->getAttenuationRatio();
+    }
+
+    return trailingLoudness * attenuationCoefficient;
+}
+
 int AudioMixer::addStreamToMixForListeningNodeWithStream(AudioMixerClientData* listenerNodeData,
                                                          const QUuid& streamUUID,
                                                          PositionalAudioStream* streamToAdd,
-                                                         AvatarAudioStream* listeningNodeStream) {
+                                                         AvatarAudioStream* listeningNodeStream,
+                                                         AudioZoneMask sourceZones,
+                                                         AudioZoneMask listenerZones) {
     // If repetition with fade is enabled:
     // If streamToAdd could not provide a frame (it was starved), then we'll mix its previously-mixed frame
     // This is preferable to not mixing it at all since that's equivalent to inserting silence.
@@ -161,14 +216,11 @@ int AudioMixer::addStreamToMixForListeningNodeWithStream(AudioMixerClientData* l
         distanceBetween = EPSILON;
     }
 
-    if (streamToAdd->getLastPopOutputTrailingLoudness() / distanceBetween <= _minAudibilityThreshold) {
-        // according to mixer performance we have decided this does not get to be mixed in
-        // bail out
-        return 0;
-    }
-
     ++_sumMixes;
 
+    // the pre-mix buffer only ever holds the contribution of the stream being added
+    memset(_preMixSamples, 0, sizeof(_preMixSamples));
+
     if (streamToAdd->getType() == PositionalAudioStream::Injector) {
         attenuationCoefficient *= reinterpret_cast<InjectedAudioStream*>(streamToAdd)->getAttenuationRatio();
         if (showDebug) {
@@ -206,21 +258,15 @@ int AudioMixer::addStreamToMixForListeningNodeWithStream(AudioMixerClientData* l
 
     float attenuationPerDoublingInDistance = _attenuationPerDoublingInDistance;
     for (int i = 0; i < _zonesSettings.length(); ++i) {
-        if (_audioZones[_zonesSettings[i].source].contains(streamToAdd->getPosition()) &&
-            _audioZones[_zonesSettings[i].listener].contains(listeningNodeStream->getPosition())) {
+        if ((sourceZones & audioZoneBit(_zonesSettings[i].sourceZone)) &&
+            (listenerZones & audioZoneBit(_zonesSettings[i].listenerZone))) {
             attenuationPerDoublingInDistance = _zonesSettings[i].coefficient;
             break;
         }
     }
 
     if (distanceBetween >= ATTENUATION_BEGINS_AT_DISTANCE) {
-        // calculate the distance coefficient using the distance to this node
-        float distanceCoefficient = 1 - (logf(distanceBetween / ATTENUATION_BEGINS_AT_DISTANCE) / logf(2.0f)
-                                         * attenuationPerDoublingInDistance);
-
-        if (distanceCoefficient < 0) {
-            distanceCoefficient = 0;
-        }
+        float distanceCoefficient = computeDistanceCoefficient(distanceBetween, attenuationPerDoublingInDistance);
 
         // multiply the current attenuation coefficient by the distance coefficient
         attenuationCoefficient *= distanceCoefficient;
@@ -263,7 +309,30 @@ int AudioMixer::addStreamToMixForListeningNodeWithStream(AudioMixerClientData* l
 
     AudioRingBuffer::ConstIterator streamPopOutput = streamToAdd->getLastPopOutput();
 
-    if (!streamToAdd->isStereo()) {
+    // the popped frame is contiguous in memory, so the loops below can index it without wrap checks
+    const int16_t* streamPopFrame = streamPopOutput.getFramePointer();
+
+    // mono sources from outside the listener's head are spatialized with the HRTF, as long as the budget for this
+    // listener allows it. Anything else falls back to the sample delay and penumbra filter below.
+    PerListenerSourcePairData* pairData = NULL;
+    bool useHRTF = false;
+    if (!sourceIsSelf && !streamToAdd->isStereo()) {
+        pairData = listenerNodeData->getListenerSourcePairData(streamUUID);
+        useHRTF = _enableHRTF && distanceBetween >= RADIUS_OF_HEAD
+            && _hrtfBudgetRemaining >= AudioHRTF::getFrameCost();
+        pairData->setHRTFActive(useHRTF);
+    }
+
+    if (useHRTF) {
+        // the HRTF models both the interaural delay and the head shadow, so it replaces the penumbra filter too
+        AudioHRTF& hrtf = pairData->getHRTF();
+        hrtf.render(streamPopFrame, _preMixSamples, AudioConstants::NETWORK_FRAME_SAMPLES_PER_CHANNEL,
+                    bearingRelativeAngleToSource, attenuationCoefficient * repeatedFrameFadeFactor);
+
+        _hrtfBudgetRemaining -= hrtf.getLastRenderCost();
+        ++_sumHRTFMixes;
+
+    } else if (!streamToAdd->isStereo()) {
         // this is a mono stream, which means it gets full attenuation and spatialization
 
         // we need to do several things in this process:
@@ -335,7 +404,7 @@ int AudioMixer::addStreamToMixForListeningNodeWithStream(AudioMixerClientData* l
 
         // Here's where we copy the MONO input to the STEREO output, and account for delay and weak side attenuation
         for (int inputSample = 0; inputSample < inputSampleCount; inputSample++) {
-            int16_t originalSample = streamPopOutput[inputSample];
+            int16_t originalSample = streamPopFrame[inputSample];
             int16_t leftSideSample = originalSample * leftSideAttenuation;
             int16_t rightSideSample = originalSample * rightSideAttenuation;
 
@@ -357,13 +426,13 @@ int AudioMixer::addStreamToMixForListeningNodeWithStream(AudioMixerClientData* l
        float attenuationAndFade = attenuationCoefficient * repeatedFrameFadeFactor;
 
         for (int s = 0; s < AudioConstants::NETWORK_FRAME_SAMPLES_STEREO; s++) {
-            _preMixSamples[s] = glm::clamp(_preMixSamples[s] + (int)(streamPopOutput[s / stereoDivider] * attenuationAndFade),
+            _preMixSamples[s] = glm::clamp(_preMixSamples[s] + (int)(streamPopFrame[s / stereoDivider] * attenuationAndFade),
                                             AudioConstants::MIN_SAMPLE_VALUE,
                                            AudioConstants::MAX_SAMPLE_VALUE);
         }
     }
 
-    if (!sourceIsSelf && _enableFilter && !streamToAdd->ignorePenumbraFilter()) {
+    if (!sourceIsSelf && !useHRTF && _enableFilter && !streamToAdd->ignorePenumbraFilter()) {
 
         const float TWO_OVER_PI = 2.0f / PI;
 
@@ -418,7 +487,8 @@ int AudioMixer::addStreamToMixForListeningNodeWithStream(AudioMixerClientData* l
         }
 
         // Get our per listener/source data so we can get our filter
-        AudioFilterHSF1s& penumbraFilter = listenerNodeData->getListenerSourcePairData(streamUUID)->getPenumbraFilter();
+        AudioFilterHSF1s& penumbraFilter = pairData ? pairData->getPenumbraFilter()
+            : listenerNodeData->getListenerSourcePairData(streamUUID)->getPenumbraFilter();
 
         // set the gain on both filter channels
         penumbraFilter.setParameters(0, 0, AudioConstants::SAMPLE_RATE, penumbraFilterFrequency, penumbraFilterGainL, penumbraFilterSlope);
@@ -443,8 +513,13 @@ int AudioMixer::prepareMixForListeningNode(Node* node) {
     memset(_preMixSamples, 0, sizeof(_preMixSamples));
     memset(_mixSamples, 0, sizeof(_mixSamples));
 
-    // loop through all other nodes that have sufficient audio to mix
-    int streamsMixed = 0;
+    // when the mixer is struggling the HRTF budget shrinks along with the audibility threshold
+    _hrtfBudgetRemaining = _hrtfBudgetPerListener * (1.0f - _performanceThrottlingRatio);
+
+    AudioZoneMask listenerZones = listenerNodeData->getStreamZones(QUuid());
+
+    // first pass: cheaply score every stream this listener could hear, dropping the ones that are not audible
+    _audibleStreams.clear();
 
     DependencyManager::get<NodeList>()->eachNode([&](const SharedNodePointer& otherNode){
         if (otherNode->getLinkedData()) {
@@ -463,26 +538,59 @@ int AudioMixer::prepareMixForListeningNode(Node* node) {
                 }
 
                 if (*otherNode != *node || otherNodeStream->shouldLoopbackForNode()) {
-                    streamsMixed += addStreamToMixForListeningNodeWithStream(listenerNodeData, streamUUID,
-                                                                             otherNodeStream, nodeAudioStream);
+                    float audibility = computeAudibility(otherNodeStream, nodeAudioStream);
+                    if (audibility > 0.0f) {
+                        AudibleStream audibleStream = { otherNodeStream, streamUUID, audibility,
+                                                        otherNodeClientData->getStreamZones(i.key()) };
+                        _audibleStreams.push_back(audibleStream);
+                    }
                 }
             }
         }
     });
 
+    _sumAudibleStreams += (int)_audibleStreams.size();
+
+    // keep only the most audible streams, so the cost of a mix stays bounded however crowded the domain gets.
+    // They are mixed loudest first, which also hands the HRTF budget to the streams that matter most.
+    auto isMoreAudible = [](const AudibleStream& a, const AudibleStream& b) {
+        return a.audibility > b.audibility;
+    };
+    if (_maxSourcesPerListener > 0 && (int)_audibleStreams.size() > _maxSourcesPerListener) {
+        std::partial_sort(_audibleStreams.begin(), _audibleStreams.begin() + _maxSourcesPerListener,
+                          _audibleStreams.end(), isMoreAudible);
+        _audibleStreams.resize(_maxSourcesPerListener);
+    } else {
+        std::sort(_audibleStreams.begin(), _audibleStreams.end(), isMoreAudible);
+    }
+
+    // second pass: mix what is left
+    int streamsMixed = 0;
+    for (const AudibleStream& audibleStream : _audibleStreams) {
+        streamsMixed += addStreamToMixForListeningNodeWithStream(listenerNodeData, audibleStream.streamUUID,
+                                                                 audibleStream.stream, nodeAudioStream,
+                                                                 audibleStream.zones, listenerZones);
+    }
+
+    // the culled streams come back to the HRTF path with a fresh history
+    listenerNodeData->endMixFrame();
+
     return streamsMixed;
 }
 
 void AudioMixer::sendAudioEnvironmentPacket(SharedNodePointer node) {
+    AudioMixerClientData* nodeData = static_cast<AudioMixerClientData*>(node->getLinkedData());
+    AvatarAudioStream* stream = nodeData->getAvatarAudioStream();
+
     // Send stream properties
     bool hasReverb = false;
     float reverbTime, wetLevel;
-    // find reverb properties
-    for (int i = 0; i < _zoneReverbSettings.size(); ++i) {
-        AudioMixerClientData* data = static_cast<AudioMixerClientData*>(node->getLinkedData());
-        glm::vec3 streamPosition = data->getAvatarAudioStream()->getPosition();
-        AABox box = _audioZones[_zoneReverbSettings[i].zone];
-        if (box.contains(streamPosition)) {
+    // find reverb properties, the zones containing the listener are already known
+    AudioZoneMask listenerZones = nodeData->getStreamZones(QUuid());
+    for (int i = 0; listenerZones && i < _zoneReverbSettings.size(); ++i) {
+        if (listenerZones & audioZoneBit(_zoneReverbSettings[i].zoneIndex)) {
+            glm::vec3 streamPosition = stream->getPosition();
+            const AABox& box = _audioZoneIndex.getZone(_zoneReverbSettings[i].zoneIndex);
             hasReverb = true;
             reverbTime = _zoneReverbSettings[i].reverbTime;
             wetLevel = _zoneReverbSettings[i].wetLevel;
@@ -499,8 +607,6 @@ void AudioMixer::sendAudioEnvironmentPacket(SharedNodePointer node) {
         }
     }
     
-    AudioMixerClientData* nodeData = static_cast<AudioMixerClientData*>(node->getLinkedData());
-    AvatarAudioStream* stream = nodeData->getAvatarAudioStream();
     bool dataChanged = (stream->hasReverb() != hasReverb) ||
     (stream->hasReverb() && (stream->getRevebTime() != reverbTime ||
                              stream->getWetLevel() != wetLevel));
@@ -513,11 +619,13 @@ void AudioMixer::sendAudioEnvironmentPacket(SharedNodePointer node) {
         }
     }
 
-    // Send at change or every so often
-    float CHANCE_OF_SEND = 0.01f;
-    bool sendData = dataChanged || (randFloat() < CHANCE_OF_SEND);
+    // Send at change, and refresh every so often
+    quint64 now = usecTimestampNow();
+    bool sendData = dataChanged || (now - nodeData->getLastAudioEnvironmentSent() > AUDIO_ENVIRONMENT_REFRESH_USECS);
 
     if (sendData) {
+        nodeData->setLastAudioEnvironmentSent(now);
+
         auto nodeList = DependencyManager::get<NodeList>();
 
         unsigned char bitset = 0;
@@ -569,6 +677,7 @@ void AudioMixer::sendStatsPacket() {
     static QJsonObject statsObject;
 
     statsObject["useDynamicJitterBuffers"] = _streamSettings._dynamicJitterBuffers;
+    statsObject["autoTuneJitterBuffers"] = _streamSettings._autoTuneJitterBuffers;
     statsObject["trailing_sleep_percentage"] = _trailingSleepRatio * 100.0f;
     statsObject["performance_throttling_ratio"] = _performanceThrottlingRatio;
 
@@ -576,12 +685,18 @@ void AudioMixer::sendStatsPacket() {
 
     if (_sumListeners > 0) {
         statsObject["average_mixes_per_listener"] = (float) _sumMixes / (float) _sumListeners;
+        statsObject["average_hrtf_mixes_per_listener"] = (float) _sumHRTFMixes / (float) _sumListeners;
+        statsObject["average_audible_streams_per_listener"] = (float) _sumAudibleStreams / (float) _sumListeners;
     } else {
         statsObject["average_mixes_per_listener"] = 0.0;
+        statsObject["average_hrtf_mixes_per_listener"] = 0.0;
+        statsObject["average_audible_streams_per_listener"] = 0.0;
     }
 
     _sumListeners = 0;
     _sumMixes = 0;
+    _sumHRTFMixes = 0;
+    _sumAudibleStreams = 0;
     _numStatFrames = 0;
 
     QJsonObject readPendingDatagramStats;
@@ -762,6 +877,9 @@ void AudioMixer::run() {
                 // That's how the popped audio data will be read for mixing (but only if the pop was successful)
                 nodeData->checkBuffersBeforeFrameSend();
 
+                // streams that moved across a zone boundary get their zones re-evaluated
+                nodeData->updateZoneMemberships(_audioZoneIndex);
+
                 // if the stream should be muted, send mute packet
                 if (nodeData->getAvatarAudioStream()
                     && shouldMute(nodeData->getAvatarAudioStream()->getQuietestFrameLoudness())) {
@@ -961,6 +1079,21 @@ void AudioMixer::parseSettingsObject(const QJsonObject &settingsObject) {
             qDebug() << "Repetition with fade disabled";
         }
 
+        const QString AUTO_TUNE_JITTER_BUFFERS_JSON_KEY = "auto_tune_jitter_buffers";
+        _streamSettings._autoTuneJitterBuffers = audioBufferGroupObject[AUTO_TUNE_JITTER_BUFFERS_JSON_KEY].toBool();
+        if (_streamSettings._autoTuneJitterBuffers) {
+            qDebug() << "Jitter buffer auto-tuning enabled if dynamic jitter buffers enabled";
+        } else {
+            qDebug() << "Jitter buffer auto-tuning disabled";
+        }
+
+        const QString TARGET_STARVES_PER_MINUTE_JSON_KEY = "target_starves_per_minute";
+        _streamSettings._targetStarvesPerMinute = audioBufferGroupObject[TARGET_STARVES_PER_MINUTE_JSON_KEY].toString().toFloat(&ok);
+        if (!ok || _streamSettings._targetStarvesPerMinute < 0.0f) {
+            _streamSettings._targetStarvesPerMinute = DEFAULT_TARGET_STARVES_PER_MINUTE;
+        }
+        qDebug() << "Target starves per minute:" << _streamSettings._targetStarvesPerMinute;
+
         const QString PRINT_STREAM_STATS_JSON_KEY = "print_stream_stats";
         _printStreamStats = audioBufferGroupObject[PRINT_STREAM_STATS_JSON_KEY].toBool();
         if (_printStreamStats) {
@@ -980,6 +1113,17 @@ void AudioMixer::parseSettingsObject(const QJsonObject &settingsObject) {
                 qDebug() << "Attenuation per doubling in distance changed to" << _attenuationPerDoublingInDistance;
             }
         }
+        _minAttenuationPerDoublingInDistance = _attenuationPerDoublingInDistance;
+
+        const QString MAX_SOURCES_PER_LISTENER = "max_sources_per_listener";
+        if (audioEnvGroupObject[MAX_SOURCES_PER_LISTENER].isString()) {
+            bool ok = false;
+            int maxSourcesPerListener = audioEnvGroupObject[MAX_SOURCES_PER_LISTENER].toString().toInt(&ok);
+            if (ok && maxSourcesPerListener >= 0) {
+                _maxSourcesPerListener = maxSourcesPerListener;
+                qDebug() << "Max sources per listener changed to" << _maxSourcesPerListener;
+            }
+        }
 
         const QString NOISE_MUTING_THRESHOLD = "noise_muting_threshold";
         if (audioEnvGroupObject[NOISE_MUTING_THRESHOLD].isString()) {
@@ -999,7 +1143,26 @@ void AudioMixer::parseSettingsObject(const QJsonObject &settingsObject) {
             qDebug() << "Filter enabled";
         }
 
+        const QString HRTF_KEY = "enable_hrtf";
+        if (audioEnvGroupObject[HRTF_KEY].isBool()) {
+            _enableHRTF = audioEnvGroupObject[HRTF_KEY].toBool();
+        }
+        if (_enableHRTF) {
+            qDebug() << "HRTF enabled";
+        }
+
+        const QString HRTF_SOURCES_PER_LISTENER = "hrtf_sources_per_listener";
+        if (audioEnvGroupObject[HRTF_SOURCES_PER_LISTENER].isString()) {
+            bool ok = false;
+            int hrtfSourcesPerListener = audioEnvGroupObject[HRTF_SOURCES_PER_LISTENER].toString().toInt(&ok);
+            if (ok && hrtfSourcesPerListener >= 0) {
+                _hrtfBudgetPerListener = hrtfSourcesPerListener * AudioHRTF::getFrameCost();
+                qDebug() << "HRTF sources per listener changed to" << hrtfSourcesPerListener;
+            }
+        }
+
         const QString AUDIO_ZONES = "zones";
+        QVector<AABox> zoneBoxes;
         if (audioEnvGroupObject[AUDIO_ZONES].isObject()) {
             const QJsonObject& zones = audioEnvGroupObject[AUDIO_ZONES].toObject();
 
@@ -1030,11 +1193,14 @@ void AudioMixer::parseSettingsObject(const QJsonObject &settingsObject) {
                         zMax = zRange[1].toFloat(&ok);
                         allOk &= ok;
 
-                        if (allOk) {
+                        if (allOk && zoneBoxes.size() >= MAX_AUDIO_ZONES) {
+                            qDebug() << "Ignoring zone:" << zone << "- at most" << MAX_AUDIO_ZONES << "zones are supported";
+                        } else if (allOk) {
                             glm::vec3 corner(xMin, yMin, zMin);
                             glm::vec3 dimensions(xMax - xMin, yMax - yMin, zMax - zMin);
                             AABox zoneAABox(corner, dimensions);
-                            _audioZones.insert(zone, zoneAABox);
+                            _audioZoneIndices.insert(zone, zoneBoxes.size());
+                            zoneBoxes.push_back(zoneAABox);
                             qDebug() << "Added zone:" << zone << "(corner:" << corner
                                      << ", dimensions:" << dimensions << ")";
                         }
@@ -1042,6 +1208,7 @@ void AudioMixer::parseSettingsObject(const QJsonObject &settingsObject) {
                 }
             }
         }
+        _audioZoneIndex.build(zoneBoxes);
 
         const QString ATTENUATION_COEFFICIENTS = "attenuation_coefficients";
         if (audioEnvGroupObject[ATTENUATION_COEFFICIENTS].isArray()) {
@@ -1065,9 +1232,14 @@ void AudioMixer::parseSettingsObject(const QJsonObject &settingsObject) {
                     settings.coefficient = coefficientObject.value(COEFFICIENT).toString().toFloat(&ok);
 
                     if (ok && settings.coefficient >= 0.0f && settings.coefficient <= 1.0f &&
-                        _audioZones.contains(settings.source) && _audioZones.contains(settings.listener)) {
+                        _audioZoneIndices.contains(settings.source) && _audioZoneIndices.contains(settings.listener)) {
+
+                        settings.sourceZone = _audioZoneIndices.value(settings.source);
+                        settings.listenerZone = _audioZoneIndices.value(settings.listener);
 
                         _zonesSettings.push_back(settings);
+                        _minAttenuationPerDoublingInDistance = std::min(_minAttenuationPerDoublingInDistance,
+                                                                        settings.coefficient);
                         qDebug() << "Added Coefficient:" << settings.source << settings.listener << settings.coefficient;
                     }
                 }
@@ -1093,9 +1265,10 @@ void AudioMixer::parseSettingsObject(const QJsonObject &settingsObject) {
                     float reverbTime = reverbObject.value(REVERB_TIME).toString().toFloat(&okReverbTime);
                     float wetLevel = reverbObject.value(WET_LEVEL).toString().toFloat(&okWetLevel);
 
-                    if (okReverbTime && okWetLevel && _audioZones.contains(zone)) {
+                    if (okReverbTime && okWetLevel && _audioZoneIndices.contains(zone)) {
                         ReverbSettings settings;
                         settings.zone = zone;
+                        settings.zoneIndex = _audioZoneIndices.value(zone);
                         settings.reverbTime = reverbTime;
                         settings.wetLevel = wetLevel;
 
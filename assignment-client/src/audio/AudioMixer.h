@@ -12,8 +12,11 @@
 #ifndef hifi_AudioMixer_h
 #define hifi_AudioMixer_h
 
+#include <vector>
+
 #include <AABox.h>
 #include <AudioRingBuffer.h>
+#include <AudioZoneIndex.h>
 #include <ThreadedAssignment.h>
 
 class PositionalAudioStream;
@@ -48,11 +51,16 @@ private:
     int addStreamToMixForListeningNodeWithStream(AudioMixerClientData* listenerNodeData,
                                                     const QUuid& streamUUID,
                                                     PositionalAudioStream* streamToAdd,
-                                                    AvatarAudioStream* listeningNodeStream);
+                                                    AvatarAudioStream* listeningNodeStream,
+                                                    AudioZoneMask sourceZones,
+                                                    AudioZoneMask listenerZones);
 
     /// prepares and sends a mix to one Node
     int prepareMixForListeningNode(Node* node);
 
+    /// cheap upper bound of how loud a stream will be in a listener's mix, 0 if it will not be heard at all
+    float computeAudibility(PositionalAudioStream* streamToAdd, AvatarAudioStream* listeningNodeStream);
+
     /// Send Audio Environment packet for a single node
     void sendAudioEnvironmentPacket(SharedNodePointer node);
 
@@ -78,16 +86,42 @@ private:
     int _numStatFrames;
     int _sumListeners;
     int _sumMixes;
+    int _sumHRTFMixes;
+    int _sumAudibleStreams;
+
+    // streams that passed the audibility pre-pass for the listener being mixed, reused across listeners
+    struct AudibleStream {
+        PositionalAudioStream* stream;
+        QUuid streamUUID;
+        float audibility;
+        AudioZoneMask zones;
+    };
+    std::vector<AudibleStream> _audibleStreams;
+
+    // only this many of the most audible streams are mixed for each listener, 0 for no limit
+    int _maxSourcesPerListener;
+
+    // the lowest of the default and per-zone attenuations, so audibility is never underestimated
+    float _minAttenuationPerDoublingInDistance;
+
+    // HRTF convolutions (see AudioHRTF::getLastRenderCost) allowed per listener per frame, and what is left of it
+    // for the listener currently being mixed. Sources beyond the budget use the cheap delay and shelf spatialization.
+    int _hrtfBudgetPerListener;
+    int _hrtfBudgetRemaining;
 
-    QHash<QString, AABox> _audioZones;
+    QHash<QString, int> _audioZoneIndices;  // zone name to its index in _audioZoneIndex
+    AudioZoneIndex _audioZoneIndex;
     struct ZonesSettings {
         QString source;
         QString listener;
+        int sourceZone;
+        int listenerZone;
         float coefficient;
     };
     QVector<ZonesSettings> _zonesSettings;
     struct ReverbSettings {
         QString zone;
+        int zoneIndex;
         float reverbTime;
         float wetLevel;
     };
@@ -97,6 +131,7 @@ private:
 
     static bool _printStreamStats;
     static bool _enableFilter;
+    static bool _enableHRTF;
 
     quint64 _lastPerSecondCallbackTime;
 
@@ -24,6 +24,7 @@
 AudioMixerClientData::AudioMixerClientData() :
     _audioStreams(),
     _outgoingMixedAudioSequenceNumber(0),
+    _lastAudioEnvironmentSent(0),
     _downstreamAudioStreamStats()
 {
 }
@@ -123,6 +124,17 @@ void AudioMixerClientData::checkBuffersBeforeFrameSend() {
     }
 }
 
+void AudioMixerClientData::updateZoneMemberships(const AudioZoneIndex& zoneIndex) {
+    if (zoneIndex.getNumZones() == 0) {
+        return;
+    }
+
+    QHash<QUuid, PositionalAudioStream*>::ConstIterator i;
+    for (i = _audioStreams.constBegin(); i != _audioStreams.constEnd(); i++) {
+        zoneIndex.update(i.value()->getPosition(), _zoneMemberships[i.key()]);
+    }
+}
+
 void AudioMixerClientData::removeDeadInjectedStreams() {
 
     const int INJECTOR_CONSECUTIVE_NOT_MIXED_AFTER_STARTED_THRESHOLD = 100;
@@ -138,6 +150,7 @@ void AudioMixerClientData::removeDeadInjectedStreams() {
             int notMixedThreshold = audioStream->hasStarted() ? INJECTOR_CONSECUTIVE_NOT_MIXED_AFTER_STARTED_THRESHOLD
                                                               : INJECTOR_CONSECUTIVE_NOT_MIXED_THRESHOLD;
             if (audioStream->getConsecutiveNotMixedCount() >= notMixedThreshold) {
+                _zoneMemberships.remove(i.key());
                 delete audioStream;
                 i = _audioStreams.erase(i);
                 continue;
@@ -196,6 +209,20 @@ void AudioMixerClientData::sendAudioStreamStatsPackets(const SharedNodePointer&
     }
 }
 
+// the decisions of the jitter buffer tuner, if it is driving this stream
+static void addJitterBufferTunerStats(QJsonObject& upstreamStats, const InboundAudioStream* stream) {
+    if (!stream->getDynamicJitterBuffers() || !stream->getAutoTuneJitterBuffers()) {
+        return;
+    }
+    const AudioJitterBufferTuner& tuner = stream->getJitterBufferTuner();
+    upstreamStats["tuner.gap_frames"] = tuner.getGapPercentileFrames();
+    upstreamStats["tuner.margin_frames"] = tuner.getMarginFrames();
+    upstreamStats["tuner.starves_per_min"] = tuner.getStarvesPerMinute();
+    upstreamStats["tuner.target_starves_per_min"] = tuner.getTargetStarvesPerMinute();
+    upstreamStats["tuner.increases"] = tuner.getIncreases();
+    upstreamStats["tuner.decreases"] = tuner.getDecreases();
+}
+
 QJsonObject AudioMixerClientData::getAudioStreamStats() const {
     QJsonObject result;
 
@@ -226,6 +253,7 @@ QJsonObject AudioMixerClientData::getAudioStreamStats() const {
         AudioStreamStats streamStats = avatarAudioStream->getAudioStreamStats();
         upstreamStats["mic.desired"] = streamStats._desiredJitterBufferFrames;
         upstreamStats["desired_calc"] = avatarAudioStream->getCalculatedJitterBufferFrames();
+        addJitterBufferTunerStats(upstreamStats, avatarAudioStream);
         upstreamStats["available_avg_10s"] = streamStats._framesAvailableAverage;
         upstreamStats["available"] = (double) streamStats._framesAvailable;
         upstreamStats["starves"] = (double) streamStats._starveCount;
@@ -255,6 +283,7 @@ QJsonObject AudioMixerClientData::getAudioStreamStats() const {
             AudioStreamStats streamStats = i.value()->getAudioStreamStats();
             upstreamStats["inj.desired"]  = streamStats._desiredJitterBufferFrames;
             upstreamStats["desired_calc"] = i.value()->getCalculatedJitterBufferFrames();
+            addJitterBufferTunerStats(upstreamStats, i.value());
             upstreamStats["available_avg_10s"] = streamStats._framesAvailableAverage;
             upstreamStats["available"] = (double) streamStats._framesAvailable;
             upstreamStats["starves"] = (double) streamStats._starveCount;
@@ -329,3 +358,33 @@ PerListenerSourcePairData* AudioMixerClientData::getListenerSourcePairData(const
     }
     return _listenerSourcePairData[sourceUUID];
 }
+
+void AudioMixerClientData::endMixFrame() {
+    foreach(PerListenerSourcePairData* pairData, _listenerSourcePairData) {
+        pairData->endFrame();
+    }
+}
+
+AudioHRTF& PerListenerSourcePairData::getHRTF() {
+    if (!_hrtf) {
+        _hrtf.reset(new AudioHRTF());
+    }
+    return *_hrtf;
+}
+
+void PerListenerSourcePairData::setHRTFActive(bool isHRTFActive) {
+    if (_isHRTFActive && !isHRTFActive) {
+        // drop the convolution history, it will be stale by the time this pair comes back to the HRTF path
+        _hrtf->reset();
+    }
+    _isHRTFActive = isHRTFActive;
+    _wasMixed = true;
+}
+
+void PerListenerSourcePairData::endFrame() {
+    if (!_wasMixed && _isHRTFActive) {
+        _hrtf->reset();
+        _isHRTFActive = false;
+    }
+    _wasMixed = false;
+}
@@ -12,6 +12,8 @@
 #ifndef hifi_AudioMixerClientData_h
 #define hifi_AudioMixerClientData_h
 
+#include <memory>
+
 #include <QtCore/QJsonObject>
 
 #include <AABox.h>
@@ -19,6 +21,8 @@
 #include <AudioBuffer.h> // For AudioFilterHSF1s and _penumbraFilter
 #include <AudioFilter.h> // For AudioFilterHSF1s and _penumbraFilter
 #include <AudioFilterBank.h> // For AudioFilterHSF1s and _penumbraFilter
+#include <AudioHRTF.h>
+#include <AudioZoneIndex.h>
 
 #include "PositionalAudioStream.h"
 #include "AvatarAudioStream.h"
@@ -30,8 +34,22 @@ public:
     };
     AudioFilterHSF1s& getPenumbraFilter() { return _penumbraFilter; }
 
+    // the HRTF state is large, so it is only allocated once this pair is first mixed through the HRTF path
+    AudioHRTF& getHRTF();
+
+    // the convolution history is only valid if this pair was rendered through the HRTF in consecutive frames,
+    // so it is reset whenever the mixer falls back to the cheap spatialization for this pair
+    bool isHRTFActive() const { return _isHRTFActive; }
+    void setHRTFActive(bool isHRTFActive);
+
+    // a pair the mixer skipped this frame (culled, or not audible) did not get setHRTFActive, and its history is stale too
+    void endFrame();
+
 private:
     AudioFilterHSF1s _penumbraFilter;
+    std::unique_ptr<AudioHRTF> _hrtf;
+    bool _isHRTFActive { false };
+    bool _wasMixed { false };
 };
 
 class AudioMixerClientData : public NodeData {
@@ -58,6 +76,16 @@ public:
     void printUpstreamDownstreamStats() const;
 
     PerListenerSourcePairData* getListenerSourcePairData(const QUuid& sourceUUID);
+
+    /// resets the HRTF state of the pairs that were not mixed since the last call, see PerListenerSourcePairData::endFrame
+    void endMixFrame();
+
+    /// moves the zone membership of every stream to its current position, see AudioZoneIndex::update
+    void updateZoneMemberships(const AudioZoneIndex& zoneIndex);
+    AudioZoneMask getStreamZones(const QUuid& streamUUID) const { return _zoneMemberships.value(streamUUID).zones; }
+
+    quint64 getLastAudioEnvironmentSent() const { return _lastAudioEnvironmentSent; }
+    void setLastAudioEnvironmentSent(quint64 lastAudioEnvironmentSent) { _lastAudioEnvironmentSent = lastAudioEnvironmentSent; }
 private:
     void printAudioStreamStats(const AudioStreamStats& streamStats) const;
 
@@ -67,8 +95,13 @@ private:
     // TODO: how can we prune this hash when a stream is no longer present?
     QHash<QUuid, PerListenerSourcePairData*> _listenerSourcePairData;
 
+    // zones containing each of our streams, keyed like _audioStreams
+    QHash<QUuid, AudioZoneMembership> _zoneMemberships;
+
     quint16 _outgoingMixedAudioSequenceNumber;
 
+    quint64 _lastAudioEnvironmentSent;
+
     AudioStreamStats _downstreamAudioStreamStats;
 };
 
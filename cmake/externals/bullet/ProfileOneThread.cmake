@@ -0,0 +1,30 @@
+# Bullet's profiler keeps a single tree of samples that any thread steps into and out of, which breaks when the islands
+# of the simulation are solved on several threads at once.  This makes it record only the thread that last reset it
+# (the simulation thread), and ignore the samples of the worker threads.
+
+set(QUICKPROF_SOURCE "${SOURCE_DIR}/src/LinearMath/btQuickprof.cpp")
+file(READ ${QUICKPROF_SOURCE} QUICKPROF)
+
+string(FIND "${QUICKPROF}" "gProfilingThread" PATCHED)
+if (NOT PATCHED EQUAL -1)
+  return()
+endif ()
+
+string(REGEX REPLACE "(#include \"btQuickprof.h\")"
+  "\\1\n\n#include <thread>\n\nstatic std::thread::id gProfilingThread = std::this_thread::get_id();"
+  QUICKPROF "${QUICKPROF}")
+string(REGEX REPLACE "(CProfileManager::Start_Profile[ \t]*\\([^)]*\\)[ \t\r\n]*{)"
+  "\\1\n\tif (std::this_thread::get_id() != gProfilingThread) return;"
+  QUICKPROF "${QUICKPROF}")
+string(REGEX REPLACE "(CProfileManager::Stop_Profile[ \t]*\\([^)]*\\)[ \t\r\n]*{)"
+  "\\1\n\tif (std::this_thread::get_id() != gProfilingThread) return;"
+  QUICKPROF "${QUICKPROF}")
+string(REGEX REPLACE "(CProfileManager::Reset[ \t]*\\([^)]*\\)[ \t\r\n]*{)"
+  "\\1\n\tgProfilingThread = std::this_thread::get_id();"
+  QUICKPROF "${QUICKPROF}")
+
+string(FIND "${QUICKPROF}" "gProfilingThread = std::this_thread::get_id();\n" RESET_PATCHED)
+if (RESET_PATCHED EQUAL -1)
+  message(FATAL_ERROR "Failed to patch ${QUICKPROF_SOURCE}")
+endif ()
+file(WRITE ${QUICKPROF_SOURCE} "${QUICKPROF}")
@@ -42,6 +42,13 @@ Item {
                         font.pixelSize: root.fontSize
                         text: "Avatars: " + root.avatarCount 
                     }
+                    Text {
+                        color: root.fontColor;
+                        font.pixelSize: root.fontSize
+                        visible: root.expanded;
+                        text: "Animated Full/Reduced/Far: " + root.avatarFullAnimationCount + "/" +
+                            root.avatarReducedAnimationCount + "/" + root.avatarFarAnimationCount
+                    }
                     Text { 
                         color: root.fontColor;
                         font.pixelSize: root.fontSize
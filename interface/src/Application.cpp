@@ -548,6 +548,10 @@ Application::Application(int& argc, char** argv, QElapsedTimer &startup_time) :
     cache->setCacheDirectory(!cachePath.isEmpty() ? cachePath : "interfaceCache");
     networkAccessManager.setCache(cache);
 
+    // the resources keep what they download and decode in a cache of their own, which survives the HTTP cache's expiry
+    ResourceCache::setDiskCache(QSharedPointer<ResourceDiskCache>(new ResourceDiskCache(
+        !cachePath.isEmpty() ? ResourceDiskCache::getDefaultDirectory() : "interfaceCache/resources")));
+
     ResourceCache::setRequestLimit(3);
 
     _glWidget = new GLCanvas();
@@ -829,6 +833,10 @@ void Application::emptyLocalCache() {
         qDebug() << "DiskCacheEditor::clear(): Clearing disk cache.";
         cache->clear();
     }
+    QSharedPointer<ResourceDiskCache> resourceCache = ResourceCache::getDiskCache();
+    if (resourceCache) {
+        resourceCache->clear();
+    }
 }
 
 Application::~Application() {
@@ -2407,6 +2415,7 @@ void Application::init() {
     _entities.init();
     _entities.setViewFrustum(getViewFrustum());
 
+    _shapeManager.setHullCache(ResourceCache::getDiskCache());
     ObjectMotionState::setShapeManager(&_shapeManager);
     _physicsEngine.init();
 
@@ -2695,6 +2704,9 @@ void Application::update(float deltaTime) {
     updateLOD();
     updateMouseRay(); // check what's under the mouse and update the mouse voxel
 
+    // renew the loading budgets of the frame, the resources closest to the camera first
+    ResourceCache::beginFrame(_myCamera.getPosition());
+
     {
         PerformanceTimer perfTimer("devices");
         DeviceTracker::updateAll();
@@ -3554,6 +3566,7 @@ void Application::displaySide(RenderArgs* renderArgs, Camera& theCamera, bool se
 
         renderContext._drawItemStatus = sceneInterface->doEngineDisplayItemStatus();
         renderContext._drawHitEffect = sceneInterface->doEngineDisplayHitEffect();
+        renderContext._optimizeBatches = sceneInterface->doEngineOptimizeBatches();
 
         renderContext._occlusionStatus = Menu::getInstance()->isOptionChecked(MenuOption::DebugAmbientOcclusion);
         renderContext._fxaaStatus = Menu::getInstance()->isOptionChecked(MenuOption::Antialiasing);
@@ -3576,6 +3589,8 @@ void Application::displaySide(RenderArgs* renderArgs, Camera& theCamera, bool se
 
         sceneInterface->setEngineFeedOverlay3DItems(engineRC->_numFeedOverlay3DItems);
         sceneInterface->setEngineDrawnOverlay3DItems(engineRC->_numDrawnOverlay3DItems);
+
+        sceneInterface->setEngineRemovedBatchCommands(engineRC->_numRemovedBatchCommands);
     }
 
     if (!selfAvatarOnly) {
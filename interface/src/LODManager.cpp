@@ -226,10 +226,9 @@ bool LODManager::shouldRender(const RenderArgs* args, const AABox& bounds) {
     float distanceToCamera = glm::length(bounds.calcCenter() - args->_viewFrustum->getPosition());
     float largestDimension = bounds.getLargestDimension();
     
-    static bool shouldRenderTableNeedsBuilding = true;
-    static QMap<float, float> shouldRenderTable;
-    if (shouldRenderTableNeedsBuilding) {
-        
+    // called from the render job threads, the static initialization is thread safe and the table is read only after it
+    static const QMap<float, float> shouldRenderTable = [maxScale] {
+        QMap<float, float> table;
         float SMALLEST_SCALE_IN_TABLE = 0.001f; // 1mm is plenty small
         float scale = maxScale;
         float factor = 1.0f;
@@ -237,11 +236,10 @@ bool LODManager::shouldRender(const RenderArgs* args, const AABox& bounds) {
         while (scale > SMALLEST_SCALE_IN_TABLE) {
             scale /= 2.0f;
             factor /= 2.0f;
-            shouldRenderTable[scale] = factor;
+            table[scale] = factor;
         }
-        
-        shouldRenderTableNeedsBuilding = false;
-    }
+        return table;
+    }();
     
     float closestScale = maxScale;
     float visibleDistanceAtClosestScale = visibleDistanceAtMaxScale;
@@ -59,7 +59,7 @@ const float DISPLAYNAME_BACKGROUND_ALPHA = 0.4f;
 
 namespace render {
     template <> const ItemKey payloadGetKey(const AvatarSharedPointer& avatar) {
-        return ItemKey::Builder::opaqueShape();
+        return ItemKey::Builder::opaqueShape().withDynamic();
     }
     template <> const Item::Bound payloadGetBound(const AvatarSharedPointer& avatar) {
         return static_pointer_cast<Avatar>(avatar)->getBounds();
@@ -147,6 +147,12 @@ float Avatar::getLODDistance() const {
 }
 
 void Avatar::simulate(float deltaTime) {
+    beginSimulation(deltaTime);
+    simulateSkeleton();
+    endSimulation(deltaTime);
+}
+
+void Avatar::beginSimulation(float deltaTime) {
     PerformanceTimer perfTimer("simulate");
 
     // update the avatar's position according to its referential
@@ -197,17 +203,56 @@ void Avatar::simulate(float deltaTime) {
         getHand()->simulate(deltaTime, false);
     }
 
-    if (!_shouldRenderBillboard && inViewFrustum) {
-        {
-            PerformanceTimer perfTimer("skeleton");
+    _isAnimated = !_shouldRenderBillboard && inViewFrustum;
+    if (_isAnimated) {
+        PerformanceTimer perfTimer("skeleton");
+        const ViewFrustum* viewFrustum = Application::getInstance()->getViewFrustum();
+        float projectedSize = AnimationLOD::computeProjectedSize(boundingRadius,
+            DependencyManager::get<LODManager>()->getAvatarLODDistanceMultiplier() *
+            glm::distance(viewFrustum->getPosition(), _position), viewFrustum->getFieldOfView());
+        _skeletonModel.setAnimationLODTier(AnimationLOD::computeTier(projectedSize, _skeletonModel.getAnimationLODTier()));
+
+        float animationDeltaTime;
+        bool updateAnimations = _skeletonModel.advanceAnimationLOD(deltaTime, animationDeltaTime);
+        if (updateAnimations) {
             for (int i = 0; i < _jointData.size(); i++) {
                 const JointData& data = _jointData.at(i);
                 _skeletonModel.setJointState(i, true, data.rotation);
             }
-            _skeletonModel.simulate(deltaTime, _hasNewJointRotations);
-            simulateAttachments(deltaTime);
+        }
+
+        // between updates, the model follows the avatar, and the joints move toward the last update
+        _skeletonModel.followOwningAvatar();
+        _skeletonDeltaTime = updateAnimations ? animationDeltaTime : deltaTime;
+        _simulateSkeletonJoints = _skeletonModel.beginSimulation(updateAnimations && _hasNewJointRotations);
+        _interpolateSkeletonJoints = !updateAnimations;
+        if (updateAnimations) {
             _hasNewJointRotations = false;
         }
+    }
+}
+
+void Avatar::simulateSkeleton() {
+    if (_simulateSkeletonJoints) {
+        _skeletonModel.simulateJoints(_skeletonDeltaTime);
+    }
+    if (_interpolateSkeletonJoints) {
+        _skeletonModel.interpolateJoints();
+    }
+}
+
+void Avatar::endSimulation(float deltaTime) {
+    if (_simulateSkeletonJoints) {
+        _skeletonModel.endSimulation();
+    }
+    _simulateSkeletonJoints = false;
+    _interpolateSkeletonJoints = false;
+
+    if (_isAnimated) {
+        {
+            PerformanceTimer perfTimer("attachments");
+            simulateAttachments(deltaTime);
+        }
         {
             PerformanceTimer perfTimer("head");
             glm::vec3 headPosition = _position;
@@ -215,7 +260,9 @@ void Avatar::simulate(float deltaTime) {
             Head* head = getHead();
             head->setPosition(headPosition);
             head->setScale(_scale);
-            head->simulate(deltaTime, false, _shouldRenderBillboard);
+            // at the far tier the face keeps its expression, but the face model and the eyes still follow the head
+            head->simulate(deltaTime, false, _shouldRenderBillboard,
+                _skeletonModel.getAnimationLODTier() != AnimationLOD::FAR_TIER);
         }
     }
 
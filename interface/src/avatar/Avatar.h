@@ -81,6 +81,15 @@ public:
     void init();
     void simulate(float deltaTime);
 
+    // simulate in three phases, so that the skeletons of many avatars can be simulated in parallel. beginSimulation reads
+    // the state of the application: the view, the LOD, the referential and the joint data. simulateSkeleton can run on
+    // any thread, alongside those of other avatars, as it only touches the avatar's own rig and skeleton model: the
+    // animations, the joint transforms and the clusters. endSimulation then commits the results on the main thread: the
+    // blendshapes, the attachments and the head.
+    void beginSimulation(float deltaTime);
+    void simulateSkeleton();
+    void endSimulation(float deltaTime);
+
     virtual void render(RenderArgs* renderArgs, const glm::vec3& cameraPosition);
 
     bool addToScene(AvatarSharedPointer self, std::shared_ptr<render::Scene> scene,
@@ -96,6 +105,8 @@ public:
     bool getIsLookAtTarget() const { return _isLookAtTarget; }
     //getters
     bool isInitialized() const { return _initialized; }
+    bool isAnimated() const { return _isAnimated; } ///< whether the last simulation animated the skeleton
+    AnimationLOD::Tier getAnimationLODTier() const { return _skeletonModel.getAnimationLODTier(); }
     SkeletonModel& getSkeletonModel() { return _skeletonModel; }
     const SkeletonModel& getSkeletonModel() const { return _skeletonModel; }
     const QVector<Model*>& getAttachmentModels() const { return _attachmentModels; }
@@ -227,6 +238,12 @@ private:
     NetworkTexturePointer _billboardTexture;
     bool _shouldRenderBillboard;
     bool _isLookAtTarget;
+    bool _isAnimated = false;
+
+    // what simulateSkeleton does, as beginSimulation decided
+    bool _simulateSkeletonJoints = false;
+    bool _interpolateSkeletonJoints = false;
+    float _skeletonDeltaTime = 0.0f;
 
     void renderBillboard(RenderArgs* renderArgs);
 
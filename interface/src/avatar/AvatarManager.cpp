@@ -9,6 +9,7 @@
 //  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
 //
 
+#include <algorithm>
 #include <string>
 
 #include <QScriptEngine>
@@ -107,6 +108,7 @@ void AvatarManager::updateMyAvatar(float deltaTime) {
 }
 
 void AvatarManager::updateOtherAvatars(float deltaTime) {
+    std::fill(_numAnimatedAvatars, _numAnimatedAvatars + AnimationLOD::NUM_TIERS, 0);
     if (_avatarHash.size() < 2 && _avatarFades.isEmpty()) {
         return;
     }
@@ -115,7 +117,8 @@ void AvatarManager::updateOtherAvatars(float deltaTime) {
 
     PerformanceTimer perfTimer("otherAvatars");
 
-    // simulate avatars
+    // collect the avatars to simulate
+    _simulatedAvatars.clear();
     AvatarHash::iterator avatarIterator = _avatarHash.begin();
     while (avatarIterator != _avatarHash.end()) {
         auto avatar = std::dynamic_pointer_cast<Avatar>(avatarIterator.value());
@@ -129,11 +132,24 @@ void AvatarManager::updateOtherAvatars(float deltaTime) {
             _avatarFades.push_back(avatarIterator.value());
             avatarIterator = _avatarHash.erase(avatarIterator);
         } else {
-            avatar->simulate(deltaTime);
+            _simulatedAvatars.push_back(avatar.get());
             ++avatarIterator;
         }
     }
 
+    // simulate avatars, their skeletons on the worker threads
+    _simulation.run(_simulatedAvatars.size(), [&](size_t i) {
+        _simulatedAvatars[i]->beginSimulation(deltaTime);
+    }, [&](size_t i) {
+        _simulatedAvatars[i]->simulateSkeleton();
+    }, [&](size_t i) {
+        Avatar* avatar = _simulatedAvatars[i];
+        avatar->endSimulation(deltaTime);
+        if (avatar->isAnimated()) {
+            _numAnimatedAvatars[avatar->getAnimationLODTier()]++;
+        }
+    });
+
     // simulate avatar fades
     simulateAvatarFades(deltaTime);
 }
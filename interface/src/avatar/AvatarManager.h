@@ -17,6 +17,7 @@
 #include <QtCore/QSharedPointer>
 
 #include <AvatarHashMap.h>
+#include <ParallelSimulation.h>
 #include <PhysicsEngine.h>
 
 #include "Avatar.h"
@@ -38,6 +39,12 @@ public:
     
     void updateMyAvatar(float deltaTime);
     void updateOtherAvatars(float deltaTime);
+
+    /// Returns the number of other avatars the last update animated at the tier.
+    int getNumAnimatedAvatars(AnimationLOD::Tier tier) const { return _numAnimatedAvatars[tier]; }
+
+    /// The other avatars simulate their skeletons in parallel, see ParallelSimulation.
+    ParallelSimulation& getSimulation() { return _simulation; }
     
     void clearOtherAvatars();
    
@@ -79,6 +86,10 @@ private:
     QVector<AvatarSharedPointer> _avatarFades;
     std::shared_ptr<MyAvatar> _myAvatar;
     quint64 _lastSendAvatarDataTime = 0; // Controls MyAvatar send data rate.
+    int _numAnimatedAvatars[AnimationLOD::NUM_TIERS] = { 0, 0, 0 };
+
+    ParallelSimulation _simulation;
+    std::vector<Avatar*> _simulatedAvatars;
     
     QVector<AvatarManager::LocalLight> _localLights;
 
@@ -39,8 +39,10 @@ void FaceModel::simulate(float deltaTime, bool fullUpdate) {
     setRotation(neckParentRotation);
     setScale(glm::vec3(1.0f, 1.0f, 1.0f) * _owningHead->getScale());
 
-    setPupilDilation(_owningHead->getPupilDilation());
-    setBlendshapeCoefficients(_owningHead->getBlendshapeCoefficients());
+    if (_owningHead->isFaceAnimated()) {
+        setPupilDilation(_owningHead->getPupilDilation());
+        setBlendshapeCoefficients(_owningHead->getBlendshapeCoefficients());
+    }
 
     // FIXME - this is very expensive, we shouldn't do it if we don't have to
     //invalidCalculatedMeshBoxes();
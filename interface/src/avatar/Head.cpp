@@ -77,7 +77,7 @@ void Head::reset() {
     _faceModel.reset();
 }
 
-void Head::simulate(float deltaTime, bool isMine, bool billboard) {
+void Head::simulate(float deltaTime, bool isMine, bool billboard, bool animateFace) {
     //  Update audio trailing average for rendering facial animations
     const float AUDIO_AVERAGING_SECS = 0.05f;
     const float AUDIO_LONG_TERM_AVERAGING_SECS = 30.0f;
@@ -134,7 +134,11 @@ void Head::simulate(float deltaTime, bool isMine, bool billboard) {
         }
     }
    
-    if (!(_isFaceTrackerConnected || billboard)) {
+    _isFaceAnimated = animateFace;
+    if (!_isFaceAnimated) {
+        // the blendshapes, blinks and saccades stay as they were
+
+    } else if (!(_isFaceTrackerConnected || billboard)) {
 
         if (!_isEyeTrackerConnected) {
             // Update eye saccades
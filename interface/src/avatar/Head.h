@@ -32,7 +32,9 @@ public:
     
     void init();
     void reset();
-    void simulate(float deltaTime, bool isMine, bool billboard = false);
+    /// \param animateFace whether the blendshapes and the eyes animate; without, the face keeps its expression but still
+    /// follows the head
+    void simulate(float deltaTime, bool isMine, bool billboard = false, bool animateFace = true);
     void render(RenderArgs* renderArgs, float alpha, ViewFrustum* renderFrustum);
     void setScale(float scale);
     void setPosition(glm::vec3 position) { _position = position; }
@@ -80,6 +82,7 @@ public:
     const FaceModel& getFaceModel() const { return _faceModel; }
     
     bool getReturnToCenter() const { return _returnHeadToCenter; } // Do you want head to try to return to center (depends on interface detected)
+    bool isFaceAnimated() const { return _isFaceAnimated; }
     float getAverageLoudness() const { return _averageLoudness; }
     /// \return the point about which scaling occurs.
     glm::vec3 getScalePivot() const;
@@ -111,6 +114,7 @@ private:
     Head& operator= (const Head&);
 
     bool _returnHeadToCenter;
+    bool _isFaceAnimated = true;
     glm::vec3 _position;
     glm::vec3 _rotation;
     glm::vec3 _leftEyePosition;
@@ -147,14 +147,21 @@ void SkeletonModel::updateRig(float deltaTime, glm::mat4 parentTransform) {
      }
 }
 
-// Called by Avatar::simulate after it has set the joint states (fullUpdate true if changed),
-// but just before head has been simulated.
-void SkeletonModel::simulate(float deltaTime, bool fullUpdate) {
+void SkeletonModel::followOwningAvatar() {
     setTranslation(_owningAvatar->getSkeletonPosition());
     static const glm::quat refOrientation = glm::angleAxis(PI, glm::vec3(0.0f, 1.0f, 0.0f));
     setRotation(_owningAvatar->getOrientation() * refOrientation);
     setScale(glm::vec3(1.0f, 1.0f, 1.0f) * _owningAvatar->getScale());
-    setBlendshapeCoefficients(_owningAvatar->getHead()->getBlendshapeCoefficients());
+    if (getAnimationLODTier() != AnimationLOD::FAR_TIER) {
+        // the far tier holds the face as it was
+        setBlendshapeCoefficients(_owningAvatar->getHead()->getBlendshapeCoefficients());
+    }
+}
+
+// Called by Avatar::simulate after it has set the joint states (fullUpdate true if changed),
+// but just before head has been simulated.
+void SkeletonModel::simulate(float deltaTime, bool fullUpdate) {
+    followOwningAvatar();
 
     Model::simulate(deltaTime, fullUpdate);
 
@@ -30,6 +30,9 @@ public:
     virtual void initJointStates(QVector<JointState> states);
 
     virtual void simulate(float deltaTime, bool fullUpdate = true);
+
+    /// Moves the model to the owning avatar and takes its blendshapes, the first thing simulate does.
+    void followOwningAvatar();
     virtual void updateRig(float deltaTime, glm::mat4 parentTransform);
 
     void renderIKConstraints(gpu::Batch& batch);
@@ -112,6 +112,9 @@ void Stats::updateStats() {
     auto avatarManager = DependencyManager::get<AvatarManager>();
     // we need to take one avatar out so we don't include ourselves
     STAT_UPDATE(avatarCount, avatarManager->size() - 1);
+    STAT_UPDATE(avatarFullAnimationCount, avatarManager->getNumAnimatedAvatars(AnimationLOD::FULL_TIER));
+    STAT_UPDATE(avatarReducedAnimationCount, avatarManager->getNumAnimatedAvatars(AnimationLOD::REDUCED_TIER));
+    STAT_UPDATE(avatarFarAnimationCount, avatarManager->getNumAnimatedAvatars(AnimationLOD::FAR_TIER));
     STAT_UPDATE(serverCount, nodeList->size());
     STAT_UPDATE(framerate, (int)qApp->getFps());
     STAT_UPDATE(simrate, (int)Application::getInstance()->getAverageSimsPerSecond());
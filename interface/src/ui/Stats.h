@@ -32,6 +32,9 @@ class Stats : public QQuickItem {
     STATS_PROPERTY(int, framerate, 0)
     STATS_PROPERTY(int, simrate, 0)
     STATS_PROPERTY(int, avatarCount, 0)
+    STATS_PROPERTY(int, avatarFullAnimationCount, 0)
+    STATS_PROPERTY(int, avatarReducedAnimationCount, 0)
+    STATS_PROPERTY(int, avatarFarAnimationCount, 0)
     STATS_PROPERTY(int, packetInCount, 0)
     STATS_PROPERTY(int, packetOutCount, 0)
     STATS_PROPERTY(float, mbpsIn, 0)
@@ -98,6 +101,9 @@ signals:
     void framerateChanged();
     void simrateChanged();
     void avatarCountChanged();
+    void avatarFullAnimationCountChanged();
+    void avatarReducedAnimationCountChanged();
+    void avatarFarAnimationCountChanged();
     void packetInCountChanged();
     void packetOutCountChanged();
     void mbpsInChanged();
@@ -245,6 +245,14 @@ bool Overlays::editOverlay(unsigned int id, const QScriptValue& properties) {
                     _overlaysWorld[id] = thisOverlay;
                 }
             }
+
+            // the edit may have moved the overlay
+            if (!drawOnHUD) {
+                render::ScenePointer scene = Application::getInstance()->getMain3DScene();
+                render::PendingChanges pendingChanges;
+                pendingChanges.updateItem(thisOverlay->getRenderItemID());
+                scene->enqueuePendingChanges(pendingChanges);
+            }
         } else {
             thisOverlay->setProperties(properties);
         }
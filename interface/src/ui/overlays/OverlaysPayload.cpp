@@ -36,11 +36,13 @@
 namespace render {
     template <> const ItemKey payloadGetKey(const Overlay::Pointer& overlay) {
         if (overlay->is3D() && !std::dynamic_pointer_cast<Base3DOverlay>(overlay)->getDrawOnHUD()) {
-            if (std::dynamic_pointer_cast<Base3DOverlay>(overlay)->getDrawInFront()) {
-                return ItemKey::Builder().withTypeShape().withLayered().build();
-            } else {
-                return ItemKey::Builder::opaqueShape();
+            ItemKey::Builder builder = std::dynamic_pointer_cast<Base3DOverlay>(overlay)->getDrawInFront() ?
+                ItemKey::Builder().withTypeShape().withLayered() : ItemKey::Builder::opaqueShape();
+            // overlays moved by scripts tell the scene when they are edited, the ones anchored to the avatar move with it
+            if (overlay->getAnchor() == Overlay::MY_AVATAR) {
+                builder.withDynamic();
             }
+            return builder.build();
         } else {
             return ItemKey::Builder().withTypeShape().withViewSpace().build();
         }
@@ -23,14 +23,12 @@ AnimBlendLinear::~AnimBlendLinear() {
 
 }
 
-const AnimPoseVec& AnimBlendLinear::evaluate(const AnimVariantMap& animVars, float dt, Triggers& triggersOut) {
+const AnimPoseBuffer& AnimBlendLinear::evaluate(const AnimVariantMap& animVars, float dt, Triggers& triggersOut) {
 
     _alpha = animVars.lookup(_alphaVar, _alpha);
 
     if (_children.size() == 0) {
-        for (auto&& pose : _poses) {
-            pose = AnimPose::identity;
-        }
+        _poses.fill(AnimPose::identity);
     } else if (_children.size() == 1) {
         _poses = _children[0]->evaluate(animVars, dt, triggersOut);
     } else {
@@ -43,13 +41,12 @@ const AnimPoseVec& AnimBlendLinear::evaluate(const AnimVariantMap& animVars, flo
             _poses = _children[prevPoseIndex]->evaluate(animVars, dt, triggersOut);
         } else {
             // need to eval and blend between two children.
-            auto prevPoses = _children[prevPoseIndex]->evaluate(animVars, dt, triggersOut);
-            auto nextPoses = _children[nextPoseIndex]->evaluate(animVars, dt, triggersOut);
+            // the children own their poses, which stay put while we blend them
+            const AnimPoseBuffer& prevPoses = _children[prevPoseIndex]->evaluate(animVars, dt, triggersOut);
+            const AnimPoseBuffer& nextPoses = _children[nextPoseIndex]->evaluate(animVars, dt, triggersOut);
 
             if (prevPoses.size() > 0 && prevPoses.size() == nextPoses.size()) {
-                _poses.resize(prevPoses.size());
-
-                ::blend(_poses.size(), &prevPoses[0], &nextPoses[0], alpha, &_poses[0]);
+                ::blend(prevPoses, nextPoses, alpha, _poses);
             }
         }
     }
@@ -57,6 +54,6 @@ const AnimPoseVec& AnimBlendLinear::evaluate(const AnimVariantMap& animVars, flo
 }
 
 // for AnimDebugDraw rendering
-const AnimPoseVec& AnimBlendLinear::getPosesInternal() const {
+const AnimPoseBuffer& AnimBlendLinear::getPosesInternal() const {
     return _poses;
 }
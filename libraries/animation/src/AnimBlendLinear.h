@@ -30,15 +30,15 @@ public:
     AnimBlendLinear(const std::string& id, float alpha);
     virtual ~AnimBlendLinear() override;
 
-    virtual const AnimPoseVec& evaluate(const AnimVariantMap& animVars, float dt, Triggers& triggersOut) override;
+    virtual const AnimPoseBuffer& evaluate(const AnimVariantMap& animVars, float dt, Triggers& triggersOut) override;
 
     void setAlphaVar(const std::string& alphaVar) { _alphaVar = alphaVar; }
 
 protected:
     // for AnimDebugDraw rendering
-    virtual const AnimPoseVec& getPosesInternal() const override;
+    virtual const AnimPoseBuffer& getPosesInternal() const override;
 
-    AnimPoseVec _poses;
+    AnimPoseBuffer _poses;
 
     float _alpha;
 
@@ -11,7 +11,6 @@
 #include "GLMHelpers.h"
 #include "AnimClip.h"
 #include "AnimationLogging.h"
-#include "AnimUtil.h"
 
 AnimClip::AnimClip(const std::string& id, const std::string& url, float startFrame, float endFrame, float timeScale, bool loopFlag) :
     AnimNode(AnimNode::Type::Clip, id),
@@ -28,7 +27,7 @@ AnimClip::~AnimClip() {
 
 }
 
-const AnimPoseVec& AnimClip::evaluate(const AnimVariantMap& animVars, float dt, Triggers& triggersOut) {
+const AnimPoseBuffer& AnimClip::evaluate(const AnimVariantMap& animVars, float dt, Triggers& triggersOut) {
 
     // lookup parameters from animVars, using current instance variables as defaults.
     _startFrame = animVars.lookup(_startFrameVar, _startFrame);
@@ -39,13 +38,14 @@ const AnimPoseVec& AnimClip::evaluate(const AnimVariantMap& animVars, float dt,
 
     // poll network anim to see if it's finished loading yet.
     if (_networkAnim && _networkAnim->isLoaded() && _skeleton) {
-        // loading is complete, copy animation frames from network animation, then throw it away.
-        copyFromNetworkAnim();
+        // loading is complete, share the compressed animation, then let go of the network animation.
+        _anim = _networkAnim->getCompressedAnimation();
         _networkAnim.reset();
+        mapJoints();
     }
 
-    if (_anim.size()) {
-        int frameCount = _anim.size();
+    if (_anim && _anim->getNumFrames() > 0 && !_jointMap.empty()) {
+        int frameCount = _anim->getNumFrames();
 
         int prevIndex = (int)glm::floor(_frame);
         int nextIndex = (int)glm::ceil(_frame);
@@ -58,11 +58,20 @@ const AnimPoseVec& AnimClip::evaluate(const AnimVariantMap& animVars, float dt,
         prevIndex = std::min(std::max(0, prevIndex), frameCount - 1);
         nextIndex = std::min(std::max(0, nextIndex), frameCount - 1);
 
-        const AnimPoseVec& prevFrame = _anim[prevIndex];
-        const AnimPoseVec& nextFrame = _anim[nextIndex];
+        // the joints the animation doesn't move keep their bind pose from mapJoints
         float alpha = glm::fract(_frame);
-
-        ::blend(_poses.size(), &prevFrame[0], &nextFrame[0], alpha, &_poses[0]);
+        for (size_t i = 0; i < _jointMap.size(); i++) {
+            int joint = _jointMap[i];
+            if (joint != -1) {
+                glm::quat prevRotation = _anim->sample(joint, prevIndex);
+                glm::quat nextRotation = _anim->sample(joint, nextIndex);
+                if (glm::dot(prevRotation, nextRotation) < 0.0f) {
+                    nextRotation = -nextRotation;
+                }
+                _poses.setRotation(i, _skeleton->getRelativeBindPose(i).rot *
+                                      glm::normalize(glm::lerp(prevRotation, nextRotation, alpha)));
+            }
+        }
     }
 
     return _poses;
@@ -113,49 +122,38 @@ float AnimClip::accumulateTime(float frame, float dt, Triggers& triggersOut) con
     return frame;
 }
 
-void AnimClip::copyFromNetworkAnim() {
-    assert(_networkAnim && _networkAnim->isLoaded() && _skeleton);
-    _anim.clear();
+void AnimClip::setSkeletonInternal(AnimSkeleton::ConstPointer skeleton) {
+    AnimNode::setSkeletonInternal(skeleton);
+    mapJoints();
+}
 
-    // build a mapping from animation joint indices to skeleton joint indices.
-    // by matching joints with the same name.
-    const FBXGeometry& geom = _networkAnim->getGeometry();
-    const QVector<FBXJoint>& animJoints = geom.joints;
-    std::vector<int> jointMap;
-    const int animJointCount = animJoints.count();
-    jointMap.reserve(animJointCount);
-    for (int i = 0; i < animJointCount; i++) {
-        int skeletonJoint = _skeleton->nameToJointIndex(animJoints.at(i).name);
-        if (skeletonJoint == -1) {
-            qCWarning(animation) << "animation contains joint =" << animJoints.at(i).name << " which is not in the skeleton, url =" << _url.c_str();
-        }
-        jointMap.push_back(skeletonJoint);
+void AnimClip::mapJoints() {
+    _jointMap.clear();
+    if (!_anim || !_skeleton) {
+        return;
     }
 
-    const int frameCount = geom.animationFrames.size();
+    // build a mapping from skeleton joint indices to animation joint indices.
+    // by matching joints with the same name.
+    const QStringList& animJointNames = _anim->getJointNames();
     const int skeletonJointCount = _skeleton->getNumJoints();
-    _anim.resize(frameCount);
-    for (int i = 0; i < frameCount; i++) {
-
-        // init all joints in animation to bind pose
-        _anim[i].reserve(skeletonJointCount);
-        for (int j = 0; j < skeletonJointCount; j++) {
-            _anim[i].push_back(_skeleton->getRelativeBindPose(j));
-        }
-
-        // init over all joint animations
-        for (int j = 0; j < animJointCount; j++) {
-            int k = jointMap[j];
-            if (k >= 0 && k < skeletonJointCount) {
-                // currently FBX animations only have rotation.
-                _anim[i][k].rot = _skeleton->getRelativeBindPose(k).rot * geom.animationFrames[i].rotations[j];
-            }
+    _jointMap.assign(skeletonJointCount, -1);
+    for (int i = 0; i < animJointNames.size(); i++) {
+        int skeletonJoint = _skeleton->nameToJointIndex(animJointNames.at(i));
+        if (skeletonJoint == -1) {
+            qCWarning(animation) << "animation contains joint =" << animJointNames.at(i) << " which is not in the skeleton, url =" << _url.c_str();
+        } else if (skeletonJoint < skeletonJointCount) {
+            _jointMap[skeletonJoint] = i;
         }
     }
+
+    // init all joints to bind pose, the animation only moves the rotations of its own.
     _poses.resize(skeletonJointCount);
+    for (int j = 0; j < skeletonJointCount; j++) {
+        _poses.setPose(j, _skeleton->getRelativeBindPose(j));
+    }
 }
 
-
-const AnimPoseVec& AnimClip::getPosesInternal() const {
+const AnimPoseBuffer& AnimClip::getPosesInternal() const {
     return _poses;
 }
@@ -28,7 +28,7 @@ public:
     AnimClip(const std::string& id, const std::string& url, float startFrame, float endFrame, float timeScale, bool loopFlag);
     virtual ~AnimClip() override;
 
-    virtual const AnimPoseVec& evaluate(const AnimVariantMap& animVars, float dt, Triggers& triggersOut) override;
+    virtual const AnimPoseBuffer& evaluate(const AnimVariantMap& animVars, float dt, Triggers& triggersOut) override;
 
     void setStartFrameVar(const std::string& startFrameVar) { _startFrameVar = startFrameVar; }
     void setEndFrameVar(const std::string& endFrameVar) { _endFrameVar = endFrameVar; }
@@ -40,18 +40,22 @@ protected:
     void loadURL(const std::string& url);
 
     virtual void setCurrentFrameInternal(float frame) override;
+    virtual void setSkeletonInternal(AnimSkeleton::ConstPointer skeleton) override;
 
     float accumulateTime(float frame, float dt, Triggers& triggersOut) const;
-    void copyFromNetworkAnim();
+    void mapJoints();
 
     // for AnimDebugDraw rendering
-    virtual const AnimPoseVec& getPosesInternal() const override;
+    virtual const AnimPoseBuffer& getPosesInternal() const override;
 
     AnimationPointer _networkAnim;
-    AnimPoseVec _poses;
+    AnimPoseBuffer _poses;
 
-    // _anim[frame][joint]
-    std::vector<AnimPoseVec> _anim;
+    // the rotations of the animation, shared with the other clips that play it
+    std::shared_ptr<const CompressedAnimation> _anim;
+
+    // _jointMap[skeleton joint], the joint of the animation, or -1 for those it doesn't move
+    std::vector<int> _jointMap;
 
     std::string _url;
     float _startFrame;
@@ -18,6 +18,7 @@
 #include <glm/glm.hpp>
 #include <glm/gtc/quaternion.hpp>
 
+#include "AnimPoseBuffer.h"
 #include "AnimSkeleton.h"
 #include "AnimVariant.h"
 
@@ -32,6 +33,7 @@ class QJsonObject;
 //   * skeleton accessors, the skeleton is from the model whose bones we are going to manipulate
 //   * evaluate method, perform actual joint manipulations here and return result by reference.
 //     Also, append any triggers that are detected during evaluation.
+//     Each node owns the buffer it returns, which it reuses from frame to frame, so that evaluation doesn't allocate.
 
 class AnimNode {
 public:
@@ -80,8 +82,8 @@ public:
 
     AnimSkeleton::ConstPointer getSkeleton() const { return _skeleton; }
 
-    virtual const AnimPoseVec& evaluate(const AnimVariantMap& animVars, float dt, Triggers& triggersOut) = 0;
-    virtual const AnimPoseVec& overlay(const AnimVariantMap& animVars, float dt, Triggers& triggersOut, const AnimPoseVec& underPoses) {
+    virtual const AnimPoseBuffer& evaluate(const AnimVariantMap& animVars, float dt, Triggers& triggersOut) = 0;
+    virtual const AnimPoseBuffer& overlay(const AnimVariantMap& animVars, float dt, Triggers& triggersOut, const AnimPoseBuffer& underPoses) {
         return evaluate(animVars, dt, triggersOut);
     }
 
@@ -100,7 +102,7 @@ protected:
     }
 
     // for AnimDebugDraw rendering
-    virtual const AnimPoseVec& getPosesInternal() const = 0;
+    virtual const AnimPoseBuffer& getPosesInternal() const = 0;
 
     Type _type;
     std::string _id;
@@ -37,7 +37,7 @@ void AnimOverlay::buildBoneSet(BoneSet boneSet) {
     }
 }
 
-const AnimPoseVec& AnimOverlay::evaluate(const AnimVariantMap& animVars, float dt, Triggers& triggersOut) {
+const AnimPoseBuffer& AnimOverlay::evaluate(const AnimVariantMap& animVars, float dt, Triggers& triggersOut) {
 
     // lookup parameters from animVars, using current instance variables as defaults.
     // NOTE: switching bonesets can be an expensive operation, let's try to avoid it.
@@ -49,17 +49,12 @@ const AnimPoseVec& AnimOverlay::evaluate(const AnimVariantMap& animVars, float d
     _alpha = animVars.lookup(_alphaVar, _alpha);
 
     if (_children.size() >= 2) {
-        auto underPoses = _children[1]->evaluate(animVars, dt, triggersOut);
-        auto overPoses = _children[0]->overlay(animVars, dt, triggersOut, underPoses);
+        const AnimPoseBuffer& underPoses = _children[1]->evaluate(animVars, dt, triggersOut);
+        const AnimPoseBuffer& overPoses = _children[0]->overlay(animVars, dt, triggersOut, underPoses);
 
         if (underPoses.size() > 0 && underPoses.size() == overPoses.size()) {
-            _poses.resize(underPoses.size());
-            assert(_boneSetVec.size() == _poses.size());
-
-            for (size_t i = 0; i < _poses.size(); i++) {
-                float alpha = _boneSetVec[i] * _alpha;
-                ::blend(1, &underPoses[i], &overPoses[i], alpha, &_poses[i]);
-            }
+            assert(_boneSetVec.size() == underPoses.size());
+            ::blend(underPoses, overPoses, &_boneSetVec[0], _alpha, _poses);
         }
     }
     return _poses;
@@ -169,7 +164,7 @@ void AnimOverlay::buildEmptyBoneSet() {
 }
 
 // for AnimDebugDraw rendering
-const AnimPoseVec& AnimOverlay::getPosesInternal() const {
+const AnimPoseBuffer& AnimOverlay::getPosesInternal() const {
     return _poses;
 }
 
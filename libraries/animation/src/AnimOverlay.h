@@ -41,7 +41,7 @@ public:
     AnimOverlay(const std::string& id, BoneSet boneSet, float alpha);
     virtual ~AnimOverlay() override;
 
-    virtual const AnimPoseVec& evaluate(const AnimVariantMap& animVars, float dt, Triggers& triggersOut) override;
+    virtual const AnimPoseBuffer& evaluate(const AnimVariantMap& animVars, float dt, Triggers& triggersOut) override;
 
     void setBoneSetVar(const std::string& boneSetVar) { _boneSetVar = boneSetVar; }
     void setAlphaVar(const std::string& alphaVar) { _alphaVar = alphaVar; }
@@ -50,10 +50,10 @@ public:
     void buildBoneSet(BoneSet boneSet);
 
     // for AnimDebugDraw rendering
-    virtual const AnimPoseVec& getPosesInternal() const override;
+    virtual const AnimPoseBuffer& getPosesInternal() const override;
     virtual void setSkeletonInternal(AnimSkeleton::ConstPointer skeleton) override;
 
-    AnimPoseVec _poses;
+    AnimPoseBuffer _poses;
     BoneSet _boneSet;
     float _alpha;
     std::vector<float> _boneSetVec;
@@ -0,0 +1,139 @@
+//
+//  AnimPoseBuffer.cpp
+//  libraries/animation/src
+//
+//  Copyright 2015 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include <algorithm>
+
+#include "AnimPoseBuffer.h"
+
+const size_t AnimPoseBuffer::LANES;
+const size_t AnimPosePool::MAX_FREE_BUFFERS = 64;
+
+void AnimPoseBuffer::resize(size_t size) {
+    size_t stride = (size + LANES - 1) / LANES * LANES;
+    if (stride > _stride) {
+        // the streams move apart, so they go to a new block
+        std::vector<float> data(NumStreams * stride);
+        for (int stream = 0; stream < NumStreams; stream++) {
+            std::copy(getStream((Stream)stream), getStream((Stream)stream) + _size, data.begin() + stream * stride);
+        }
+        _data.swap(data);
+        _stride = stride;
+    }
+    size_t oldSize = _size;
+    _size = size;
+    for (size_t i = std::min(oldSize, size); i < _stride; i++) {
+        setPose(i, AnimPose::identity);
+    }
+}
+
+AnimPose AnimPoseBuffer::getPose(size_t index) const {
+    const float* data = _data.data() + index;
+    return AnimPose(glm::vec3(data[ScaleX * _stride], data[ScaleY * _stride], data[ScaleZ * _stride]),
+                    glm::quat(data[RotW * _stride], data[RotX * _stride], data[RotY * _stride], data[RotZ * _stride]),
+                    glm::vec3(data[TransX * _stride], data[TransY * _stride], data[TransZ * _stride]));
+}
+
+void AnimPoseBuffer::setPose(size_t index, const AnimPose& pose) {
+    float* data = _data.data() + index;
+    data[TransX * _stride] = pose.trans.x;
+    data[TransY * _stride] = pose.trans.y;
+    data[TransZ * _stride] = pose.trans.z;
+    data[RotX * _stride] = pose.rot.x;
+    data[RotY * _stride] = pose.rot.y;
+    data[RotZ * _stride] = pose.rot.z;
+    data[RotW * _stride] = pose.rot.w;
+    data[ScaleX * _stride] = pose.scale.x;
+    data[ScaleY * _stride] = pose.scale.y;
+    data[ScaleZ * _stride] = pose.scale.z;
+}
+
+void AnimPoseBuffer::fill(const AnimPose& pose) {
+    for (size_t i = 0; i < _size; i++) {
+        setPose(i, pose);
+    }
+}
+
+glm::quat AnimPoseBuffer::getRotation(size_t index) const {
+    const float* data = _data.data() + index;
+    return glm::quat(data[RotW * _stride], data[RotX * _stride], data[RotY * _stride], data[RotZ * _stride]);
+}
+
+void AnimPoseBuffer::setRotation(size_t index, const glm::quat& rotation) {
+    float* data = _data.data() + index;
+    data[RotX * _stride] = rotation.x;
+    data[RotY * _stride] = rotation.y;
+    data[RotZ * _stride] = rotation.z;
+    data[RotW * _stride] = rotation.w;
+}
+
+void AnimPoseBuffer::fromPoses(const AnimPoseVec& poses) {
+    resize(poses.size());
+    for (size_t i = 0; i < poses.size(); i++) {
+        setPose(i, poses[i]);
+    }
+}
+
+void AnimPoseBuffer::toPoses(AnimPoseVec& poses) const {
+    poses.resize(_size);
+    for (size_t i = 0; i < _size; i++) {
+        poses[i] = getPose(i);
+    }
+}
+
+void AnimPosePool::Releaser::operator()(AnimPoseBuffer* buffer) const {
+    pool->release(buffer);
+}
+
+AnimPosePool& AnimPosePool::getInstance() {
+    static AnimPosePool instance;
+    return instance;
+}
+
+AnimPosePool::~AnimPosePool() {
+    clear();
+}
+
+AnimPosePool::Handle AnimPosePool::acquire(size_t size) {
+    AnimPoseBuffer* buffer = nullptr;
+    {
+        QMutexLocker locker(&_mutex);
+        if (!_free.empty()) {
+            buffer = _free.back();
+            _free.pop_back();
+        }
+    }
+    if (!buffer) {
+        buffer = new AnimPoseBuffer();
+    }
+    buffer->resize(size);
+    return Handle(buffer, Releaser { this });
+}
+
+size_t AnimPosePool::getNumFree() const {
+    QMutexLocker locker(&_mutex);
+    return _free.size();
+}
+
+void AnimPosePool::clear() {
+    QMutexLocker locker(&_mutex);
+    for (auto buffer : _free) {
+        delete buffer;
+    }
+    _free.clear();
+}
+
+void AnimPosePool::release(AnimPoseBuffer* buffer) {
+    QMutexLocker locker(&_mutex);
+    if (_free.size() < MAX_FREE_BUFFERS) {
+        _free.push_back(buffer);
+    } else {
+        delete buffer;
+    }
+}
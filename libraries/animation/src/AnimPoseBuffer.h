@@ -0,0 +1,104 @@
+//
+//  AnimPoseBuffer.h
+//  libraries/animation/src
+//
+//  Copyright 2015 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_AnimPoseBuffer_h
+#define hifi_AnimPoseBuffer_h
+
+#include <memory>
+#include <vector>
+
+#include <QMutex>
+
+#include "AnimSkeleton.h"
+
+// The poses of the joints of a skeleton, as the anim graph passes them from node to node. They are stored as a structure
+// of arrays: each of the ten components (translation x, y, z, rotation x, y, z, w and scale x, y, z) is a contiguous
+// stream of floats, padded with identity poses to a multiple of LANES joints, so that the blend kernels work on LANES
+// joints at a time without a scalar tail.
+class AnimPoseBuffer {
+public:
+    enum Stream {
+        TransX = 0, TransY, TransZ,
+        RotX, RotY, RotZ, RotW,
+        ScaleX, ScaleY, ScaleZ,
+        NumStreams
+    };
+
+    static const size_t LANES = 4;
+
+    AnimPoseBuffer() {}
+    explicit AnimPoseBuffer(size_t size) { resize(size); }
+    explicit AnimPoseBuffer(const AnimPoseVec& poses) { fromPoses(poses); }
+
+    size_t size() const { return _size; }
+
+    // the length of each stream, a multiple of LANES
+    size_t getStride() const { return _stride; }
+
+    // new joints get the identity pose. Shrinking keeps the memory, so that a buffer sized for a skeleton never reallocates.
+    void resize(size_t size);
+    void clear() { resize(0); }
+
+    AnimPose getPose(size_t index) const;
+    void setPose(size_t index, const AnimPose& pose);
+    void fill(const AnimPose& pose);
+
+    glm::quat getRotation(size_t index) const;
+    void setRotation(size_t index, const glm::quat& rotation);
+
+    float* getStream(Stream stream) { return _data.data() + stream * _stride; }
+    const float* getStream(Stream stream) const { return _data.data() + stream * _stride; }
+
+    void fromPoses(const AnimPoseVec& poses);
+    void toPoses(AnimPoseVec& poses) const;
+
+private:
+    size_t _size = 0;
+    size_t _stride = 0;
+    std::vector<float> _data;
+};
+
+// Recycles the pose buffers the anim graphs only need for a while, such as the poses a state machine blends from while it
+// switches states, so that once warm the graphs evaluate without allocating. Shared by all the graphs and thread safe.
+class AnimPosePool {
+public:
+    class Releaser {
+    public:
+        void operator()(AnimPoseBuffer* buffer) const;
+        AnimPosePool* pool;
+    };
+    using Handle = std::unique_ptr<AnimPoseBuffer, Releaser>;
+
+    // the number of free buffers past which released buffers are deleted
+    static const size_t MAX_FREE_BUFFERS;
+
+    static AnimPosePool& getInstance();
+
+    AnimPosePool() {}
+    ~AnimPosePool();
+
+    // a buffer of the size, returned to the pool when the handle goes
+    Handle acquire(size_t size);
+
+    size_t getNumFree() const;
+    void clear();
+
+private:
+    void release(AnimPoseBuffer* buffer);
+
+    mutable QMutex _mutex;
+    std::vector<AnimPoseBuffer*> _free;
+
+    // no copies
+    AnimPosePool(const AnimPosePool&) = delete;
+    AnimPosePool& operator=(const AnimPosePool&) = delete;
+};
+
+#endif // hifi_AnimPoseBuffer_h
@@ -21,7 +21,7 @@ AnimStateMachine::~AnimStateMachine() {
 
 }
 
-const AnimPoseVec& AnimStateMachine::evaluate(const AnimVariantMap& animVars, float dt, Triggers& triggersOut) {
+const AnimPoseBuffer& AnimStateMachine::evaluate(const AnimVariantMap& animVars, float dt, Triggers& triggersOut) {
 
     std::string desiredStateID = animVars.lookup(_currentStateVar, _currentState->getID());
     if (_currentState->getID() != desiredStateID) {
@@ -52,13 +52,13 @@ const AnimPoseVec& AnimStateMachine::evaluate(const AnimVariantMap& animVars, fl
     if (_duringInterp) {
         _alpha += _alphaVel * dt;
         if (_alpha < 1.0f) {
-            if (_poses.size() > 0) {
-                ::blend(_poses.size(), &_prevPoses[0], &_nextPoses[0], _alpha, &_poses[0]);
+            if (_poses.size() > 0 && _prevPoses->size() == _nextPoses->size()) {
+                ::blend(*_prevPoses, *_nextPoses, _alpha, _poses);
             }
         } else {
             _duringInterp = false;
-            _prevPoses.clear();
-            _nextPoses.clear();
+            _prevPoses.reset();
+            _nextPoses.reset();
         }
     }
     if (!_duringInterp) {
@@ -88,13 +88,17 @@ void AnimStateMachine::switchState(const AnimVariantMap& animVars, State::Pointe
     _alpha = 0.0f;
     float duration = std::max(0.001f, animVars.lookup(desiredState->_interpDurationVar, desiredState->_interpDuration));
     _alphaVel = FRAMES_PER_SECOND / duration;
-    _prevPoses = _poses;
+    if (!_prevPoses) {
+        _prevPoses = AnimPosePool::getInstance().acquire(_poses.size());
+        _nextPoses = AnimPosePool::getInstance().acquire(_poses.size());
+    }
+    *_prevPoses = _poses;
     nextStateNode->setCurrentFrame(desiredState->_interpTarget);
 
     // because dt is 0, we should not encounter any triggers
     const float dt = 0.0f;
     Triggers triggers;
-    _nextPoses = nextStateNode->evaluate(animVars, dt, triggers);
+    *_nextPoses = nextStateNode->evaluate(animVars, dt, triggers);
 
     _currentState = desiredState;
 }
@@ -109,6 +113,6 @@ AnimStateMachine::State::Pointer AnimStateMachine::evaluateTransitions(const Ani
     return _currentState;
 }
 
-const AnimPoseVec& AnimStateMachine::getPosesInternal() const {
+const AnimPoseBuffer& AnimStateMachine::getPosesInternal() const {
     return _poses;
 }
@@ -95,7 +95,7 @@ public:
     AnimStateMachine(const std::string& id);
     virtual ~AnimStateMachine() override;
 
-    virtual const AnimPoseVec& evaluate(const AnimVariantMap& animVars, float dt, Triggers& triggersOut) override;
+    virtual const AnimPoseBuffer& evaluate(const AnimVariantMap& animVars, float dt, Triggers& triggersOut) override;
 
     void setCurrentStateVar(std::string& currentStateVar) { _currentStateVar = currentStateVar; }
 
@@ -109,16 +109,17 @@ protected:
     State::Pointer evaluateTransitions(const AnimVariantMap& animVars) const;
 
     // for AnimDebugDraw rendering
-    virtual const AnimPoseVec& getPosesInternal() const override;
+    virtual const AnimPoseBuffer& getPosesInternal() const override;
 
-    AnimPoseVec _poses;
+    AnimPoseBuffer _poses;
 
     // interpolation state
     bool _duringInterp = false;
     float _alphaVel = 0.0f;
     float _alpha = 0.0f;
-    AnimPoseVec _prevPoses;
-    AnimPoseVec _nextPoses;
+    // only held while interpolating, taken from the pool
+    AnimPosePool::Handle _prevPoses;
+    AnimPosePool::Handle _nextPoses;
 
     State::Pointer _currentState;
     std::vector<State::Pointer> _states;
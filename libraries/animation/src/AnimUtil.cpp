@@ -8,15 +8,121 @@
 //  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
 //
 
+#include <algorithm>
+#include <cmath>
+
 #include "AnimUtil.h"
 #include "GLMHelpers.h"
 
+#if defined(__SSE__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 1)
+#define HIFI_ANIM_SSE
+#include <xmmintrin.h>
+#endif
+
 void blend(size_t numPoses, const AnimPose* a, const AnimPose* b, float alpha, AnimPose* result) {
     for (size_t i = 0; i < numPoses; i++) {
         const AnimPose& aPose = a[i];
         const AnimPose& bPose = b[i];
         result[i].scale = lerp(aPose.scale, bPose.scale, alpha);
-        result[i].rot = glm::normalize(glm::lerp(aPose.rot, bPose.rot, alpha));
+        glm::quat bRot = glm::dot(aPose.rot, bPose.rot) < 0.0f ? -bPose.rot : bPose.rot;
+        result[i].rot = glm::normalize(glm::lerp(aPose.rot, bRot, alpha));
         result[i].trans = lerp(aPose.trans, bPose.trans, alpha);
     }
 }
+
+static const AnimPoseBuffer::Stream LINEAR_STREAMS[] = {
+    AnimPoseBuffer::TransX, AnimPoseBuffer::TransY, AnimPoseBuffer::TransZ,
+    AnimPoseBuffer::ScaleX, AnimPoseBuffer::ScaleY, AnimPoseBuffer::ScaleZ
+};
+static const AnimPoseBuffer::Stream ROTATION_STREAMS[] = {
+    AnimPoseBuffer::RotX, AnimPoseBuffer::RotY, AnimPoseBuffer::RotZ, AnimPoseBuffer::RotW
+};
+
+// the buffers may have different strides, having been larger before, so each stream is addressed on its own
+static void blendStreams(const AnimPoseBuffer& a, const AnimPoseBuffer& b, const float* alphas, float alphaScale,
+                         AnimPoseBuffer& result) {
+    const size_t size = a.size();
+
+#ifdef HIFI_ANIM_SSE
+    const __m128 zero = _mm_setzero_ps();
+    const __m128 one = _mm_set1_ps(1.0f);
+    const __m128 signBit = _mm_set1_ps(-0.0f);
+    const __m128 scale = _mm_set1_ps(alphaScale);
+    for (size_t i = 0; i < size; i += AnimPoseBuffer::LANES) {
+        __m128 alpha;
+        if (!alphas) {
+            alpha = scale;
+        } else if (i + AnimPoseBuffer::LANES <= size) {
+            alpha = _mm_mul_ps(_mm_loadu_ps(alphas + i), scale);
+        } else {
+            // the padding joints have no alpha of their own
+            float tail[AnimPoseBuffer::LANES] = { 0.0f, 0.0f, 0.0f, 0.0f };
+            std::copy(alphas + i, alphas + size, tail);
+            alpha = _mm_mul_ps(_mm_loadu_ps(tail), scale);
+        }
+
+        for (auto stream : LINEAR_STREAMS) {
+            __m128 aValue = _mm_loadu_ps(a.getStream(stream) + i);
+            __m128 bValue = _mm_loadu_ps(b.getStream(stream) + i);
+            _mm_storeu_ps(result.getStream(stream) + i, _mm_add_ps(aValue, _mm_mul_ps(_mm_sub_ps(bValue, aValue), alpha)));
+        }
+
+        // b goes to the hemisphere of a, then the rotations are lerped and normalized
+        __m128 aRotation[4];
+        __m128 bRotation[4];
+        __m128 dot = zero;
+        for (int j = 0; j < 4; j++) {
+            aRotation[j] = _mm_loadu_ps(a.getStream(ROTATION_STREAMS[j]) + i);
+            bRotation[j] = _mm_loadu_ps(b.getStream(ROTATION_STREAMS[j]) + i);
+            dot = _mm_add_ps(dot, _mm_mul_ps(aRotation[j], bRotation[j]));
+        }
+        __m128 flip = _mm_and_ps(_mm_cmplt_ps(dot, zero), signBit);
+        __m128 length2 = zero;
+        for (int j = 0; j < 4; j++) {
+            __m128 bValue = _mm_xor_ps(bRotation[j], flip);
+            aRotation[j] = _mm_add_ps(aRotation[j], _mm_mul_ps(_mm_sub_ps(bValue, aRotation[j]), alpha));
+            length2 = _mm_add_ps(length2, _mm_mul_ps(aRotation[j], aRotation[j]));
+        }
+        __m128 inverseLength = _mm_div_ps(one, _mm_sqrt_ps(length2));
+        for (int j = 0; j < 4; j++) {
+            _mm_storeu_ps(result.getStream(ROTATION_STREAMS[j]) + i, _mm_mul_ps(aRotation[j], inverseLength));
+        }
+    }
+#else
+    for (size_t i = 0; i < size; i++) {
+        float alpha = alphas ? alphas[i] * alphaScale : alphaScale;
+        for (auto stream : LINEAR_STREAMS) {
+            float aValue = a.getStream(stream)[i];
+            result.getStream(stream)[i] = aValue + (b.getStream(stream)[i] - aValue) * alpha;
+        }
+        float dot = 0.0f;
+        for (auto stream : ROTATION_STREAMS) {
+            dot += a.getStream(stream)[i] * b.getStream(stream)[i];
+        }
+        float sign = dot < 0.0f ? -1.0f : 1.0f;
+        float rotation[4];
+        float length2 = 0.0f;
+        for (int j = 0; j < 4; j++) {
+            float aValue = a.getStream(ROTATION_STREAMS[j])[i];
+            rotation[j] = aValue + (sign * b.getStream(ROTATION_STREAMS[j])[i] - aValue) * alpha;
+            length2 += rotation[j] * rotation[j];
+        }
+        float inverseLength = 1.0f / sqrtf(length2);
+        for (int j = 0; j < 4; j++) {
+            result.getStream(ROTATION_STREAMS[j])[i] = rotation[j] * inverseLength;
+        }
+    }
+#endif
+}
+
+void blend(const AnimPoseBuffer& a, const AnimPoseBuffer& b, float alpha, AnimPoseBuffer& result) {
+    assert(a.size() == b.size());
+    result.resize(a.size());
+    blendStreams(a, b, nullptr, alpha, result);
+}
+
+void blend(const AnimPoseBuffer& a, const AnimPoseBuffer& b, const float* alphas, float alphaScale, AnimPoseBuffer& result) {
+    assert(a.size() == b.size());
+    result.resize(a.size());
+    blendStreams(a, b, alphas, alphaScale, result);
+}
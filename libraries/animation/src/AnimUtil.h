@@ -13,12 +13,14 @@
 
 #include "AnimNode.h"
 
-// TODO: use restrict keyword
-// TODO: excellent candidate for simd vectorization.
-
 // this is where the magic happens
+// scale and translation are lerped, rotations are nlerped along the shortest path.
 void blend(size_t numPoses, const AnimPose* a, const AnimPose* b, float alpha, AnimPose* result);
 
-#endif
+// same as above, over the streams of the buffers, four joints at a time. result can be a or b.
+void blend(const AnimPoseBuffer& a, const AnimPoseBuffer& b, float alpha, AnimPoseBuffer& result);
 
+// same as above, with an alpha per joint, scaled by alphaScale.
+void blend(const AnimPoseBuffer& a, const AnimPoseBuffer& b, const float* alphas, float alphaScale, AnimPoseBuffer& result);
 
+#endif
@@ -10,12 +10,12 @@
 //
 
 #include <QRunnable>
-#include <QThreadPool>
 
 #include "AnimationCache.h"
 #include "AnimationLogging.h"
 
 static int animationPointerMetaTypeId = qRegisterMetaType<AnimationPointer>();
+static int compressedAnimationPointerMetaTypeId = qRegisterMetaType<CompressedAnimation*>();
 
 AnimationCache::AnimationCache(QObject* parent) :
     ResourceCache(parent)
@@ -39,9 +39,17 @@ QSharedPointer<Resource> AnimationCache::createResource(const QUrl& url, const Q
     return QSharedPointer<Resource>(new Animation(url), &Resource::allReferencesCleared);
 }
 
-AnimationReader::AnimationReader(const QUrl& url, QNetworkReply* reply) :
+AnimationReader::AnimationReader(const QUrl& url, QNetworkReply* reply, int loadGeneration) :
     _url(url),
-    _reply(reply) {
+    _reply(reply),
+    _loadGeneration(loadGeneration) {
+}
+
+AnimationReader::~AnimationReader() {
+    // the reader may be dropped by the scheduler without running
+    if (_reply) {
+        _reply->deleteLater();
+    }
 }
 
 void AnimationReader::run() {
@@ -57,21 +65,26 @@ void AnimationReader::run() {
         if (urlValid) {
             // Parse the FBX directly from the QNetworkReply
             FBXGeometry* fbxgeo = nullptr;
+            CompressedAnimation* compressed = nullptr;
             if (_url.path().toLower().endsWith(".fbx")) {
                 fbxgeo = readFBX(_reply, QVariantHash(), _url.path());
+                compressed = new CompressedAnimation(fbxgeo->joints, fbxgeo->animationFrames);
             } else {
                 QString errorStr("usupported format");
-                emit onError(299, errorStr);
+                emit onError(299, errorStr, _loadGeneration);
             }
-            emit onSuccess(fbxgeo);
+            emit onSuccess(fbxgeo, compressed, _loadGeneration);
         } else {
             throw QString("url is invalid");
         }
 
     } catch (const QString& error) {
-        emit onError(299, error);
+        emit onError(299, error, _loadGeneration);
+    }
+    if (_reply) {
+        _reply->deleteLater();
+        _reply = nullptr;
     }
-    _reply->deleteLater();
 }
 
 Animation::Animation(const QUrl& url) : Resource(url) {}
@@ -110,21 +123,36 @@ const QVector<FBXAnimationFrame>& Animation::getFramesReference() const {
 
 void Animation::downloadFinished(QNetworkReply* reply) {
     // parse the animation/fbx file on a background thread.
-    AnimationReader* animationReader = new AnimationReader(reply->url(), reply);
-    connect(animationReader, SIGNAL(onSuccess(FBXGeometry*)), SLOT(animationParseSuccess(FBXGeometry*)));
-    connect(animationReader, SIGNAL(onError(int, QString)), SLOT(animationParseError(int, QString)));
-    QThreadPool::globalInstance()->start(animationReader);
-}
-
-void Animation::animationParseSuccess(FBXGeometry* geometry) {
+    AnimationReader* animationReader = new AnimationReader(reply->url(), reply, getLoadGeneration());
+    connect(animationReader, SIGNAL(onSuccess(FBXGeometry*, CompressedAnimation*, int)),
+            SLOT(animationParseSuccess(FBXGeometry*, CompressedAnimation*, int)));
+    connect(animationReader, SIGNAL(onError(int, QString, int)), SLOT(animationParseError(int, QString, int)));
+    ResourceCache::startDecode(this, ResourceScheduler::ANIMATION_DECODE, animationReader);
+}
+
+void Animation::animationParseSuccess(FBXGeometry* geometry, CompressedAnimation* compressedAnimation, int loadGeneration) {
+    // a parse started before the loading was cancelled leaves the animation to the one started after
+    if (loadGeneration != getLoadGeneration()) {
+        delete geometry;
+        delete compressedAnimation;
+        return;
+    }
 
     qCDebug(animation) << "Animation parse success" << _url.toDisplayString();
+    if (compressedAnimation) {
+        qCDebug(animation) << "Compressed" << compressedAnimation->getUncompressedByteSize() << "bytes of rotations to"
+                           << compressedAnimation->getByteSize() << "in" << compressedAnimation->getNumKeys() << "keys";
+    }
 
     _geometry.reset(geometry);
+    _compressedAnimation.reset(compressedAnimation);
     finishedLoading(true);
 }
 
-void Animation::animationParseError(int error, QString str) {
+void Animation::animationParseError(int error, QString str, int loadGeneration) {
+    if (loadGeneration != getLoadGeneration()) {
+        return;
+    }
     qCCritical(animation) << "Animation failure parsing " << _url.toDisplayString() << "code =" << error << str;
     emit failed(QNetworkReply::UnknownContentError);
 }
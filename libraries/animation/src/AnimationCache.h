@@ -20,6 +20,8 @@
 #include <FBXReader.h>
 #include <ResourceCache.h>
 
+#include "CompressedAnimation.h"
+
 class Animation;
 
 typedef QSharedPointer<Animation> AnimationPointer;
@@ -44,6 +46,7 @@ private:
 };
 
 Q_DECLARE_METATYPE(AnimationPointer)
+Q_DECLARE_METATYPE(CompressedAnimation*)
 
 /// An animation loaded from the network.
 class Animation : public Resource {
@@ -63,17 +66,21 @@ public:
     Q_INVOKABLE QVector<FBXAnimationFrame> getFrames() const;
 
     const QVector<FBXAnimationFrame>& getFramesReference() const;
+
+    /// The compressed rotations, shared by all the clips that play the animation.
+    std::shared_ptr<const CompressedAnimation> getCompressedAnimation() const { return _compressedAnimation; }
     
 protected:
     virtual void downloadFinished(QNetworkReply* reply);
 
 protected slots:
-    void animationParseSuccess(FBXGeometry* geometry);
-    void animationParseError(int error, QString str);
+    void animationParseSuccess(FBXGeometry* geometry, CompressedAnimation* compressedAnimation, int loadGeneration);
+    void animationParseError(int error, QString str, int loadGeneration);
 
 private:
     
     std::unique_ptr<FBXGeometry> _geometry;
+    std::shared_ptr<const CompressedAnimation> _compressedAnimation;
 };
 
 /// Reads geometry in a worker thread.
@@ -81,16 +88,18 @@ class AnimationReader : public QObject, public QRunnable {
     Q_OBJECT
 
 public:
-    AnimationReader(const QUrl& url, QNetworkReply* reply);
+    AnimationReader(const QUrl& url, QNetworkReply* reply, int loadGeneration);
+    virtual ~AnimationReader();
     virtual void run();
 
 signals:
-    void onSuccess(FBXGeometry* geometry);
-    void onError(int error, QString str);
+    void onSuccess(FBXGeometry* geometry, CompressedAnimation* compressedAnimation, int loadGeneration);
+    void onError(int error, QString str, int loadGeneration);
 
 private:
     QUrl _url;
     QNetworkReply* _reply;
+    int _loadGeneration;
 };
 
 class AnimationDetails {
@@ -0,0 +1,63 @@
+//
+//  AnimationLOD.cpp
+//  libraries/animation/src
+//
+//  Copyright 2015 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include <cmath>
+
+#include <GLMHelpers.h>
+
+#include "AnimationLOD.h"
+
+const float AnimationLOD::REDUCED_TIER_SIZE = 0.1f;
+const float AnimationLOD::FAR_TIER_SIZE = 0.03f;
+const float AnimationLOD::HYSTERESIS_PROPORTION = 0.1f;
+
+static const float UPDATE_PERIODS[AnimationLOD::NUM_TIERS] = { 0.0f, 1.0f / 15.0f, 1.0f / 4.0f };
+
+float AnimationLOD::computeProjectedSize(float radius, float distance, float fieldOfView) {
+    const float MIN_DISTANCE = 0.01f;
+    return radius / (glm::max(distance, MIN_DISTANCE) * tanf(glm::radians(fieldOfView) * 0.5f));
+}
+
+AnimationLOD::Tier AnimationLOD::computeTier(float projectedSize, Tier previousTier) {
+    // the thresholds move away from the size at the previous tier, so that a rig only changes tiers once clearly past them
+    float reducedSize = REDUCED_TIER_SIZE;
+    float farSize = FAR_TIER_SIZE;
+    if (previousTier == FULL_TIER) {
+        reducedSize *= 1.0f - HYSTERESIS_PROPORTION;
+        farSize *= 1.0f - HYSTERESIS_PROPORTION;
+    } else if (previousTier == REDUCED_TIER) {
+        reducedSize *= 1.0f + HYSTERESIS_PROPORTION;
+        farSize *= 1.0f - HYSTERESIS_PROPORTION;
+    } else {
+        reducedSize *= 1.0f + HYSTERESIS_PROPORTION;
+        farSize *= 1.0f + HYSTERESIS_PROPORTION;
+    }
+    if (projectedSize >= reducedSize) {
+        return FULL_TIER;
+    }
+    return (projectedSize >= farSize) ? REDUCED_TIER : FAR_TIER;
+}
+
+float AnimationLOD::getUpdatePeriod(Tier tier) {
+    return UPDATE_PERIODS[tier];
+}
+
+const char* AnimationLOD::getTierName(Tier tier) {
+    switch (tier) {
+        case FULL_TIER:
+            return "Full";
+        case REDUCED_TIER:
+            return "Reduced";
+        case FAR_TIER:
+            return "Far";
+        default:
+            return "Unknown";
+    }
+}
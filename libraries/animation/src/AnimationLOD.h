@@ -0,0 +1,44 @@
+//
+//  AnimationLOD.h
+//  libraries/animation/src
+//
+//  Copyright 2015 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_AnimationLOD_h
+#define hifi_AnimationLOD_h
+
+// How much animation a rig gets, by the size of its avatar on the screen. Near the camera, rigs update every frame. Farther
+// out, they update at a reduced rate and their joints move between the last two updates in the frames between. At the far
+// tier, they update rarely, hold their pose between updates, and get neither IK nor new blendshapes.
+class AnimationLOD {
+public:
+    enum Tier {
+        FULL_TIER = 0,
+        REDUCED_TIER,
+        FAR_TIER,
+        NUM_TIERS
+    };
+
+    // the projected sizes, as fractions of half the height of the view, below which the rigs drop to the tiers
+    static const float REDUCED_TIER_SIZE;
+    static const float FAR_TIER_SIZE;
+
+    // the proportion by which the size must pass a threshold to change tiers, so that rigs on the edge don't flicker
+    static const float HYSTERESIS_PROPORTION;
+
+    // the radius of the avatar over the distance to the camera, over the tangent of half the vertical field of view
+    static float computeProjectedSize(float radius, float distance, float fieldOfView);
+
+    static Tier computeTier(float projectedSize, Tier previousTier);
+
+    // the seconds between updates of the rigs in the tier, zero for every frame
+    static float getUpdatePeriod(Tier tier);
+
+    static const char* getTierName(Tier tier);
+};
+
+#endif // hifi_AnimationLOD_h
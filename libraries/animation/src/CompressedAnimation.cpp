@@ -0,0 +1,161 @@
+//
+//  CompressedAnimation.cpp
+//  libraries/animation/src
+//
+//  Copyright 2015 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include <algorithm>
+#include <cmath>
+
+#include <GLMHelpers.h>
+
+#include "CompressedAnimation.h"
+
+const float CompressedAnimation::DEFAULT_TOLERANCE = 0.002f;
+const int CompressedAnimation::MAX_KEY_SPACING = 256;
+
+static const int COMPONENT_BITS = 15;
+static const float COMPONENT_SCALE = (float)((1 << COMPONENT_BITS) - 1);
+static const float COMPONENT_RANGE = 0.5f * sqrtf(2.0f); // no component but the largest is bigger
+
+// nlerps along the shortest path
+static glm::quat interpolate(const glm::quat& a, const glm::quat& b, float alpha) {
+    glm::quat target = glm::dot(a, b) < 0.0f ? -b : b;
+    return glm::normalize(glm::lerp(a, target, alpha));
+}
+
+// the distance between the rotations, about half the angle between them when small
+static float distance(const glm::quat& a, const glm::quat& b) {
+    glm::quat target = glm::dot(a, b) < 0.0f ? -b : b;
+    glm::quat delta = a - target;
+    return sqrtf(glm::dot(delta, delta));
+}
+
+CompressedAnimation::CompressedAnimation(const QVector<FBXJoint>& joints, const QVector<FBXAnimationFrame>& frames,
+                                         float tolerance) :
+    _numFrames(frames.size()) {
+
+    std::vector<glm::quat> rotations(_numFrames);
+    _tracks.reserve(joints.size());
+    for (int i = 0; i < joints.size(); i++) {
+        _jointNames.append(joints.at(i).name);
+
+        // the tracks are checked against what the keys will decode to
+        for (int j = 0; j < _numFrames; j++) {
+            const QVector<glm::quat>& frameRotations = frames.at(j).rotations;
+            rotations[j] = dequantize(quantize(i < frameRotations.size() ? frameRotations.at(i) : glm::quat()));
+        }
+        compressTrack(rotations, 0.5f * tolerance);
+    }
+}
+
+void CompressedAnimation::compressTrack(const std::vector<glm::quat>& rotations, float halfTolerance) {
+    Track track = { (uint32_t)_keyFrames.size(), 0 };
+    int numFrames = (int)rotations.size();
+    if (numFrames > 0) {
+        // a joint that holds still keeps one key
+        bool constant = true;
+        for (int i = 1; i < numFrames && constant; i++) {
+            constant = distance(rotations[0], rotations[i]) <= halfTolerance;
+        }
+        int start = 0;
+        _keyFrames.push_back(0);
+        _keyRotations.push_back(quantize(rotations[0]));
+        while (!constant && start < numFrames - 1) {
+            // extend the key as far as interpolating to it reproduces the frames between
+            int end = start + 1;
+            while (end + 1 < numFrames && end + 1 - start <= MAX_KEY_SPACING) {
+                int next = end + 1;
+                bool reproduced = true;
+                for (int i = start + 1; i < next && reproduced; i++) {
+                    float alpha = (float)(i - start) / (next - start);
+                    reproduced = distance(interpolate(rotations[start], rotations[next], alpha), rotations[i]) <= halfTolerance;
+                }
+                if (!reproduced) {
+                    break;
+                }
+                end = next;
+            }
+            _keyFrames.push_back((uint32_t)end);
+            _keyRotations.push_back(quantize(rotations[end]));
+            start = end;
+        }
+    }
+    track.numKeys = (uint32_t)_keyFrames.size() - track.firstKey;
+    _tracks.push_back(track);
+}
+
+glm::quat CompressedAnimation::sample(int joint, int frame) const {
+    const Track& track = _tracks[joint];
+    if (track.numKeys == 0) {
+        return glm::quat();
+    }
+    auto first = _keyFrames.begin() + track.firstKey;
+    auto last = first + track.numKeys;
+    auto next = std::upper_bound(first, last, (uint32_t)std::max(frame, 0));
+    if (next == first) {
+        return dequantize(_keyRotations[track.firstKey]);
+    }
+    if (next == last) {
+        return dequantize(_keyRotations[track.firstKey + track.numKeys - 1]);
+    }
+    auto prev = next - 1;
+    float alpha = (float)(frame - (int)*prev) / (*next - *prev);
+    return interpolate(dequantize(_keyRotations[prev - _keyFrames.begin()]),
+                       dequantize(_keyRotations[next - _keyFrames.begin()]), alpha);
+}
+
+size_t CompressedAnimation::getByteSize() const {
+    return sizeof(CompressedAnimation) + _tracks.size() * sizeof(Track) + _keyFrames.size() * sizeof(uint32_t) +
+        _keyRotations.size() * sizeof(QuantizedRotation);
+}
+
+size_t CompressedAnimation::getUncompressedByteSize() const {
+    return (size_t)_numFrames * _tracks.size() * sizeof(glm::quat);
+}
+
+CompressedAnimation::QuantizedRotation CompressedAnimation::quantize(const glm::quat& rotation) {
+    float components[4] = { rotation.x, rotation.y, rotation.z, rotation.w };
+    int largest = 0;
+    for (int i = 1; i < 4; i++) {
+        if (fabsf(components[i]) > fabsf(components[largest])) {
+            largest = i;
+        }
+    }
+    // q and -q are the same rotation, so the largest is made positive and left out
+    float sign = components[largest] < 0.0f ? -1.0f : 1.0f;
+    uint64_t packed = (uint64_t)largest;
+    for (int i = 0; i < 4; i++) {
+        if (i != largest) {
+            float value = glm::clamp(sign * components[i] / COMPONENT_RANGE, -1.0f, 1.0f);
+            packed = (packed << COMPONENT_BITS) | (uint64_t)lroundf((value * 0.5f + 0.5f) * COMPONENT_SCALE);
+        }
+    }
+    QuantizedRotation result;
+    result.data[0] = (uint16_t)(packed >> 32);
+    result.data[1] = (uint16_t)(packed >> 16);
+    result.data[2] = (uint16_t)packed;
+    return result;
+}
+
+glm::quat CompressedAnimation::dequantize(const QuantizedRotation& rotation) {
+    uint64_t packed = ((uint64_t)rotation.data[0] << 32) | ((uint64_t)rotation.data[1] << 16) | (uint64_t)rotation.data[2];
+    int largest = (int)(packed >> (3 * COMPONENT_BITS));
+    float components[4];
+    float sumOfSquares = 0.0f;
+    const uint64_t MASK = (1 << COMPONENT_BITS) - 1;
+    for (int i = 3, shift = 0; i >= 0; i--) {
+        if (i != largest) {
+            float value = ((float)((packed >> shift) & MASK) / COMPONENT_SCALE * 2.0f - 1.0f) * COMPONENT_RANGE;
+            components[i] = value;
+            sumOfSquares += value * value;
+            shift += COMPONENT_BITS;
+        }
+    }
+    components[largest] = sqrtf(std::max(0.0f, 1.0f - sumOfSquares));
+    return glm::normalize(glm::quat(components[3], components[0], components[1], components[2]));
+}
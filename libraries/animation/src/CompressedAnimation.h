@@ -0,0 +1,77 @@
+//
+//  CompressedAnimation.h
+//  libraries/animation/src
+//
+//  Copyright 2015 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_CompressedAnimation_h
+#define hifi_CompressedAnimation_h
+
+#include <cstdint>
+#include <vector>
+
+#include <glm/glm.hpp>
+#include <glm/gtc/quaternion.hpp>
+
+#include <QStringList>
+
+#include <FBXReader.h>
+
+// The joint rotations of an animation, compressed and shared by all the clips that play it. Each joint is a track of
+// keyframes: frames that interpolating their neighbors reproduces within a tolerance are dropped, a joint that holds still
+// keeps a single key, and the rotations are quantized to 48 bits. Immutable once built, so clips on any thread can sample it.
+class CompressedAnimation {
+public:
+    // a rotation as its three smallest components at 15 bits each, with the index of the largest in the top two bits
+    class QuantizedRotation {
+    public:
+        uint16_t data[3];
+    };
+
+    // the angle, in radians, within which the dropped frames must be reproduced
+    static const float DEFAULT_TOLERANCE;
+
+    // the most frames between two keys, which bounds the time to compress long tracks
+    static const int MAX_KEY_SPACING;
+
+    CompressedAnimation(const QVector<FBXJoint>& joints, const QVector<FBXAnimationFrame>& frames,
+                        float tolerance = DEFAULT_TOLERANCE);
+
+    int getNumFrames() const { return _numFrames; }
+    int getNumJoints() const { return (int)_tracks.size(); }
+    const QStringList& getJointNames() const { return _jointNames; }
+
+    int getNumKeys() const { return (int)_keyFrames.size(); }
+    int getNumKeys(int joint) const { return (int)_tracks[joint].numKeys; }
+
+    // the rotation of the joint at the frame
+    glm::quat sample(int joint, int frame) const;
+
+    // the bytes the tracks take, and those the frames took
+    size_t getByteSize() const;
+    size_t getUncompressedByteSize() const;
+
+    static QuantizedRotation quantize(const glm::quat& rotation);
+    static glm::quat dequantize(const QuantizedRotation& rotation);
+
+private:
+    class Track {
+    public:
+        uint32_t firstKey;
+        uint32_t numKeys;
+    };
+
+    void compressTrack(const std::vector<glm::quat>& rotations, float halfTolerance);
+
+    int _numFrames = 0;
+    QStringList _jointNames;
+    std::vector<Track> _tracks;
+    std::vector<uint32_t> _keyFrames;
+    std::vector<QuantizedRotation> _keyRotations;
+};
+
+#endif // hifi_CompressedAnimation_h
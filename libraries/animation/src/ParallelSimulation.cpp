@@ -0,0 +1,46 @@
+//
+//  ParallelSimulation.cpp
+//  libraries/animation/src
+//
+//  Copyright 2015 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include <tbb/parallel_for.h>
+
+#include <SharedUtil.h>
+
+#include "ParallelSimulation.h"
+
+const size_t ParallelSimulation::DEFAULT_MIN_PARALLEL_COUNT = 2;
+
+void ParallelSimulation::run(size_t count, const Phase& begin, const Phase& simulate, const Phase& end) {
+    quint64 start = usecTimestampNow();
+    for (size_t i = 0; i < count; i++) {
+        begin(i);
+    }
+
+    quint64 parallelStart = usecTimestampNow();
+    _ranInParallel = _enabled && count >= _minParallelCount;
+    if (_ranInParallel) {
+        // one task per avatar, as their costs vary too much with their skeletons and LOD to chunk them evenly
+        tbb::parallel_for(tbb::blocked_range<size_t>(0, count, 1), [&](const tbb::blocked_range<size_t>& range) {
+            for (size_t i = range.begin(); i != range.end(); i++) {
+                simulate(i);
+            }
+        });
+    } else {
+        for (size_t i = 0; i < count; i++) {
+            simulate(i);
+        }
+    }
+    quint64 parallelEnd = usecTimestampNow();
+
+    for (size_t i = 0; i < count; i++) {
+        end(i);
+    }
+    _parallelUsecs = parallelEnd - parallelStart;
+    _serialUsecs = (parallelStart - start) + (usecTimestampNow() - parallelEnd);
+}
@@ -0,0 +1,55 @@
+//
+//  ParallelSimulation.h
+//  libraries/animation/src
+//
+//  Copyright 2015 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_ParallelSimulation_h
+#define hifi_ParallelSimulation_h
+
+#include <functional>
+
+#include <QtGlobal>
+
+/// Simulates many avatars a frame in three phases. The first, on the calling thread, reads the state of the application
+/// for each avatar in turn. The second, the bulk of the work, is pure math on the state of each avatar (animations, joint
+/// transforms, bounds), so the avatars run it in parallel on the tbb worker threads. The third, on the calling thread
+/// again, commits the results of each avatar in turn to the scene.
+class ParallelSimulation {
+public:
+    using Phase = std::function<void(size_t index)>;
+
+    /// Below this many avatars, the middle phase runs on the calling thread, where the tasks would cost more than they save
+    static const size_t DEFAULT_MIN_PARALLEL_COUNT;
+
+    /// Disabled, all three phases run on the calling thread, as for a single avatar
+    void setEnabled(bool enabled) { _enabled = enabled; }
+    bool isEnabled() const { return _enabled; }
+
+    void setMinParallelCount(size_t count) { _minParallelCount = count; }
+    size_t getMinParallelCount() const { return _minParallelCount; }
+
+    /// Runs begin for each of the count avatars, then simulate for all of them, then end for each. The functions get the
+    /// index of the avatar.
+    void run(size_t count, const Phase& begin, const Phase& simulate, const Phase& end);
+
+    /// The microseconds the last run spent on the calling thread, in the first and last phases, and in the middle phase
+    quint64 getSerialUsecs() const { return _serialUsecs; }
+    quint64 getParallelUsecs() const { return _parallelUsecs; }
+
+    /// Whether the last run spread the middle phase over the worker threads
+    bool ranInParallel() const { return _ranInParallel; }
+
+private:
+    bool _enabled = true;
+    size_t _minParallelCount = DEFAULT_MIN_PARALLEL_COUNT;
+    quint64 _serialUsecs = 0;
+    quint64 _parallelUsecs = 0;
+    bool _ranInParallel = false;
+};
+
+#endif // hifi_ParallelSimulation_h
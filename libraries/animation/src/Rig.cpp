@@ -575,7 +575,7 @@ void Rig::updateAnimations(float deltaTime, glm::mat4 rootTransform) {
 
         // evaluate the animation
         AnimNode::Triggers triggersOut;
-        AnimPoseVec poses = _animNode->evaluate(_animVars, deltaTime, triggersOut);
+        const AnimPoseBuffer& poses = _animNode->evaluate(_animVars, deltaTime, triggersOut);
         _animVars.clearTriggers();
         for (auto& trigger : triggersOut) {
             _animVars.setTrigger(trigger);
@@ -584,7 +584,7 @@ void Rig::updateAnimations(float deltaTime, glm::mat4 rootTransform) {
         // copy poses into jointStates
         const float PRIORITY = 1.0f;
         for (size_t i = 0; i < poses.size(); i++) {
-            setJointRotationInConstrainedFrame((int)i, glm::inverse(_animSkeleton->getRelativeBindPose(i).rot) * poses[i].rot, PRIORITY, false);
+            setJointRotationInConstrainedFrame((int)i, glm::inverse(_animSkeleton->getRelativeBindPose(i).rot) * poses.getRotation(i), PRIORITY, false);
         }
 
     } else {
@@ -633,6 +633,23 @@ void Rig::updateAnimations(float deltaTime, glm::mat4 rootTransform) {
         }
     }
 
+    if (_animationLODTier == AnimationLOD::REDUCED_TIER) {
+        // the joints start back at the pose of the last update, and move to this one until the next
+        if (_animationLODToRotations.size() != _jointStates.size()) {
+            _animationLODToRotations.clear();
+            for (int i = 0; i < _jointStates.size(); i++) {
+                _animationLODToRotations.append(_jointStates[i].getRotationInConstrainedFrame());
+            }
+        }
+        _animationLODFromRotations.swap(_animationLODToRotations);
+        _animationLODToRotations.resize(_jointStates.size());
+        for (int i = 0; i < _jointStates.size(); i++) {
+            JointState& state = _jointStates[i];
+            _animationLODToRotations[i] = state.getRotationInConstrainedFrame();
+            state.setRotationInConstrainedFrame(_animationLODFromRotations[i], state.getAnimationPriority());
+        }
+    }
+
     for (int i = 0; i < _jointStates.size(); i++) {
         updateJointState(i, rootTransform);
     }
@@ -641,10 +658,48 @@ void Rig::updateAnimations(float deltaTime, glm::mat4 rootTransform) {
     }
 }
 
+void Rig::setAnimationLODTier(AnimationLOD::Tier tier) {
+    if (tier != _animationLODTier) {
+        _animationLODTier = tier;
+        _animationLODFromRotations.clear();
+        _animationLODToRotations.clear();
+    }
+}
+
+bool Rig::advanceAnimationLOD(float deltaTime, float& animationDeltaTime) {
+    _animationLODTime += deltaTime;
+    if (_animationLODTime < AnimationLOD::getUpdatePeriod(_animationLODTier)) {
+        return false;
+    }
+    animationDeltaTime = _animationLODTime;
+    _animationLODTime = 0.0f;
+    return true;
+}
+
+bool Rig::interpolateAnimations(glm::mat4 rootTransform) {
+    if (_animationLODTier != AnimationLOD::REDUCED_TIER || _animationLODToRotations.size() != _jointStates.size() ||
+            _animationLODFromRotations.size() != _jointStates.size()) {
+        return false;
+    }
+    float alpha = glm::min(_animationLODTime / AnimationLOD::getUpdatePeriod(_animationLODTier), 1.0f);
+    for (int i = 0; i < _jointStates.size(); i++) {
+        JointState& state = _jointStates[i];
+        state.setRotationInConstrainedFrame(safeMix(_animationLODFromRotations[i], _animationLODToRotations[i], alpha),
+                                            state.getAnimationPriority());
+    }
+    for (int i = 0; i < _jointStates.size(); i++) {
+        updateJointState(i, rootTransform);
+    }
+    for (int i = 0; i < _jointStates.size(); i++) {
+        _jointStates[i].resetTransformChanged();
+    }
+    return true;
+}
+
 bool Rig::setJointPosition(int jointIndex, const glm::vec3& position, const glm::quat& rotation, bool useRotation,
                            int lastFreeIndex, bool allIntermediatesFree, const glm::vec3& alignment, float priority,
                            const QVector<int>& freeLineage, glm::mat4 rootTransform) {
-    if (jointIndex == -1 || _jointStates.isEmpty()) {
+    if (jointIndex == -1 || _jointStates.isEmpty() || _animationLODTier == AnimationLOD::FAR_TIER) {
         return false;
     }
     if (freeLineage.isEmpty()) {
@@ -728,7 +783,7 @@ void Rig::inverseKinematics(int endIndex, glm::vec3 targetPosition, const glm::q
                             const QVector<int>& freeLineage, glm::mat4 rootTransform) {
     // NOTE: targetRotation is from in model-frame
 
-    if (endIndex == -1 || _jointStates.isEmpty()) {
+    if (endIndex == -1 || _jointStates.isEmpty() || _animationLODTier == AnimationLOD::FAR_TIER) {
         return;
     }
 
@@ -982,6 +1037,9 @@ void Rig::updateNeckJoint(int index, const glm::quat& localHeadOrientation, floa
 
 void Rig::updateEyeJoints(int leftEyeIndex, int rightEyeIndex, const glm::vec3& modelTranslation, const glm::quat& modelRotation,
                           const glm::quat& worldHeadOrientation, const glm::vec3& lookAtSpot, const glm::vec3& saccade) {
+    if (_animationLODTier == AnimationLOD::FAR_TIER) {
+        return; // the eyes hold with the rest of the pose
+    }
     updateEyeJoint(leftEyeIndex, modelTranslation, modelRotation, worldHeadOrientation, lookAtSpot, saccade);
     updateEyeJoint(rightEyeIndex, modelTranslation, modelRotation, worldHeadOrientation, lookAtSpot, saccade);
 }
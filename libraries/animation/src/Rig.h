@@ -42,6 +42,7 @@
 
 #include "AnimNode.h"
 #include "AnimNodeLoader.h"
+#include "AnimationLOD.h"
 
 class AnimationHandle;
 typedef std::shared_ptr<AnimationHandle> AnimationHandlePointer;
@@ -140,6 +141,18 @@ public:
     void computeMotionAnimationState(float deltaTime, const glm::vec3& worldPosition, const glm::vec3& worldVelocity, const glm::quat& worldRotation);
     // Regardless of who started the animations or how many, update the joints.
     void updateAnimations(float deltaTime, glm::mat4 rootTransform);
+
+    // Beyond the full tier, the animations update at the rate of the tier, and there is no IK. See AnimationLOD.
+    void setAnimationLODTier(AnimationLOD::Tier tier);
+    AnimationLOD::Tier getAnimationLODTier() const { return _animationLODTier; }
+
+    // Advances the LOD clock by a frame. Returns whether the animations update this frame, with the time since the last
+    // update in animationDeltaTime.
+    bool advanceAnimationLOD(float deltaTime, float& animationDeltaTime);
+
+    // In the frames between updates at the reduced tier, moves the joints from the pose of the update before the last to
+    // that of the last, so that they reach it as the next update comes. Returns whether the joints moved.
+    bool interpolateAnimations(glm::mat4 rootTransform);
     bool setJointPosition(int jointIndex, const glm::vec3& position, const glm::quat& rotation, bool useRotation,
                           int lastFreeIndex, bool allIntermediatesFree, const glm::vec3& alignment, float priority,
                           const QVector<int>& freeLineage, glm::mat4 rootTransform);
@@ -209,6 +222,11 @@ public:
         Move
     };
     RigRole _state = RigRole::Idle;
+
+    AnimationLOD::Tier _animationLODTier = AnimationLOD::FULL_TIER;
+    float _animationLODTime = 0.0f; // since the last update
+    QVector<glm::quat> _animationLODFromRotations;
+    QVector<glm::quat> _animationLODToRotations;
 };
 
 #endif /* defined(__hifi__Rig__) */
@@ -0,0 +1,347 @@
+//
+//  AudioHRTF.cpp
+//  libraries/audio/src
+//
+//  Copyright 2015 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include <algorithm>
+#include <math.h>
+#include <string.h>
+
+#include <NumericalConstants.h>
+
+#include "AudioHRTF.h"
+
+// spherical head model parameters
+const float32_t HEAD_RADIUS = 0.0875f;        // meters
+const float32_t SPEED_OF_SOUND = 343.0f;      // meters per second
+const float32_t SHADOW_ALPHA_MIN = 0.1f;      // high frequency gain at the darkest point of the head shadow
+const float32_t SHADOW_THETA_MIN = 150.0f * RADIANS_PER_DEGREE;
+const float32_t REAR_SHADOW_GAIN = 0.708f;    // -3dB high shelf for sources directly behind the listener
+const float32_t REAR_SHADOW_FREQUENCY = 1000.0f;
+
+// bulk delay added to every HRIR so the band limited onset does not wrap around to the end of the filter
+const float32_t HRIR_PRE_DELAY_SAMPLES = 8.0f;
+const int HRIR_FADE_OUT_SAMPLES = 32;
+
+// the azimuth has to move by this much before the cached filter is re-interpolated (and crossfaded)
+const float32_t HRTF_AZIMUTH_EPSILON = 1.0f * RADIANS_PER_DEGREE;
+
+// the HRIRs are synthesized at twice their final length, then truncated
+const int SYNTHESIS_FFT_SIZE = 2 * HRTF_FILTER_LENGTH;
+const int MAX_FFT_SIZE = (SYNTHESIS_FFT_SIZE > HRTF_FFT_SIZE) ? SYNTHESIS_FFT_SIZE : HRTF_FFT_SIZE;
+
+struct FFTTwiddles {
+    FFTTwiddles() {
+        for (int i = 0; i < MAX_FFT_SIZE / 2; ++i) {
+            cosTable[i] = cosf(TWO_PI * i / MAX_FFT_SIZE);
+            sinTable[i] = sinf(TWO_PI * i / MAX_FFT_SIZE);
+        }
+    }
+    float32_t cosTable[MAX_FFT_SIZE / 2];
+    float32_t sinTable[MAX_FFT_SIZE / 2];
+};
+
+//
+// In-place iterative radix-2 complex FFT, n must be a power of two no larger than MAX_FFT_SIZE.
+// The inverse transform is not scaled.
+//
+static void fft(float32_t* real, float32_t* imag, int n, bool inverse) {
+    static const FFTTwiddles twiddles;
+
+    // bit reversal permutation
+    for (int i = 1, j = 0; i < n; ++i) {
+        int bit = n >> 1;
+        for (; j & bit; bit >>= 1) {
+            j ^= bit;
+        }
+        j ^= bit;
+        if (i < j) {
+            std::swap(real[i], real[j]);
+            std::swap(imag[i], imag[j]);
+        }
+    }
+
+    float32_t direction = inverse ? 1.0f : -1.0f;
+    for (int length = 2; length <= n; length <<= 1) {
+        int halfLength = length >> 1;
+        int tableStride = MAX_FFT_SIZE / length;
+        for (int start = 0; start < n; start += length) {
+            for (int k = 0; k < halfLength; ++k) {
+                float32_t wr = twiddles.cosTable[k * tableStride];
+                float32_t wi = direction * twiddles.sinTable[k * tableStride];
+
+                int even = start + k;
+                int odd = even + halfLength;
+                float32_t oddReal = real[odd] * wr - imag[odd] * wi;
+                float32_t oddImag = real[odd] * wi + imag[odd] * wr;
+
+                real[odd] = real[even] - oddReal;
+                imag[odd] = imag[even] - oddImag;
+                real[even] += oddReal;
+                imag[even] += oddImag;
+            }
+        }
+    }
+}
+
+// first order shelf (1 + j * alpha * w / w0) / (1 + j * w / w0), multiplied into (real, imag)
+static void applyShelf(float32_t alpha, float32_t omegaRatio, float32_t& real, float32_t& imag) {
+    // numerator (1 + j a), denominator (1 + j b)
+    float32_t a = alpha * omegaRatio;
+    float32_t b = omegaRatio;
+    float32_t denominator = 1.0f + b * b;
+    float32_t shelfReal = (1.0f + a * b) / denominator;
+    float32_t shelfImag = (a - b) / denominator;
+
+    float32_t outReal = real * shelfReal - imag * shelfImag;
+    float32_t outImag = real * shelfImag + imag * shelfReal;
+    real = outReal;
+    imag = outImag;
+}
+
+const AudioHRTFFilterSet& AudioHRTFFilterSet::getInstance() {
+    static AudioHRTFFilterSet instance;
+    return instance;
+}
+
+AudioHRTFFilterSet::AudioHRTFFilterSet() {
+    for (int i = 0; i < HRTF_AZIMUTH_STEPS; ++i) {
+        synthesize(i);
+    }
+}
+
+void AudioHRTFFilterSet::synthesize(int azimuthIndex) {
+    const float32_t azimuth = TWO_PI * azimuthIndex / HRTF_AZIMUTH_STEPS;
+    const float32_t headDelay = HEAD_RADIUS / SPEED_OF_SOUND;
+    const float32_t shadowOmega = 2.0f * SPEED_OF_SOUND / HEAD_RADIUS;
+    const float32_t rearOmega = TWO_PI * REAR_SHADOW_FREQUENCY;
+
+    // sources behind the listener lose some high end to the pinnae, regardless of the ear
+    float32_t rearAlpha = 1.0f + (REAR_SHADOW_GAIN - 1.0f) * std::max(0.0f, -cosf(azimuth));
+
+    for (int ear = 0; ear < HRTF_NUM_EARS; ++ear) {
+        // angle between the source direction and the axis through this ear
+        float32_t cosIncidence = (ear == HRTF_LEFT) ? sinf(azimuth) : -sinf(azimuth);
+        float32_t incidence = acosf(std::min(std::max(cosIncidence, -1.0f), 1.0f));
+
+        float32_t shadowAlpha = (1.0f + SHADOW_ALPHA_MIN / 2.0f) +
+            (1.0f - SHADOW_ALPHA_MIN / 2.0f) * cosf(incidence / SHADOW_THETA_MIN * PI);
+
+        // Woodworth's formula, offset so that the delay is never negative
+        float32_t delay = (incidence < PI_OVER_TWO) ? -headDelay * cosf(incidence) : headDelay * (incidence - PI_OVER_TWO);
+        delay += headDelay + HRIR_PRE_DELAY_SAMPLES / AudioConstants::SAMPLE_RATE;
+
+        float32_t real[SYNTHESIS_FFT_SIZE];
+        float32_t imag[SYNTHESIS_FFT_SIZE];
+
+        for (int k = 0; k <= SYNTHESIS_FFT_SIZE / 2; ++k) {
+            float32_t omega = TWO_PI * k * AudioConstants::SAMPLE_RATE / SYNTHESIS_FFT_SIZE;
+
+            real[k] = cosf(omega * delay);
+            imag[k] = -sinf(omega * delay);
+            applyShelf(shadowAlpha, omega / shadowOmega, real[k], imag[k]);
+            applyShelf(rearAlpha, omega / rearOmega, real[k], imag[k]);
+        }
+
+        // the nyquist bin of a real signal is real, and the negative frequencies are the conjugate mirror
+        imag[SYNTHESIS_FFT_SIZE / 2] = 0.0f;
+        for (int k = 1; k < SYNTHESIS_FFT_SIZE / 2; ++k) {
+            real[SYNTHESIS_FFT_SIZE - k] = real[k];
+            imag[SYNTHESIS_FFT_SIZE - k] = -imag[k];
+        }
+
+        fft(real, imag, SYNTHESIS_FFT_SIZE, true);
+
+        // truncate to the filter length, fading out the tail
+        float32_t hrir[HRTF_FILTER_LENGTH];
+        for (int i = 0; i < HRTF_FILTER_LENGTH; ++i) {
+            hrir[i] = real[i] / SYNTHESIS_FFT_SIZE;
+        }
+        for (int i = 0; i < HRIR_FADE_OUT_SAMPLES; ++i) {
+            hrir[HRTF_FILTER_LENGTH - 1 - i] *= (float32_t)i / HRIR_FADE_OUT_SAMPLES;
+        }
+
+        // split into partitions, and transform each one to the frequency domain
+        for (int p = 0; p < HRTF_NUM_PARTITIONS; ++p) {
+            float32_t partitionReal[HRTF_FFT_SIZE];
+            float32_t partitionImag[HRTF_FFT_SIZE];
+            for (int i = 0; i < HRTF_FFT_SIZE; ++i) {
+                partitionReal[i] = (i < HRTF_BLOCK_SIZE) ? hrir[p * HRTF_BLOCK_SIZE + i] : 0.0f;
+                partitionImag[i] = 0.0f;
+            }
+            fft(partitionReal, partitionImag, HRTF_FFT_SIZE, false);
+
+            int offset = azimuthIndex * getFilterSize() + ear * getEarStride() + p * getPartitionStride();
+            memcpy(&_real[offset], partitionReal, HRTF_NUM_BINS * sizeof(float32_t));
+            memcpy(&_imag[offset], partitionImag, HRTF_NUM_BINS * sizeof(float32_t));
+        }
+    }
+}
+
+void AudioHRTFFilterSet::interpolate(float32_t azimuth, float32_t* real, float32_t* imag) const {
+    if (azimuth != azimuth) {
+        // a source directly above or below the listener has no defined bearing
+        azimuth = 0.0f;
+    }
+    float32_t position = azimuth / TWO_PI * HRTF_AZIMUTH_STEPS;
+    position -= floorf(position / HRTF_AZIMUTH_STEPS) * HRTF_AZIMUTH_STEPS;
+
+    int index0 = std::min((int)position, HRTF_AZIMUTH_STEPS - 1);
+    int index1 = (index0 + 1) % HRTF_AZIMUTH_STEPS;
+    float32_t fraction = position - index0;
+
+    const float32_t* real0 = &_real[index0 * getFilterSize()];
+    const float32_t* imag0 = &_imag[index0 * getFilterSize()];
+    const float32_t* real1 = &_real[index1 * getFilterSize()];
+    const float32_t* imag1 = &_imag[index1 * getFilterSize()];
+
+    for (int i = 0; i < getFilterSize(); ++i) {
+        real[i] = real0[i] + fraction * (real1[i] - real0[i]);
+        imag[i] = imag0[i] + fraction * (imag1[i] - imag0[i]);
+    }
+}
+
+AudioHRTF::AudioHRTF() {
+    reset();
+}
+
+void AudioHRTF::reset() {
+    memset(_input, 0, sizeof(_input));
+    memset(_delayLineReal, 0, sizeof(_delayLineReal));
+    memset(_delayLineImag, 0, sizeof(_delayLineImag));
+    _delayLineHead = 0;
+    _azimuth = 0.0f;
+    _hasFilter = false;
+    _crossfade = false;
+    _lastRenderCost = 0;
+}
+
+int AudioHRTF::getFrameCost() {
+    return (AudioConstants::NETWORK_FRAME_SAMPLES_PER_CHANNEL / HRTF_BLOCK_SIZE) * HRTF_NUM_EARS * HRTF_NUM_PARTITIONS;
+}
+
+void AudioHRTF::render(const int16_t* input, int16_t* output, int numFrames, float32_t azimuth, float32_t gain) {
+    _lastRenderCost = 0;
+
+    if (!_hasFilter) {
+        AudioHRTFFilterSet::getInstance().interpolate(azimuth, _filterReal, _filterImag);
+        _azimuth = azimuth;
+        _hasFilter = true;
+    } else {
+        float32_t delta = fabsf(azimuth - _azimuth);
+        delta = std::min(delta, TWO_PI - delta);
+        if (delta > HRTF_AZIMUTH_EPSILON) {
+            memcpy(_previousFilterReal, _filterReal, sizeof(_filterReal));
+            memcpy(_previousFilterImag, _filterImag, sizeof(_filterImag));
+            AudioHRTFFilterSet::getInstance().interpolate(azimuth, _filterReal, _filterImag);
+            _azimuth = azimuth;
+            _crossfade = true;
+        }
+    }
+
+    for (int i = 0; i + HRTF_BLOCK_SIZE <= numFrames; i += HRTF_BLOCK_SIZE) {
+        renderBlock(&input[i], &output[i * 2], gain);
+        _crossfade = false;
+    }
+}
+
+void AudioHRTF::accumulate(const float32_t* filterReal, const float32_t* filterImag, float32_t* real, float32_t* imag) {
+    // real and imag receive the full spectrum of (left + j * right), so a single inverse FFT yields both ears
+    float32_t leftReal[HRTF_NUM_BINS];
+    float32_t leftImag[HRTF_NUM_BINS];
+    float32_t rightReal[HRTF_NUM_BINS];
+    float32_t rightImag[HRTF_NUM_BINS];
+
+    float32_t* earReal[HRTF_NUM_EARS] = { leftReal, rightReal };
+    float32_t* earImag[HRTF_NUM_EARS] = { leftImag, rightImag };
+
+    for (int ear = 0; ear < HRTF_NUM_EARS; ++ear) {
+        float32_t* outReal = earReal[ear];
+        float32_t* outImag = earImag[ear];
+        memset(outReal, 0, HRTF_NUM_BINS * sizeof(float32_t));
+        memset(outImag, 0, HRTF_NUM_BINS * sizeof(float32_t));
+
+        for (int p = 0; p < HRTF_NUM_PARTITIONS; ++p) {
+            // partition p of the filter is applied to the input from p blocks ago
+            int slot = (_delayLineHead - p + HRTF_NUM_PARTITIONS) % HRTF_NUM_PARTITIONS;
+            const float32_t* xReal = &_delayLineReal[slot * HRTF_NUM_BINS];
+            const float32_t* xImag = &_delayLineImag[slot * HRTF_NUM_BINS];
+
+            int offset = ear * AudioHRTFFilterSet::getEarStride() + p * AudioHRTFFilterSet::getPartitionStride();
+            const float32_t* hReal = &filterReal[offset];
+            const float32_t* hImag = &filterImag[offset];
+
+            for (int k = 0; k < HRTF_NUM_BINS; ++k) {
+                outReal[k] += xReal[k] * hReal[k] - xImag[k] * hImag[k];
+                outImag[k] += xReal[k] * hImag[k] + xImag[k] * hReal[k];
+            }
+        }
+        _lastRenderCost += HRTF_NUM_PARTITIONS;
+    }
+
+    // expand the two half spectra into one full spectrum: Z[k] = L[k] + jR[k], Z[N - k] = conj(L[k]) + j conj(R[k])
+    for (int k = 0; k < HRTF_NUM_BINS; ++k) {
+        real[k] = leftReal[k] - rightImag[k];
+        imag[k] = leftImag[k] + rightReal[k];
+    }
+    for (int k = 1; k < HRTF_FFT_SIZE / 2; ++k) {
+        real[HRTF_FFT_SIZE - k] = leftReal[k] + rightImag[k];
+        imag[HRTF_FFT_SIZE - k] = -leftImag[k] + rightReal[k];
+    }
+
+    fft(real, imag, HRTF_FFT_SIZE, true);
+}
+
+void AudioHRTF::renderBlock(const int16_t* input, int16_t* output, float32_t gain) {
+    // slide the overlap-save window and append the new block
+    memmove(_input, &_input[HRTF_BLOCK_SIZE], HRTF_BLOCK_SIZE * sizeof(float32_t));
+    for (int i = 0; i < HRTF_BLOCK_SIZE; ++i) {
+        _input[HRTF_BLOCK_SIZE + i] = input[i] * gain;
+    }
+
+    // transform the window into the newest delay line slot
+    _delayLineHead = (_delayLineHead + 1) % HRTF_NUM_PARTITIONS;
+    {
+        float32_t real[HRTF_FFT_SIZE];
+        float32_t imag[HRTF_FFT_SIZE];
+        memcpy(real, _input, sizeof(real));
+        memset(imag, 0, sizeof(imag));
+        fft(real, imag, HRTF_FFT_SIZE, false);
+        memcpy(&_delayLineReal[_delayLineHead * HRTF_NUM_BINS], real, HRTF_NUM_BINS * sizeof(float32_t));
+        memcpy(&_delayLineImag[_delayLineHead * HRTF_NUM_BINS], imag, HRTF_NUM_BINS * sizeof(float32_t));
+    }
+
+    float32_t real[HRTF_FFT_SIZE];
+    float32_t imag[HRTF_FFT_SIZE];
+    accumulate(_filterReal, _filterImag, real, imag);
+
+    float32_t previousReal[HRTF_FFT_SIZE];
+    float32_t previousImag[HRTF_FFT_SIZE];
+    if (_crossfade) {
+        accumulate(_previousFilterReal, _previousFilterImag, previousReal, previousImag);
+    }
+
+    // the last block of the inverse transform is the valid (non circular) part of the convolution
+    const float32_t scale = 1.0f / HRTF_FFT_SIZE;
+    for (int i = 0; i < HRTF_BLOCK_SIZE; ++i) {
+        float32_t left = real[HRTF_BLOCK_SIZE + i];
+        float32_t right = imag[HRTF_BLOCK_SIZE + i];
+
+        if (_crossfade) {
+            float32_t fade = (float32_t)(i + 1) / HRTF_BLOCK_SIZE;
+            left = previousReal[HRTF_BLOCK_SIZE + i] + fade * (left - previousReal[HRTF_BLOCK_SIZE + i]);
+            right = previousImag[HRTF_BLOCK_SIZE + i] + fade * (right - previousImag[HRTF_BLOCK_SIZE + i]);
+        }
+
+        int mixedLeft = output[2 * i] + (int)(left * scale);
+        int mixedRight = output[2 * i + 1] + (int)(right * scale);
+        output[2 * i] = std::min(std::max(mixedLeft, AudioConstants::MIN_SAMPLE_VALUE), AudioConstants::MAX_SAMPLE_VALUE);
+        output[2 * i + 1] = std::min(std::max(mixedRight, AudioConstants::MIN_SAMPLE_VALUE),
+                                     AudioConstants::MAX_SAMPLE_VALUE);
+    }
+}
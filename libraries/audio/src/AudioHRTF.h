@@ -0,0 +1,114 @@
+//
+//  AudioHRTF.h
+//  libraries/audio/src
+//
+//  Copyright 2015 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_AudioHRTF_h
+#define hifi_AudioHRTF_h
+
+#include <stdint.h>
+
+#include "AudioFormat.h"
+
+// The convolution runs in blocks of HRTF_BLOCK_SIZE samples (two blocks per network frame) using uniformly
+// partitioned overlap-save: each HRIR of HRTF_FILTER_LENGTH taps is split into HRTF_NUM_PARTITIONS partitions,
+// and every partition is applied in the frequency domain with an FFT of HRTF_FFT_SIZE points.
+const int HRTF_BLOCK_SIZE = 128;
+const int HRTF_FFT_SIZE = 2 * HRTF_BLOCK_SIZE;
+const int HRTF_NUM_PARTITIONS = 2;
+const int HRTF_FILTER_LENGTH = HRTF_NUM_PARTITIONS * HRTF_BLOCK_SIZE;
+
+// all signals are real, so only the non-negative half of each spectrum is stored
+const int HRTF_NUM_BINS = HRTF_FFT_SIZE / 2 + 1;
+
+// the filter set is precomputed on a grid of azimuths and linearly interpolated in between
+const int HRTF_AZIMUTH_STEPS = 72;  // 5 degree resolution
+
+const int HRTF_NUM_EARS = 2;
+const int HRTF_LEFT = 0;
+const int HRTF_RIGHT = 1;
+
+//
+// Precomputed, read-only set of frequency domain HRIR partitions, shared by every AudioHRTF instance.
+//
+// The filters are synthesized from a spherical head model (Brown & Duda, "A structural model for binaural sound
+// synthesis", 1998): a per-ear first order head shadow filter plus the Woodworth interaural time delay.
+//
+class AudioHRTFFilterSet {
+public:
+    static const AudioHRTFFilterSet& getInstance();
+
+    // fills the frequency domain partitions for both ears at the given azimuth, interpolating between grid entries.
+    // azimuth is in radians, with the same convention as the mixer's bearing: 0 is straight ahead, positive is to
+    // the left of the listener
+    void interpolate(float32_t azimuth, float32_t* real, float32_t* imag) const;
+
+    static int getPartitionStride() { return HRTF_NUM_BINS; }
+    static int getEarStride() { return HRTF_NUM_PARTITIONS * HRTF_NUM_BINS; }
+    static int getFilterSize() { return HRTF_NUM_EARS * getEarStride(); }
+
+private:
+    AudioHRTFFilterSet();
+
+    void synthesize(int azimuthIndex);
+
+    // [azimuth][ear][partition][bin]
+    float32_t _real[HRTF_AZIMUTH_STEPS * HRTF_NUM_EARS * HRTF_NUM_PARTITIONS * HRTF_NUM_BINS];
+    float32_t _imag[HRTF_AZIMUTH_STEPS * HRTF_NUM_EARS * HRTF_NUM_PARTITIONS * HRTF_NUM_BINS];
+};
+
+//
+// Per listener/source pair HRTF convolution state.
+//
+// Holds the frequency domain delay line of the mono source and the interpolated filter for the current azimuth.
+// The interpolated filter is cached and only recomputed when the azimuth moves, and the output is crossfaded from
+// the previous filter over one block whenever it does.
+//
+class AudioHRTF {
+public:
+    AudioHRTF();
+
+    void reset();
+
+    // renders numFrames (a multiple of HRTF_BLOCK_SIZE) samples of mono input, scaled by gain, and accumulates the
+    // result into interleaved stereo output with saturation
+    void render(const int16_t* input, int16_t* output, int numFrames, float32_t azimuth, float32_t gain);
+
+    // the number of convolutions (one per block, per ear, per partition) performed by the last render call.
+    // crossfading blocks cost twice as much, the mixer uses this to charge its per-frame budget
+    int getLastRenderCost() const { return _lastRenderCost; }
+
+    // the number of convolutions a render of one network frame costs when the filter does not change
+    static int getFrameCost();
+
+private:
+    void renderBlock(const int16_t* input, int16_t* output, float32_t gain);
+    void accumulate(const float32_t* filterReal, const float32_t* filterImag, float32_t* real, float32_t* imag);
+
+    // overlap-save input: the previous block followed by the current block
+    float32_t _input[HRTF_FFT_SIZE];
+
+    // frequency domain delay line of the input, one spectrum per partition
+    float32_t _delayLineReal[HRTF_NUM_PARTITIONS * HRTF_NUM_BINS];
+    float32_t _delayLineImag[HRTF_NUM_PARTITIONS * HRTF_NUM_BINS];
+    int _delayLineHead;
+
+    // interpolated filters for the current and the previous azimuth
+    float32_t _filterReal[HRTF_NUM_EARS * HRTF_NUM_PARTITIONS * HRTF_NUM_BINS];
+    float32_t _filterImag[HRTF_NUM_EARS * HRTF_NUM_PARTITIONS * HRTF_NUM_BINS];
+    float32_t _previousFilterReal[HRTF_NUM_EARS * HRTF_NUM_PARTITIONS * HRTF_NUM_BINS];
+    float32_t _previousFilterImag[HRTF_NUM_EARS * HRTF_NUM_PARTITIONS * HRTF_NUM_BINS];
+
+    float32_t _azimuth;
+    bool _hasFilter;
+    bool _crossfade;
+
+    int _lastRenderCost;
+};
+
+#endif // hifi_AudioHRTF_h
@@ -0,0 +1,108 @@
+//
+//  AudioJitterBufferTuner.cpp
+//  libraries/audio/src
+//
+//  Copyright 2015 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include <algorithm>
+
+#include <glm/glm.hpp>
+
+#include "AudioConstants.h"
+
+#include "AudioJitterBufferTuner.h"
+
+const int MIN_DESIRED_FRAMES = 1;
+const int MAX_MARGIN_FRAMES = 10;
+
+// the margin is lowered by one frame after this many seconds without a starve
+const int MARGIN_DECAY_SECONDS = 30;
+
+AudioJitterBufferTuner::AudioJitterBufferTuner(float targetStarvesPerMinute) :
+    _targetStarvesPerMinute(targetStarvesPerMinute),
+    _starveHistory(JITTER_BUFFER_TUNER_WINDOW_SECONDS)
+{
+    reset();
+}
+
+void AudioJitterBufferTuner::reset() {
+    // a second whose max gap lands above this percentile of the window is, on average, a second with a starve
+    float percentile = 1.0f - _targetStarvesPerMinute / (float)JITTER_BUFFER_TUNER_WINDOW_SECONDS;
+    _gapPercentile.reset(new MovingPercentile(JITTER_BUFFER_TUNER_WINDOW_SECONDS, glm::clamp(percentile, 0.5f, 1.0f)));
+
+    _maxGapThisSecond = 0;
+    _receivedThisSecond = false;
+    _starvesThisSecond = 0;
+
+    _starveHistory.fill(0);
+    _secondsElapsed = 0;
+    _secondsSinceLastStarve = 0;
+
+    _desiredFrames = MIN_DESIRED_FRAMES;
+    _gapPercentileFrames = 0;
+    _marginFrames = 0;
+
+    _increases = 0;
+    _decreases = 0;
+}
+
+void AudioJitterBufferTuner::setTargetStarvesPerMinute(float targetStarvesPerMinute) {
+    if (targetStarvesPerMinute != _targetStarvesPerMinute) {
+        _targetStarvesPerMinute = targetStarvesPerMinute;
+        reset();
+    }
+}
+
+void AudioJitterBufferTuner::packetReceived(quint64 timeGap) {
+    _maxGapThisSecond = std::max(_maxGapThisSecond, timeGap);
+    _receivedThisSecond = true;
+}
+
+float AudioJitterBufferTuner::getStarvesPerMinute() const {
+    int starves = 0;
+    foreach (int starvesInSecond, _starveHistory) {
+        starves += starvesInSecond;
+    }
+    return starves * (60.0f / (float)JITTER_BUFFER_TUNER_WINDOW_SECONDS);
+}
+
+int AudioJitterBufferTuner::update() {
+    // seconds without any packet (the sender is gone or muted) say nothing about the network
+    if (_receivedThisSecond) {
+        _gapPercentile->updatePercentile((float)_maxGapThisSecond / (float)AudioConstants::NETWORK_FRAME_USECS);
+    }
+    _gapPercentileFrames = (int)ceilf(_gapPercentile->getValueAtPercentile());
+
+    _starveHistory[_secondsElapsed % JITTER_BUFFER_TUNER_WINDOW_SECONDS] = _starvesThisSecond;
+    _secondsElapsed++;
+
+    if (_starvesThisSecond > 0) {
+        _secondsSinceLastStarve = 0;
+        if (getStarvesPerMinute() > _targetStarvesPerMinute && _marginFrames < MAX_MARGIN_FRAMES) {
+            _marginFrames++;
+        }
+    } else if (++_secondsSinceLastStarve >= MARGIN_DECAY_SECONDS && _marginFrames > 0) {
+        _marginFrames--;
+        _secondsSinceLastStarve = 0;
+    }
+
+    int targetFrames = std::max(_gapPercentileFrames + _marginFrames, MIN_DESIRED_FRAMES);
+    if (targetFrames > _desiredFrames) {
+        _desiredFrames = targetFrames;
+        _increases++;
+    } else if (targetFrames < _desiredFrames) {
+        // the extra frames drain through dropped silent frames anyway, there is no point in rushing
+        _desiredFrames--;
+        _decreases++;
+    }
+
+    _maxGapThisSecond = 0;
+    _receivedThisSecond = false;
+    _starvesThisSecond = 0;
+
+    return _desiredFrames;
+}
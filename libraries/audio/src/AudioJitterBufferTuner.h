@@ -0,0 +1,79 @@
+//
+//  AudioJitterBufferTuner.h
+//  libraries/audio/src
+//
+//  Copyright 2015 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_AudioJitterBufferTuner_h
+#define hifi_AudioJitterBufferTuner_h
+
+#include <memory>
+
+#include <QtCore/QVector>
+
+#include "MovingPercentile.h"
+
+const float DEFAULT_TARGET_STARVES_PER_MINUTE = 1.0f;
+
+// length of the history the tuner works from, one sample per second
+const int JITTER_BUFFER_TUNER_WINDOW_SECONDS = 60;
+
+//
+// Adaptive controller for the desired number of jitter buffer frames of one inbound stream.
+//
+// Every second, the largest packet time gap seen during that second is recorded. The desired frames follow a moving
+// percentile of those per-second maxima, where the percentile is picked so that, on a stationary network, the gap
+// exceeds the buffer in about targetStarvesPerMinute seconds out of every sixty. A margin on top of the percentile is
+// raised when the stream actually starves more often than targeted and slowly decays while it doesn't, so links
+// whose jitter is not well described by the history still converge to the target rate.
+//
+// Increases of the desired frames take effect immediately, decreases happen one frame per second.
+//
+class AudioJitterBufferTuner {
+public:
+    AudioJitterBufferTuner(float targetStarvesPerMinute = DEFAULT_TARGET_STARVES_PER_MINUTE);
+
+    void reset();
+
+    void setTargetStarvesPerMinute(float targetStarvesPerMinute);
+    float getTargetStarvesPerMinute() const { return _targetStarvesPerMinute; }
+
+    void packetReceived(quint64 timeGap);
+    void starved() { _starvesThisSecond++; }
+
+    /// must be called once per second, returns the new desired jitter buffer frames
+    int update();
+
+    int getDesiredFrames() const { return _desiredFrames; }
+    int getGapPercentileFrames() const { return _gapPercentileFrames; }
+    int getMarginFrames() const { return _marginFrames; }
+    float getStarvesPerMinute() const;
+    int getIncreases() const { return _increases; }
+    int getDecreases() const { return _decreases; }
+
+private:
+    float _targetStarvesPerMinute;
+    std::unique_ptr<MovingPercentile> _gapPercentile;   // in frames
+
+    quint64 _maxGapThisSecond;
+    bool _receivedThisSecond;
+    int _starvesThisSecond;
+
+    QVector<int> _starveHistory;    // starves per second, circular over the window
+    int _secondsElapsed;
+    int _secondsSinceLastStarve;
+
+    int _desiredFrames;
+    int _gapPercentileFrames;
+    int _marginFrames;
+
+    // decisions taken since the last reset
+    int _increases;
+    int _decreases;
+};
+
+#endif // hifi_AudioJitterBufferTuner_h
@@ -31,8 +31,8 @@ _randomAccessMode(randomAccessMode),
 _overflowCount(0)
 {
     if (numFrameSamples) {
-        _buffer = new int16_t[_bufferLength];
-        memset(_buffer, 0, _bufferLength * sizeof(int16_t));
+        _buffer = new int16_t[_bufferLength + _numFrameSamples];
+        memset(_buffer, 0, (_bufferLength + _numFrameSamples) * sizeof(int16_t));
         _nextOutput = _buffer;
         _endOfLastWrite = _buffer;
     } else {
@@ -56,11 +56,8 @@ void AudioRingBuffer::resizeForFrameSize(int numFrameSamples) {
     _sampleCapacity = numFrameSamples * _frameCapacity;
     _bufferLength = numFrameSamples * (_frameCapacity + 1);
     _numFrameSamples = numFrameSamples;
-    _buffer = new int16_t[_bufferLength];
-    memset(_buffer, 0, _bufferLength * sizeof(int16_t));
-    if (_randomAccessMode) {
-        memset(_buffer, 0, _bufferLength * sizeof(int16_t));
-    }
+    _buffer = new int16_t[_bufferLength + _numFrameSamples];
+    memset(_buffer, 0, (_bufferLength + _numFrameSamples) * sizeof(int16_t));
     reset();
 }
 
@@ -108,6 +105,10 @@ int AudioRingBuffer::readData(char *data, int maxSize) {
         }
     }
 
+    if (_randomAccessMode) {
+        updateGuardFrame(_nextOutput, numReadSamples);
+    }
+
     // push the position of _nextOutput by the number of samples read
     _nextOutput = shiftedPositionAccomodatingWrap(_nextOutput, numReadSamples);
 
@@ -140,15 +141,12 @@ int AudioRingBuffer::writeData(const char* data, int maxSize) {
         memcpy(_buffer, data + (numSamplesToEnd * sizeof(int16_t)), (samplesToCopy - numSamplesToEnd) * sizeof(int16_t));
     }
 
+    updateGuardFrame(_endOfLastWrite, samplesToCopy);
     _endOfLastWrite = shiftedPositionAccomodatingWrap(_endOfLastWrite, samplesToCopy);
 
     return samplesToCopy * sizeof(int16_t);
 }
 
-int16_t& AudioRingBuffer::operator[](const int index) {
-    return *shiftedPositionAccomodatingWrap(_nextOutput, index);
-}
-
 const int16_t& AudioRingBuffer::operator[] (const int index) const {
     return *shiftedPositionAccomodatingWrap(_nextOutput, index);
 }
@@ -187,6 +185,7 @@ int AudioRingBuffer::addSilentSamples(int silentSamples) {
         memset(_endOfLastWrite, 0, numSamplesToEnd * sizeof(int16_t));
         memset(_buffer, 0, (silentSamples - numSamplesToEnd) * sizeof(int16_t));
     }
+    updateGuardFrame(_endOfLastWrite, silentSamples);
     _endOfLastWrite = shiftedPositionAccomodatingWrap(_endOfLastWrite, silentSamples);
 
     return silentSamples;
@@ -205,14 +204,21 @@ int16_t* AudioRingBuffer::shiftedPositionAccomodatingWrap(int16_t* position, int
     }
 }
 
+void AudioRingBuffer::updateGuardFrame(const int16_t* writeStart, int numSamples) {
+    // the guard frame past the end of the ring mirrors the first frame of the ring, so that a full frame starting
+    // anywhere in the ring is contiguous in memory. it only needs a refresh when that first frame was written.
+    bool wrapped = writeStart + numSamples > _buffer + _bufferLength;
+    if (numSamples > 0 && (wrapped || writeStart < _buffer + _numFrameSamples)) {
+        memcpy(_buffer + _bufferLength, _buffer, _numFrameSamples * sizeof(int16_t));
+    }
+}
+
 float AudioRingBuffer::getFrameLoudness(const int16_t* frameStart) const {
     float loudness = 0.0f;
-    const int16_t* sampleAt = frameStart;
-    const int16_t* _bufferLastAt = _buffer + _bufferLength - 1;
 
+    // frameStart is contiguous for a full frame thanks to the guard frame
     for (int i = 0; i < _numFrameSamples; ++i) {
-        loudness += (float) std::abs(*sampleAt);
-        sampleAt = sampleAt == _bufferLastAt ? _buffer : sampleAt + 1;
+        loudness += (float) std::abs(frameStart[i]);
     }
     loudness /= _numFrameSamples;
     loudness /= AudioConstants::MAX_SAMPLE_VALUE;
@@ -243,11 +249,13 @@ int AudioRingBuffer::writeSamples(ConstIterator source, int maxSamples) {
     }
 
     int16_t* bufferLast = _buffer + _bufferLength - 1;
+    int16_t* writeStart = _endOfLastWrite;
     for (int i = 0; i < samplesToCopy; i++) {
         *_endOfLastWrite = *source;
         _endOfLastWrite = (_endOfLastWrite == bufferLast) ? _buffer : _endOfLastWrite + 1;
         ++source;
     }
+    updateGuardFrame(writeStart, samplesToCopy);
 
     return samplesToCopy;
 }
@@ -264,11 +272,13 @@ int AudioRingBuffer::writeSamplesWithFade(ConstIterator source, int maxSamples,
     }
 
     int16_t* bufferLast = _buffer + _bufferLength - 1;
+    int16_t* writeStart = _endOfLastWrite;
     for (int i = 0; i < samplesToCopy; i++) {
         *_endOfLastWrite = (int16_t)((float)(*source) * fade);
         _endOfLastWrite = (_endOfLastWrite == bufferLast) ? _buffer : _endOfLastWrite + 1;
         ++source;
     }
+    updateGuardFrame(writeStart, samplesToCopy);
 
     return samplesToCopy;
 }
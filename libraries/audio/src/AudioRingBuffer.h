@@ -40,7 +40,7 @@ public:
     int readData(char* data, int maxSize);
     int writeData(const char* data, int maxSize);
 
-    int16_t& operator[](const int index);
+    // read only: the samples are written through the calls above, which keep the guard frame in sync with the ring
     const int16_t& operator[] (const int index) const;
 
     void shiftReadPosition(unsigned int numSamples);
@@ -66,9 +66,13 @@ protected:
 
     int16_t* shiftedPositionAccomodatingWrap(int16_t* position, int numSamplesShift) const;
 
+    // called after samples are written at writeStart, to keep the guard frame in sync with the start of the ring
+    void updateGuardFrame(const int16_t* writeStart, int numSamples);
+
     int _frameCapacity;
     int _sampleCapacity;
-    int _bufferLength;      // actual length of _buffer: will be one frame larger than _sampleCapacity
+    int _bufferLength;      // length of the ring: will be one frame larger than _sampleCapacity
+                            // _buffer is allocated one more frame larger still, see updateGuardFrame
     int _numFrameSamples;
     int16_t* _nextOutput;
     int16_t* _endOfLastWrite;
@@ -98,6 +102,10 @@ public:
         bool operator!=(const ConstIterator& rhs) { return _at != rhs._at; }
         const int16_t& operator*() { return *_at; }
 
+        // the ring buffer mirrors its first frame past the end of the ring, so up to one frame of samples can
+        // always be read from here as a plain array, without any wrap checks
+        const int16_t* getFramePointer() const { return _at; }
+
         ConstIterator& operator=(const ConstIterator& rhs) {
             _bufferLength = rhs._bufferLength;
             _bufferFirst = rhs._bufferFirst;
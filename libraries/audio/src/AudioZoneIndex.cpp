@@ -0,0 +1,124 @@
+//
+//  AudioZoneIndex.cpp
+//  libraries/audio/src
+//
+//  Copyright 2015 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include <algorithm>
+#include <limits>
+
+#include "AudioZoneIndex.h"
+
+// distances are measured along the worst axis (Chebyshev distance), which is what matters for axis aligned boxes:
+// a point has to move at least this far along some axis to enter (or leave) the box
+
+static float distanceOutside(const glm::vec3& minimum, const glm::vec3& maximum, const glm::vec3& point) {
+    glm::vec3 gap = glm::max(glm::max(minimum - point, point - maximum), glm::vec3(0.0f));
+    return glm::max(gap.x, glm::max(gap.y, gap.z));
+}
+
+static float distanceInside(const glm::vec3& minimum, const glm::vec3& maximum, const glm::vec3& point) {
+    glm::vec3 gap = glm::min(point - minimum, maximum - point);
+    return glm::min(gap.x, glm::min(gap.y, gap.z));
+}
+
+void AudioZoneIndex::build(const QVector<AABox>& zones) {
+    _zones = zones;
+    _nodes.clear();
+
+    if (_zones.isEmpty()) {
+        return;
+    }
+
+    std::vector<int> zoneIndices;
+    for (int i = 0; i < _zones.size(); ++i) {
+        zoneIndices.push_back(i);
+    }
+    _nodes.reserve(2 * _zones.size());
+    buildNode(zoneIndices, 0, (int)zoneIndices.size());
+}
+
+int AudioZoneIndex::buildNode(std::vector<int>& zoneIndices, int begin, int end) {
+    int nodeIndex = (int)_nodes.size();
+    _nodes.push_back(Node());
+
+    Node node;
+    node.minimum = glm::vec3(std::numeric_limits<float>::max());
+    node.maximum = glm::vec3(-std::numeric_limits<float>::max());
+    for (int i = begin; i < end; ++i) {
+        node.minimum = glm::min(node.minimum, _zones[zoneIndices[i]].getMinimumPoint());
+        node.maximum = glm::max(node.maximum, _zones[zoneIndices[i]].getMaximumPoint());
+    }
+
+    if (end - begin == 1) {
+        node.left = node.right = -1;
+        node.zone = zoneIndices[begin];
+    } else {
+        // split at the median zone center along the longest axis of the node
+        glm::vec3 extent = node.maximum - node.minimum;
+        int axis = (extent.x > extent.y) ? ((extent.x > extent.z) ? 0 : 2) : ((extent.y > extent.z) ? 1 : 2);
+
+        int middle = begin + (end - begin) / 2;
+        std::nth_element(zoneIndices.begin() + begin, zoneIndices.begin() + middle, zoneIndices.begin() + end,
+                         [&](int a, int b) { return _zones[a].calcCenter()[axis] < _zones[b].calcCenter()[axis]; });
+
+        node.zone = -1;
+        node.left = buildNode(zoneIndices, begin, middle);
+        node.right = buildNode(zoneIndices, middle, end);
+    }
+
+    _nodes[nodeIndex] = node;
+    return nodeIndex;
+}
+
+void AudioZoneIndex::query(const glm::vec3& position, AudioZoneMembership& membership) const {
+    membership.position = position;
+    membership.zones = 0;
+    membership.safeDistance = std::numeric_limits<float>::max();
+
+    if (!_nodes.empty()) {
+        queryNode(0, position, membership);
+    }
+}
+
+void AudioZoneIndex::queryNode(int nodeIndex, const glm::vec3& position, AudioZoneMembership& membership) const {
+    const Node& node = _nodes[nodeIndex];
+
+    // every zone under this node is at least this far away, so none of them can shrink the safe distance. A position on
+    // the face of a zone is at no distance from it, yet in it
+    if (distanceOutside(node.minimum, node.maximum, position) > membership.safeDistance) {
+        return;
+    }
+
+    if (node.zone >= 0) {
+        const AABox& zone = _zones[node.zone];
+        if (zone.contains(position)) {
+            membership.zones |= audioZoneBit(node.zone);
+            membership.safeDistance = std::min(membership.safeDistance,
+                distanceInside(zone.getMinimumPoint(), zone.getMaximumPoint(), position));
+        } else {
+            membership.safeDistance = std::min(membership.safeDistance,
+                distanceOutside(zone.getMinimumPoint(), zone.getMaximumPoint(), position));
+        }
+        return;
+    }
+
+    queryNode(node.left, position, membership);
+    queryNode(node.right, position, membership);
+}
+
+bool AudioZoneIndex::update(const glm::vec3& position, AudioZoneMembership& membership) const {
+    glm::vec3 moved = glm::abs(position - membership.position);
+    if (glm::max(moved.x, glm::max(moved.y, moved.z)) < membership.safeDistance) {
+        // still on the same side of every zone boundary
+        return false;
+    }
+
+    AudioZoneMask previousZones = membership.zones;
+    query(position, membership);
+    return membership.zones != previousZones;
+}
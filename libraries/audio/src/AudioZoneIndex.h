@@ -0,0 +1,67 @@
+//
+//  AudioZoneIndex.h
+//  libraries/audio/src
+//
+//  Copyright 2015 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_AudioZoneIndex_h
+#define hifi_AudioZoneIndex_h
+
+#include <vector>
+
+#include <glm/glm.hpp>
+
+#include <QtCore/QVector>
+
+#include <AABox.h>
+
+// zone membership is tracked as a bitmask, one bit per zone index
+typedef quint64 AudioZoneMask;
+const int MAX_AUDIO_ZONES = 64;
+
+inline AudioZoneMask audioZoneBit(int zoneIndex) { return (AudioZoneMask)1 << zoneIndex; }
+
+/// The zones containing a position, and how far that position can move before the answer might change.
+class AudioZoneMembership {
+public:
+    glm::vec3 position;
+    float safeDistance { -1.0f }; // largest move along any axis that cannot cross a zone boundary
+    AudioZoneMask zones { 0 };
+};
+
+/// Static bounding volume hierarchy over the audio zones of a domain
+class AudioZoneIndex {
+public:
+    void build(const QVector<AABox>& zones);
+
+    int getNumZones() const { return _zones.size(); }
+    const AABox& getZone(int zoneIndex) const { return _zones[zoneIndex]; }
+
+    /// finds the zones containing position, from scratch
+    void query(const glm::vec3& position, AudioZoneMembership& membership) const;
+
+    /// moves a membership to a new position, only querying the hierarchy if the move may have crossed a zone boundary.
+    /// returns true if the set of zones changed
+    bool update(const glm::vec3& position, AudioZoneMembership& membership) const;
+
+private:
+    struct Node {
+        glm::vec3 minimum;
+        glm::vec3 maximum;
+        int left;
+        int right;
+        int zone; // leaf nodes hold a single zone, -1 for inner nodes
+    };
+
+    int buildNode(std::vector<int>& zoneIndices, int begin, int end);
+    void queryNode(int nodeIndex, const glm::vec3& position, AudioZoneMembership& membership) const;
+
+    QVector<AABox> _zones;
+    std::vector<Node> _nodes;
+};
+
+#endif // hifi_AudioZoneIndex_h
@@ -47,6 +47,8 @@ InboundAudioStream::InboundAudioStream(int numFrameSamples, int numFramesCapacit
     _currentJitterBufferFrames(0),
     _timeGapStatsForStatsPacket(0, STATS_FOR_STATS_PACKET_WINDOW_SECONDS),
     _repetitionWithFade(settings._repetitionWithFade),
+    _autoTuneJitterBuffers(settings._autoTuneJitterBuffers),
+    _jitterBufferTuner(settings._targetStarvesPerMinute),
     _hasReverb(false)
 {
 }
@@ -77,6 +79,7 @@ void InboundAudioStream::resetStats() {
     _framesAvailableStat.reset();
     _currentJitterBufferFrames = 0;
     _timeGapStatsForStatsPacket.reset();
+    _jitterBufferTuner.reset();
 }
 
 void InboundAudioStream::clearBuffer() {
@@ -96,6 +99,10 @@ void InboundAudioStream::perSecondCallbackForUpdatingStats() {
     _timeGapStatsForDesiredCalcOnTooManyStarves.currentIntervalComplete();
     _timeGapStatsForDesiredReduction.currentIntervalComplete();
     _timeGapStatsForStatsPacket.currentIntervalComplete();
+
+    if (isAutoTuning()) {
+        _desiredJitterBufferFrames = clampDesiredJitterBufferFramesValue(_jitterBufferTuner.update());
+    }
 }
 
 int InboundAudioStream::parseData(NLPacket& packet) {
@@ -295,7 +302,10 @@ void InboundAudioStream::setToStarved() {
     quint64 now = usecTimestampNow();
     _starveHistory.insert(now);
 
-    if (_dynamicJitterBuffers) {
+    if (isAutoTuning()) {
+        // the tuner reacts to starves on its next per second update
+        _jitterBufferTuner.starved();
+    } else if (_dynamicJitterBuffers) {
         // dynamic jitter buffers are enabled. check if this starve put us over the window
         // starve threshold
         quint64 windowEnd = now - _starveHistoryWindowSeconds * USECS_PER_SECOND;
@@ -341,6 +351,8 @@ void InboundAudioStream::setSettings(const Settings& settings) {
     setWindowSecondsForDesiredCalcOnTooManyStarves(settings._windowSecondsForDesiredCalcOnTooManyStarves);
     setWindowSecondsForDesiredReduction(settings._windowSecondsForDesiredReduction);
     setRepetitionWithFade(settings._repetitionWithFade);
+    setAutoTuneJitterBuffers(settings._autoTuneJitterBuffers);
+    setTargetStarvesPerMinute(settings._targetStarvesPerMinute);
 }
 
 void InboundAudioStream::setDynamicJitterBuffers(bool dynamicJitterBuffers) {
@@ -355,6 +367,17 @@ void InboundAudioStream::setDynamicJitterBuffers(bool dynamicJitterBuffers) {
     _dynamicJitterBuffers = dynamicJitterBuffers;
 }
 
+void InboundAudioStream::setAutoTuneJitterBuffers(bool autoTuneJitterBuffers) {
+    if (autoTuneJitterBuffers && !_autoTuneJitterBuffers) {
+        // start tuning from a clean history
+        _jitterBufferTuner.reset();
+        if (_dynamicJitterBuffers) {
+            _desiredJitterBufferFrames = _jitterBufferTuner.getDesiredFrames();
+        }
+    }
+    _autoTuneJitterBuffers = autoTuneJitterBuffers;
+}
+
 void InboundAudioStream::setStaticDesiredJitterBufferFrames(int staticDesiredJitterBufferFrames) {
     _staticDesiredJitterBufferFrames = staticDesiredJitterBufferFrames;
     if (!_dynamicJitterBuffers) {
@@ -392,6 +415,7 @@ void InboundAudioStream::packetReceivedUpdateTimingStats() {
         _timeGapStatsForDesiredCalcOnTooManyStarves.update(gap);
         _stdevStatsForDesiredCalcOnTooManyStarves.addValue(gap);
         _timeGapStatsForDesiredReduction.update(gap);
+        _jitterBufferTuner.packetReceived(gap);
 
         if (_timeGapStatsForDesiredCalcOnTooManyStarves.getNewStatsAvailableFlag()) {
             _calculatedJitterBufferFramesUsingMaxGap = ceilf((float)_timeGapStatsForDesiredCalcOnTooManyStarves.getWindowMax()
@@ -408,7 +432,7 @@ void InboundAudioStream::packetReceivedUpdateTimingStats() {
             _stdevStatsForDesiredCalcOnTooManyStarves.reset();
         }
 
-        if (_dynamicJitterBuffers) {
+        if (_dynamicJitterBuffers && !_autoTuneJitterBuffers) {
             // if the max gap in window B (_timeGapStatsForDesiredReduction) corresponds to a smaller number of frames than _desiredJitterBufferFrames,
             // then reduce _desiredJitterBufferFrames to that number of frames.
             if (_timeGapStatsForDesiredReduction.getNewStatsAvailableFlag() && _timeGapStatsForDesiredReduction.isWindowFilled()) {
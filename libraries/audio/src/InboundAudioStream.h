@@ -17,6 +17,7 @@
 #include <udt/PacketHeaders.h>
 #include <StDev.h>
 
+#include "AudioJitterBufferTuner.h"
 #include "AudioRingBuffer.h"
 #include "MovingMinMaxAvg.h"
 #include "SequenceNumberStats.h"
@@ -46,6 +47,7 @@ const int DEFAULT_WINDOW_STARVE_THRESHOLD = 3;
 const int DEFAULT_WINDOW_SECONDS_FOR_DESIRED_CALC_ON_TOO_MANY_STARVES = 50;
 const int DEFAULT_WINDOW_SECONDS_FOR_DESIRED_REDUCTION = 10;
 const bool DEFAULT_REPETITION_WITH_FADE = true;
+const bool DEFAULT_AUTO_TUNE_JITTER_BUFFERS = false;
 
 // Audio Env bitset
 const int HAS_REVERB_BIT = 0; // 1st bit
@@ -63,7 +65,9 @@ public:
             _windowStarveThreshold(DEFAULT_WINDOW_STARVE_THRESHOLD),
             _windowSecondsForDesiredCalcOnTooManyStarves(DEFAULT_WINDOW_SECONDS_FOR_DESIRED_CALC_ON_TOO_MANY_STARVES),
             _windowSecondsForDesiredReduction(DEFAULT_WINDOW_SECONDS_FOR_DESIRED_REDUCTION),
-            _repetitionWithFade(DEFAULT_REPETITION_WITH_FADE)
+            _repetitionWithFade(DEFAULT_REPETITION_WITH_FADE),
+            _autoTuneJitterBuffers(DEFAULT_AUTO_TUNE_JITTER_BUFFERS),
+            _targetStarvesPerMinute(DEFAULT_TARGET_STARVES_PER_MINUTE)
         {}
 
         Settings(int maxFramesOverDesired, bool dynamicJitterBuffers, int staticDesiredJitterBufferFrames,
@@ -76,7 +80,9 @@ public:
             _windowStarveThreshold(windowStarveThreshold),
             _windowSecondsForDesiredCalcOnTooManyStarves(windowSecondsForDesiredCalcOnTooManyStarves),
             _windowSecondsForDesiredReduction(windowSecondsForDesiredCalcOnTooManyStarves),
-            _repetitionWithFade(repetitionWithFade)
+            _repetitionWithFade(repetitionWithFade),
+            _autoTuneJitterBuffers(DEFAULT_AUTO_TUNE_JITTER_BUFFERS),
+            _targetStarvesPerMinute(DEFAULT_TARGET_STARVES_PER_MINUTE)
         {}
 
         // max number of frames over desired in the ringbuffer.
@@ -98,6 +104,11 @@ public:
         // if true, the prev frame will be repeated (fading to silence) for dropped frames.
         // otherwise, silence will be inserted.
         bool _repetitionWithFade;
+
+        // if true (and dynamic jitter buffers are enabled), _desiredJitterBufferFrames is driven by an
+        // AudioJitterBufferTuner aiming for _targetStarvesPerMinute, instead of the window A/B method
+        bool _autoTuneJitterBuffers;
+        float _targetStarvesPerMinute;
     };
 
 public:
@@ -127,6 +138,9 @@ public:
     void setWindowSecondsForDesiredCalcOnTooManyStarves(int windowSecondsForDesiredCalcOnTooManyStarves);
     void setWindowSecondsForDesiredReduction(int windowSecondsForDesiredReduction);
     void setRepetitionWithFade(bool repetitionWithFade) { _repetitionWithFade = repetitionWithFade; }
+    void setAutoTuneJitterBuffers(bool autoTuneJitterBuffers);
+    void setTargetStarvesPerMinute(float targetStarvesPerMinute) {
+        _jitterBufferTuner.setTargetStarvesPerMinute(targetStarvesPerMinute); }
 
     virtual AudioStreamStats getAudioStreamStats() const;
 
@@ -146,6 +160,8 @@ public:
         return _timeGapStatsForDesiredCalcOnTooManyStarves.getWindowIntervals(); }
     bool getDynamicJitterBuffers() const { return _dynamicJitterBuffers; }
     bool getRepetitionWithFade() const { return _repetitionWithFade;}
+    bool getAutoTuneJitterBuffers() const { return _autoTuneJitterBuffers; }
+    const AudioJitterBufferTuner& getJitterBufferTuner() const { return _jitterBufferTuner; }
     int getWindowStarveThreshold() const { return _starveThreshold;}
     bool getUseStDevForJitterCalc() const { return _useStDevForJitterCalc; }
     int getDesiredJitterBufferFrames() const { return _desiredJitterBufferFrames; }
@@ -180,6 +196,7 @@ public slots:
 private:
     void packetReceivedUpdateTimingStats();
     int clampDesiredJitterBufferFramesValue(int desired) const;
+    bool isAutoTuning() const { return _dynamicJitterBuffers && _autoTuneJitterBuffers; }
 
     int writeSamplesForDroppedPackets(int networkSamples);
 
@@ -259,6 +276,9 @@ protected:
     MovingMinMaxAvg<quint64> _timeGapStatsForStatsPacket;
 
     bool _repetitionWithFade;
+
+    bool _autoTuneJitterBuffers;
+    AudioJitterBufferTuner _jitterBufferTuner;
     
     // Reverb properties
     bool _hasReverb;
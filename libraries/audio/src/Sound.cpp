@@ -14,6 +14,7 @@
 #include <glm/glm.hpp>
 
 #include <QDataStream>
+#include <QRunnable>
 #include <QtCore/QDebug>
 #include <QtNetwork/QNetworkRequest>
 #include <QtNetwork/QNetworkReply>
@@ -56,16 +57,98 @@ Sound::Sound(const QUrl& url, bool isStereo) :
 
 }
 
+// Bumped whenever the decoding changes, which invalidates the decoded sounds in the disk cache
+static const quint32 DECODED_SOUND_VERSION = 1;
+static const QString DECODED_SOUND_EXTENSION = ".sound";
+
+// Decodes the downloaded sound on the thread pool, dropping it if the sound goes away first. The decoded audio is kept in
+// the disk cache, under the hash of what it is decoded from.
+class SoundReader : public QRunnable {
+public:
+    SoundReader(const QWeakPointer<Resource>& sound, const QSharedPointer<ResourceDiskCache>& diskCache,
+                const QByteArray& content, const QUrl& url, bool hasContentType, const QByteArray& contentType,
+                int loadGeneration) :
+        _sound(sound), _diskCache(diskCache), _content(content), _url(url), _hasContentType(hasContentType),
+        _contentType(contentType), _loadGeneration(loadGeneration) { }
+
+    virtual void run() {
+        QSharedPointer<Resource> resource = _sound.toStrongRef();
+        if (resource.isNull()) {
+            return;
+        }
+        Sound* sound = static_cast<Sound*>(resource.data());
+        QString key;
+        QByteArray decoded;
+        if (_diskCache) {
+            QByteArray settings;
+            QDataStream stream(&settings, QIODevice::WriteOnly);
+            stream << DECODED_SOUND_VERSION << _url.fileName() << _hasContentType << _contentType;
+            key = ResourceDiskCache::getContentHash(settings + _content) + DECODED_SOUND_EXTENSION;
+        }
+        if (!(_diskCache && _diskCache->load(key, decoded) && sound->readDecoded(decoded))) {
+            sound->decode(_content, _url, _hasContentType, _contentType);
+            if (_diskCache && !_diskCache->store(key, sound->writeDecoded())) {
+                qCDebug(audio) << "Failed to cache the decoded sound of" << _url;
+            }
+        }
+
+        // the sound is read from other threads as soon as it is ready, so it only becomes ready once its audio is complete
+        QMetaObject::invokeMethod(sound, "setReady", Q_ARG(int, _loadGeneration));
+    }
+
+private:
+    QWeakPointer<Resource> _sound;
+    QSharedPointer<ResourceDiskCache> _diskCache;
+    QByteArray _content;
+    QUrl _url;
+    bool _hasContentType;
+    QByteArray _contentType;
+    int _loadGeneration;
+};
+
 void Sound::downloadFinished(QNetworkReply* reply) {
+    ResourceCache::startDecode(this, ResourceScheduler::SOUND_DECODE, new SoundReader(_self, ResourceCache::getDiskCache(),
+        reply->readAll(), reply->url(), reply->hasRawHeader("Content-Type"), reply->rawHeader("Content-Type"),
+        getLoadGeneration()));
+    reply->deleteLater();
+}
+
+void Sound::setReady(int loadGeneration) {
+    // a decode started before the loading was cancelled leaves the sound to the one started after
+    if (loadGeneration == getLoadGeneration()) {
+        _isReady = true;
+    }
+}
+
+QByteArray Sound::writeDecoded() const {
+    QByteArray data;
+    QDataStream stream(&data, QIODevice::WriteOnly);
+    stream << DECODED_SOUND_VERSION << _isStereo << _byteArray;
+    return data;
+}
+
+bool Sound::readDecoded(const QByteArray& data) {
+    QDataStream stream(data);
+    quint32 version = 0;
+    bool isStereo = false;
+    QByteArray byteArray;
+    stream >> version >> isStereo >> byteArray;
+    if (stream.status() != QDataStream::Ok || version != DECODED_SOUND_VERSION) {
+        return false;
+    }
+    _isStereo = isStereo;
+    _byteArray = byteArray;
+    return true;
+}
+
+void Sound::decode(const QByteArray& rawAudioByteArray, const QUrl& url, bool hasContentType,
+                   const QByteArray& headerContentType) {
     // replace our byte array with the downloaded data
-    QByteArray rawAudioByteArray = reply->readAll();
-    QString fileName = reply->url().fileName();
+    QString fileName = url.fileName();
 
     const QString WAV_EXTENSION = ".wav";
 
-    if (reply->hasRawHeader("Content-Type") || fileName.endsWith(WAV_EXTENSION)) {
-
-        QByteArray headerContentType = reply->rawHeader("Content-Type");
+    if (hasContentType || fileName.endsWith(WAV_EXTENSION)) {
 
         // WAV audio file encountered
         if (headerContentType == "audio/x-wav"
@@ -80,9 +163,9 @@ void Sound::downloadFinished(QNetworkReply* reply) {
         } else {
             // check if this was a stereo raw file
             // since it's raw the only way for us to know that is if the file was called .stereo.raw
-            if (reply->url().fileName().toLower().endsWith("stereo.raw")) {
+            if (fileName.toLower().endsWith("stereo.raw")) {
                 _isStereo = true;
-                qCDebug(audio) << "Processing sound of" << rawAudioByteArray.size() << "bytes from" << reply->url() << "as stereo audio file.";
+                qCDebug(audio) << "Processing sound of" << rawAudioByteArray.size() << "bytes from" << url << "as stereo audio file.";
             }
 
             // Process as RAW file
@@ -92,9 +175,6 @@ void Sound::downloadFinished(QNetworkReply* reply) {
     } else {
         qCDebug(audio) << "Network reply without 'Content-Type'.";
     }
-
-    _isReady = true;
-    reply->deleteLater();
 }
 
 void Sound::downSample(const QByteArray& rawAudioByteArray) {
@@ -30,11 +30,21 @@ public:
      
     const QByteArray& getByteArray() { return _byteArray; }
 
+private slots:
+    void setReady(int loadGeneration);
+
 private:
+    friend class SoundReader;
+
     QByteArray _byteArray;
     bool _isStereo;
     bool _isReady;
     
+    void decode(const QByteArray& rawAudioByteArray, const QUrl& url, bool hasContentType, const QByteArray& contentType);
+
+    /// The decoded audio as kept in the disk cache
+    QByteArray writeDecoded() const;
+    bool readDecoded(const QByteArray& data);
     void trimFrames();
     void downSample(const QByteArray& rawAudioByteArray);
     void interpretAsWav(const QByteArray& inputAudioByteArray, QByteArray& outputAudioByteArray);
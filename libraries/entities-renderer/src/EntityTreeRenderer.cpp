@@ -122,6 +122,9 @@ void EntityTreeRenderer::init() {
     // first chance, we'll check for enter/leave entity events.
     _lastAvatarPosition = _viewState->getAvatarPosition() + glm::vec3((float)TREE_SCALE);
     
+    // the render items of the entities follow them around, see moveEntitiesInScene
+    entityTree->setTrackMovedEntities(true);
+
     connect(entityTree, &EntityTree::deletingEntity, this, &EntityTreeRenderer::deletingEntity, Qt::QueuedConnection);
     connect(entityTree, &EntityTree::addingEntity, this, &EntityTreeRenderer::addingEntity, Qt::QueuedConnection);
     connect(entityTree, &EntityTree::entityScriptChanging, this, &EntityTreeRenderer::entitySciptChanging, Qt::QueuedConnection);
@@ -311,6 +314,8 @@ void EntityTreeRenderer::update() {
     if (_tree && !_shuttingDown) {
         EntityTree* tree = static_cast<EntityTree*>(_tree);
         tree->update();
+
+        moveEntitiesInScene();
         
         // check to see if the avatar has moved and if we need to handle enter/leave entity logic
         checkEnterLeaveEntities();
@@ -1034,6 +1039,24 @@ void EntityTreeRenderer::addEntityToScene(EntityItemPointer entity) {
     scene->enqueuePendingChanges(pendingChanges);
 }
 
+void EntityTreeRenderer::moveEntitiesInScene() {
+    // the scene only places the render items when told, so the items of the entities moved by edits or by the
+    // simulation move along with them
+    static_cast<EntityTree*>(_tree)->takeMovedEntities(_movedEntities);
+    if (_movedEntities.isEmpty()) {
+        return;
+    }
+    render::PendingChanges pendingChanges;
+    auto scene = _viewState->getMain3DScene();
+    foreach (const EntityItemID& entityID, _movedEntities) {
+        auto entity = _entitiesInScene.value(entityID);
+        if (entity) {
+            entity->moveInScene(entity, scene, pendingChanges);
+        }
+    }
+    scene->enqueuePendingChanges(pendingChanges);
+}
+
 
 void EntityTreeRenderer::entitySciptChanging(const EntityItemID& entityID, const bool reload) {
     if (_tree && !_shuttingDown) {
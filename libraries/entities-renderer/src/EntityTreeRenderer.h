@@ -129,6 +129,7 @@ protected:
 
 private:
     void addEntityToScene(EntityItemPointer entity);
+    void moveEntitiesInScene();
 
     void applyZonePropertiesToScene(std::shared_ptr<ZoneEntityItem> zone);
     void renderElementProxy(EntityTreeElement* entityTreeElement, RenderArgs* args);
@@ -193,6 +194,7 @@ private:
     int _previousStageDay;
     
     QHash<EntityItemID, EntityItemPointer> _entitiesInScene;
+    QSet<EntityItemID> _movedEntities;
     // For Scene.shouldRenderEntities
     QList<EntityItemID> _entityIDsLastInScene;
 };
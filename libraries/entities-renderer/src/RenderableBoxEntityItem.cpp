@@ -38,19 +38,37 @@ void RenderableBoxEntityItem::render(RenderArgs* args) {
     Q_ASSERT(getType() == EntityTypes::Box);
     Q_ASSERT(args->_batch);
     gpu::Batch& batch = *args->_batch;
-    batch.setModelTransform(getTransformToCenter()); // we want to include the scale as well
     
     if (!_procedural) {
         _procedural.reset(new ProceduralInfo(this));
     }
 
     if (_procedural->ready()) {
+        batch.setModelTransform(getTransformToCenter()); // we want to include the scale as well
         _procedural->prepare(batch);
         DependencyManager::get<GeometryCache>()->renderUnitCube(batch);
+    } else if (isInstanced()) {
+        // drawn with the other plain cubes of the batch when its named calls are flushed
+        glm::vec4 cubeColor(toGlm(getXColor()), getLocalRenderAlpha());
+        DependencyManager::get<DeferredLightingEffect>()->renderSolidCubeInstance(batch, getTransformToCenter(), cubeColor);
     } else {
+        // blended with what is behind it, so it is drawn in the order of the items, after the instances recorded before it
+        batch.flushNamedCalls();
+        batch.setModelTransform(getTransformToCenter()); // we want to include the scale as well
         glm::vec4 cubeColor(toGlm(getXColor()), getLocalRenderAlpha());
         DependencyManager::get<DeferredLightingEffect>()->renderSolidCube(batch, 1.0f, cubeColor);
     }
 
     RenderableDebugableEntityItem::render(this, args);
 };
+
+bool RenderableBoxEntityItem::canRenderConcurrently(const RenderArgs* args) const {
+    // the plain opaque cubes only add to the instances of their batch, while the translucent and procedural ones and
+    // the debug shapes fill caches shared by all the batches
+    return _procedural && !_procedural->_enabled && isInstanced() &&
+        !(args->_debugFlags & RenderArgs::RENDER_DEBUG_SIMULATION_OWNERSHIP);
+}
+
+bool RenderableBoxEntityItem::isInstanced() const {
+    return getLocalRenderAlpha() >= 1.0f;
+}
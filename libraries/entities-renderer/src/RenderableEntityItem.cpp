@@ -38,6 +38,9 @@ namespace render {
             }
         }
     }
+    template <> bool payloadCanRenderConcurrently(const RenderableEntityItemProxy::Pointer& payload, const RenderArgs* args) {
+        return payload && payload->entity && payload->entity->canRenderConcurrently(args);
+    }
 }
 
 
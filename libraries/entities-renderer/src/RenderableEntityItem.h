@@ -29,6 +29,7 @@ namespace render {
    template <> const ItemKey payloadGetKey(const RenderableEntityItemProxy::Pointer& payload); 
    template <> const Item::Bound payloadGetBound(const RenderableEntityItemProxy::Pointer& payload);
    template <> void payloadRender(const RenderableEntityItemProxy::Pointer& payload, RenderArgs* args);
+   template <> bool payloadCanRenderConcurrently(const RenderableEntityItemProxy::Pointer& payload, const RenderArgs* args);
 }
 
 // Mixin class for implementing basic single item rendering
@@ -48,6 +49,10 @@ public:
     void removeFromScene(EntityItemPointer self, std::shared_ptr<render::Scene> scene, render::PendingChanges& pendingChanges) {
         pendingChanges.removeItem(_myItem);
     }
+
+    void moveInScene(EntityItemPointer self, std::shared_ptr<render::Scene> scene, render::PendingChanges& pendingChanges) {
+        pendingChanges.updateItem(_myItem);
+    }
     
 private:
     render::ItemID _myItem;
@@ -58,6 +63,7 @@ private:
 public: \
     virtual bool addToScene(EntityItemPointer self, std::shared_ptr<render::Scene> scene, render::PendingChanges& pendingChanges) { return _renderHelper.addToScene(self, scene, pendingChanges); } \
     virtual void removeFromScene(EntityItemPointer self, std::shared_ptr<render::Scene> scene, render::PendingChanges& pendingChanges) { _renderHelper.removeFromScene(self, scene, pendingChanges); } \
+    virtual void moveInScene(EntityItemPointer self, std::shared_ptr<render::Scene> scene, render::PendingChanges& pendingChanges) { _renderHelper.moveInScene(self, scene, pendingChanges); } \
 private: \
     SimpleRenderableEntityItem _renderHelper;
 
@@ -215,6 +215,11 @@ void RenderableModelEntityItem::removeFromScene(EntityItemPointer self, std::sha
     }
 }
 
+void RenderableModelEntityItem::moveInScene(EntityItemPointer self, std::shared_ptr<render::Scene> scene,
+                                               render::PendingChanges& pendingChanges) {
+    pendingChanges.updateItem(_myMetaItem);
+}
+
 
 // NOTE: this only renders the "meta" portion of the Model, namely it renders debugging items, and it handles
 // the per frame simulation/update that might be required if the models properties changed.
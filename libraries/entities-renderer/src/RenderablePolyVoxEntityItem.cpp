@@ -565,6 +565,12 @@ void RenderablePolyVoxEntityItem::removeFromScene(EntityItemPointer self,
     pendingChanges.removeItem(_myItem);
 }
 
+void RenderablePolyVoxEntityItem::moveInScene(EntityItemPointer self,
+                                              std::shared_ptr<render::Scene> scene,
+                                              render::PendingChanges& pendingChanges) {
+    pendingChanges.updateItem(_myItem);
+}
+
 namespace render {
     template <> const ItemKey payloadGetKey(const PolyVoxPayload::Pointer& payload) {
         return ItemKey::Builder::opaqueShape();
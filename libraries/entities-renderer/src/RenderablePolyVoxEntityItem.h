@@ -105,6 +105,9 @@ public:
     virtual void removeFromScene(EntityItemPointer self,
                                  std::shared_ptr<render::Scene> scene,
                                  render::PendingChanges& pendingChanges);
+    virtual void moveInScene(EntityItemPointer self,
+                             std::shared_ptr<render::Scene> scene,
+                             render::PendingChanges& pendingChanges);
 
     virtual void setXNNeighborID(const EntityItemID& xNNeighborID);
     virtual void setYNNeighborID(const EntityItemID& yNNeighborID);
@@ -38,7 +38,6 @@ void RenderableSphereEntityItem::render(RenderArgs* args) {
     Q_ASSERT(getType() == EntityTypes::Sphere);
     Q_ASSERT(args->_batch);
     gpu::Batch& batch = *args->_batch;
-    batch.setModelTransform(getTransformToCenter()); // use a transform with scale, rotation, registration point and translation
 
     // TODO: it would be cool to select different slices/stacks geometry based on the size of the sphere
     // and the distance to the viewer. This would allow us to reduce the triangle count for smaller spheres
@@ -51,9 +50,18 @@ void RenderableSphereEntityItem::render(RenderArgs* args) {
     }
 
     if (_procedural->ready()) {
+        batch.setModelTransform(getTransformToCenter()); // use a transform with scale, rotation, registration point and translation
         _procedural->prepare(batch);
         DependencyManager::get<GeometryCache>()->renderSphere(batch, 0.5f, SLICES, STACKS, vec3(1));
+    } else if (isInstanced()) {
+        // drawn with the other plain spheres of the batch when its named calls are flushed
+        glm::vec4 sphereColor(toGlm(getXColor()), getLocalRenderAlpha());
+        DependencyManager::get<DeferredLightingEffect>()->renderSolidSphereInstance(batch, getTransformToCenter(),
+            SLICES, STACKS, sphereColor);
     } else {
+        // blended with what is behind it, so it is drawn in the order of the items, after the instances recorded before it
+        batch.flushNamedCalls();
+        batch.setModelTransform(getTransformToCenter()); // use a transform with scale, rotation, registration point and translation
         glm::vec4 sphereColor(toGlm(getXColor()), getLocalRenderAlpha());
         DependencyManager::get<DeferredLightingEffect>()->renderSolidSphere(batch, 0.5f, SLICES, STACKS, sphereColor);
     }
@@ -61,3 +69,14 @@ void RenderableSphereEntityItem::render(RenderArgs* args) {
 
     RenderableDebugableEntityItem::render(this, args);
 };
+
+bool RenderableSphereEntityItem::canRenderConcurrently(const RenderArgs* args) const {
+    // the plain opaque spheres only add to the instances of their batch, while the translucent and procedural ones and
+    // the debug shapes fill caches shared by all the batches
+    return _procedural && !_procedural->_enabled && isInstanced() &&
+        !(args->_debugFlags & RenderArgs::RENDER_DEBUG_SIMULATION_OWNERSHIP);
+}
+
+bool RenderableSphereEntityItem::isInstanced() const {
+    return getLocalRenderAlpha() >= 1.0f;
+}
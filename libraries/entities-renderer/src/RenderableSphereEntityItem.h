@@ -25,8 +25,13 @@ public:
         { }
 
     virtual void render(RenderArgs* args);
+    virtual bool canRenderConcurrently(const RenderArgs* args) const;
     virtual void setUserData(const QString& value);
 
+private:
+    // only the opaque spheres are drawn as instances, the translucent ones keep their place in the order of the pass
+    bool isInstanced() const;
+
     SIMPLE_RENDERABLE();
 };
 
@@ -209,3 +209,8 @@ void RenderableZoneEntityItem::removeFromScene(EntityItemPointer self, std::shar
         _model->removeFromScene(scene, pendingChanges);
     }
 }
+
+void RenderableZoneEntityItem::moveInScene(EntityItemPointer self, std::shared_ptr<render::Scene> scene,
+                                              render::PendingChanges& pendingChanges) {
+    pendingChanges.updateItem(_myMetaItem);
+}
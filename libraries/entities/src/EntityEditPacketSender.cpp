@@ -34,10 +34,10 @@ void EntityEditPacketSender::adjustEditPacketForClockSkew(PacketType::Value type
     }
 }
 
-void EntityEditPacketSender::queueEditEntityMessage(PacketType::Value type, EntityItemID modelID,
+int EntityEditPacketSender::queueEditEntityMessage(PacketType::Value type, EntityItemID modelID,
                                                                 const EntityItemProperties& properties) {
     if (!_shouldSend) {
-        return; // bail early
+        return 0; // bail early
     }
 
     QByteArray bufferOut(NLPacket::maxPayloadSize(type), 0);
@@ -49,7 +49,9 @@ void EntityEditPacketSender::queueEditEntityMessage(PacketType::Value type, Enti
             qCDebug(entities) << "    properties:" << properties;
         #endif
         queueOctreeEditMessage(type, bufferOut);
+        return bufferOut.size();
     }
+    return 0;
 }
 
 void EntityEditPacketSender::queueEraseEntityMessage(const EntityItemID& entityItemID) {
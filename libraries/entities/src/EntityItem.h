@@ -181,7 +181,10 @@ public:
                             render::PendingChanges& pendingChanges) { return false; } // by default entity items don't add to scene
     virtual void removeFromScene(EntityItemPointer self, std::shared_ptr<render::Scene> scene,
                                 render::PendingChanges& pendingChanges) { } // by default entity items don't add to scene
+    virtual void moveInScene(EntityItemPointer self, std::shared_ptr<render::Scene> scene,
+                             render::PendingChanges& pendingChanges) { } // by default entity items don't add to scene
     virtual void render(RenderArgs* args) { } // by default entity items don't know how to render
+    virtual bool canRenderConcurrently(const RenderArgs* args) const { return false; } // nor render on other threads
 
     static int expectedBytes();
 
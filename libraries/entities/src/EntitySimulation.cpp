@@ -133,6 +133,7 @@ void EntitySimulation::sortEntitiesThatMoved() {
             itemItr = _entitiesToSort.erase(itemItr);
         } else {
             moveOperator.addEntityToMoveList(entity, newCube);
+            _entityTree->noteEntityMoved(entity->getEntityItemID());
             ++itemItr;
         }
     }
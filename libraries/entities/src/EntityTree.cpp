@@ -25,6 +25,9 @@
 #include "RecurseOctreeToMapOperator.h"
 #include "LogHandler.h"
 
+// the changes that move an entity or change its bounds, see noteEntityMoved
+static const uint32_t MOVED_ENTITY_FLAGS = EntityItem::DIRTY_TRANSFORM | EntityItem::DIRTY_SHAPE;
+
 
 EntityTree::EntityTree(bool shouldReaverage) :
     Octree(shouldReaverage),
@@ -204,6 +207,7 @@ bool EntityTree::updateEntityWithElement(EntityItemPointer entity, const EntityI
         UpdateEntityOperator theOperator(this, containingElement, entity, properties);
         recurseTreeWithOperator(&theOperator);
         _isDirty = true;
+        noteEntityMoved(entity->getEntityItemID());
 
         uint32_t newFlags = entity->getDirtyFlags() & ~preFlags;
         if (newFlags) {
@@ -699,6 +703,19 @@ void EntityTree::removeNewlyCreatedHook(NewlyCreatedEntityHook* hook) {
     _newlyCreatedHooksLock.unlock();
 }
 
+void EntityTree::noteEntityMoved(const EntityItemID& entityID) {
+    if (_trackMovedEntities) {
+        QMutexLocker locker(&_movedEntitiesMutex);
+        _movedEntities.insert(entityID);
+    }
+}
+
+void EntityTree::takeMovedEntities(QSet<EntityItemID>& movedEntities) {
+    QMutexLocker locker(&_movedEntitiesMutex);
+    movedEntities.clear();
+    movedEntities.swap(_movedEntities);
+}
+
 
 void EntityTree::releaseSceneEncodeData(OctreeElementExtraEncodeData* extraEncodeData) const {
     foreach(void* extraData, *extraEncodeData) {
@@ -709,6 +726,10 @@ void EntityTree::releaseSceneEncodeData(OctreeElementExtraEncodeData* extraEncod
 }
 
 void EntityTree::entityChanged(EntityItemPointer entity) {
+    // the updates from the entity server move the entities too, before the simulation takes their flags
+    if (entity->getDirtyFlags() & MOVED_ENTITY_FLAGS) {
+        noteEntityMoved(entity->getEntityItemID());
+    }
     if (_simulation) {
         _simulation->lock();
         _simulation->changeEntity(entity);
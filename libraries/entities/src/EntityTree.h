@@ -12,6 +12,7 @@
 #ifndef hifi_EntityTree_h
 #define hifi_EntityTree_h
 
+#include <QMutex>
 #include <QSet>
 #include <QVector>
 
@@ -127,6 +128,13 @@ public:
     void addNewlyCreatedHook(NewlyCreatedEntityHook* hook);
     void removeNewlyCreatedHook(NewlyCreatedEntityHook* hook);
 
+    /// the entities moved by edits or by the simulation are only remembered for those who ask, see takeMovedEntities
+    void setTrackMovedEntities(bool trackMovedEntities) { _trackMovedEntities = trackMovedEntities; }
+    void noteEntityMoved(const EntityItemID& entityID);
+
+    /// \param movedEntities[out] the entities which moved since the last call
+    void takeMovedEntities(QSet<EntityItemID>& movedEntities);
+
     bool hasAnyDeletedEntities() const { return _recentlyDeletedEntityItemIDs.size() > 0; }
     bool hasEntitiesDeletedSince(quint64 sinceTime);
     std::unique_ptr<NLPacket> encodeEntitiesDeletedSince(OCTREE_PACKET_SEQUENCE sequenceNumber, quint64& sinceTime,
@@ -219,6 +227,10 @@ private:
 
     QReadWriteLock _recentlyDeletedEntitiesLock;
     QMultiMap<quint64, QUuid> _recentlyDeletedEntityItemIDs;
+
+    bool _trackMovedEntities = false;
+    QMutex _movedEntitiesMutex;
+    QSet<EntityItemID> _movedEntities;
     EntityItemFBXService* _fbxService;
 
     QHash<EntityItemID, EntityTreeElement*> _entityToElementMap;
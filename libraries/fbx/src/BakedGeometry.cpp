@@ -0,0 +1,598 @@
+//
+//  BakedGeometry.cpp
+//  libraries/fbx/src
+//
+//  Copyright 2015 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "BakedGeometry.h"
+
+#include <cstring>
+#include <memory>
+
+#include <QCryptographicHash>
+#include <QDataStream>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QSaveFile>
+#include <QStandardPaths>
+#include <QStringList>
+
+#include <ResourceDiskCache.h>
+
+#include "ModelFormatLogging.h"
+
+const quint32 BakedGeometry::VERSION = 1;
+const QString BakedGeometry::FILE_EXTENSION = ".baked";
+
+static const char MAGIC[8] = { 'H', 'F', 'B', 'A', 'K', 'E', 'D', 'G' };
+
+// written in native order, so that a file baked on a big-endian machine reads as a mismatch rather than as garbage
+static const quint32 BYTE_ORDER_MARK = 0x01020304;
+
+// the streams start on this boundary, as the GPU buffers do
+static const int STREAM_ALIGNMENT = 16;
+
+class BakedWriter {
+public:
+    const QByteArray& getData() const { return _data; }
+
+    template<class T> void write(const T& value) {
+        _data.append((const char*)&value, sizeof(T));
+    }
+
+    void write(bool value) {
+        write<quint8>(value ? 1 : 0);
+    }
+
+    void write(const QByteArray& value) {
+        write<quint32>(value.size());
+        _data.append(value);
+    }
+
+    void write(const QString& value) {
+        write(value.toUtf8());
+    }
+
+    void write(const Extents& extents) {
+        write(extents.minimum);
+        write(extents.maximum);
+    }
+
+    void write(const Transform& transform) {
+        write(transform.isIdentity());
+        if (!transform.isIdentity()) {
+            write(transform.getTranslation());
+            write(transform.getRotation());
+            write(transform.getScale());
+        }
+    }
+
+    template<class T> void writeArray(const QVector<T>& values) {
+        write<quint32>(values.size());
+        align();
+        _data.append((const char*)values.constData(), values.size() * sizeof(T));
+    }
+
+private:
+    void align() {
+        int padding = (STREAM_ALIGNMENT - _data.size() % STREAM_ALIGNMENT) % STREAM_ALIGNMENT;
+        _data.append(padding, '\0');
+    }
+
+    QByteArray _data;
+};
+
+class BakedReader {
+public:
+    BakedReader(const char* data, qint64 size) : _data(data), _position(data), _end(data + size) { }
+
+    const char* take(qint64 size) {
+        if (size < 0 || size > _end - _position) {
+            throw QString("Unexpected end of baked geometry.");
+        }
+        const char* data = _position;
+        _position += size;
+        return data;
+    }
+
+    template<class T> T read() {
+        T value;
+        memcpy(&value, take(sizeof(T)), sizeof(T));
+        return value;
+    }
+
+    bool readBool() {
+        return read<quint8>() != 0;
+    }
+
+    QByteArray readBytes() {
+        quint32 size = read<quint32>();
+        return QByteArray(take(size), size);
+    }
+
+    QString readString() {
+        return QString::fromUtf8(readBytes());
+    }
+
+    Extents readExtents() {
+        Extents extents;
+        extents.minimum = read<glm::vec3>();
+        extents.maximum = read<glm::vec3>();
+        return extents;
+    }
+
+    Transform readTransform() {
+        Transform transform;
+        if (!readBool()) {
+            transform.setTranslation(read<glm::vec3>());
+            transform.setRotation(read<glm::quat>());
+            transform.setScale(read<glm::vec3>());
+        }
+        return transform;
+    }
+
+    template<class T> void readArray(QVector<T>& values) {
+        quint32 count = read<quint32>();
+        take((STREAM_ALIGNMENT - (_position - _data) % STREAM_ALIGNMENT) % STREAM_ALIGNMENT);
+        const char* data = take((qint64)count * sizeof(T));
+        values.resize(count);
+        memcpy(values.data(), data, (size_t)count * sizeof(T));
+    }
+
+private:
+    const char* _data;
+    const char* _position;
+    const char* _end;
+};
+
+// Hashes the mapping in a stable order: the order of a QHash changes from one process to the next
+static void hashVariant(QDataStream& stream, const QVariant& value) {
+    if (value.type() == QVariant::Hash) {
+        QVariantHash hash = value.toHash();
+        QStringList keys = hash.uniqueKeys();
+        keys.sort();
+        stream << (quint32)keys.size();
+        foreach (const QString& key, keys) {
+            stream << key;
+            QVariantList values = hash.values(key);
+            stream << (quint32)values.size();
+            foreach (const QVariant& keyValue, values) {
+                hashVariant(stream, keyValue);
+            }
+        }
+    } else if (value.type() == QVariant::List) {
+        QVariantList list = value.toList();
+        stream << (quint32)list.size();
+        foreach (const QVariant& element, list) {
+            hashVariant(stream, element);
+        }
+    } else {
+        stream << value;
+    }
+}
+
+QByteArray BakedGeometry::getKey(const QByteArray& model, const QVariantHash& mapping, const QString& url,
+                                 bool loadLightmaps, float lightmapLevel) {
+    QByteArray settings;
+    QDataStream stream(&settings, QIODevice::WriteOnly);
+    stream << VERSION << QFileInfo(url).path() << loadLightmaps << lightmapLevel;
+    hashVariant(stream, mapping);
+
+    QCryptographicHash hash(QCryptographicHash::Sha1);
+    hash.addData(settings);
+    hash.addData(model);
+    return hash.result().toHex();
+}
+
+static void writeTexture(BakedWriter& writer, const FBXTexture& texture) {
+    writer.write(texture.name);
+    writer.write(texture.filename);
+    writer.write(texture.content);
+    writer.write(texture.transform);
+    writer.write<qint32>(texture.texcoordSet);
+    writer.write(texture.texcoordSetName);
+}
+
+static FBXTexture readTexture(BakedReader& reader) {
+    FBXTexture texture;
+    texture.name = reader.readString();
+    texture.filename = reader.readBytes();
+    texture.content = reader.readBytes();
+    texture.transform = reader.readTransform();
+    texture.texcoordSet = reader.read<qint32>();
+    texture.texcoordSetName = reader.readString();
+    return texture;
+}
+
+static void writeMeshPart(BakedWriter& writer, const FBXMeshPart& part) {
+    writer.writeArray(part.quadIndices);
+    writer.writeArray(part.triangleIndices);
+    writer.write(part.diffuseColor);
+    writer.write(part.specularColor);
+    writer.write(part.emissiveColor);
+    writer.write(part.emissiveParams);
+    writer.write(part.shininess);
+    writer.write(part.opacity);
+    writeTexture(writer, part.diffuseTexture);
+    writeTexture(writer, part.normalTexture);
+    writeTexture(writer, part.specularTexture);
+    writeTexture(writer, part.emissiveTexture);
+    writer.write(part.materialID);
+    writer.write((bool)part._material);
+    if (part._material) {
+        writer.write(part._material->getEmissive());
+        writer.write(part._material->getDiffuse());
+        writer.write(part._material->getMetallic());
+        writer.write(part._material->getGloss());
+        writer.write(part._material->getOpacity());
+    }
+}
+
+static FBXMeshPart readMeshPart(BakedReader& reader, QHash<QString, model::MaterialPointer>& materials) {
+    FBXMeshPart part;
+    reader.readArray(part.quadIndices);
+    reader.readArray(part.triangleIndices);
+    part.diffuseColor = reader.read<glm::vec3>();
+    part.specularColor = reader.read<glm::vec3>();
+    part.emissiveColor = reader.read<glm::vec3>();
+    part.emissiveParams = reader.read<glm::vec2>();
+    part.shininess = reader.read<float>();
+    part.opacity = reader.read<float>();
+    part.diffuseTexture = readTexture(reader);
+    part.normalTexture = readTexture(reader);
+    part.specularTexture = readTexture(reader);
+    part.emissiveTexture = readTexture(reader);
+    part.materialID = reader.readString();
+    if (reader.readBool()) {
+        // the parts of a material share it, as they do when extracted
+        model::MaterialPointer& material = materials[part.materialID];
+        if (!material) {
+            material = std::make_shared<model::Material>();
+        }
+        material->setEmissive(reader.read<glm::vec3>());
+        material->setDiffuse(reader.read<glm::vec3>());
+        material->setMetallic(reader.read<float>());
+        material->setGloss(reader.read<float>());
+        material->setOpacity(reader.read<float>());
+        part._material = material;
+    }
+    return part;
+}
+
+static void writeMesh(BakedWriter& writer, const FBXMesh& mesh) {
+    // the streams of the model mesh, as buildModelMesh uploads them
+    writer.writeArray(mesh.vertices);
+    writer.writeArray(mesh.normals);
+    writer.writeArray(mesh.tangents);
+    writer.writeArray(mesh.colors);
+    writer.writeArray(mesh.texCoords);
+    writer.writeArray(mesh.texCoords1);
+    writer.writeArray(mesh.clusterIndices);
+    writer.writeArray(mesh.clusterWeights);
+
+    writer.write<quint32>(mesh.parts.size());
+    foreach (const FBXMeshPart& part, mesh.parts) {
+        writeMeshPart(writer, part);
+    }
+
+    writer.write<quint32>(mesh.clusters.size());
+    foreach (const FBXCluster& cluster, mesh.clusters) {
+        writer.write<qint32>(cluster.jointIndex);
+        writer.write(cluster.inverseBindMatrix);
+    }
+    writer.write(mesh.meshExtents);
+    writer.write(mesh.modelTransform);
+    writer.write(mesh.isEye);
+    writer.write<quint32>(mesh.meshIndex);
+
+    writer.write<quint32>(mesh.blendshapes.size());
+    foreach (const FBXBlendshape& blendshape, mesh.blendshapes) {
+        writer.writeArray(blendshape.indices);
+        writer.writeArray(blendshape.vertices);
+        writer.writeArray(blendshape.normals);
+    }
+}
+
+static void readMesh(BakedReader& reader, FBXMesh& mesh, QHash<QString, model::MaterialPointer>& materials) {
+    reader.readArray(mesh.vertices);
+    reader.readArray(mesh.normals);
+    reader.readArray(mesh.tangents);
+    reader.readArray(mesh.colors);
+    reader.readArray(mesh.texCoords);
+    reader.readArray(mesh.texCoords1);
+    reader.readArray(mesh.clusterIndices);
+    reader.readArray(mesh.clusterWeights);
+
+    quint32 numParts = reader.read<quint32>();
+    for (quint32 i = 0; i < numParts; i++) {
+        mesh.parts.append(readMeshPart(reader, materials));
+    }
+
+    quint32 numClusters = reader.read<quint32>();
+    for (quint32 i = 0; i < numClusters; i++) {
+        FBXCluster cluster;
+        cluster.jointIndex = reader.read<qint32>();
+        cluster.inverseBindMatrix = reader.read<glm::mat4>();
+        mesh.clusters.append(cluster);
+    }
+    mesh.meshExtents = reader.readExtents();
+    mesh.modelTransform = reader.read<glm::mat4>();
+    mesh.isEye = reader.readBool();
+    mesh.meshIndex = reader.read<quint32>();
+
+    quint32 numBlendshapes = reader.read<quint32>();
+    mesh.blendshapes.resize(numBlendshapes);
+    for (quint32 i = 0; i < numBlendshapes; i++) {
+        FBXBlendshape& blendshape = mesh.blendshapes[i];
+        reader.readArray(blendshape.indices);
+        reader.readArray(blendshape.vertices);
+        reader.readArray(blendshape.normals);
+    }
+}
+
+static void writeJoint(BakedWriter& writer, const FBXJoint& joint) {
+    writer.write(joint.isFree);
+    writer.writeArray(joint.freeLineage);
+    writer.write<qint32>(joint.parentIndex);
+    writer.write(joint.distanceToParent);
+    writer.write(joint.boneRadius);
+    writer.write(joint.translation);
+    writer.write(joint.preTransform);
+    writer.write(joint.preRotation);
+    writer.write(joint.rotation);
+    writer.write(joint.postRotation);
+    writer.write(joint.postTransform);
+    writer.write(joint.transform);
+    writer.write(joint.rotationMin);
+    writer.write(joint.rotationMax);
+    writer.write(joint.inverseDefaultRotation);
+    writer.write(joint.inverseBindRotation);
+    writer.write(joint.bindTransform);
+    writer.write(joint.name);
+    writer.write(joint.isSkeletonJoint);
+    writer.write(joint.bindTransformFoundInCluster);
+}
+
+static FBXJoint readJoint(BakedReader& reader) {
+    FBXJoint joint;
+    joint.isFree = reader.readBool();
+    reader.readArray(joint.freeLineage);
+    joint.parentIndex = reader.read<qint32>();
+    joint.distanceToParent = reader.read<float>();
+    joint.boneRadius = reader.read<float>();
+    joint.translation = reader.read<glm::vec3>();
+    joint.preTransform = reader.read<glm::mat4>();
+    joint.preRotation = reader.read<glm::quat>();
+    joint.rotation = reader.read<glm::quat>();
+    joint.postRotation = reader.read<glm::quat>();
+    joint.postTransform = reader.read<glm::mat4>();
+    joint.transform = reader.read<glm::mat4>();
+    joint.rotationMin = reader.read<glm::vec3>();
+    joint.rotationMax = reader.read<glm::vec3>();
+    joint.inverseDefaultRotation = reader.read<glm::quat>();
+    joint.inverseBindRotation = reader.read<glm::quat>();
+    joint.bindTransform = reader.read<glm::mat4>();
+    joint.name = reader.readString();
+    joint.isSkeletonJoint = reader.readBool();
+    joint.bindTransformFoundInCluster = reader.readBool();
+    return joint;
+}
+
+QByteArray BakedGeometry::write(const FBXGeometry& geometry) {
+    BakedWriter writer;
+    writer.write(MAGIC);
+    writer.write(VERSION);
+    writer.write(BYTE_ORDER_MARK);
+
+    writer.write(geometry.author);
+    writer.write(geometry.applicationName);
+
+    writer.write<quint32>(geometry.joints.size());
+    foreach (const FBXJoint& joint, geometry.joints) {
+        writeJoint(writer, joint);
+    }
+    writer.write<quint32>(geometry.jointIndices.size());
+    for (auto it = geometry.jointIndices.constBegin(); it != geometry.jointIndices.constEnd(); it++) {
+        writer.write(it.key());
+        writer.write<qint32>(it.value());
+    }
+    writer.write(geometry.hasSkeletonJoints);
+    writer.write(geometry.offset);
+
+    for (int index : { geometry.leftEyeJointIndex, geometry.rightEyeJointIndex, geometry.neckJointIndex,
+            geometry.rootJointIndex, geometry.leanJointIndex, geometry.headJointIndex, geometry.leftHandJointIndex,
+            geometry.rightHandJointIndex, geometry.leftToeJointIndex, geometry.rightToeJointIndex }) {
+        writer.write<qint32>(index);
+    }
+    writer.write(geometry.leftEyeSize);
+    writer.write(geometry.rightEyeSize);
+    writer.writeArray(geometry.humanIKJointIndices);
+    writer.write(geometry.palmDirection);
+
+    writer.write<quint32>(geometry.sittingPoints.size());
+    foreach (const SittingPoint& sittingPoint, geometry.sittingPoints) {
+        writer.write(sittingPoint.name);
+        writer.write(sittingPoint.position);
+        writer.write(sittingPoint.rotation);
+    }
+    writer.write(geometry.neckPivot);
+    writer.write(geometry.bindExtents);
+    writer.write(geometry.meshExtents);
+
+    writer.write<quint32>(geometry.animationFrames.size());
+    foreach (const FBXAnimationFrame& frame, geometry.animationFrames) {
+        writer.writeArray(frame.rotations);
+    }
+    writer.write<quint32>(geometry.meshIndicesToModelNames.size());
+    for (auto it = geometry.meshIndicesToModelNames.constBegin(); it != geometry.meshIndicesToModelNames.constEnd(); it++) {
+        writer.write<qint32>(it.key());
+        writer.write(it.value());
+    }
+    writer.write<quint32>(geometry.blendshapeChannelNames.size());
+    foreach (const QString& name, geometry.blendshapeChannelNames) {
+        writer.write(name);
+    }
+
+    writer.write<quint32>(geometry.meshes.size());
+    foreach (const FBXMesh& mesh, geometry.meshes) {
+        writeMesh(writer, mesh);
+    }
+    return writer.getData();
+}
+
+FBXGeometry* BakedGeometry::read(const char* data, qint64 size, const QString& url) {
+    BakedReader reader(data, size);
+    if (memcmp(reader.take(sizeof(MAGIC)), MAGIC, sizeof(MAGIC)) != 0) {
+        throw QString("Not a baked geometry.");
+    }
+    if (reader.read<quint32>() != VERSION) {
+        throw QString("Baked geometry of another version.");
+    }
+    if (reader.read<quint32>() != BYTE_ORDER_MARK) {
+        throw QString("Baked geometry of another byte order.");
+    }
+
+    std::unique_ptr<FBXGeometry> geometry(new FBXGeometry());
+    geometry->author = reader.readString();
+    geometry->applicationName = reader.readString();
+
+    quint32 numJoints = reader.read<quint32>();
+    for (quint32 i = 0; i < numJoints; i++) {
+        geometry->joints.append(readJoint(reader));
+    }
+    quint32 numJointIndices = reader.read<quint32>();
+    for (quint32 i = 0; i < numJointIndices; i++) {
+        QString name = reader.readString();
+        geometry->jointIndices.insert(name, reader.read<qint32>());
+    }
+    geometry->hasSkeletonJoints = reader.readBool();
+    geometry->offset = reader.read<glm::mat4>();
+
+    for (int* index : { &geometry->leftEyeJointIndex, &geometry->rightEyeJointIndex, &geometry->neckJointIndex,
+            &geometry->rootJointIndex, &geometry->leanJointIndex, &geometry->headJointIndex, &geometry->leftHandJointIndex,
+            &geometry->rightHandJointIndex, &geometry->leftToeJointIndex, &geometry->rightToeJointIndex }) {
+        *index = reader.read<qint32>();
+    }
+    geometry->leftEyeSize = reader.read<float>();
+    geometry->rightEyeSize = reader.read<float>();
+    reader.readArray(geometry->humanIKJointIndices);
+    geometry->palmDirection = reader.read<glm::vec3>();
+
+    quint32 numSittingPoints = reader.read<quint32>();
+    for (quint32 i = 0; i < numSittingPoints; i++) {
+        SittingPoint sittingPoint;
+        sittingPoint.name = reader.readString();
+        sittingPoint.position = reader.read<glm::vec3>();
+        sittingPoint.rotation = reader.read<glm::quat>();
+        geometry->sittingPoints.append(sittingPoint);
+    }
+    geometry->neckPivot = reader.read<glm::vec3>();
+    geometry->bindExtents = reader.readExtents();
+    geometry->meshExtents = reader.readExtents();
+
+    quint32 numFrames = reader.read<quint32>();
+    geometry->animationFrames.resize(numFrames);
+    for (quint32 i = 0; i < numFrames; i++) {
+        reader.readArray(geometry->animationFrames[i].rotations);
+    }
+    quint32 numModelNames = reader.read<quint32>();
+    for (quint32 i = 0; i < numModelNames; i++) {
+        int meshIndex = reader.read<qint32>();
+        geometry->meshIndicesToModelNames.insert(meshIndex, reader.readString());
+    }
+    quint32 numChannelNames = reader.read<quint32>();
+    for (quint32 i = 0; i < numChannelNames; i++) {
+        geometry->blendshapeChannelNames.append(reader.readString());
+    }
+
+    QHash<QString, model::MaterialPointer> materials;
+    quint32 numMeshes = reader.read<quint32>();
+    geometry->meshes.resize(numMeshes);
+    for (quint32 i = 0; i < numMeshes; i++) {
+        FBXMesh& mesh = geometry->meshes[i];
+        readMesh(reader, mesh, materials);
+#       if USE_MODEL_MESH
+        buildModelMesh(mesh, url);
+#       endif
+    }
+    return geometry.release();
+}
+
+QString BakedGeometryCache::getDefaultDirectory() {
+    return QStandardPaths::writableLocation(QStandardPaths::DataLocation) + "/geometry";
+}
+
+BakedGeometryCache::BakedGeometryCache(const QString& directory) :
+    _directory(directory) {
+}
+
+QString BakedGeometryCache::getFilePath(const QByteArray& key) const {
+    return _directory + "/" + QString::fromLatin1(key) + BakedGeometry::FILE_EXTENSION;
+}
+
+FBXGeometry* BakedGeometryCache::load(const QByteArray& key, const QString& url) const {
+    QFile file(getFilePath(key));
+    if (!file.open(QIODevice::ReadOnly)) {
+        return nullptr;
+    }
+    qint64 size = file.size();
+    uchar* data = file.map(0, size);
+    try {
+        FBXGeometry* geometry = data ? BakedGeometry::read((const char*)data, size, url) :
+            BakedGeometry::read(file.readAll().constData(), size, url);
+        if (data) {
+            file.unmap(data);
+        }
+        return geometry;
+
+    } catch (const QString& error) {
+        qCDebug(modelformat) << "Removing baked geometry" << file.fileName() << ":" << error;
+        if (data) {
+            file.unmap(data);
+        }
+        file.remove();
+        return nullptr;
+    }
+}
+
+bool BakedGeometryCache::store(const QByteArray& key, const FBXGeometry& geometry) const {
+    if (!QDir().mkpath(_directory)) {
+        return false;
+    }
+    QSaveFile file(getFilePath(key));
+    if (!file.open(QIODevice::WriteOnly)) {
+        return false;
+    }
+    file.write(BakedGeometry::write(geometry));
+    return file.commit();
+}
+
+FBXGeometry* BakedGeometryCache::readModel(const QByteArray& model, const QVariantHash& mapping, const QString& url,
+                                           bool loadLightmaps, float lightmapLevel, ResourceDiskCache* diskCache) const {
+    QByteArray key = BakedGeometry::getKey(model, mapping, url, loadLightmaps, lightmapLevel);
+    FBXGeometry* geometry = load(key, url);
+    if (geometry) {
+        return geometry;
+    }
+    QString bakedName = QString::fromLatin1(key) + BakedGeometry::FILE_EXTENSION;
+    QByteArray baked;
+    if (diskCache && diskCache->load(bakedName, baked)) {
+        try {
+            return BakedGeometry::read(baked.constData(), baked.size(), url);
+
+        } catch (const QString& error) {
+            qCDebug(modelformat) << "Removing baked geometry" << bakedName << ":" << error;
+            diskCache->remove(bakedName);
+        }
+    }
+    geometry = readFBX(model, mapping, url, loadLightmaps, lightmapLevel);
+    if (diskCache && !diskCache->store(bakedName, BakedGeometry::write(*geometry))) {
+        qCDebug(modelformat) << "Failed to store the baked geometry of" << url;
+    }
+    return geometry;
+}
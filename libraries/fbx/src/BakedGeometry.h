@@ -0,0 +1,71 @@
+//
+//  BakedGeometry.h
+//  libraries/fbx/src
+//
+//  Copyright 2015 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_BakedGeometry_h
+#define hifi_BakedGeometry_h
+
+#include "FBXReader.h"
+
+class ResourceDiskCache;
+
+/// Fully processed FBX geometry in a binary layout that loads without parsing: the vertex, attribute and index streams are
+/// stored as they go into the GPU buffers (aligned, in native little-endian order), followed by the clusters, blendshapes,
+/// joints and extents.
+class BakedGeometry {
+public:
+    /// Bumped whenever the layout or the processing of the geometry changes, which invalidates the baked files
+    static const quint32 VERSION;
+
+    static const QString FILE_EXTENSION;
+
+    /// Returns the key of the geometry read from the model with the mapping and the lightmap settings, a hash of all that
+    /// goes into the processing, so that the baked files of a model are shared by all of its URLs in the same directory
+    /// (which the texture filenames are resolved against).
+    static QByteArray getKey(const QByteArray& model, const QVariantHash& mapping, const QString& url, bool loadLightmaps,
+                             float lightmapLevel);
+
+    static QByteArray write(const FBXGeometry& geometry);
+
+    /// Reads a baked geometry and builds the model meshes of its meshes.
+    /// \exception QString if the data isn't a baked geometry of this version, or is truncated
+    static FBXGeometry* read(const char* data, qint64 size, const QString& url = QString());
+};
+
+/// A directory of baked geometries, named after their keys.  The model baker seeds the directory of the clients ahead of
+/// time, with the models baked for the URLs they're served from.
+class BakedGeometryCache {
+public:
+    /// The directory of the cache of the application
+    static QString getDefaultDirectory();
+
+    BakedGeometryCache(const QString& directory = getDefaultDirectory());
+
+    const QString& getDirectory() const { return _directory; }
+
+    QString getFilePath(const QByteArray& key) const;
+
+    /// Returns the geometry of the key, or null if it isn't baked (or its file is stale or corrupt, in which case the file
+    /// is removed).
+    FBXGeometry* load(const QByteArray& key, const QString& url = QString()) const;
+
+    /// Writes the baked geometry atomically, so that concurrent loaders never see a partial file
+    bool store(const QByteArray& key, const FBXGeometry& geometry) const;
+
+    /// Reads the model served from the URL path, from the geometry baked ahead of time if there is one, else from the
+    /// geometry baked in the disk cache by an earlier read, else from the model itself (and bakes it into the disk cache).
+    /// \exception QString if the model has to be read and can't be
+    FBXGeometry* readModel(const QByteArray& model, const QVariantHash& mapping, const QString& url, bool loadLightmaps,
+                           float lightmapLevel, ResourceDiskCache* diskCache) const;
+
+private:
+    QString _directory;
+};
+
+#endif // hifi_BakedGeometry_h
@@ -0,0 +1,238 @@
+//
+//  BlendshapeBlender.cpp
+//  libraries/fbx/src
+//
+//  Copyright 2015 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "BlendshapeBlender.h"
+
+#include <algorithm>
+
+#include <tbb/enumerable_thread_specific.h>
+#include <tbb/parallel_for.h>
+
+#include <NumericalConstants.h>
+
+#if defined(__SSE__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 1)
+#define HIFI_BLENDSHAPES_SSE
+#include <xmmintrin.h>
+#endif
+
+const float BlendshapeBlender::COEFFICIENT_THRESHOLD = 0.001f;
+const float BlendshapeBlender::NORMAL_COEFFICIENT_SCALE = 0.01f;
+
+// below this many deltas to apply, a blend isn't worth splitting across threads
+const int MIN_PARALLEL_DELTAS = 16 * 1024;
+
+// The sums of the deltas of the range being blended, kept by each thread from blend to blend
+class BlendAccumulators {
+public:
+    std::vector<glm::vec4> vertices;
+    std::vector<glm::vec4> normals;
+};
+static tbb::enumerable_thread_specific<BlendAccumulators> threadAccumulators;
+
+BlendshapeLayout::BlendshapeLayout(const FBXMesh& mesh, int verticesPerRange) :
+    _numVertices(mesh.vertices.size()),
+    _numShapes(mesh.blendshapes.size()),
+    _hasNormals(mesh.normals.size() == mesh.vertices.size())
+{
+    int numRanges = (_numVertices + verticesPerRange - 1) / verticesPerRange;
+    _ranges.resize(numRanges);
+    for (int i = 0; i < numRanges; i++) {
+        Range& range = _ranges[i];
+        range._begin = i * verticesPerRange;
+        range._end = std::min(_numVertices, range._begin + verticesPerRange);
+        range._shapeOffsets.resize(_numShapes + 1, 0);
+    }
+
+    // count the deltas of each shape in each range, then turn the counts into offsets
+    for (int i = 0; i < _numShapes; i++) {
+        const FBXBlendshape& blendshape = mesh.blendshapes.at(i);
+        for (int index : blendshape.indices) {
+            if (index >= 0 && index < _numVertices) {
+                _ranges[index / verticesPerRange]._shapeOffsets[i + 1]++;
+            }
+        }
+    }
+    for (auto& range : _ranges) {
+        for (int i = 0; i < _numShapes; i++) {
+            range._shapeOffsets[i + 1] += range._shapeOffsets[i];
+        }
+        int numDeltas = range._shapeOffsets[_numShapes];
+        range._indices.resize(numDeltas);
+        range._vertexDeltas.resize(numDeltas);
+        if (_hasNormals) {
+            range._normalDeltas.resize(numDeltas);
+        }
+    }
+
+    // the deltas of a shape keep their order within a range, so every vertex gets its deltas in the same order as before
+    std::vector<int> next(numRanges);
+    for (int i = 0; i < _numShapes; i++) {
+        const FBXBlendshape& blendshape = mesh.blendshapes.at(i);
+        for (int r = 0; r < numRanges; r++) {
+            next[r] = _ranges[r]._shapeOffsets[i];
+        }
+        bool hasShapeNormals = blendshape.normals.size() == blendshape.indices.size();
+        for (int j = 0; j < blendshape.indices.size(); j++) {
+            int index = blendshape.indices.at(j);
+            if (index < 0 || index >= _numVertices) {
+                continue;
+            }
+            Range& range = _ranges[index / verticesPerRange];
+            int delta = next[index / verticesPerRange]++;
+            range._indices[delta] = index - range._begin;
+            range._vertexDeltas[delta] = glm::vec4(blendshape.vertices.at(j), 0.0f);
+            if (_hasNormals) {
+                range._normalDeltas[delta] = hasShapeNormals ? glm::vec4(blendshape.normals.at(j), 0.0f) : glm::vec4(0.0f);
+            }
+        }
+    }
+}
+
+bool BlendshapeBlender::coefficientsChanged(const QVector<float>& blended, const QVector<float>& coefficients,
+                                            float threshold) {
+    if (blended.size() != coefficients.size()) {
+        return true;
+    }
+    for (int i = 0; i < coefficients.size(); i++) {
+        if (fabsf(coefficients.at(i) - blended.at(i)) > threshold) {
+            return true;
+        }
+    }
+    return false;
+}
+
+BlendshapeLayouts BlendshapeBlender::makeLayouts(const QVector<FBXMesh>& meshes) {
+    BlendshapeLayouts layouts;
+    layouts.reserve(meshes.size());
+    foreach (const FBXMesh& mesh, meshes) {
+        layouts.push_back(mesh.blendshapes.isEmpty() ? BlendshapeLayoutPointer() : std::make_shared<BlendshapeLayout>(mesh));
+    }
+    return layouts;
+}
+
+// Adds the scaled deltas of one shape to the accumulators of a range
+static void accumulateDeltas(const glm::vec4* deltas, const int* indices, int numDeltas, float coefficient,
+                             glm::vec4* accumulators) {
+    int j = 0;
+#ifdef HIFI_BLENDSHAPES_SSE
+    __m128 scale = _mm_set1_ps(coefficient);
+    for (; j + 4 <= numDeltas; j += 4) {
+        // the deltas are vec4s with w = 0, so a whole accumulator is one load, one multiply-add and one store
+        float* a0 = &accumulators[indices[j]].x;
+        float* a1 = &accumulators[indices[j + 1]].x;
+        float* a2 = &accumulators[indices[j + 2]].x;
+        float* a3 = &accumulators[indices[j + 3]].x;
+        const float* d = &deltas[j].x;
+        _mm_storeu_ps(a0, _mm_add_ps(_mm_loadu_ps(a0), _mm_mul_ps(_mm_loadu_ps(d), scale)));
+        _mm_storeu_ps(a1, _mm_add_ps(_mm_loadu_ps(a1), _mm_mul_ps(_mm_loadu_ps(d + 4), scale)));
+        _mm_storeu_ps(a2, _mm_add_ps(_mm_loadu_ps(a2), _mm_mul_ps(_mm_loadu_ps(d + 8), scale)));
+        _mm_storeu_ps(a3, _mm_add_ps(_mm_loadu_ps(a3), _mm_mul_ps(_mm_loadu_ps(d + 12), scale)));
+    }
+#endif
+    for (; j < numDeltas; j++) {
+        accumulators[indices[j]] += deltas[j] * coefficient;
+    }
+}
+
+void BlendshapeBlender::blendRange(const FBXMesh& mesh, const BlendshapeLayout& layout, const BlendshapeLayout::Range& range,
+                                   const QVector<float>& coefficients, glm::vec3* vertices, glm::vec3* normals) {
+    int numVertices = range._end - range._begin;
+    BlendAccumulators& accumulators = threadAccumulators.local();
+    std::vector<glm::vec4>& vertexAccumulators = accumulators.vertices;
+    std::vector<glm::vec4>& normalAccumulators = accumulators.normals;
+    vertexAccumulators.assign(numVertices, glm::vec4(0.0f));
+    if (layout.hasNormals()) {
+        normalAccumulators.assign(numVertices, glm::vec4(0.0f));
+    }
+
+    for (int i = 0, n = qMin(coefficients.size(), layout.getNumShapes()); i < n; i++) {
+        float vertexCoefficient = coefficients.at(i);
+        if (vertexCoefficient < EPSILON) {
+            continue;
+        }
+        int begin = range._shapeOffsets[i];
+        int numDeltas = range._shapeOffsets[i + 1] - begin;
+        if (numDeltas == 0) {
+            continue;
+        }
+        accumulateDeltas(range._vertexDeltas.data() + begin, range._indices.data() + begin, numDeltas, vertexCoefficient,
+            vertexAccumulators.data());
+        if (layout.hasNormals()) {
+            accumulateDeltas(range._normalDeltas.data() + begin, range._indices.data() + begin, numDeltas,
+                vertexCoefficient * NORMAL_COEFFICIENT_SCALE, normalAccumulators.data());
+        }
+    }
+
+    const glm::vec3* baseVertices = mesh.vertices.constData();
+    for (int i = 0; i < numVertices; i++) {
+        int index = range._begin + i;
+        vertices[index] = baseVertices[index] + glm::vec3(vertexAccumulators[i]);
+    }
+    const glm::vec3* baseNormals = mesh.normals.constData();
+    if (layout.hasNormals()) {
+        for (int i = 0; i < numVertices; i++) {
+            int index = range._begin + i;
+            normals[index] = baseNormals[index] + glm::vec3(normalAccumulators[i]);
+        }
+    } else {
+        for (int index = range._begin; index < range._end; index++) {
+            normals[index] = (index < mesh.normals.size()) ? baseNormals[index] : glm::vec3(0.0f);
+        }
+    }
+}
+
+void BlendshapeBlender::blend(const QVector<FBXMesh>& meshes, const BlendshapeLayouts& layouts,
+                              const QVector<float>& coefficients, QVector<glm::vec3>& vertices, QVector<glm::vec3>& normals) {
+    class Work {
+    public:
+        const FBXMesh* mesh;
+        const BlendshapeLayout* layout;
+        const BlendshapeLayout::Range* range;
+        int offset;
+    };
+    std::vector<Work> work;
+    int numVertices = 0;
+    int numDeltas = 0;
+    for (int i = 0; i < meshes.size() && i < (int)layouts.size(); i++) {
+        const BlendshapeLayout* layout = layouts[i].get();
+        if (!layout) {
+            continue;
+        }
+        for (auto& range : layout->getRanges()) {
+            Work rangeWork = { &meshes.at(i), layout, &range, numVertices };
+            work.push_back(rangeWork);
+            for (int j = 0, n = qMin(coefficients.size(), layout->getNumShapes()); j < n; j++) {
+                if (coefficients.at(j) >= EPSILON) {
+                    numDeltas += range._shapeOffsets[j + 1] - range._shapeOffsets[j];
+                }
+            }
+        }
+        numVertices += layout->getNumVertices();
+    }
+
+    // resizing keeps the allocation of a vector that isn't shared
+    vertices.resize(numVertices);
+    normals.resize(numVertices);
+    glm::vec3* vertexData = vertices.data();
+    glm::vec3* normalData = normals.data();
+
+    auto blendWork = [&](size_t i) {
+        const Work& rangeWork = work[i];
+        blendRange(*rangeWork.mesh, *rangeWork.layout, *rangeWork.range, coefficients,
+            vertexData + rangeWork.offset, normalData + rangeWork.offset);
+    };
+    if (work.size() > 1 && numDeltas >= MIN_PARALLEL_DELTAS) {
+        tbb::parallel_for((size_t)0, work.size(), blendWork);
+    } else {
+        for (size_t i = 0; i < work.size(); i++) {
+            blendWork(i);
+        }
+    }
+}
@@ -0,0 +1,83 @@
+//
+//  BlendshapeBlender.h
+//  libraries/fbx/src
+//
+//  Copyright 2015 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_BlendshapeBlender_h
+#define hifi_BlendshapeBlender_h
+
+#include <memory>
+#include <vector>
+
+#include "FBXReader.h"
+
+/// The blendshapes of a mesh rearranged for blending. The vertices of the mesh are split in ranges, and the deltas of each
+/// range are stored shape by shape as vec4s, so that a range can be blended on its own thread with one SIMD multiply-add per
+/// delta.
+class BlendshapeLayout {
+public:
+    static const int DEFAULT_VERTICES_PER_RANGE = 2048;
+
+    BlendshapeLayout(const FBXMesh& mesh, int verticesPerRange = DEFAULT_VERTICES_PER_RANGE);
+
+    class Range {
+    public:
+        int _begin = 0;
+        int _end = 0;
+
+        // the deltas of the shape i are [_shapeOffsets[i], _shapeOffsets[i + 1])
+        std::vector<int> _shapeOffsets;
+        std::vector<int> _indices; // relative to _begin
+        std::vector<glm::vec4> _vertexDeltas;
+        std::vector<glm::vec4> _normalDeltas;
+    };
+
+    int getNumVertices() const { return _numVertices; }
+    int getNumShapes() const { return _numShapes; }
+    bool hasNormals() const { return _hasNormals; }
+    const std::vector<Range>& getRanges() const { return _ranges; }
+
+private:
+    int _numVertices = 0;
+    int _numShapes = 0;
+    bool _hasNormals = false;
+    std::vector<Range> _ranges;
+};
+
+typedef std::shared_ptr<const BlendshapeLayout> BlendshapeLayoutPointer;
+typedef std::vector<BlendshapeLayoutPointer> BlendshapeLayouts;
+
+/// Blends the meshes of a model with their blendshapes
+class BlendshapeBlender {
+public:
+    /// Changes of the coefficients below this don't show, and don't need a new blend
+    static const float COEFFICIENT_THRESHOLD;
+
+    /// The normal deltas are scaled down compared to the vertex deltas
+    static const float NORMAL_COEFFICIENT_SCALE;
+
+    /// Returns true if any coefficient moved by more than the threshold since the blended ones
+    static bool coefficientsChanged(const QVector<float>& blended, const QVector<float>& coefficients,
+        float threshold = COEFFICIENT_THRESHOLD);
+
+    /// Returns the layouts of the meshes, a null layout for the meshes without blendshapes
+    static BlendshapeLayouts makeLayouts(const QVector<FBXMesh>& meshes);
+
+    /// Blends the meshes with blendshapes, one after the other, into vertices and normals.
+    /// The vectors are resized to fit and keep their allocation when they are reused; large meshes are split across the
+    /// worker threads.
+    static void blend(const QVector<FBXMesh>& meshes, const BlendshapeLayouts& layouts, const QVector<float>& coefficients,
+        QVector<glm::vec3>& vertices, QVector<glm::vec3>& normals);
+
+    /// Blends one range of a mesh into vertices and normals, the arrays of the whole mesh, through accumulators that each
+    /// thread keeps for its next blend
+    static void blendRange(const FBXMesh& mesh, const BlendshapeLayout& layout, const BlendshapeLayout::Range& range,
+        const QVector<float>& coefficients, glm::vec3* vertices, glm::vec3* normals);
+};
+
+#endif // hifi_BlendshapeBlender_h
@@ -0,0 +1,334 @@
+//
+//  FBXBinaryParser.cpp
+//  libraries/fbx/src
+//
+//  Copyright 2015 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "FBXBinaryParser.h"
+
+#include <algorithm>
+#include <cstring>
+#include <vector>
+
+#include <QtEndian>
+
+#include <zlib.h>
+
+#include "FBXReader.h"
+
+// see http://code.blender.org/index.php/2013/08/fbx-binary-file-format-specification/ for an explanation
+// of the FBX binary format
+
+static const char BINARY_PROLOG[] = "Kaydara FBX Binary  ";
+static const int BINARY_PROLOG_SIZE = sizeof(BINARY_PROLOG) - 1;
+static const int VERSION_OFFSET = 23;
+static const int HEADER_SIZE = 27;
+
+// from this version on, the offsets and counts of the node records are 64 bits
+static const quint32 FIRST_64_BIT_VERSION = 7500;
+
+// the arrays that need converting are inflated through a buffer of this size
+static const int INFLATE_CHUNK_SIZE = 16 * 1024;
+
+static_assert(sizeof(glm::vec2) == 2 * sizeof(float) && sizeof(glm::vec3) == 3 * sizeof(float) &&
+    sizeof(glm::vec4) == 4 * sizeof(float), "the vectors are read as arrays of floats");
+
+// The data has no alignment, the elements are copied out of it
+template<class T> static T loadElement(const char* bytes) {
+    T value;
+    memcpy(&value, bytes, sizeof(T));
+    return qFromLittleEndian<T>(value);
+}
+
+template<> float loadElement<float>(const char* bytes) {
+    quint32 bits = loadElement<quint32>(bytes);
+    float value;
+    memcpy(&value, &bits, sizeof(value));
+    return value;
+}
+
+template<> double loadElement<double>(const char* bytes) {
+    quint64 bits = loadElement<quint64>(bytes);
+    double value;
+    memcpy(&value, &bits, sizeof(value));
+    return value;
+}
+
+template<> bool loadElement<bool>(const char* bytes) {
+    return *bytes != 0;
+}
+
+template<class T> static char getArrayType();
+template<> char getArrayType<float>() { return 'f'; }
+template<> char getArrayType<double>() { return 'd'; }
+template<> char getArrayType<int>() { return 'i'; }
+
+template<class S, class T> static void convertElements(const char* bytes, quint32 count, T* values) {
+    for (quint32 i = 0; i < count; i++) {
+        values[i] = (T)loadElement<S>(bytes + i * sizeof(S));
+    }
+}
+
+template<class T> static void convertElements(char type, const char* bytes, quint32 count, T* values) {
+    switch (type) {
+        case 'f':
+            convertElements<float>(bytes, count, values);
+            break;
+        case 'd':
+            convertElements<double>(bytes, count, values);
+            break;
+        case 'l':
+            convertElements<qint64>(bytes, count, values);
+            break;
+        case 'i':
+            convertElements<qint32>(bytes, count, values);
+            break;
+        case 'b':
+            convertElements<bool>(bytes, count, values);
+            break;
+        default:
+            break;
+    }
+}
+
+// Reads the first count elements of the array into values
+template<class T> static bool readElements(const FBXArrayProperty& array, T* values, quint32 count) {
+    int elementSize = array.getElementSize();
+    if (elementSize == 0) {
+        return false;
+    }
+    count = std::min(count, array.length);
+    quint64 size = (quint64)count * elementSize;
+    bool isSameType = (Q_BYTE_ORDER == Q_LITTLE_ENDIAN) && array.type == getArrayType<T>();
+
+    if (array.encoding == FBXArrayProperty::RAW_ENCODING) {
+        if (size > array.dataLength) {
+            return false;
+        }
+        if (isSameType) {
+            memcpy(values, array.data, size);
+        } else {
+            convertElements(array.type, array.data, count, values);
+        }
+        return true;
+    }
+    if (array.encoding != FBXArrayProperty::DEFLATE_ENCODING) {
+        return false;
+    }
+
+    z_stream stream;
+    memset(&stream, 0, sizeof(stream));
+    stream.next_in = (Bytef*)array.data;
+    stream.avail_in = array.dataLength;
+    if (inflateInit(&stream) != Z_OK) {
+        return false;
+    }
+    bool isComplete = true;
+    if (isSameType) {
+        stream.next_out = (Bytef*)values;
+        stream.avail_out = (uInt)size;
+        int result = inflate(&stream, Z_FINISH);
+        isComplete = (stream.avail_out == 0) && (result == Z_STREAM_END || result == Z_OK || result == Z_BUF_ERROR);
+
+    } else {
+        // all the input is there, so inflate only stops short of filling the chunk at the end of the stream
+        char chunk[INFLATE_CHUNK_SIZE];
+        quint32 chunkElements = INFLATE_CHUNK_SIZE / elementSize;
+        for (quint32 done = 0; done < count && isComplete; ) {
+            quint32 numElements = std::min(count - done, chunkElements);
+            stream.next_out = (Bytef*)chunk;
+            stream.avail_out = numElements * elementSize;
+            int result = inflate(&stream, Z_SYNC_FLUSH);
+            if (stream.avail_out != 0 || (result != Z_OK && result != Z_STREAM_END)) {
+                isComplete = false;
+                break;
+            }
+            convertElements(array.type, chunk, numElements, values + done);
+            done += numElements;
+        }
+    }
+    inflateEnd(&stream);
+    return isComplete;
+}
+
+template<class V, class T> static bool readVector(const FBXArrayProperty& array, QVector<V>& values) {
+    const int SCALARS_PER_VALUE = sizeof(V) / sizeof(T);
+    values.resize(array.length / SCALARS_PER_VALUE);
+    if (!readElements(array, reinterpret_cast<T*>(values.data()), values.size() * SCALARS_PER_VALUE)) {
+        values.clear();
+        return false;
+    }
+    return true;
+}
+
+int FBXArrayProperty::getElementSize() const {
+    switch (type) {
+        case 'f':
+        case 'i':
+            return 4;
+        case 'd':
+        case 'l':
+            return 8;
+        case 'b':
+            return 1;
+        default:
+            return 0;
+    }
+}
+
+bool FBXArrayProperty::read(QVector<double>& values) const {
+    return readVector<double, double>(*this, values);
+}
+
+bool FBXArrayProperty::read(QVector<float>& values) const {
+    return readVector<float, float>(*this, values);
+}
+
+bool FBXArrayProperty::read(QVector<int>& values) const {
+    return readVector<int, int>(*this, values);
+}
+
+bool FBXArrayProperty::read(QVector<glm::vec2>& values) const {
+    return readVector<glm::vec2, float>(*this, values);
+}
+
+bool FBXArrayProperty::read(QVector<glm::vec3>& values) const {
+    return readVector<glm::vec3, float>(*this, values);
+}
+
+bool FBXArrayProperty::read(QVector<glm::vec4>& values) const {
+    return readVector<glm::vec4, float>(*this, values);
+}
+
+static int fbxArrayPropertyMetaTypeId = qRegisterMetaType<FBXArrayProperty>();
+
+class BinaryReader {
+public:
+    BinaryReader(const char* data, qint64 size) : _data(data), _position(data), _end(data + size) { }
+
+    qint64 getOffset() const { return _position - _data; }
+    qint64 getBytesLeft() const { return _end - _position; }
+
+    const char* take(qint64 size) {
+        if (size < 0 || size > getBytesLeft()) {
+            throw QString("Unexpected end of binary FBX data.");
+        }
+        const char* data = _position;
+        _position += size;
+        return data;
+    }
+
+    void seek(quint64 offset) {
+        if (offset < (quint64)getOffset() || offset > (quint64)(_end - _data)) {
+            throw QString("Invalid node offset in binary FBX data.");
+        }
+        _position = _data + offset;
+    }
+
+    template<class T> T read() {
+        return loadElement<T>(take(sizeof(T)));
+    }
+
+private:
+    const char* _data;
+    const char* _position;
+    const char* _end;
+};
+
+static QVariant parseBinaryFBXProperty(BinaryReader& reader) {
+    char ch = *reader.take(1);
+    switch (ch) {
+        case 'Y':
+            return QVariant::fromValue(reader.read<qint16>());
+        case 'C':
+            return QVariant::fromValue(reader.read<bool>());
+        case 'I':
+            return QVariant::fromValue(reader.read<qint32>());
+        case 'F':
+            return QVariant::fromValue(reader.read<float>());
+        case 'D':
+            return QVariant::fromValue(reader.read<double>());
+        case 'L':
+            return QVariant::fromValue(reader.read<qint64>());
+        case 'f':
+        case 'd':
+        case 'l':
+        case 'i':
+        case 'b': {
+            FBXArrayProperty array;
+            array.type = ch;
+            array.length = reader.read<quint32>();
+            array.encoding = reader.read<quint32>();
+            array.dataLength = reader.read<quint32>();
+            array.data = reader.take(array.dataLength);
+            return QVariant::fromValue(array);
+        }
+        case 'S':
+        case 'R': {
+            quint32 length = reader.read<quint32>();
+            return QVariant::fromValue(QByteArray(reader.take(length), length));
+        }
+        default:
+            throw QString("Unknown property type: ") + ch;
+    }
+}
+
+static FBXNode parseBinaryFBXNode(BinaryReader& reader, bool has64BitOffsets) {
+    quint64 endOffset = has64BitOffsets ? reader.read<quint64>() : reader.read<quint32>();
+    quint64 propertyCount = has64BitOffsets ? reader.read<quint64>() : reader.read<quint32>();
+    reader.take(has64BitOffsets ? sizeof(quint64) : sizeof(quint32)); // the length of the property list
+    quint8 nameLength = (quint8)*reader.take(1);
+
+    FBXNode node;
+    if (endOffset == 0 || nameLength == 0) {
+        // use a null name to indicate a null node
+        return node;
+    }
+    node.name = QByteArray(reader.take(nameLength), nameLength);
+
+    for (quint64 i = 0; i < propertyCount; i++) {
+        node.properties.append(parseBinaryFBXProperty(reader));
+    }
+
+    while ((quint64)reader.getOffset() < endOffset) {
+        FBXNode child = parseBinaryFBXNode(reader, has64BitOffsets);
+        if (child.name.isNull()) {
+            break;
+        }
+        node.children.append(child);
+    }
+    reader.seek(endOffset);
+
+    return node;
+}
+
+bool isBinaryFBX(const char* data, qint64 size) {
+    return size >= HEADER_SIZE && memcmp(data, BINARY_PROLOG, BINARY_PROLOG_SIZE) == 0;
+}
+
+FBXNode parseBinaryFBX(const char* data, qint64 size) {
+    if (!isBinaryFBX(data, size)) {
+        throw QString("Not a binary FBX document.");
+    }
+    BinaryReader reader(data, size);
+    reader.take(VERSION_OFFSET);
+    bool has64BitOffsets = reader.read<quint32>() >= FIRST_64_BIT_VERSION;
+
+    // parse the top-level node
+    FBXNode top;
+    while (reader.getBytesLeft() > 0) {
+        FBXNode next = parseBinaryFBXNode(reader, has64BitOffsets);
+        if (next.name.isNull()) {
+            return top;
+
+        } else {
+            top.children.append(next);
+        }
+    }
+
+    return top;
+}
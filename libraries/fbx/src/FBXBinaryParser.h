@@ -0,0 +1,59 @@
+//
+//  FBXBinaryParser.h
+//  libraries/fbx/src
+//
+//  Copyright 2015 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_FBXBinaryParser_h
+#define hifi_FBXBinaryParser_h
+
+#include <QMetaType>
+#include <QVector>
+
+#include <glm/glm.hpp>
+
+class FBXNode;
+
+/// An array property of a binary FBX node, left as it is in the file until something reads it. The data points into the
+/// parsed buffer (usually the memory-mapped file), which has to outlive the node.
+class FBXArrayProperty {
+public:
+    char type = 0;              // 'f', 'd', 'l', 'i' or 'b'
+    quint32 length = 0;         // in elements
+    quint32 encoding = 0;       // RAW_ENCODING or DEFLATE_ENCODING
+    const char* data = nullptr;
+    quint32 dataLength = 0;     // in bytes, as stored
+
+    static const quint32 RAW_ENCODING = 0;
+    static const quint32 DEFLATE_ENCODING = 1;
+
+    int getElementSize() const;
+
+    /// Reads the elements, converted to the type of the vector. The compressed arrays are inflated straight into the vector
+    /// when they hold the same type, or chunk by chunk through a small buffer otherwise.
+    /// \return false if the data is corrupt
+    bool read(QVector<double>& values) const;
+    bool read(QVector<float>& values) const;
+    bool read(QVector<int>& values) const;
+
+    /// Reads the array of scalars as vectors, without going through an array of doubles
+    bool read(QVector<glm::vec2>& values) const;
+    bool read(QVector<glm::vec3>& values) const;
+    bool read(QVector<glm::vec4>& values) const;
+};
+
+Q_DECLARE_METATYPE(FBXArrayProperty)
+
+/// Returns true if the data starts with the prolog of a binary FBX document
+bool isBinaryFBX(const char* data, qint64 size);
+
+/// Parses a binary FBX document in place: the scalar properties become QVariants as in the stream parser, and the array
+/// properties become FBXArrayProperty pointing into the data.
+/// \exception QString if the document is truncated or has an unknown property type
+FBXNode parseBinaryFBX(const char* data, qint64 size);
+
+#endif // hifi_FBXBinaryParser_h
@@ -10,6 +10,7 @@
 //
 
 #include <iostream>
+#include <vector>
 #include <QBuffer>
 #include <QDataStream>
 #include <QIODevice>
@@ -17,12 +18,15 @@
 #include <QTextStream>
 #include <QtDebug>
 #include <QtEndian>
+#include <QFile>
 #include <QFileInfo>
 
 #include <glm/gtc/quaternion.hpp>
 #include <glm/gtx/quaternion.hpp>
 #include <glm/gtx/transform.hpp>
 
+#include <tbb/parallel_for.h>
+
 #include <FaceshiftConstants.h>
 #include <GeometryUtil.h>
 #include <GLMHelpers.h>
@@ -31,8 +35,10 @@
 #include <gpu/Format.h>
 #include <LogHandler.h>
 
+#include "FBXBinaryParser.h"
 #include "FBXReader.h"
 #include "ModelFormatLogging.h"
+#include "VertexIndexTable.h"
 
 // TOOL: Uncomment the following line to enable the filtering of all the unkwnon fields of a node so we can break point easily while loading a model with problems...
 //#define DEBUG_FBXREADER
@@ -571,6 +577,11 @@ QVector<int> getIntVector(const FBXNode& node) {
     if (node.properties.isEmpty()) {
         return QVector<int>();
     }
+    if (node.properties.at(0).userType() == qMetaTypeId<FBXArrayProperty>()) {
+        QVector<int> vector;
+        node.properties.at(0).value<FBXArrayProperty>().read(vector);
+        return vector;
+    }
     QVector<int> vector = node.properties.at(0).value<QVector<int> >();
     if (!vector.isEmpty()) {
         return vector;
@@ -590,6 +601,11 @@ QVector<float> getFloatVector(const FBXNode& node) {
     if (node.properties.isEmpty()) {
         return QVector<float>();
     }
+    if (node.properties.at(0).userType() == qMetaTypeId<FBXArrayProperty>()) {
+        QVector<float> vector;
+        node.properties.at(0).value<FBXArrayProperty>().read(vector);
+        return vector;
+    }
     QVector<float> vector = node.properties.at(0).value<QVector<float> >();
     if (!vector.isEmpty()) {
         return vector;
@@ -609,6 +625,11 @@ QVector<double> getDoubleVector(const FBXNode& node) {
     if (node.properties.isEmpty()) {
         return QVector<double>();
     }
+    if (node.properties.at(0).userType() == qMetaTypeId<FBXArrayProperty>()) {
+        QVector<double> vector;
+        node.properties.at(0).value<FBXArrayProperty>().read(vector);
+        return vector;
+    }
     QVector<double> vector = node.properties.at(0).value<QVector<double> >();
     if (!vector.isEmpty()) {
         return vector;
@@ -619,6 +640,59 @@ QVector<double> getDoubleVector(const FBXNode& node) {
     return vector;
 }
 
+// Binary arrays are read straight into the vectors, the others go through an array of doubles
+static bool getArrayProperty(const FBXNode& node, FBXArrayProperty& array) {
+    foreach (const FBXNode& child, node.children) {
+        if (child.name == "a") {
+            return getArrayProperty(child, array);
+        }
+    }
+    if (node.properties.isEmpty() || node.properties.at(0).userType() != qMetaTypeId<FBXArrayProperty>()) {
+        return false;
+    }
+    array = node.properties.at(0).value<FBXArrayProperty>();
+    return true;
+}
+
+QVector<glm::vec3> getVec3Vector(const FBXNode& node) {
+    FBXArrayProperty array;
+    if (!getArrayProperty(node, array)) {
+        return createVec3Vector(getDoubleVector(node));
+    }
+    QVector<glm::vec3> values;
+    array.read(values);
+    return values;
+}
+
+QVector<glm::vec2> getVec2Vector(const FBXNode& node) {
+    FBXArrayProperty array;
+    if (!getArrayProperty(node, array)) {
+        return createVec2Vector(getDoubleVector(node));
+    }
+    QVector<glm::vec2> values;
+    array.read(values);
+    for (auto& value : values) {
+        value.t = -value.t;
+    }
+    return values;
+}
+
+QVector<glm::vec4> getVec4VectorRGBA(const FBXNode& node, glm::vec4& average) {
+    FBXArrayProperty array;
+    if (!getArrayProperty(node, array)) {
+        return createVec4VectorRGBA(getDoubleVector(node), average);
+    }
+    QVector<glm::vec4> values;
+    array.read(values);
+    foreach (const glm::vec4& value, values) {
+        average += value;
+    }
+    if (!values.isEmpty()) {
+        average *= (1.0f / float(values.size()));
+    }
+    return values;
+}
+
 glm::vec3 getVec3(const QVariantList& properties, int index) {
     return glm::vec3(properties.at(index).value<double>(), properties.at(index + 1).value<double>(),
         properties.at(index + 2).value<double>());
@@ -774,21 +848,6 @@ void appendModelIDs(const QString& parentID, const QMultiHash<QString, QString>&
     }
 }
 
-class Vertex {
-public:
-    int originalIndex;
-    glm::vec2 texCoord;
-    glm::vec2 texCoord1;
-};
-
-uint qHash(const Vertex& vertex, uint seed = 0) {
-    return qHash(vertex.originalIndex, seed);
-}
-
-bool operator==(const Vertex& v1, const Vertex& v2) {
-    return v1.originalIndex == v2.originalIndex && v1.texCoord == v2.texCoord && v1.texCoord1 == v2.texCoord1;
-}
-
 class ExtractedMesh {
 public:
     FBXMesh mesh;
@@ -824,7 +883,7 @@ public:
     QVector<glm::vec2> texCoords;
     QVector<int> texCoordIndices;
 
-    QHash<Vertex, int> indices;
+    VertexIndexTable indices;
 
     std::vector<AttributeData> attributes;
 };
@@ -950,11 +1009,10 @@ void appendIndex(MeshData& data, QVector<int>& indices, int index) {
         }
     }
 
-    QHash<Vertex, int>::const_iterator it = data.indices.find(vertex);
-    if (it == data.indices.constEnd()) {
-        int newIndex = data.extracted.mesh.vertices.size();
+    int newIndex = data.extracted.mesh.vertices.size();
+    int existingIndex = data.indices.insert(vertex, newIndex);
+    if (existingIndex == newIndex) {
         indices.append(newIndex);
-        data.indices.insert(vertex, newIndex);
         data.extracted.newIndices.insert(vertexIndex, newIndex);
         data.extracted.mesh.vertices.append(position);
         data.extracted.mesh.normals.append(normal);
@@ -966,8 +1024,8 @@ void appendIndex(MeshData& data, QVector<int>& indices, int index) {
             data.extracted.mesh.texCoords1.append(vertex.texCoord1);
         }
     } else {
-        indices.append(*it);
-        data.extracted.mesh.normals[*it] += normal;
+        indices.append(existingIndex);
+        data.extracted.mesh.normals[existingIndex] += normal;
     }
 }
 
@@ -980,7 +1038,7 @@ ExtractedMesh extractMesh(const FBXNode& object, unsigned int& meshIndex) {
 
     foreach (const FBXNode& child, object.children) {
         if (child.name == "Vertices") {
-            data.vertices = createVec3Vector(getDoubleVector(child));
+            data.vertices = getVec3Vector(child);
 
         } else if (child.name == "PolygonVertexIndex") {
             data.polygonIndices = getIntVector(child);
@@ -990,7 +1048,7 @@ ExtractedMesh extractMesh(const FBXNode& object, unsigned int& meshIndex) {
             bool indexToDirect = false;
             foreach (const FBXNode& subdata, child.children) {
                 if (subdata.name == "Normals") {
-                    data.normals = createVec3Vector(getDoubleVector(subdata));
+                    data.normals = getVec3Vector(subdata);
 
                 } else if (subdata.name == "NormalsIndex") {
                     data.normalIndices = getIntVector(subdata);
@@ -1011,7 +1069,7 @@ ExtractedMesh extractMesh(const FBXNode& object, unsigned int& meshIndex) {
             bool indexToDirect = false;
             foreach (const FBXNode& subdata, child.children) {
                 if (subdata.name == "Colors") {
-                    data.colors = createVec4VectorRGBA(getDoubleVector(subdata), data.averageColor);
+                    data.colors = getVec4VectorRGBA(subdata, data.averageColor);
                 } else if (subdata.name == "ColorsIndex") {
                     data.colorIndices = getIntVector(subdata);
 
@@ -1046,11 +1104,11 @@ ExtractedMesh extractMesh(const FBXNode& object, unsigned int& meshIndex) {
                 attrib.index = child.properties.at(0).toInt();
                 foreach (const FBXNode& subdata, child.children) {
                     if (subdata.name == "UV") {
-                        data.texCoords = createVec2Vector(getDoubleVector(subdata));
-                        attrib.texCoords = createVec2Vector(getDoubleVector(subdata));
+                        data.texCoords = getVec2Vector(subdata);
+                        attrib.texCoords = data.texCoords;
                     } else if (subdata.name == "UVIndex") {
                         data.texCoordIndices = getIntVector(subdata);
-                        attrib.texCoordIndices = getIntVector(subdata);
+                        attrib.texCoordIndices = data.texCoordIndices;
                     } else if (subdata.name == "Name") {
                         attrib.name = subdata.properties.at(0).toString();
                     } 
@@ -1074,7 +1132,7 @@ ExtractedMesh extractMesh(const FBXNode& object, unsigned int& meshIndex) {
                 attrib.index = child.properties.at(0).toInt();
                 foreach (const FBXNode& subdata, child.children) {
                     if (subdata.name == "UV") {
-                        attrib.texCoords = createVec2Vector(getDoubleVector(subdata));
+                        attrib.texCoords = getVec2Vector(subdata);
                     } else if (subdata.name == "UVIndex") {
                         attrib.texCoordIndices = getIntVector(subdata);
                     } else if  (subdata.name == "Name") {
@@ -1130,6 +1188,9 @@ ExtractedMesh extractMesh(const FBXNode& object, unsigned int& meshIndex) {
         isMultiMaterial = true;
     }
 
+    // most meshes have about one new vertex per original one
+    data.indices.reserve(data.vertices.size());
+
     // convert the polygons to quads and triangles
     int polygonIndex = 0;
     QHash<QPair<int, int>, int> materialTextureParts;
@@ -1175,10 +1236,10 @@ FBXBlendshape extractBlendshape(const FBXNode& object) {
             blendshape.indices = getIntVector(data);
 
         } else if (data.name == "Vertices") {
-            blendshape.vertices = createVec3Vector(getDoubleVector(data));
+            blendshape.vertices = getVec3Vector(data);
 
         } else if (data.name == "Normals") {
-            blendshape.normals = createVec3Vector(getDoubleVector(data));
+            blendshape.normals = getVec3Vector(data);
         }
     }
     return blendshape;
@@ -1197,6 +1258,28 @@ void setTangents(FBXMesh& mesh, int firstIndex, int secondIndex) {
         glm::normalize(bitangent), normalizedNormal);
 }
 
+void generateTangents(FBXMesh& mesh) {
+    mesh.tangents.resize(mesh.vertices.size());
+    foreach (const FBXMeshPart& part, mesh.parts) {
+        for (int i = 0; i < part.quadIndices.size(); i += 4) {
+            setTangents(mesh, part.quadIndices.at(i), part.quadIndices.at(i + 1));
+            setTangents(mesh, part.quadIndices.at(i + 1), part.quadIndices.at(i + 2));
+            setTangents(mesh, part.quadIndices.at(i + 2), part.quadIndices.at(i + 3));
+            setTangents(mesh, part.quadIndices.at(i + 3), part.quadIndices.at(i));
+        }
+        // <= size - 3 in order to prevent overflowing triangleIndices when (i % 3) != 0 
+        // This is most likely evidence of a further problem in extractMesh()
+        for (int i = 0; i <= part.triangleIndices.size() - 3; i += 3) {
+            setTangents(mesh, part.triangleIndices.at(i), part.triangleIndices.at(i + 1));
+            setTangents(mesh, part.triangleIndices.at(i + 1), part.triangleIndices.at(i + 2));
+            setTangents(mesh, part.triangleIndices.at(i + 2), part.triangleIndices.at(i));
+        }
+        if ((part.triangleIndices.size() % 3) != 0){
+            qCDebug(modelformat) << "Error in extractFBXGeometry part.triangleIndices.size() is not divisible by three ";
+        }
+    }
+}
+
 QVector<int> getIndices(const QVector<QString> ids, QVector<QString> modelIDs) {
     QVector<int> indices;
     foreach (const QString& id, ids) {
@@ -1373,21 +1456,22 @@ FBXLight extractLight(const FBXNode& object) {
 
 
 #if USE_MODEL_MESH
-void buildModelMesh(ExtractedMesh& extracted, const QString& url) {
-    static QString repeatedMessage = LogHandler::getInstance().addRepeatedMessageRegex("buildModelMesh failed -- .*");
+// registered before any thread builds meshes: buildModelMesh runs in parallel, and LogHandler doesn't lock its regexes
+static const QString BUILD_MODEL_MESH_FAILED_MESSAGE =
+    LogHandler::getInstance().addRepeatedMessageRegex("buildModelMesh failed -- .*");
 
-    if (extracted.mesh.vertices.size() == 0) {
-        extracted.mesh._mesh = model::Mesh();
+void buildModelMesh(FBXMesh& fbxMesh, const QString& url) {
+    if (fbxMesh.vertices.size() == 0) {
+        fbxMesh._mesh = model::Mesh();
         qCDebug(modelformat) << "buildModelMesh failed -- no vertices, url = " << url;
         return;
     }
-    FBXMesh& fbxMesh = extracted.mesh;
     model::Mesh mesh;
 
     // Grab the vertices in a buffer
     auto vb = make_shared<gpu::Buffer>();
-    vb->setData(extracted.mesh.vertices.size() * sizeof(glm::vec3),
-                (const gpu::Byte*) extracted.mesh.vertices.data());
+    vb->setData(fbxMesh.vertices.size() * sizeof(glm::vec3),
+                (const gpu::Byte*) fbxMesh.vertices.data());
     gpu::BufferView vbv(vb, gpu::Element(gpu::VEC3, gpu::FLOAT, gpu::XYZ));
     mesh.setVertexBuffer(vbv);
 
@@ -1459,12 +1543,12 @@ void buildModelMesh(ExtractedMesh& extracted, const QString& url) {
 
     unsigned int totalIndices = 0;
 
-    foreach(const FBXMeshPart& part, extracted.mesh.parts) {
+    foreach(const FBXMeshPart& part, fbxMesh.parts) {
         totalIndices += (part.quadIndices.size() + part.triangleIndices.size());
     }
 
     if (! totalIndices) {
-        extracted.mesh._mesh = model::Mesh();
+        fbxMesh._mesh = model::Mesh();
         qCDebug(modelformat) << "buildModelMesh failed -- no indices, url = " << url;
         return;
     }
@@ -1477,7 +1561,7 @@ void buildModelMesh(ExtractedMesh& extracted, const QString& url) {
 
     std::vector< model::Mesh::Part > parts;
 
-    foreach(const FBXMeshPart& part, extracted.mesh.parts) {
+    foreach(const FBXMeshPart& part, fbxMesh.parts) {
         model::Mesh::Part quadPart(indexNum, part.quadIndices.size(), 0, model::Mesh::QUADS);
         if (quadPart._numIndices) {
             parts.push_back(quadPart);
@@ -1504,7 +1588,7 @@ void buildModelMesh(ExtractedMesh& extracted, const QString& url) {
         gpu::BufferView pbv(pb, gpu::Element(gpu::VEC4, gpu::UINT32, gpu::XYZW));
         mesh.setPartBuffer(pbv);
     } else {
-        extracted.mesh._mesh = model::Mesh();
+        fbxMesh._mesh = model::Mesh();
         qCDebug(modelformat) << "buildModelMesh failed -- no parts, url = " << url;
         return;
     }
@@ -1512,7 +1596,7 @@ void buildModelMesh(ExtractedMesh& extracted, const QString& url) {
     // model::Box box =
     mesh.evalPartBound(0);
 
-    extracted.mesh._mesh = mesh;
+    fbxMesh._mesh = mesh;
 }
 #endif // USE_MODEL_MESH
 
@@ -1622,6 +1706,13 @@ FBXGeometry* extractFBXGeometry(const FBXNode& node, const QVariantHash& mapping
     glm::vec3 ambientColor;
     QString hifiGlobalNodeID;
     unsigned int meshIndex = 0;
+    class MeshObject {
+    public:
+        QString id;
+        const FBXNode* object;
+        unsigned int meshIndex;
+    };
+    std::vector<MeshObject> meshObjects;
     foreach (const FBXNode& child, node.children) {
     
         if (child.name == "FBXHeaderExtension") {
@@ -1666,7 +1757,11 @@ FBXGeometry* extractFBXGeometry(const FBXNode& node, const QVariantHash& mapping
             foreach (const FBXNode& object, child.children) {
                 if (object.name == "Geometry") {
                     if (object.properties.at(2) == "Mesh") {
-                        meshes.insert(getID(object.properties), extractMesh(object, meshIndex));
+                        // extracted in parallel once all the objects are read
+                        QString meshID = getID(object.properties);
+                        meshes.insert(meshID, ExtractedMesh());
+                        MeshObject meshObject = { meshID, &object, meshIndex++ };
+                        meshObjects.push_back(meshObject);
                     } else { // object.properties.at(2) == "Shape"
                         ExtractedBlendshape extracted = { getID(object.properties), extractBlendshape(object) };
                         blendshapes.append(extracted);
@@ -2191,6 +2286,23 @@ FBXGeometry* extractFBXGeometry(const FBXNode& node, const QVariantHash& mapping
         }
     }
 
+    // the meshes are independent of each other, and their table isn't modified while they're extracted
+    // (when an ID comes back, the last object wins as it did when they were extracted in order)
+    std::vector<ExtractedMesh*> meshTargets(meshObjects.size(), nullptr);
+    QSet<QString> targetedIDs;
+    for (int i = (int)meshObjects.size() - 1; i >= 0; i--) {
+        if (!targetedIDs.contains(meshObjects[i].id)) {
+            targetedIDs.insert(meshObjects[i].id);
+            meshTargets[i] = &meshes[meshObjects[i].id];
+        }
+    }
+    tbb::parallel_for((size_t)0, meshObjects.size(), [&](size_t i) {
+        if (meshTargets[i]) {
+            unsigned int meshIndex = meshObjects[i].meshIndex;
+            *meshTargets[i] = extractMesh(*meshObjects[i].object, meshIndex);
+        }
+    });
+
     // assign the blendshapes to their corresponding meshes
     foreach (const ExtractedBlendshape& extracted, blendshapes) {
         QString blendshapeChannelID = parentMap.value(extracted.id);
@@ -2358,6 +2470,14 @@ FBXGeometry* extractFBXGeometry(const FBXNode& node, const QVariantHash& mapping
     // see if any materials have texture children
     bool materialsHaveTextures = checkMaterialsHaveTextures(materials, textureFilenames, childMap);
 
+    class FinishedMesh {
+    public:
+        ExtractedMesh* extracted;
+        bool generateTangents;
+    };
+    std::vector<FinishedMesh> finishedMeshes;
+    finishedMeshes.reserve(meshes.size());
+
     for (QHash<QString, ExtractedMesh>::iterator it = meshes.begin(); it != meshes.end(); it++) {
         ExtractedMesh& extracted = it.value();
         
@@ -2490,27 +2610,8 @@ FBXGeometry* extractFBXGeometry(const FBXNode& node, const QVariantHash& mapping
         }
 
         // if we have a normal map (and texture coordinates), we must compute tangents
-        if (generateTangents && !extracted.mesh.texCoords.isEmpty()) {
-            extracted.mesh.tangents.resize(extracted.mesh.vertices.size());
-            foreach (const FBXMeshPart& part, extracted.mesh.parts) {
-                for (int i = 0; i < part.quadIndices.size(); i += 4) {
-                    setTangents(extracted.mesh, part.quadIndices.at(i), part.quadIndices.at(i + 1));
-                    setTangents(extracted.mesh, part.quadIndices.at(i + 1), part.quadIndices.at(i + 2));
-                    setTangents(extracted.mesh, part.quadIndices.at(i + 2), part.quadIndices.at(i + 3));
-                    setTangents(extracted.mesh, part.quadIndices.at(i + 3), part.quadIndices.at(i));
-                }
-                // <= size - 3 in order to prevent overflowing triangleIndices when (i % 3) != 0 
-                // This is most likely evidence of a further problem in extractMesh()
-                for (int i = 0; i <= part.triangleIndices.size() - 3; i += 3) {
-                    setTangents(extracted.mesh, part.triangleIndices.at(i), part.triangleIndices.at(i + 1));
-                    setTangents(extracted.mesh, part.triangleIndices.at(i + 1), part.triangleIndices.at(i + 2));
-                    setTangents(extracted.mesh, part.triangleIndices.at(i + 2), part.triangleIndices.at(i));
-                }
-                if ((part.triangleIndices.size() % 3) != 0){
-                    qCDebug(modelformat) << "Error in extractFBXGeometry part.triangleIndices.size() is not divisible by three ";
-                }
-            }
-        }
+        FinishedMesh finished = { &extracted, generateTangents && !extracted.mesh.texCoords.isEmpty() };
+        finishedMeshes.push_back(finished);
 
         // find the clusters with which the mesh is associated
         QVector<QString> clusterIDs;
@@ -2700,10 +2801,6 @@ FBXGeometry* extractFBXGeometry(const FBXNode& node, const QVariantHash& mapping
         }
         extracted.mesh.isEye = (maxJointIndex == geometry.leftEyeJointIndex || maxJointIndex == geometry.rightEyeJointIndex);
 
-#       if USE_MODEL_MESH
-        buildModelMesh(extracted, url);
-#       endif
-        
         if (extracted.mesh.isEye) {
             if (maxJointIndex == geometry.leftEyeJointIndex) {
                 geometry.leftEyeSize = extracted.mesh.meshExtents.largestDimension() * offsetScale;
@@ -2712,11 +2809,25 @@ FBXGeometry* extractFBXGeometry(const FBXNode& node, const QVariantHash& mapping
             }
         }
 
-        geometry.meshes.append(extracted.mesh);
-        int meshIndex = geometry.meshes.size() - 1;
+        int meshIndex = finishedMeshes.size() - 1;
         meshIDsToMeshIndices.insert(it.key(), meshIndex);
     }
 
+    // the tangents and the model meshes only depend on their own mesh
+    tbb::parallel_for((size_t)0, finishedMeshes.size(), [&](size_t i) {
+        ExtractedMesh& extracted = *finishedMeshes[i].extracted;
+        if (finishedMeshes[i].generateTangents) {
+            generateTangents(extracted.mesh);
+        }
+#       if USE_MODEL_MESH
+        buildModelMesh(extracted.mesh, url);
+#       endif
+    });
+    geometry.meshes.reserve(finishedMeshes.size());
+    for (const FinishedMesh& finished : finishedMeshes) {
+        geometry.meshes.append(finished.extracted->mesh);
+    }
+
     // now that all joints have been scanned, compute a radius for each bone
     glm::vec3 defaultCapsuleAxis(0.0f, 1.0f, 0.0f);
     for (int i = 0; i < geometry.joints.size(); ++i) {
@@ -2775,11 +2886,50 @@ FBXGeometry* extractFBXGeometry(const FBXNode& node, const QVariantHash& mapping
 }
 
 FBXGeometry* readFBX(const QByteArray& model, const QVariantHash& mapping, const QString& url, bool loadLightmaps, float lightmapLevel) {
+    if (isBinaryFBX(model.constData(), model.size())) {
+        // the array properties of the nodes point into the model, which outlives them
+        return extractFBXGeometry(parseBinaryFBX(model.constData(), model.size()), mapping, url, loadLightmaps, lightmapLevel);
+    }
     QBuffer buffer(const_cast<QByteArray*>(&model));
     buffer.open(QIODevice::ReadOnly);
-    return readFBX(&buffer, mapping, url, loadLightmaps, lightmapLevel);
+    return extractFBXGeometry(parseFBX(&buffer), mapping, url, loadLightmaps, lightmapLevel);
 }
 
+// Unmaps the file when the geometry is extracted, or when parsing throws
+class FileMapping {
+public:
+    FileMapping(QFile* file) : _file(file), _size(file->size() - file->pos()) {
+        _data = (_size > 0) ? _file->map(_file->pos(), _size) : nullptr;
+    }
+    ~FileMapping() {
+        if (_data) {
+            _file->unmap(_data);
+        }
+    }
+
+    const char* getData() const { return (const char*)_data; }
+    qint64 getSize() const { return _size; }
+
+private:
+    QFile* _file;
+    qint64 _size;
+    uchar* _data;
+};
+
 FBXGeometry* readFBX(QIODevice* device, const QVariantHash& mapping, const QString& url, bool loadLightmaps, float lightmapLevel) {
-    return extractFBXGeometry(parseFBX(device), mapping, url, loadLightmaps, lightmapLevel);
+    const QByteArray BINARY_PROLOG = "Kaydara FBX Binary  ";
+    if (device->peek(BINARY_PROLOG.size()) != BINARY_PROLOG) {
+        return extractFBXGeometry(parseFBX(device), mapping, url, loadLightmaps, lightmapLevel);
+    }
+
+    // map the files, so that only the pages of the arrays that are read get loaded
+    QFile* file = qobject_cast<QFile*>(device);
+    if (file) {
+        FileMapping fileMapping(file);
+        if (fileMapping.getData()) {
+            return extractFBXGeometry(parseBinaryFBX(fileMapping.getData(), fileMapping.getSize()), mapping, url,
+                loadLightmaps, lightmapLevel);
+        }
+    }
+    return readFBX(device->readAll(), mapping, url, loadLightmaps, lightmapLevel);
 }
@@ -277,6 +277,20 @@ public:
 
 Q_DECLARE_METATYPE(FBXGeometry)
 
+/// Parses the node tree of an FBX document with the stream parser, which reads the binary arrays into QVariants.
+/// readFBX only uses it for the text documents.
+/// \exception QString if an error occurs in parsing
+FBXNode parseFBX(QIODevice* device);
+
+/// Extracts FBX geometry from the node tree of a parsed document.
+FBXGeometry* extractFBXGeometry(const FBXNode& node, const QVariantHash& mapping, const QString& url = "",
+    bool loadLightmaps = true, float lightmapLevel = 1.0f);
+
+#if USE_MODEL_MESH
+/// Builds the model mesh (the GPU buffers) of a mesh from its vertex and index data.
+void buildModelMesh(FBXMesh& mesh, const QString& url);
+#endif
+
 /// Reads FBX geometry from the supplied model and mapping data.
 /// \exception QString if an error occurs in parsing
 FBXGeometry* readFBX(const QByteArray& model, const QVariantHash& mapping, const QString& url = "", bool loadLightmaps = true, float lightmapLevel = 1.0f);
@@ -0,0 +1,114 @@
+//
+//  VertexIndexTable.h
+//  libraries/fbx/src
+//
+//  Copyright 2015 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_VertexIndexTable_h
+#define hifi_VertexIndexTable_h
+
+#include <algorithm>
+#include <cstring>
+#include <vector>
+
+#include <QtGlobal>
+
+#include <glm/glm.hpp>
+
+/// A vertex of an FBX mesh before deduplication: the vertices of a polygon that share their original index and texture
+/// coordinates become one vertex of the extracted mesh.
+class Vertex {
+public:
+    int originalIndex;
+    glm::vec2 texCoord;
+    glm::vec2 texCoord1;
+};
+
+inline bool operator==(const Vertex& v1, const Vertex& v2) {
+    return v1.originalIndex == v2.originalIndex && v1.texCoord == v2.texCoord && v1.texCoord1 == v2.texCoord1;
+}
+
+/// Maps the vertices of a mesh to their new indices with open addressing: the entries sit in one array, and a lookup is a
+/// short linear probe through it rather than a walk through the nodes of a QHash bucket.
+class VertexIndexTable {
+public:
+    void reserve(int count) {
+        if (count * 2 > (int)_entries.size()) {
+            rehash(count * 2);
+        }
+    }
+
+    /// Returns the index of the vertex if it is in the table, or inserts it with newIndex and returns newIndex
+    int insert(const Vertex& vertex, int newIndex) {
+        if ((_size + 1) * 2 > (int)_entries.size()) {
+            rehash(std::max((int)_entries.size() * 2, MIN_CAPACITY));
+        }
+        for (uint i = hash(vertex) & _mask;; i = (i + 1) & _mask) {
+            Entry& entry = _entries[i];
+            if (entry.index == -1) {
+                entry.vertex = vertex;
+                entry.index = newIndex;
+                _size++;
+                return newIndex;
+            }
+            if (entry.vertex == vertex) {
+                return entry.index;
+            }
+        }
+    }
+
+private:
+    static const int MIN_CAPACITY = 64;
+
+    class Entry {
+    public:
+        Vertex vertex;
+        int index = -1;
+    };
+
+    static uint hashFloat(float value) {
+        value += 0.0f; // -0.0f equals 0.0f, and so needs the same bits
+        quint32 bits;
+        memcpy(&bits, &value, sizeof(bits));
+        return bits;
+    }
+
+    static uint hash(const Vertex& vertex) {
+        // the texture coordinates only differ at the seams, so most of the spread comes from the original index
+        uint hash = (uint)vertex.originalIndex * 0x9E3779B1u;
+        hash ^= (hashFloat(vertex.texCoord.s) + 0x7F4A7C15u + (hash << 6) + (hash >> 2));
+        hash ^= (hashFloat(vertex.texCoord.t) + 0x7F4A7C15u + (hash << 6) + (hash >> 2));
+        hash ^= (hashFloat(vertex.texCoord1.s) + 0x7F4A7C15u + (hash << 6) + (hash >> 2));
+        hash ^= (hashFloat(vertex.texCoord1.t) + 0x7F4A7C15u + (hash << 6) + (hash >> 2));
+        return hash ^ (hash >> 16);
+    }
+
+    void rehash(int minCapacity) {
+        int capacity = MIN_CAPACITY;
+        while (capacity < minCapacity) {
+            capacity *= 2;
+        }
+        std::vector<Entry> entries(capacity);
+        _entries.swap(entries);
+        _mask = capacity - 1;
+        for (const Entry& entry : entries) {
+            if (entry.index != -1) {
+                uint i = hash(entry.vertex) & _mask;
+                while (_entries[i].index != -1) {
+                    i = (i + 1) & _mask;
+                }
+                _entries[i] = entry;
+            }
+        }
+    }
+
+    std::vector<Entry> _entries;
+    int _size = 0;
+    uint _mask = 0;
+};
+
+#endif // hifi_VertexIndexTable_h
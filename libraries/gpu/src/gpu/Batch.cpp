@@ -55,6 +55,106 @@ void Batch::clear() {
     _transforms.clear();
     _pipelines.clear();
     _framebuffers.clear();
+    _namedData.clear();
+    _namedCallsFlushed = false;
+}
+
+void Batch::append(const Batch& batch) {
+    // the other batch drew its instances in the middle of its commands, the instances gathered so far in this batch come
+    // before them
+    if (batch._namedCallsFlushed) {
+        flushNamedCalls();
+    }
+
+    uint32 paramsOffset = _params.size();
+    uint32 dataOffset = _data.size();
+    uint32 buffersOffset = _buffers.size();
+    uint32 texturesOffset = _textures.size();
+    uint32 streamFormatsOffset = _streamFormats.size();
+    uint32 transformsOffset = _transforms.size();
+    uint32 pipelinesOffset = _pipelines.size();
+    uint32 framebuffersOffset = _framebuffers.size();
+    uint32 queriesOffset = _queries.size();
+
+    _params.insert(_params.end(), batch._params.begin(), batch._params.end());
+    _data.insert(_data.end(), batch._data.begin(), batch._data.end());
+    _buffers.append(batch._buffers);
+    _textures.append(batch._textures);
+    _streamFormats.append(batch._streamFormats);
+    _transforms.append(batch._transforms);
+    _pipelines.append(batch._pipelines);
+    _framebuffers.append(batch._framebuffers);
+    _queries.append(batch._queries);
+
+    // the instances of the other batch come after the ones of this batch, as if they had been recorded here
+    for (auto& namedData : batch._namedData) {
+        const auto& instanceName = namedData.first;
+        const NamedBatchData& data = namedData.second;
+        for (size_t i = 0; i < data._buffers.size(); i++) {
+            if (data._buffers[i]) {
+                getNamedBuffer(instanceName, (uint8)i)->append(data._buffers[i]->getSize(), data._buffers[i]->getData());
+            }
+        }
+        setupNamedCalls(instanceName, data._count, data._function);
+    }
+
+    _commands.reserve(_commands.size() + batch._commands.size());
+    _commandOffsets.reserve(_commandOffsets.size() + batch._commandOffsets.size());
+
+    for (size_t i = 0; i < batch._commands.size(); i++) {
+        Command command = batch._commands[i];
+        uint32 offset = batch._commandOffsets[i] + paramsOffset;
+        _commands.push_back(command);
+        _commandOffsets.push_back(offset);
+
+        // the params referencing a cache or the data, at the positions the recording functions push them
+        Param* params = _params.data() + offset;
+        switch (command) {
+            case COMMAND_setInputFormat:
+                params[0]._uint += streamFormatsOffset;
+                break;
+            case COMMAND_setInputBuffer:
+            case COMMAND_setUniformBuffer:
+                params[2]._uint += buffersOffset;
+                break;
+            case COMMAND_setIndexBuffer:
+                params[1]._uint += buffersOffset;
+                break;
+            case COMMAND_setModelTransform:
+            case COMMAND_setViewTransform:
+                params[0]._uint += transformsOffset;
+                break;
+            case COMMAND_setProjectionTransform:
+            case COMMAND_setViewportTransform:
+            case COMMAND_setStateScissorRect:
+            case COMMAND_glUniform3fv:
+            case COMMAND_glUniform4fv:
+            case COMMAND_glUniform4iv:
+            case COMMAND_glUniformMatrix4fv:
+                params[0]._uint += dataOffset;
+                break;
+            case COMMAND_setPipeline:
+                params[0]._uint += pipelinesOffset;
+                break;
+            case COMMAND_setResourceTexture:
+                params[0]._uint += texturesOffset;
+                break;
+            case COMMAND_setFramebuffer:
+                params[0]._uint += framebuffersOffset;
+                break;
+            case COMMAND_blit:
+                params[0]._uint += framebuffersOffset;
+                params[5]._uint += framebuffersOffset;
+                break;
+            case COMMAND_beginQuery:
+            case COMMAND_endQuery:
+            case COMMAND_getQuery:
+                params[0]._uint += queriesOffset;
+                break;
+            default:
+                break;
+        }
+    }
 }
 
 uint32 Batch::cacheData(uint32 size, const void* data) {
@@ -288,6 +388,35 @@ void Batch::resetStages() {
     ADD_COMMAND(resetStages);
 }
 
+void Batch::setupNamedCalls(const std::string& instanceName, uint32 count, const NamedBatchData::Function& function) {
+    NamedBatchData& instance = _namedData[instanceName];
+    instance._count += count;
+    instance._function = function;
+}
+
+BufferPointer Batch::getNamedBuffer(const std::string& instanceName, uint8 index) {
+    NamedBatchData& instance = _namedData[instanceName];
+    if (instance._buffers.size() <= index) {
+        instance._buffers.resize(index + 1);
+    }
+    if (!instance._buffers[index]) {
+        instance._buffers[index] = std::make_shared<Buffer>();
+    }
+    return instance._buffers[index];
+}
+
+void Batch::flushNamedCalls() {
+    // the functions record in this batch, so they can't run while iterating on its named data
+    NamedBatchDataMap namedData;
+    namedData.swap(_namedData);
+    _namedCallsFlushed = true;
+    for (auto& instance : namedData) {
+        if (instance.second._function && instance.second._count > 0) {
+            instance.second._function(*this, instance.second);
+        }
+    }
+}
+
 void Batch::enableStereo(bool enable) {
     _enableStereo = enable;
 }
@@ -11,6 +11,9 @@
 #ifndef hifi_gpu_Batch_h
 #define hifi_gpu_Batch_h
 
+#include <functional>
+#include <map>
+#include <string>
 #include <vector>
 
 #include "Framebuffer.h"
@@ -47,6 +50,11 @@ public:
     ~Batch();
 
     void clear();
+
+    // Append the commands of another batch, as if they had been recorded after the ones of this batch.
+    // The references of the commands to the object caches and data of the other batch are rebased on the way.
+    // The stereo and skybox settings of this batch are kept.
+    void append(const Batch& batch);
     
     // Batches may need to override the context level stereo settings
     // if they're performing framebuffer copy operations, like the 
@@ -132,6 +140,28 @@ public:
     // Reset the stage caches and states
     void resetStages();
 
+    // Named calls gather the instances of a shape drawn many times in the batch: every instance appends its data to
+    // the named buffers of the call, and the function of the call draws all of them at once when the calls are flushed.
+    // The calls are flushed when the batch is rendered, or earlier by calling flushNamedCalls, for instance before a
+    // draw that blends with the instances recorded ahead of it
+    class NamedBatchData {
+    public:
+        typedef std::vector<BufferPointer> BufferPointers;
+        typedef std::function<void(Batch&, NamedBatchData&)> Function;
+
+        BufferPointers _buffers;
+        uint32 _count = 0;
+        Function _function;
+    };
+    typedef std::map<std::string, NamedBatchData> NamedBatchDataMap;
+
+    // Count more instances for the named call, to be drawn by the function
+    void setupNamedCalls(const std::string& instanceName, uint32 count, const NamedBatchData::Function& function);
+    BufferPointer getNamedBuffer(const std::string& instanceName, uint8 index = 0);
+
+    // Record the draws of the named calls in the order of their names, and forget them
+    void flushNamedCalls();
+
     // TODO: As long as we have gl calls explicitely issued from interface
     // code, we need to be able to record and batch these calls. THe long 
     // term strategy is to get rid of any GL calls in favor of the HIFI GPU API
@@ -253,6 +283,12 @@ public:
             void clear() {
                 _items.clear();
             }
+
+            uint32 size() const { return (uint32)_items.size(); }
+
+            void append(const Vector& other) {
+                _items.insert(_items.end(), other._items.begin(), other._items.end());
+            }
         };
     };
 
@@ -289,6 +325,9 @@ public:
     FramebufferCaches _framebuffers;
     QueryCaches _queries;
 
+    NamedBatchDataMap _namedData;
+    bool _namedCallsFlushed{ false }; // when appended, the named calls of the batch appended to are flushed first
+
     bool _enableStereo{ true };
     bool _enableSkybox{ false };
 
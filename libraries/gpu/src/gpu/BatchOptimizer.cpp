@@ -0,0 +1,267 @@
+//
+//  BatchOptimizer.cpp
+//  libraries/gpu/src/gpu
+//
+//  Copyright 2015 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+#include "BatchOptimizer.h"
+
+#include <unordered_map>
+
+#include "GPUConfig.h"
+
+using namespace gpu;
+
+int BatchOptimizer::Stats::getNumRemovedCommands() const {
+    return _numRemovedPipelines + _numRemovedInputFormats + _numRemovedInputBuffers + _numRemovedUniformBuffers +
+        _numRemovedResourceTextures + _numCoalescedDraws;
+}
+
+BatchOptimizer::Stats& BatchOptimizer::Stats::operator+=(const Stats& other) {
+    _numRemovedPipelines += other._numRemovedPipelines;
+    _numRemovedInputFormats += other._numRemovedInputFormats;
+    _numRemovedInputBuffers += other._numRemovedInputBuffers;
+    _numRemovedUniformBuffers += other._numRemovedUniformBuffers;
+    _numRemovedResourceTextures += other._numRemovedResourceTextures;
+    _numCoalescedDraws += other._numCoalescedDraws;
+    return (*this);
+}
+
+// The objects are compared by address, the batch holds them for the whole pass
+template <typename T>
+static const void* objectAt(const typename Batch::Cache<T>::Vector& caches, uint32 offset) {
+    return (offset < caches._items.size()) ? caches._items[offset]._data.get() : nullptr;
+}
+
+// A state of the backend, as set by the commands of the batch seen so far
+template <typename T>
+class KnownState {
+public:
+    bool _isKnown = false;
+    T _value;
+
+    // returns false if the state is already set to this value
+    bool set(const T& value) {
+        if (_isKnown && _value == value) {
+            return false;
+        }
+        _isKnown = true;
+        _value = value;
+        return true;
+    }
+};
+
+template <typename T>
+class KnownSlots {
+public:
+    std::vector<KnownState<T>> _slots;
+
+    bool set(uint32 slot, const T& value) {
+        if (slot >= _slots.size()) {
+            _slots.resize(slot + 1);
+        }
+        return _slots[slot].set(value);
+    }
+
+    void clear() { _slots.clear(); }
+};
+
+class BufferBinding {
+public:
+    const void* _buffer = nullptr;
+    uint32 _offset = 0;
+    uint32 _size = 0;
+
+    bool operator==(const BufferBinding& other) const {
+        return _buffer == other._buffer && _offset == other._offset && _size == other._size;
+    }
+};
+
+class DrawCall {
+public:
+    uint32 _primitive = 0;
+    uint32 _numVertices = 0;
+    uint32 _startVertex = 0;
+    uint32 _startInstance = 0;
+    uint32 _numInstances = 1;
+
+    bool isSameDraw(const DrawCall& other) const {
+        return _primitive == other._primitive && _numVertices == other._numVertices &&
+            _startVertex == other._startVertex && _startInstance == other._startInstance;
+    }
+};
+
+static DrawCall getDrawCall(const Batch& batch, Batch::Command command, uint32 paramOffset) {
+    const Batch::Param* params = batch._params.data() + paramOffset;
+    DrawCall draw;
+    if (command == Batch::COMMAND_draw) {
+        draw._startVertex = params[0]._uint;
+        draw._numVertices = params[1]._uint;
+        draw._primitive = params[2]._uint;
+    } else {
+        draw._startInstance = params[0]._uint;
+        draw._startVertex = params[1]._uint;
+        draw._numVertices = params[2]._uint;
+        draw._primitive = params[3]._uint;
+        draw._numInstances = params[4]._uint;
+    }
+    return draw;
+}
+
+// Instances of a draw are only the same as repeated draws if the shaders can't tell them apart
+static bool canInstance(const Pipeline* pipeline) {
+    if (!pipeline || !pipeline->getProgram()) {
+        return false;
+    }
+    const auto& program = pipeline->getProgram();
+    Shader::Shaders shaders = program->isProgram() ? program->getShaders() : Shader::Shaders(1, program);
+    for (auto& shader : shaders) {
+        if (!shader || shader->getSource().getCode().find("gl_InstanceID") != std::string::npos) {
+            return false;
+        }
+    }
+    return true;
+}
+
+BatchOptimizer::Stats BatchOptimizer::optimize(Batch& batch) {
+    Stats stats;
+
+    KnownState<const void*> pipeline;
+    KnownState<const void*> inputFormat;
+    KnownSlots<BufferBinding> inputBuffers;
+    KnownSlots<BufferBinding> uniformBuffers;
+    KnownSlots<const void*> resourceTextures;
+    std::unordered_map<const void*, bool> instancingPipelines;
+
+    Batch::Commands commands;
+    Batch::CommandOffsets commandOffsets;
+    commands.reserve(batch._commands.size());
+    commandOffsets.reserve(batch._commandOffsets.size());
+
+    // the kept draw that the next command could be merged with, if no other command was kept since
+    int lastDraw = -1;
+
+    for (size_t i = 0; i < batch._commands.size(); i++) {
+        Batch::Command command = batch._commands[i];
+        uint32 paramOffset = batch._commandOffsets[i];
+        const Batch::Param* params = batch._params.data() + paramOffset;
+        bool keep = true;
+
+        switch (command) {
+            case Batch::COMMAND_setPipeline: {
+                keep = pipeline.set(objectAt<PipelinePointer>(batch._pipelines, params[0]._uint));
+                if (!keep) {
+                    stats._numRemovedPipelines++;
+                }
+#if (GPU_FEATURE_PROFILE != GPU_CORE)
+                // without uniform buffer objects, the backend uploads the uniform buffers to the bound program
+                if (keep) {
+                    uniformBuffers.clear();
+                }
+#endif
+                break;
+            }
+            case Batch::COMMAND_setInputFormat: {
+                keep = inputFormat.set(objectAt<Stream::FormatPointer>(batch._streamFormats, params[0]._uint));
+                if (!keep) {
+                    stats._numRemovedInputFormats++;
+                }
+                break;
+            }
+            case Batch::COMMAND_setInputBuffer: {
+                BufferBinding binding;
+                binding._size = params[0]._uint;
+                binding._offset = params[1]._uint;
+                binding._buffer = objectAt<BufferPointer>(batch._buffers, params[2]._uint);
+                keep = inputBuffers.set(params[3]._uint, binding);
+                if (!keep) {
+                    stats._numRemovedInputBuffers++;
+                }
+                break;
+            }
+            case Batch::COMMAND_setUniformBuffer: {
+                BufferBinding binding;
+                binding._size = params[0]._uint;
+                binding._offset = params[1]._uint;
+                binding._buffer = objectAt<BufferPointer>(batch._buffers, params[2]._uint);
+                keep = uniformBuffers.set(params[3]._uint, binding);
+                if (!keep) {
+                    stats._numRemovedUniformBuffers++;
+                }
+                break;
+            }
+            case Batch::COMMAND_setResourceTexture: {
+                keep = resourceTextures.set(params[1]._uint, objectAt<TexturePointer>(batch._textures, params[0]._uint));
+                if (!keep) {
+                    stats._numRemovedResourceTextures++;
+                }
+                break;
+            }
+            case Batch::COMMAND_resetStages: {
+                pipeline = KnownState<const void*>();
+                inputFormat = KnownState<const void*>();
+                inputBuffers.clear();
+                uniformBuffers.clear();
+                resourceTextures.clear();
+                break;
+            }
+            case Batch::COMMAND_glActiveBindTexture: {
+                // binds behind the back of the backend texture cache
+                resourceTextures.clear();
+                break;
+            }
+            case Batch::COMMAND_draw:
+            case Batch::COMMAND_drawInstanced: {
+                if (lastDraw < 0 || !pipeline._isKnown) {
+                    break;
+                }
+                DrawCall draw = getDrawCall(batch, command, paramOffset);
+                DrawCall previous = getDrawCall(batch, commands[lastDraw], commandOffsets[lastDraw]);
+                if (!draw.isSameDraw(previous)) {
+                    break;
+                }
+                auto instancing = instancingPipelines.find(pipeline._value);
+                if (instancing == instancingPipelines.end()) {
+                    instancing = instancingPipelines.emplace(pipeline._value,
+                        canInstance(static_cast<const Pipeline*>(pipeline._value))).first;
+                }
+                if (!instancing->second) {
+                    break;
+                }
+
+                uint32 numInstances = previous._numInstances + draw._numInstances;
+                if (commands[lastDraw] == Batch::COMMAND_draw) {
+                    // the params of the draw are too short, the instanced draw gets new ones
+                    commands[lastDraw] = Batch::COMMAND_drawInstanced;
+                    commandOffsets[lastDraw] = batch._params.size();
+                    batch._params.push_back(previous._startInstance);
+                    batch._params.push_back(previous._startVertex);
+                    batch._params.push_back(previous._numVertices);
+                    batch._params.push_back(previous._primitive);
+                    batch._params.push_back(numInstances);
+                } else {
+                    batch._params[commandOffsets[lastDraw] + 4]._uint = numInstances;
+                }
+                stats._numCoalescedDraws++;
+                keep = false;
+                break;
+            }
+            default:
+                break;
+        }
+
+        if (keep) {
+            bool isDraw = (command == Batch::COMMAND_draw || command == Batch::COMMAND_drawInstanced);
+            lastDraw = isDraw ? (int)commands.size() : -1;
+            commands.push_back(command);
+            commandOffsets.push_back(paramOffset);
+        }
+    }
+
+    batch._commands.swap(commands);
+    batch._commandOffsets.swap(commandOffsets);
+    return stats;
+}
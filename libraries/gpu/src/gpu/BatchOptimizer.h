@@ -0,0 +1,46 @@
+//
+//  BatchOptimizer.h
+//  libraries/gpu/src/gpu
+//
+//  Copyright 2015 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+#ifndef hifi_gpu_BatchOptimizer_h
+#define hifi_gpu_BatchOptimizer_h
+
+#include "Batch.h"
+
+namespace gpu {
+
+// Rewrites the command stream of a recorded Batch before it is submitted:
+// - the setPipeline, setInputFormat, setInputBuffer, setUniformBuffer and setResourceTexture commands setting a state
+//   that the previous commands of the batch already set are dropped,
+// - consecutive identical draws are merged into one drawInstanced, when the bound pipeline doesn't read gl_InstanceID.
+//
+// The state in the backend when the batch starts is unknown, so the first command setting each state is always kept.
+// Only the command list is touched, the caches and data of the batch are left as they are, so the pass only needs the
+// batch and can run on any thread before the batch is rendered.
+class BatchOptimizer {
+public:
+    class Stats {
+    public:
+        int _numRemovedPipelines = 0;
+        int _numRemovedInputFormats = 0;
+        int _numRemovedInputBuffers = 0;
+        int _numRemovedUniformBuffers = 0;
+        int _numRemovedResourceTextures = 0;
+        int _numCoalescedDraws = 0;
+
+        int getNumRemovedCommands() const;
+
+        Stats& operator+=(const Stats& other);
+    };
+
+    static Stats optimize(Batch& batch);
+};
+
+};
+
+#endif
@@ -37,6 +37,7 @@ bool Context::makeProgram(Shader& shader, const Shader::BindingSet& bindings) {
 
 void Context::render(Batch& batch) {
     PROFILE_RANGE(__FUNCTION__);
+    batch.flushNamedCalls();
     _backend->render(batch);
 }
 
@@ -154,6 +154,10 @@ enum Semantic {
     SRGBA,
     SBGRA,
 
+    // Block compressed color, 4x4 texels per block
+    COMPRESSED_BC1, // 8 bytes per block of RGB, aka DXT1
+    COMPRESSED_BC3, // 16 bytes per block of RGBA, aka DXT5
+
     UNIFORM,
     UNIFORM_BUFFER,
     SAMPLER,
@@ -191,6 +195,11 @@ public:
 
     uint32 getSize() const { return DIMENSION_COUNT[_dimension] * TYPE_SIZE[_type]; }
 
+    // The compressed formats are sized by blocks of COMPRESSED_BLOCK_DIM x COMPRESSED_BLOCK_DIM texels, not by texels
+    bool isCompressed() const { return (getSemantic() == COMPRESSED_BC1) || (getSemantic() == COMPRESSED_BC3); }
+    uint32 getCompressedBlockSize() const { return (getSemantic() == COMPRESSED_BC1) ? 8 : 16; }
+    static const uint32 COMPRESSED_BLOCK_DIM = 4;
+
     uint16 getRaw() const { return *((uint16*) (this)); }
 
     
@@ -107,6 +107,7 @@ void GLBackend::updateInput() {
                     _elementTypeToGLType[attrib._element.getType()],
                     attrib._element.isNormalized(),
                     attrib._offset);
+                glVertexAttribDivisor(attrib._slot, attrib._frequency);
             }
             (void) CHECK_GL_ERROR();
         }
@@ -218,6 +219,8 @@ void GLBackend::updateInput() {
 
                             glVertexAttribPointer(slot, count, type, isNormalized, stride,
                                                       reinterpret_cast<GLvoid*>(pointer));
+                            // per instance attributes advance once per instance
+                            glVertexAttribDivisor(slot, attrib._frequency);
 
                             // TODO: Support properly the IAttrib version
 
@@ -247,6 +250,7 @@ void GLBackend::resetInputStage() {
     for (uint32_t i = 0; i < _input._attributeActivation.size(); i++) {
         glDisableVertexAttribArray(i);
         glVertexAttribPointer(i, 4, GL_FLOAT, GL_FALSE, 0, 0);
+        glVertexAttribDivisor(i, 0);
     }
 
     // Reset vertex buffer and format
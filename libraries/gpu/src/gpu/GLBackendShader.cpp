@@ -75,6 +75,21 @@ void makeBindings(GLBackend::GLShader* shader) {
         glBindAttribLocation(glprogram, gpu::Stream::SKIN_CLUSTER_WEIGHT, "inSkinClusterWeight");
     }
 
+    loc = glGetAttribLocation(glprogram, "inInstanceXfm");
+    if (loc >= 0 && loc != gpu::Stream::INSTANCE_XFM) {
+        glBindAttribLocation(glprogram, gpu::Stream::INSTANCE_XFM, "inInstanceXfm");
+    }
+
+    loc = glGetAttribLocation(glprogram, "inInstanceScale");
+    if (loc >= 0 && loc != gpu::Stream::INSTANCE_SCALE) {
+        glBindAttribLocation(glprogram, gpu::Stream::INSTANCE_SCALE, "inInstanceScale");
+    }
+
+    loc = glGetAttribLocation(glprogram, "inInstanceTranslate");
+    if (loc >= 0 && loc != gpu::Stream::INSTANCE_TRANSLATE) {
+        glBindAttribLocation(glprogram, gpu::Stream::INSTANCE_TRANSLATE, "inInstanceTranslate");
+    }
+
     // Link again to take into account the assigned attrib location
     glLinkProgram(glprogram);
 
@@ -34,6 +34,14 @@ public:
     GLenum type;
 
     static GLTexelFormat evalGLTexelFormat(const Element& dstFormat, const Element& srcFormat) {
+        if (dstFormat.isCompressed()) {
+            // The compressed mips are uploaded as they are stored, only the internal format matters
+            GLTexelFormat texel = {GL_COMPRESSED_RGBA_S3TC_DXT5_EXT, GL_RGBA, GL_UNSIGNED_BYTE};
+            if (dstFormat.getSemantic() == gpu::COMPRESSED_BC1) {
+                texel.internalFormat = GL_COMPRESSED_RGB_S3TC_DXT1_EXT;
+            }
+            return texel;
+        }
         if (dstFormat != srcFormat) {
             GLTexelFormat texel = {GL_RGBA, GL_RGBA, GL_UNSIGNED_BYTE};
 
@@ -259,6 +267,26 @@ public:
     }
 };
 
+// The compressed textures come with their mip chain, which is uploaded level by level instead of generated
+static void uploadCompressedMips(const Texture& texture) {
+    GLTexelFormat texelFormat = GLTexelFormat::evalGLTexelFormat(texture.getTexelFormat(), texture.getTexelFormat());
+    uint16 maxMip = 0;
+    for (uint16 level = 0; level <= texture.maxMip(); level++) {
+        if (!texture.isStoredMipFaceAvailable(level)) {
+            break;
+        }
+        Texture::PixelsPointer mip = texture.accessStoredMipFace(level);
+        glCompressedTexImage2D(GL_TEXTURE_2D, level, texelFormat.internalFormat,
+            texture.evalMipWidth(level), texture.evalMipHeight(level), 0,
+            (GLsizei) mip->_sysmem.getSize(), mip->_sysmem.read<Byte>());
+        maxMip = level;
+
+        // At this point the mip pixels have been loaded, we can notify
+        texture.notifyMipFaceGPULoaded(level, 0);
+    }
+    // Don't let the sampler reach for mips that weren't provided
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, maxMip);
+}
 
 GLBackend::GLTexture* GLBackend::syncGPUObject(const Texture& texture) {
     GLTexture* object = Backend::getGPUObject<GLBackend::GLTexture>(texture);
@@ -295,7 +323,21 @@ GLBackend::GLTexture* GLBackend::syncGPUObject(const Texture& texture) {
             glGetIntegerv(GL_TEXTURE_BINDING_2D, &boundTex);
             glBindTexture(GL_TEXTURE_2D, object->_texture);
 
-            if (needUpdate) {
+            if (texture.getTexelFormat().isCompressed()) {
+                // Compressed storage is always respecified along with its content
+                if (texture.isStoredMipFaceAvailable(0)) {
+                    uploadCompressedMips(texture);
+                }
+
+                object->_target = GL_TEXTURE_2D;
+
+                syncSampler(texture.getSampler(), texture.getType(), object);
+
+                object->_storageStamp = texture.getStamp();
+                object->_contentStamp = texture.getDataStamp();
+                object->_size = texture.getSize();
+
+            } else if (needUpdate) {
                 if (texture.isStoredMipFaceAvailable(0)) {
                     Texture::PixelsPointer mip = texture.accessStoredMipFace(0);
                     const GLvoid* bytes = mip->_sysmem.read<Byte>();
@@ -214,7 +214,7 @@ Texture::Size Texture::resize(Type type, const Element& texelFormat, uint16 widt
         }
         
         // Evaluate the new size with the new format
-        uint32_t size = NUM_FACES_PER_TYPE[_type] *_width * _height * _depth * _numSamples * texelFormat.getSize();
+        uint32_t size = NUM_FACES_PER_TYPE[_type] * _numSamples * evalImageSize(_width, _height, _depth, texelFormat);
 
         // If size change then we need to reset 
         if (changed || (size != getSize())) {
@@ -277,6 +277,15 @@ uint16 Texture::evalNumMips() const {
     return 1 + (uint16) val;
 }
 
+uint32 Texture::evalImageSize(uint16 width, uint16 height, uint16 depth, const Element& format) {
+    if (format.isCompressed()) {
+        const uint32 BLOCK_DIM = Element::COMPRESSED_BLOCK_DIM;
+        uint32 numBlocks = ((width + BLOCK_DIM - 1) / BLOCK_DIM) * ((height + BLOCK_DIM - 1) / BLOCK_DIM) * depth;
+        return numBlocks * format.getCompressedBlockSize();
+    }
+    return width * height * depth * format.getSize();
+}
+
 uint16 Texture::maxMip() const {
     return _maxMip;
 }
@@ -296,6 +305,10 @@ bool Texture::assignStoredMip(uint16 level, const Element& format, Size size, co
     Size expectedSize = evalStoredMipSize(level, format);
     if (size == expectedSize) {
         _storage->assignMipData(level, format, size, bytes);
+        if (!_autoGenerateMips) {
+            // the deepest mip assigned is the max mip
+            _maxMip = std::max(_maxMip, level);
+        }
         _stamp++;
         return true;
     } else if (size > expectedSize) {
@@ -384,7 +397,7 @@ uint32 Texture::getStoredMipNumTexels(uint16 level) const {
 uint32 Texture::getStoredMipSize(uint16 level) const {
     PixelsPointer mipFace = accessStoredMipFace(level);
     if (mipFace && mipFace->_sysmem.getSize()) {
-        return evalMipWidth(level) * evalMipHeight(level) * evalMipDepth(level) * getTexelFormat().getSize();
+        return evalMipFaceSize(level);
     }
     return 0;
 }
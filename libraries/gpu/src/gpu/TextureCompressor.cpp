@@ -0,0 +1,350 @@
+//
+//  TextureCompressor.cpp
+//  libraries/gpu/src/gpu
+//
+//  Copyright 2015 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "TextureCompressor.h"
+
+#include <algorithm>
+#include <climits>
+#include <cmath>
+#include <cstdint>
+
+#include <tbb/parallel_for.h>
+
+using namespace gpu;
+
+// see https://www.opengl.org/registry/specs/EXT/texture_compression_s3tc.txt for the layout of the blocks
+
+static const uint32 BLOCK_DIM = Element::COMPRESSED_BLOCK_DIM;
+static const uint32 TEXELS_PER_BLOCK = BLOCK_DIM * BLOCK_DIM;
+static const uint32 COLOR_BLOCK_SIZE = 8;
+static const uint32 NUM_AXIS_ITERATIONS = 8;
+
+typedef Byte Block[TEXELS_PER_BLOCK][TextureCompressor::RGBA_TEXEL_SIZE];
+
+Element TextureCompressor::getCompressedFormat(bool hasAlpha) {
+    return hasAlpha ? Element(VEC4, NUINT8, COMPRESSED_BC3) : Element(VEC3, NUINT8, COMPRESSED_BC1);
+}
+
+bool TextureCompressor::isCompressible(uint16 width, uint16 height) {
+    return (width > 0) && (height > 0) && (width % BLOCK_DIM == 0) && (height % BLOCK_DIM == 0);
+}
+
+TextureCompressor::MipChain TextureCompressor::generateMips(const Image& image) {
+    MipChain mips;
+    mips.push_back(image);
+    while (mips.back()._width > 1 || mips.back()._height > 1) {
+        const Image& source = mips.back();
+        uint16 width = std::max(source._width / 2, 1);
+        uint16 height = std::max(source._height / 2, 1);
+        Image mip(width, height, width * height * RGBA_TEXEL_SIZE);
+
+        // 2x2 box filter, the odd last row or column of the source being repeated
+        tbb::parallel_for((uint16)0, height, [&](uint16 y) {
+            const Byte* row0 = &source._bytes[std::min(2 * y, source._height - 1) * source._width * RGBA_TEXEL_SIZE];
+            const Byte* row1 = &source._bytes[std::min(2 * y + 1, source._height - 1) * source._width * RGBA_TEXEL_SIZE];
+            Byte* destination = &mip._bytes[y * width * RGBA_TEXEL_SIZE];
+            for (uint16 x = 0; x < width; x++) {
+                uint32 x0 = std::min(2 * x, source._width - 1) * RGBA_TEXEL_SIZE;
+                uint32 x1 = std::min(2 * x + 1, source._width - 1) * RGBA_TEXEL_SIZE;
+                for (uint32 c = 0; c < RGBA_TEXEL_SIZE; c++) {
+                    *destination++ = (Byte)((row0[x0 + c] + row0[x1 + c] + row1[x0 + c] + row1[x1 + c] + 2) / 4);
+                }
+            }
+        });
+        mips.push_back(std::move(mip));
+    }
+    return mips;
+}
+
+// The texels of a block, the edges of the image repeated to fill the blocks that overhang it
+static void loadBlock(const TextureCompressor::Image& image, uint32 blockX, uint32 blockY, Block& block) {
+    for (uint32 y = 0; y < BLOCK_DIM; y++) {
+        uint32 imageY = std::min(blockY * BLOCK_DIM + y, (uint32)image._height - 1);
+        for (uint32 x = 0; x < BLOCK_DIM; x++) {
+            uint32 imageX = std::min(blockX * BLOCK_DIM + x, (uint32)image._width - 1);
+            const Byte* texel = &image._bytes[(imageY * image._width + imageX) * TextureCompressor::RGBA_TEXEL_SIZE];
+            std::copy(texel, texel + TextureCompressor::RGBA_TEXEL_SIZE, block[y * BLOCK_DIM + x]);
+        }
+    }
+}
+
+static uint16 packRGB565(const float color[3]) {
+    uint16 red = (uint16)(color[0] * (31.0f / 255.0f) + 0.5f);
+    uint16 green = (uint16)(color[1] * (63.0f / 255.0f) + 0.5f);
+    uint16 blue = (uint16)(color[2] * (31.0f / 255.0f) + 0.5f);
+    return (red << 11) | (green << 5) | blue;
+}
+
+static void unpackRGB565(uint16 packed, int color[3]) {
+    int red = (packed >> 11) & 0x1F;
+    int green = (packed >> 5) & 0x3F;
+    int blue = packed & 0x1F;
+    color[0] = (red << 3) | (red >> 2);
+    color[1] = (green << 2) | (green >> 4);
+    color[2] = (blue << 3) | (blue >> 2);
+}
+
+static void storeUInt16(Byte* bytes, uint16 value) {
+    bytes[0] = (Byte)value;
+    bytes[1] = (Byte)(value >> 8);
+}
+
+static uint16 loadUInt16(const Byte* bytes) {
+    return bytes[0] | (bytes[1] << 8);
+}
+
+// The four colors of a block, interpolated as the GPU does
+static void evalColorPalette(uint16 color0, uint16 color1, bool hasFourColors, int palette[4][3]) {
+    unpackRGB565(color0, palette[0]);
+    unpackRGB565(color1, palette[1]);
+    for (int c = 0; c < 3; c++) {
+        if (hasFourColors) {
+            palette[2][c] = (2 * palette[0][c] + palette[1][c]) / 3;
+            palette[3][c] = (palette[0][c] + 2 * palette[1][c]) / 3;
+        } else {
+            palette[2][c] = (palette[0][c] + palette[1][c]) / 2;
+            palette[3][c] = 0;
+        }
+    }
+}
+
+// Range fit: the endpoints are the extremes of the texels along their principal axis
+static void compressColorBlock(const Block& block, Byte* bytes) {
+    float mean[3] = { 0.0f, 0.0f, 0.0f };
+    for (uint32 i = 0; i < TEXELS_PER_BLOCK; i++) {
+        for (int c = 0; c < 3; c++) {
+            mean[c] += block[i][c];
+        }
+    }
+    for (int c = 0; c < 3; c++) {
+        mean[c] /= TEXELS_PER_BLOCK;
+    }
+
+    // power iteration from the texel farthest from the mean, which at worst leaves that direction as the axis
+    float covariance[3][3] = { { 0.0f } };
+    float axis[3] = { 0.0f, 0.0f, 0.0f };
+    float maxDistance = 0.0f;
+    for (uint32 i = 0; i < TEXELS_PER_BLOCK; i++) {
+        float delta[3] = { block[i][0] - mean[0], block[i][1] - mean[1], block[i][2] - mean[2] };
+        for (int r = 0; r < 3; r++) {
+            for (int c = 0; c < 3; c++) {
+                covariance[r][c] += delta[r] * delta[c];
+            }
+        }
+        float distance = delta[0] * delta[0] + delta[1] * delta[1] + delta[2] * delta[2];
+        if (distance > maxDistance) {
+            maxDistance = distance;
+            std::copy(delta, delta + 3, axis);
+        }
+    }
+    for (uint32 iteration = 0; iteration < NUM_AXIS_ITERATIONS; iteration++) {
+        float next[3];
+        for (int r = 0; r < 3; r++) {
+            next[r] = covariance[r][0] * axis[0] + covariance[r][1] * axis[1] + covariance[r][2] * axis[2];
+        }
+        float length = std::max(std::max(std::abs(next[0]), std::abs(next[1])), std::abs(next[2]));
+        if (length == 0.0f) {
+            break;
+        }
+        for (int c = 0; c < 3; c++) {
+            axis[c] = next[c] / length;
+        }
+    }
+    float axisLengthSquared = axis[0] * axis[0] + axis[1] * axis[1] + axis[2] * axis[2];
+
+    float minProjection = 0.0f;
+    float maxProjection = 0.0f;
+    if (axisLengthSquared > 0.0f) {
+        for (uint32 i = 0; i < TEXELS_PER_BLOCK; i++) {
+            float projection = ((block[i][0] - mean[0]) * axis[0] + (block[i][1] - mean[1]) * axis[1] +
+                (block[i][2] - mean[2]) * axis[2]) / axisLengthSquared;
+            minProjection = std::min(minProjection, projection);
+            maxProjection = std::max(maxProjection, projection);
+        }
+    }
+    float endpoints[2][3];
+    for (int c = 0; c < 3; c++) {
+        endpoints[0][c] = std::min(std::max(mean[c] + axis[c] * maxProjection, 0.0f), 255.0f);
+        endpoints[1][c] = std::min(std::max(mean[c] + axis[c] * minProjection, 0.0f), 255.0f);
+    }
+    uint16 color0 = packRGB565(endpoints[0]);
+    uint16 color1 = packRGB565(endpoints[1]);
+
+    // color0 > color1 selects the four color mode, and equal endpoints need no indices
+    if (color0 < color1) {
+        std::swap(color0, color1);
+    }
+    storeUInt16(bytes, color0);
+    storeUInt16(bytes + 2, color1);
+
+    uint32 indices = 0;
+    if (color0 != color1) {
+        int palette[4][3];
+        evalColorPalette(color0, color1, true, palette);
+        for (uint32 i = 0; i < TEXELS_PER_BLOCK; i++) {
+            int bestIndex = 0;
+            int bestDistance = INT_MAX;
+            for (int p = 0; p < 4; p++) {
+                int red = block[i][0] - palette[p][0];
+                int green = block[i][1] - palette[p][1];
+                int blue = block[i][2] - palette[p][2];
+                int distance = red * red + green * green + blue * blue;
+                if (distance < bestDistance) {
+                    bestDistance = distance;
+                    bestIndex = p;
+                }
+            }
+            indices |= bestIndex << (2 * i);
+        }
+    }
+    for (int b = 0; b < 4; b++) {
+        bytes[4 + b] = (Byte)(indices >> (8 * b));
+    }
+}
+
+static void evalAlphaPalette(int alpha0, int alpha1, int palette[8]) {
+    palette[0] = alpha0;
+    palette[1] = alpha1;
+    if (alpha0 > alpha1) {
+        for (int code = 2; code < 8; code++) {
+            palette[code] = ((8 - code) * alpha0 + (code - 1) * alpha1) / 7;
+        }
+    } else {
+        for (int code = 2; code < 6; code++) {
+            palette[code] = ((6 - code) * alpha0 + (code - 1) * alpha1) / 5;
+        }
+        palette[6] = 0;
+        palette[7] = 255;
+    }
+}
+
+// The alpha endpoints are the extremes of the block, interpolated in eight steps
+static void compressAlphaBlock(const Block& block, Byte* bytes) {
+    const int ALPHA = 3;
+    int alpha0 = 0;
+    int alpha1 = 255;
+    for (uint32 i = 0; i < TEXELS_PER_BLOCK; i++) {
+        alpha0 = std::max(alpha0, (int)block[i][ALPHA]);
+        alpha1 = std::min(alpha1, (int)block[i][ALPHA]);
+    }
+    bytes[0] = (Byte)alpha0;
+    bytes[1] = (Byte)alpha1;
+
+    uint64_t indices = 0;
+    if (alpha0 != alpha1) {
+        int palette[8];
+        evalAlphaPalette(alpha0, alpha1, palette);
+        for (uint32 i = 0; i < TEXELS_PER_BLOCK; i++) {
+            uint64_t bestIndex = 0;
+            int bestDistance = INT_MAX;
+            for (int p = 0; p < 8; p++) {
+                int distance = std::abs(block[i][ALPHA] - palette[p]);
+                if (distance < bestDistance) {
+                    bestDistance = distance;
+                    bestIndex = p;
+                }
+            }
+            indices |= bestIndex << (3 * i);
+        }
+    }
+    for (int b = 0; b < 6; b++) {
+        bytes[2 + b] = (Byte)(indices >> (8 * b));
+    }
+}
+
+TextureCompressor::Image TextureCompressor::compress(const Image& image, const Element& format) {
+    Image compressed(image._width, image._height, Texture::evalImageSize(image._width, image._height, 1, format));
+    bool hasAlpha = (format.getSemantic() == COMPRESSED_BC3);
+    uint32 blockSize = format.getCompressedBlockSize();
+    uint32 numBlocksX = (image._width + BLOCK_DIM - 1) / BLOCK_DIM;
+    uint32 numBlocksY = (image._height + BLOCK_DIM - 1) / BLOCK_DIM;
+
+    tbb::parallel_for((uint32)0, numBlocksY, [&](uint32 blockY) {
+        Byte* bytes = &compressed._bytes[blockY * numBlocksX * blockSize];
+        Block block;
+        for (uint32 blockX = 0; blockX < numBlocksX; blockX++) {
+            loadBlock(image, blockX, blockY, block);
+            if (hasAlpha) {
+                compressAlphaBlock(block, bytes);
+                compressColorBlock(block, bytes + COLOR_BLOCK_SIZE);
+            } else {
+                compressColorBlock(block, bytes);
+            }
+            bytes += blockSize;
+        }
+    });
+    return compressed;
+}
+
+TextureCompressor::MipChain TextureCompressor::compress(const MipChain& mips, const Element& format) {
+    MipChain compressed(mips.size());
+    // the base level is most of the work, and is itself parallel
+    tbb::parallel_for((size_t)0, mips.size(), [&](size_t level) {
+        compressed[level] = compress(mips[level], format);
+    });
+    return compressed;
+}
+
+TextureCompressor::Image TextureCompressor::decompress(const Image& compressed, const Element& format) {
+    Image image(compressed._width, compressed._height, compressed._width * compressed._height * RGBA_TEXEL_SIZE);
+    bool hasAlpha = (format.getSemantic() == COMPRESSED_BC3);
+    uint32 blockSize = format.getCompressedBlockSize();
+    uint32 numBlocksX = (compressed._width + BLOCK_DIM - 1) / BLOCK_DIM;
+    uint32 numBlocksY = (compressed._height + BLOCK_DIM - 1) / BLOCK_DIM;
+
+    for (uint32 blockY = 0; blockY < numBlocksY; blockY++) {
+        for (uint32 blockX = 0; blockX < numBlocksX; blockX++) {
+            const Byte* bytes = &compressed._bytes[(blockY * numBlocksX + blockX) * blockSize];
+            int alphas[8];
+            uint64_t alphaIndices = 0;
+            if (hasAlpha) {
+                evalAlphaPalette(bytes[0], bytes[1], alphas);
+                for (int b = 0; b < 6; b++) {
+                    alphaIndices |= (uint64_t)bytes[2 + b] << (8 * b);
+                }
+                bytes += COLOR_BLOCK_SIZE;
+            }
+            uint16 color0 = loadUInt16(bytes);
+            uint16 color1 = loadUInt16(bytes + 2);
+            uint32 indices = bytes[4] | (bytes[5] << 8) | (bytes[6] << 16) | ((uint32)bytes[7] << 24);
+
+            // the color blocks of BC3 always have four colors
+            int palette[4][3];
+            evalColorPalette(color0, color1, hasAlpha || color0 > color1, palette);
+
+            for (uint32 i = 0; i < TEXELS_PER_BLOCK; i++) {
+                uint32 x = blockX * BLOCK_DIM + i % BLOCK_DIM;
+                uint32 y = blockY * BLOCK_DIM + i / BLOCK_DIM;
+                if (x >= compressed._width || y >= compressed._height) {
+                    continue;
+                }
+                Byte* texel = &image._bytes[(y * compressed._width + x) * RGBA_TEXEL_SIZE];
+                const int* color = palette[(indices >> (2 * i)) & 0x3];
+                texel[0] = (Byte)color[0];
+                texel[1] = (Byte)color[1];
+                texel[2] = (Byte)color[2];
+                texel[3] = hasAlpha ? (Byte)alphas[(alphaIndices >> (3 * i)) & 0x7] : 255;
+            }
+        }
+    }
+    return image;
+}
+
+Texture* TextureCompressor::createTexture(const MipChain& compressedMips, const Element& format, const Sampler& sampler) {
+    if (compressedMips.empty()) {
+        return nullptr;
+    }
+    Texture* texture = Texture::create2D(format, compressedMips[0]._width, compressedMips[0]._height, sampler);
+    for (uint16 level = 0; level < compressedMips.size(); level++) {
+        const Image& mip = compressedMips[level];
+        texture->assignStoredMip(level, format, (Texture::Size)mip._bytes.size(), mip._bytes.data());
+    }
+    return texture;
+}
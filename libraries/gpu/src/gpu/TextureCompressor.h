@@ -0,0 +1,60 @@
+//
+//  TextureCompressor.h
+//  libraries/gpu/src/gpu
+//
+//  Copyright 2015 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_gpu_TextureCompressor_h
+#define hifi_gpu_TextureCompressor_h
+
+#include <vector>
+
+#include "Texture.h"
+
+namespace gpu {
+
+// CPU side preparation of the textures: the mip chain of an image, and its block compression into
+// the BC1 (DXT1) format for opaque images or the BC3 (DXT5) format for images with alpha.
+// The images are 8 bit RGBA, R first in memory, with tightly packed rows.
+class TextureCompressor {
+public:
+    class Image {
+    public:
+        Image() {}
+        Image(uint16 width, uint16 height, uint32 size) : _width(width), _height(height), _bytes(size) {}
+
+        uint16 _width = 0;
+        uint16 _height = 0;
+        std::vector<Byte> _bytes;
+    };
+    typedef std::vector<Image> MipChain;
+
+    static const uint32 RGBA_TEXEL_SIZE = 4;
+
+    // The format of the image compressed, BC3 if it has alpha, BC1 otherwise
+    static Element getCompressedFormat(bool hasAlpha);
+
+    // The block compressed formats are uploaded in whole blocks, so the base level needs dimensions in blocks
+    static bool isCompressible(uint16 width, uint16 height);
+
+    // The mips of the image down to 1x1, the image included, each level box filtered from the previous one
+    static MipChain generateMips(const Image& image);
+
+    // Compresses the image in the format, the blocks being spread over the worker threads
+    static Image compress(const Image& image, const Element& format);
+    static MipChain compress(const MipChain& mips, const Element& format);
+
+    // Back to RGBA, as the GPU would sample it
+    static Image decompress(const Image& compressed, const Element& format);
+
+    // A 2D texture of the compressed mips, with its mips as they are
+    static Texture* createTexture(const MipChain& compressedMips, const Element& format, const Sampler& sampler = Sampler());
+};
+
+};
+
+#endif
@@ -0,0 +1,86 @@
+//
+//  CachedReply.cpp
+//  libraries/networking/src
+//
+//  Copyright 2015 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include <algorithm>
+#include <cstring>
+
+#include <QNetworkAccessManager>
+#include <QThreadPool>
+
+#include "CachedReply.h"
+
+CachedReply::CachedReply(const QNetworkRequest& request, const QSharedPointer<ResourceDiskCache>& diskCache) {
+    setRequest(request);
+    setUrl(request.url());
+    setOperation(QNetworkAccessManager::GetOperation);
+    open(QIODevice::ReadOnly);
+
+    // the reader goes away with its signal, and the signal with this reply if it goes first
+    CachedContentReader* reader = new CachedContentReader(diskCache, request.url());
+    connect(reader, &CachedContentReader::loaded, this, &CachedReply::setContent);
+    QThreadPool::globalInstance()->start(reader);
+}
+
+void CachedReply::abort() {
+    close();
+}
+
+qint64 CachedReply::bytesAvailable() const {
+    return _data.size() - _offset + QIODevice::bytesAvailable();
+}
+
+qint64 CachedReply::readData(char* data, qint64 maxSize) {
+    qint64 size = std::min(maxSize, _data.size() - _offset);
+    memcpy(data, _data.constData() + _offset, size);
+    _offset += size;
+    return size;
+}
+
+void CachedReply::setContent(bool success, const QByteArray& data, const QByteArray& contentType, const QByteArray& etag,
+                             const QByteArray& lastModified) {
+    if (!isOpen()) {
+        return;
+    }
+    if (success) {
+        const int HTTP_OK = 200;
+        _data = data;
+        setAttribute(QNetworkRequest::HttpStatusCodeAttribute, HTTP_OK);
+        setAttribute(QNetworkRequest::SourceIsFromCacheAttribute, true);
+        setHeader(QNetworkRequest::ContentLengthHeader, _data.size());
+        if (!contentType.isEmpty()) {
+            setRawHeader("Content-Type", contentType);
+        }
+        if (!etag.isEmpty()) {
+            setRawHeader("ETag", etag);
+        }
+        if (!lastModified.isEmpty()) {
+            setRawHeader("Last-Modified", lastModified);
+        }
+        emit downloadProgress(_data.size(), _data.size());
+        emit readyRead();
+
+    } else {
+        setError(QNetworkReply::ContentNotFoundError, "No cached content for " + url().toDisplayString());
+        emit error(QNetworkReply::ContentNotFoundError);
+    }
+    setFinished(true);
+    emit finished();
+}
+
+CachedContentReader::CachedContentReader(const QSharedPointer<ResourceDiskCache>& diskCache, const QUrl& url) :
+    _diskCache(diskCache),
+    _url(url) {
+}
+
+void CachedContentReader::run() {
+    ResourceDiskCache::Content content;
+    bool success = _diskCache->loadContent(_url, content);
+    emit loaded(success, content.data, content.contentType, content.etag, content.lastModified);
+}
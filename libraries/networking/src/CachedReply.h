@@ -0,0 +1,61 @@
+//
+//  CachedReply.h
+//  libraries/networking/src
+//
+//  Copyright 2015 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_CachedReply_h
+#define hifi_CachedReply_h
+
+#include <QNetworkReply>
+#include <QRunnable>
+#include <QSharedPointer>
+
+#include "ResourceDiskCache.h"
+
+/// A reply with the content the disk cache has for the URL of the request, read on the thread pool. It finishes like a
+/// download does, with the headers of the download, or fails with ContentNotFoundError if the content can't be read.
+class CachedReply : public QNetworkReply {
+    Q_OBJECT
+
+public:
+    CachedReply(const QNetworkRequest& request, const QSharedPointer<ResourceDiskCache>& diskCache);
+
+    virtual void abort();
+    virtual bool isSequential() const { return true; }
+    virtual qint64 bytesAvailable() const;
+
+protected:
+    virtual qint64 readData(char* data, qint64 maxSize);
+
+private slots:
+    void setContent(bool success, const QByteArray& data, const QByteArray& contentType, const QByteArray& etag,
+                    const QByteArray& lastModified);
+
+private:
+    QByteArray _data;
+    qint64 _offset = 0;
+};
+
+/// Reads the content of a URL from the disk cache.
+class CachedContentReader : public QObject, public QRunnable {
+    Q_OBJECT
+
+public:
+    CachedContentReader(const QSharedPointer<ResourceDiskCache>& diskCache, const QUrl& url);
+    virtual void run();
+
+signals:
+    void loaded(bool success, const QByteArray& data, const QByteArray& contentType, const QByteArray& etag,
+                const QByteArray& lastModified);
+
+private:
+    QSharedPointer<ResourceDiskCache> _diskCache;
+    QUrl _url;
+};
+
+#endif // hifi_CachedReply_h
@@ -15,11 +15,13 @@
 #include <QDebug>
 #include <QNetworkDiskCache>
 #include <QThread>
+#include <QThreadPool>
 #include <QTimer>
 
 #include <SharedUtil.h>
 #include <assert.h>
 
+#include "CachedReply.h"
 #include "NetworkAccessManager.h"
 #include "NetworkLogging.h"
 
@@ -80,6 +82,9 @@ QSharedPointer<Resource> ResourceCache::getResource(const QUrl& url, const QUrl&
     QSharedPointer<Resource> resource = _resources.value(url);
     if (!resource.isNull()) {
         removeUnusedResource(resource);
+        if (resource->isLoadingCancelled()) {
+            resource->ensureLoading();
+        }
         return resource;
     }
 
@@ -152,9 +157,15 @@ void ResourceCache::clearUnusedResource() {
     }
 }
 
+void ResourceCache::beginFrame(const glm::vec3& viewPosition) {
+    getScheduler().beginFrame(viewPosition);
+    startPendingRequests();
+}
+
 void ResourceCache::attemptRequest(Resource* resource) {
     auto sharedItems = DependencyManager::get<ResourceCacheSharedItems>();
-    if (_requestLimit <= 0) {
+    // once there are frames, the requests wait for the next one so that the closest go first
+    if (_requestLimit <= 0 || sharedItems->_scheduler.isFrameDriven()) {
         // wait until a slot becomes available
         sharedItems->_pendingRequests.append(resource);
         return;
@@ -170,24 +181,35 @@ void ResourceCache::requestCompleted(Resource* resource) {
     sharedItems->_loadingRequests.removeOne(resource);
     _requestLimit++;
     
-    // look for the highest priority pending request
-    int highestIndex = -1;
-    float highestPriority = -FLT_MAX;
-    for (int i = 0; i < sharedItems->_pendingRequests.size(); ) {
-        Resource* resource = sharedItems->_pendingRequests.at(i).data();
-        if (!resource) {
-            sharedItems->_pendingRequests.removeAt(i);
-            continue;
+    startPendingRequests();
+}
+
+void ResourceCache::startPendingRequests() {
+    auto sharedItems = DependencyManager::get<ResourceCacheSharedItems>();
+    while (_requestLimit > 0 && !sharedItems->_pendingRequests.isEmpty()) {
+        // look for the highest priority pending request
+        int highestIndex = -1;
+        float highestPriority = -FLT_MAX;
+        for (int i = 0; i < sharedItems->_pendingRequests.size(); ) {
+            Resource* resource = sharedItems->_pendingRequests.at(i).data();
+            if (!resource) {
+                sharedItems->_pendingRequests.removeAt(i);
+                continue;
+            }
+            float priority = resource->getLoadPriority();
+            if (priority >= highestPriority) {
+                highestPriority = priority;
+                highestIndex = i;
+            }
+            i++;
         }
-        float priority = resource->getLoadPriority();
-        if (priority >= highestPriority) {
-            highestPriority = priority;
-            highestIndex = i;
+        if (highestIndex < 0 || !sharedItems->_scheduler.takeRequest()) {
+            return;
         }
-        i++;
-    }
-    if (highestIndex >= 0) {
-        attemptRequest(sharedItems->_pendingRequests.takeAt(highestIndex));
+        Resource* resource = sharedItems->_pendingRequests.takeAt(highestIndex).data();
+        _requestLimit--;
+        sharedItems->_loadingRequests.append(resource);
+        resource->makeRequest();
     }
 }
 
@@ -245,6 +267,15 @@ void Resource::clearLoadPriority(const QPointer<QObject>& owner) {
     }
 }
 
+void Resource::setLoadBounds(const QPointer<QObject>& owner, const glm::vec3& center, float radius) {
+    // unlike the priorities, the bounds outlive the download, for the decoding and the upload that follow
+    _loadBounds.insert(owner, glm::vec4(center, radius));
+}
+
+void Resource::clearLoadBounds(const QPointer<QObject>& owner) {
+    _loadBounds.remove(owner);
+}
+
 float Resource::getLoadPriority() {
     float highestPriority = -FLT_MAX;
     for (QHash<QPointer<QObject>, float>::iterator it = _loadPriorities.begin(); it != _loadPriorities.end(); ) {
@@ -255,6 +286,18 @@ float Resource::getLoadPriority() {
         highestPriority = qMax(highestPriority, it.value());
         it++;
     }
+    if (!_loadBounds.isEmpty()) {
+        const glm::vec3& viewPosition = ResourceCache::getScheduler().getViewPosition();
+        for (QHash<QPointer<QObject>, glm::vec4>::iterator it = _loadBounds.begin(); it != _loadBounds.end(); ) {
+            if (it.key().isNull()) {
+                it = _loadBounds.erase(it);
+                continue;
+            }
+            highestPriority = qMax(highestPriority,
+                ResourceScheduler::evalScore(viewPosition, glm::vec3(it.value()), it.value().w));
+            it++;
+        }
+    }
     return highestPriority;
 }
 
@@ -262,6 +305,11 @@ void Resource::refresh() {
     if (_reply && !(_loaded || _failedToLoad)) {
         return;
     }
+    _request.setAttribute(QNetworkRequest::CacheLoadControlAttribute, QNetworkRequest::AlwaysNetwork);
+    restartLoading();
+}
+
+void Resource::restartLoading() {
     if (_reply) {
         ResourceCache::requestCompleted(this);
         _reply->disconnect(this);
@@ -273,11 +321,32 @@ void Resource::refresh() {
     }
     
     init();
-    _request.setAttribute(QNetworkRequest::CacheLoadControlAttribute, QNetworkRequest::AlwaysNetwork);
     ensureLoading();
     emit onRefresh();
 }
 
+void Resource::cancelLoading() {
+    auto sharedItems = DependencyManager::get<ResourceCacheSharedItems>();
+    bool wasLoading = sharedItems->_pendingRequests.removeAll(this) > 0;
+    if (_reply) {
+        ResourceCache::requestCompleted(this);
+        _reply->disconnect(this);
+        _replyTimer->disconnect(this);
+        _reply->abort();
+        _reply->deleteLater();
+        _reply = nullptr;
+        _replyTimer->deleteLater();
+        _replyTimer = nullptr;
+        wasLoading = true;
+    }
+    wasLoading |= sharedItems->_scheduler.cancel(this);
+    if (wasLoading) {
+        // start over when used again; the download itself is likely to come from the disk cache then
+        init();
+        _loadingCancelled = true;
+    }
+}
+
 void Resource::allReferencesCleared() {
     if (_cache) {
         if (QThread::currentThread() != thread()) {
@@ -285,6 +354,9 @@ void Resource::allReferencesCleared() {
             return;
         }
         
+        // nobody is waiting for the resource anymore, so leave the budgets to those that are
+        cancelLoading();
+
         // create and reinsert new shared pointer 
         QSharedPointer<Resource> self(this, &Resource::allReferencesCleared);
         setSelf(self);
@@ -303,6 +375,7 @@ void Resource::init() {
     _failedToLoad = false;
     _loaded = false;
     _attempts = 0;
+    _loadGeneration++;
     
     if (_url.isEmpty()) {
         _startedLoading = _loaded = true;
@@ -314,6 +387,7 @@ void Resource::init() {
 
 void Resource::attemptRequest() {
     _startedLoading = true;
+    _loadingCancelled = false;
     ResourceCache::attemptRequest(this);
 }
 
@@ -330,6 +404,38 @@ void Resource::reinsert() {
     _cache->_resources.insert(_url, _self);
 }
 
+// Writes downloaded content to the disk cache on the thread pool
+class ContentWriter : public QRunnable {
+public:
+    ContentWriter(const QSharedPointer<ResourceDiskCache>& diskCache, const QUrl& url,
+                  const ResourceDiskCache::Content& content) :
+        _diskCache(diskCache), _url(url), _content(content) { }
+
+    virtual void run() {
+        if (!_diskCache->storeContent(_url, _content)) {
+            qCDebug(networking) << "Failed to cache url =" << _url.toDisplayString();
+        }
+    }
+
+private:
+    QSharedPointer<ResourceDiskCache> _diskCache;
+    QUrl _url;
+    ResourceDiskCache::Content _content;
+};
+
+static void storeContent(const QUrl& url, QNetworkReply* reply) {
+    const int HTTP_OK = 200;
+    auto diskCache = ResourceCache::getDiskCache();
+    if (!diskCache || !(url.scheme() == "http" || url.scheme() == "https") ||
+            reply->attribute(QNetworkRequest::HttpStatusCodeAttribute).toInt() != HTTP_OK) {
+        return;
+    }
+    ResourceDiskCache::Content content = ResourceDiskCache::Content::fromReply(reply);
+    if (content.isValidatable()) {
+        QThreadPool::globalInstance()->start(new ContentWriter(diskCache, url, content));
+    }
+}
+
 static const int REPLY_TIMEOUT_MS = 5000;
 void Resource::handleDownloadProgress(qint64 bytesReceived, qint64 bytesTotal) {
     _bytesReceived = bytesReceived;
@@ -346,7 +452,17 @@ void Resource::handleReplyTimeout() {
 }
 
 void Resource::makeRequest() {
-    _reply = NetworkAccessManager::getInstance().get(_request);
+    // what was downloaded before loads from the disk right away, and is checked against the server once loaded; refreshing
+    // goes to the network
+    auto diskCache = ResourceCache::getDiskCache();
+    bool isRefreshing = _request.attribute(QNetworkRequest::CacheLoadControlAttribute).toInt() ==
+        QNetworkRequest::AlwaysNetwork;
+    _warmStarted = diskCache && !(isRefreshing || _warmStartFailed) && diskCache->hasContent(_url);
+    if (_warmStarted) {
+        _reply = new CachedReply(_request, diskCache);
+    } else {
+        _reply = NetworkAccessManager::getInstance().get(_request);
+    }
 
     connect(_reply, SIGNAL(downloadProgress(qint64,qint64)), SLOT(handleDownloadProgress(qint64,qint64)));
     connect(_reply, SIGNAL(error(QNetworkReply::NetworkError)), SLOT(handleReplyError()));
@@ -369,6 +485,14 @@ void Resource::handleReplyErrorInternal(QNetworkReply::NetworkError error) {
     _replyTimer = nullptr;
     ResourceCache::requestCompleted(this);
 
+    if (_warmStarted) {
+        // the cached content couldn't be read, so it gets downloaded
+        _warmStarted = false;
+        _warmStartFailed = true;
+        attemptRequest();
+        return;
+    }
+
     // retry for certain types of failures
     switch (error) {
         case QNetworkReply::RemoteHostClosedError:
@@ -411,11 +535,59 @@ void Resource::handleReplyFinished() {
     _replyTimer = nullptr;
     ResourceCache::requestCompleted(this);
 
+    if (_warmStarted) {
+        _warmStarted = false;
+        revalidate(ResourceDiskCache::Content::fromReply(reply));
+    } else {
+        storeContent(_url, reply);
+    }
+
     finishedLoading(true);
     emit loaded(*reply);
     downloadFinished(reply);
 }
 
+void Resource::revalidate(const ResourceDiskCache::Content& cached) {
+    QNetworkRequest request(_request);
+    request.setAttribute(QNetworkRequest::CacheLoadControlAttribute, QNetworkRequest::AlwaysNetwork);
+    if (!cached.etag.isEmpty()) {
+        request.setRawHeader("If-None-Match", cached.etag);
+    }
+    if (!cached.lastModified.isEmpty()) {
+        request.setRawHeader("If-Modified-Since", cached.lastModified);
+    }
+    QByteArray cachedHash = ResourceDiskCache::getContentHash(cached.data);
+    QByteArray cachedEtag = cached.etag;
+    QNetworkReply* reply = NetworkAccessManager::getInstance().get(request);
+    reply->setParent(this);
+    connect(reply, &QNetworkReply::finished, this, [this, reply, cachedHash, cachedEtag] {
+        const int HTTP_OK = 200;
+        auto diskCache = ResourceCache::getDiskCache();
+        // when the network access manager has an HTTP cache of its own, a 304 comes back as the 200 it cached
+        if (diskCache && reply->error() == QNetworkReply::NoError &&
+                reply->attribute(QNetworkRequest::HttpStatusCodeAttribute).toInt() == HTTP_OK &&
+                !reply->attribute(QNetworkRequest::SourceIsFromCacheAttribute).toBool()) {
+            ResourceDiskCache::Content content = ResourceDiskCache::Content::fromReply(reply);
+            if ((!cachedEtag.isEmpty() && content.etag == cachedEtag) ||
+                    ResourceDiskCache::getContentHash(content.data) == cachedHash) {
+                // the same content, maybe with new validators, which spare the download next time
+                if (content.etag != cachedEtag) {
+                    diskCache->storeContent(_url, content);
+                }
+            } else {
+                // changed on the server: without validators the new content can't be cached, so it gets downloaded
+                // instead
+                qCDebug(networking) << "url changed since it was cached =" << _url.toDisplayString();
+                if (!diskCache->storeContent(_url, content)) {
+                    diskCache->removeContent(_url);
+                }
+                restartLoading();
+            }
+        }
+        reply->deleteLater();
+    });
+}
+
 
 void Resource::downloadFinished(QNetworkReply* reply) {
     ;
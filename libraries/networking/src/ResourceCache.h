@@ -26,6 +26,9 @@
 
 #include <DependencyManager.h>
 
+#include "ResourceDiskCache.h"
+#include "ResourceScheduler.h"
+
 class QNetworkReply;
 class QTimer;
 
@@ -53,6 +56,8 @@ class ResourceCacheSharedItems : public Dependency  {
 public:
     QList<QPointer<Resource>> _pendingRequests;
     QList<Resource*> _loadingRequests;
+    ResourceScheduler _scheduler;
+    QSharedPointer<ResourceDiskCache> _diskCache;
 private:
     ResourceCacheSharedItems() { }
     virtual ~ResourceCacheSharedItems() { }
@@ -76,6 +81,27 @@ public:
     static int getPendingRequestCount() 
         { return DependencyManager::get<ResourceCacheSharedItems>()->_pendingRequests.size(); }
 
+    static ResourceScheduler& getScheduler() { return DependencyManager::get<ResourceCacheSharedItems>()->_scheduler; }
+
+    /// Starts a frame of loading seen from the view: renews the budgets of the scheduler, and starts the pending requests
+    /// that are closest to the view.  Until then, the requests start as soon as the request limit allows.
+    static void beginFrame(const glm::vec3& viewPosition);
+
+    /// Decodes on the thread pool within the budget of the kind of decode, taking ownership of the job
+    static void startDecode(Resource* resource, ResourceScheduler::DecodeKind kind, QRunnable* job)
+        { getScheduler().startDecode(resource, kind, job); }
+
+    /// Uploads to the GPU within the budget of the frame
+    static void queueUpload(Resource* resource, qint64 bytes, std::function<void()> upload)
+        { getScheduler().queueUpload(resource, bytes, upload); }
+
+    /// Sets the persistent cache of the downloads and of what they decode to.  Without one, the resources load from the
+    /// network every time (through the HTTP cache of the network access manager, if it has one).
+    static void setDiskCache(const QSharedPointer<ResourceDiskCache>& diskCache)
+        { DependencyManager::get<ResourceCacheSharedItems>()->_diskCache = diskCache; }
+    static QSharedPointer<ResourceDiskCache> getDiskCache()
+        { return DependencyManager::get<ResourceCacheSharedItems>()->_diskCache; }
+
     ResourceCache(QObject* parent = NULL);
     virtual ~ResourceCache();
     
@@ -104,6 +130,7 @@ protected:
     
     static void attemptRequest(Resource* resource);
     static void requestCompleted(Resource* resource);
+    static void startPendingRequests();
 
 private:
     friend class Resource;
@@ -146,7 +173,13 @@ public:
     /// Clears the load priority for one owner.
     virtual void clearLoadPriority(const QPointer<QObject>& owner);
     
-    /// Returns the highest load priority across all owners.
+    /// Sets the bounds of the resource for one owner, its load priority following their size as seen from the view.
+    virtual void setLoadBounds(const QPointer<QObject>& owner, const glm::vec3& center, float radius);
+
+    /// Clears the bounds of the resource for one owner.
+    virtual void clearLoadBounds(const QPointer<QObject>& owner);
+
+    /// Returns the highest load priority across all owners, set or evaluated from the bounds.
     float getLoadPriority();
 
     /// Checks whether the resource has loaded.
@@ -164,6 +197,12 @@ public:
     /// Refreshes the resource.
     void refresh();
 
+    /// Stops the loading that is pending or under way, until the resource is used again.
+    virtual void cancelLoading();
+
+    /// Checks whether the loading was cancelled since the resource was last used.
+    bool isLoadingCancelled() const { return _loadingCancelled; }
+
     void setSelf(const QWeakPointer<Resource>& self) { _self = self; }
 
     void setCache(ResourceCache* cache) { _cache = cache; }
@@ -197,12 +236,18 @@ protected:
     /// Reinserts this resource into the cache.
     virtual void reinsert();
 
+    /// Returns the generation of the current load, which changes whenever the loading is cancelled or restarted.  Decodes
+    /// carry the generation they were started in, and their results are dropped if it is no longer the current one.
+    int getLoadGeneration() const { return _loadGeneration; }
+
     QUrl _url;
     QNetworkRequest _request;
     bool _startedLoading = false;
     bool _failedToLoad = false;
     bool _loaded = false;
+    bool _loadingCancelled = false;
     QHash<QPointer<QObject>, float> _loadPriorities;
+    QHash<QPointer<QObject>, glm::vec4> _loadBounds;
     QWeakPointer<Resource> _self;
     QPointer<ResourceCache> _cache;
     
@@ -216,6 +261,10 @@ private:
     void setLRUKey(int lruKey) { _lruKey = lruKey; }
     
     void makeRequest();
+    void restartLoading();
+
+    /// Checks the content loaded from the disk cache against the server, loading again if it changed
+    void revalidate(const ResourceDiskCache::Content& cached);
     
     void handleReplyErrorInternal(QNetworkReply::NetworkError error);
     
@@ -227,6 +276,9 @@ private:
     qint64 _bytesReceived = 0;
     qint64 _bytesTotal = 0;
     int _attempts = 0;
+    int _loadGeneration = 0;
+    bool _warmStarted = false;
+    bool _warmStartFailed = false;
 };
 
 uint qHash(const QPointer<QObject>& value, uint seed = 0);
@@ -0,0 +1,266 @@
+//
+//  ResourceDiskCache.cpp
+//  libraries/networking/src
+//
+//  Copyright 2015 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include <algorithm>
+#include <vector>
+
+#include <QCryptographicHash>
+#include <QDataStream>
+#include <QDir>
+#include <QFile>
+#include <QSaveFile>
+#include <QStandardPaths>
+
+#include "NetworkLogging.h"
+#include "ResourceCache.h"
+
+#include "ResourceDiskCache.h"
+
+const quint32 ResourceDiskCache::VERSION = 1;
+const qint64 ResourceDiskCache::DEFAULT_MAXIMUM_SIZE = 2 * BYTES_PER_GIGABYTES;
+
+static const QString INDEX_FILE_NAME = "index";
+static const QString CONTENT_EXTENSION = ".content";
+static const QString URL_EXTENSION = ".url";
+
+QString ResourceDiskCache::getDefaultDirectory() {
+    return QStandardPaths::writableLocation(QStandardPaths::DataLocation) + "/resources";
+}
+
+QByteArray ResourceDiskCache::getContentHash(const QByteArray& content) {
+    return QCryptographicHash::hash(content, QCryptographicHash::Sha1).toHex();
+}
+
+ResourceDiskCache::Content ResourceDiskCache::Content::fromReply(QNetworkReply* reply) {
+    Content content;
+    content.data = reply->peek(reply->bytesAvailable());
+    content.contentType = reply->rawHeader("Content-Type");
+    content.etag = reply->rawHeader("ETag");
+    content.lastModified = reply->rawHeader("Last-Modified");
+    return content;
+}
+
+ResourceDiskCache::ResourceDiskCache(const QString& directory, qint64 maximumSize) :
+    _directory(directory),
+    _maximumSize(maximumSize) {
+
+    loadIndex();
+}
+
+ResourceDiskCache::~ResourceDiskCache() {
+    saveIndex();
+}
+
+void ResourceDiskCache::setMaximumSize(qint64 maximumSize) {
+    QMutexLocker locker(&_mutex);
+    _maximumSize = maximumSize;
+    evict();
+}
+
+qint64 ResourceDiskCache::getSize() const {
+    QMutexLocker locker(&_mutex);
+    return _size;
+}
+
+int ResourceDiskCache::getEntryCount() const {
+    QMutexLocker locker(&_mutex);
+    return _entries.size();
+}
+
+bool ResourceDiskCache::load(const QString& name, QByteArray& data) {
+    QFile file(getFilePath(name));
+    if (!file.open(QIODevice::ReadOnly)) {
+        return false;
+    }
+    data = file.readAll();
+
+    QMutexLocker locker(&_mutex);
+    markUsed(name, data.size());
+    return true;
+}
+
+bool ResourceDiskCache::store(const QString& name, const QByteArray& data) {
+    if (!QDir().mkpath(_directory)) {
+        return false;
+    }
+    QSaveFile file(getFilePath(name));
+    if (!file.open(QIODevice::WriteOnly)) {
+        return false;
+    }
+    file.write(data);
+    if (!file.commit()) {
+        return false;
+    }
+    QMutexLocker locker(&_mutex);
+    markUsed(name, data.size());
+    evict();
+    return true;
+}
+
+bool ResourceDiskCache::contains(const QString& name) const {
+    QMutexLocker locker(&_mutex);
+    return _entries.contains(name);
+}
+
+void ResourceDiskCache::remove(const QString& name) {
+    QFile::remove(getFilePath(name));
+
+    QMutexLocker locker(&_mutex);
+    auto entry = _entries.find(name);
+    if (entry != _entries.end()) {
+        _size -= entry.value().size;
+        _entries.erase(entry);
+    }
+}
+
+void ResourceDiskCache::clear() {
+    QMutexLocker locker(&_mutex);
+    foreach (const QString& name, _entries.keys()) {
+        QFile::remove(getFilePath(name));
+    }
+    QFile::remove(getFilePath(INDEX_FILE_NAME));
+    _entries.clear();
+    _size = 0;
+}
+
+bool ResourceDiskCache::loadContent(const QUrl& url, Content& content) {
+    QString recordName = getContentHash(url.toEncoded()) + URL_EXTENSION;
+    QByteArray record;
+    if (!load(recordName, record)) {
+        return false;
+    }
+    QDataStream stream(record);
+    quint32 version = 0;
+    QByteArray hash;
+    stream >> version >> hash >> content.contentType >> content.etag >> content.lastModified;
+    if (stream.status() != QDataStream::Ok || version != VERSION) {
+        remove(recordName);
+        return false;
+    }
+    QString contentName = hash + CONTENT_EXTENSION;
+    if (!load(contentName, content.data)) {
+        remove(recordName);
+        return false;
+    }
+    if (getContentHash(content.data) != hash) {
+        qCDebug(networking) << "Removing cached content of" << url.toDisplayString() << ": hash mismatch";
+        remove(contentName);
+        remove(recordName);
+        return false;
+    }
+    return true;
+}
+
+bool ResourceDiskCache::storeContent(const QUrl& url, const Content& content) {
+    if (!content.isValidatable()) {
+        return false;
+    }
+    QByteArray hash = getContentHash(content.data);
+    QByteArray record;
+    QDataStream stream(&record, QIODevice::WriteOnly);
+    stream << VERSION << hash << content.contentType << content.etag << content.lastModified;
+
+    // the content goes first, so that a record always finds its content; the URLs of the same content share it
+    QString contentName = hash + CONTENT_EXTENSION;
+    if (!contains(contentName) && !store(contentName, content.data)) {
+        return false;
+    }
+    return store(getContentHash(url.toEncoded()) + URL_EXTENSION, record);
+}
+
+bool ResourceDiskCache::hasContent(const QUrl& url) const {
+    return contains(getContentHash(url.toEncoded()) + URL_EXTENSION);
+}
+
+void ResourceDiskCache::removeContent(const QUrl& url) {
+    remove(getContentHash(url.toEncoded()) + URL_EXTENSION);
+}
+
+void ResourceDiskCache::saveIndex() {
+    QMutexLocker locker(&_mutex);
+    if (_entries.isEmpty() || !QDir().mkpath(_directory)) {
+        return;
+    }
+    QSaveFile file(getFilePath(INDEX_FILE_NAME));
+    if (!file.open(QIODevice::WriteOnly)) {
+        return;
+    }
+    QDataStream stream(&file);
+    stream << VERSION << (quint32)_entries.size();
+    for (auto entry = _entries.constBegin(); entry != _entries.constEnd(); entry++) {
+        stream << entry.key() << entry.value().lastUse;
+    }
+    if (!file.commit()) {
+        qCDebug(networking) << "Failed to save the index of the resource cache in" << _directory;
+    }
+}
+
+QString ResourceDiskCache::getFilePath(const QString& name) const {
+    return _directory + "/" + name;
+}
+
+void ResourceDiskCache::loadIndex() {
+    // the files are what is in the cache, and the index only tells in which order they were last used; the files the
+    // index doesn't know of are the oldest
+    QDir directory(_directory);
+    foreach (const QFileInfo& info, directory.entryInfoList(QDir::Files)) {
+        if (info.fileName() != INDEX_FILE_NAME) {
+            _entries.insert(info.fileName(), { info.size(), 0 });
+            _size += info.size();
+        }
+    }
+    QFile file(getFilePath(INDEX_FILE_NAME));
+    if (!file.open(QIODevice::ReadOnly)) {
+        return;
+    }
+    QDataStream stream(&file);
+    quint32 version = 0;
+    quint32 count = 0;
+    stream >> version >> count;
+    if (version != VERSION) {
+        return;
+    }
+    for (quint32 i = 0; i < count && stream.status() == QDataStream::Ok; i++) {
+        QString name;
+        quint64 lastUse;
+        stream >> name >> lastUse;
+        auto entry = _entries.find(name);
+        if (entry != _entries.end()) {
+            entry.value().lastUse = lastUse;
+            _lastUse = std::max(_lastUse, lastUse);
+        }
+    }
+}
+
+void ResourceDiskCache::markUsed(const QString& name, qint64 size) {
+    Entry& entry = _entries[name];
+    _size += size - entry.size;
+    entry.size = size;
+    entry.lastUse = ++_lastUse;
+}
+
+void ResourceDiskCache::evict() {
+    if (_size <= _maximumSize) {
+        return;
+    }
+    std::vector<std::pair<quint64, QString>> entries;
+    for (auto entry = _entries.constBegin(); entry != _entries.constEnd(); entry++) {
+        entries.emplace_back(entry.value().lastUse, entry.key());
+    }
+    std::sort(entries.begin(), entries.end());
+
+    // the most recently used entry stays, even if it doesn't fit by itself
+    for (size_t i = 0; i + 1 < entries.size() && _size > _maximumSize; i++) {
+        const QString& name = entries[i].second;
+        QFile::remove(getFilePath(name));
+        _size -= _entries.value(name).size;
+        _entries.remove(name);
+    }
+}
@@ -0,0 +1,112 @@
+//
+//  ResourceDiskCache.h
+//  libraries/networking/src
+//
+//  Copyright 2015 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_ResourceDiskCache_h
+#define hifi_ResourceDiskCache_h
+
+#include <QByteArray>
+#include <QHash>
+#include <QMutex>
+#include <QNetworkReply>
+#include <QString>
+#include <QUrl>
+
+/// A persistent cache on disk of what the resources download and of what they decode to, so that coming back to a place
+/// loads everything from the disk. The downloaded content is kept by URL along with its validators (the ETag and the
+/// modification date), so that it can be checked against the server rather than downloaded again; it is stored under the
+/// hash of its bytes, so that the URLs of the same content share it. The decoded forms are stored under keys of their own,
+/// derived from the content they are decoded from. Past the maximum size, the least recently used entries go first.
+/// The cache can be used from any thread.
+class ResourceDiskCache {
+public:
+    /// Bumped whenever the layout of the entries changes, which invalidates the URL records
+    static const quint32 VERSION;
+
+    static const qint64 DEFAULT_MAXIMUM_SIZE;
+
+    /// The directory of the cache of the application
+    static QString getDefaultDirectory();
+
+    /// The hash of the content, in hex
+    static QByteArray getContentHash(const QByteArray& content);
+
+    /// Downloaded content, with what it takes to check whether it is still current
+    class Content {
+    public:
+        QByteArray data;
+        QByteArray contentType;
+        QByteArray etag;
+        QByteArray lastModified;
+
+        /// Only the content with validators can be cached, since it couldn't be checked otherwise
+        bool isValidatable() const { return !(etag.isEmpty() && lastModified.isEmpty()); }
+
+        /// Reads the content of a successful HTTP reply, without consuming it
+        static Content fromReply(QNetworkReply* reply);
+    };
+
+    ResourceDiskCache(const QString& directory = getDefaultDirectory(), qint64 maximumSize = DEFAULT_MAXIMUM_SIZE);
+    ~ResourceDiskCache();
+
+    const QString& getDirectory() const { return _directory; }
+
+    void setMaximumSize(qint64 maximumSize);
+    qint64 getMaximumSize() const { return _maximumSize; }
+
+    qint64 getSize() const;
+    int getEntryCount() const;
+
+    /// Reads the entry, making it the most recently used
+    bool load(const QString& name, QByteArray& data);
+
+    /// Writes the entry atomically, so that concurrent loaders never see a partial file, and evicts past the maximum size
+    bool store(const QString& name, const QByteArray& data);
+
+    bool contains(const QString& name) const;
+    void remove(const QString& name);
+    void clear();
+
+    /// Reads the content last downloaded from the URL. Content that doesn't match its hash is removed.
+    bool loadContent(const QUrl& url, Content& content);
+
+    /// Keeps the content downloaded from the URL, if it has validators
+    bool storeContent(const QUrl& url, const Content& content);
+
+    /// Checks whether there is content for the URL, without reading it
+    bool hasContent(const QUrl& url) const;
+
+    /// Forgets the content of the URL (which other URLs may still share)
+    void removeContent(const QUrl& url);
+
+    /// Writes the order of use of the entries, which the cache otherwise writes when destroyed
+    void saveIndex();
+
+private:
+    class Entry {
+    public:
+        qint64 size;
+        quint64 lastUse;
+    };
+
+    QString getFilePath(const QString& name) const;
+    void loadIndex();
+    void markUsed(const QString& name, qint64 size);
+    void evict();
+
+    QString _directory;
+    qint64 _maximumSize;
+
+    mutable QMutex _mutex;
+    QHash<QString, Entry> _entries;
+    qint64 _size = 0;
+    quint64 _lastUse = 0;
+};
+
+#endif // hifi_ResourceDiskCache_h
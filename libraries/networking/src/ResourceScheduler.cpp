@@ -0,0 +1,187 @@
+//
+//  ResourceScheduler.cpp
+//  libraries/networking/src
+//
+//  Copyright 2015 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include <cfloat>
+#include <memory>
+
+#include <QThreadPool>
+
+#include "ResourceCache.h"
+
+#include "ResourceScheduler.h"
+
+const int ResourceScheduler::DEFAULT_REQUESTS_PER_FRAME = 4;
+const int ResourceScheduler::DEFAULT_DECODE_LIMIT = 2;
+const qint64 ResourceScheduler::DEFAULT_UPLOAD_BYTES_PER_FRAME = 8 * BYTES_PER_MEGABYTES;
+
+// Runs a decode job on the thread pool, and tells the scheduler once it is done so that the next one of its kind starts
+class ScheduledDecode : public QRunnable {
+public:
+    ScheduledDecode(ResourceScheduler* scheduler, int kind, Resource* resource, QRunnable* job) :
+        _scheduler(scheduler), _kind(kind), _resource(resource), _job(job) { }
+
+    virtual void run() {
+        _job->run();
+        _job.reset();
+        if (_scheduler) {
+            QMetaObject::invokeMethod(_scheduler, "decodeCompleted", Qt::QueuedConnection,
+                Q_ARG(int, _kind), Q_ARG(void*, _resource));
+        }
+    }
+
+private:
+    QPointer<ResourceScheduler> _scheduler;
+    int _kind;
+    Resource* _resource;
+    std::unique_ptr<QRunnable> _job;
+};
+
+// Returns the index of the entry of the resource with the highest load priority, the oldest one among equals, dropping the
+// entries of the resources that went away along the way
+template<class T> static int takeHighestPriority(QList<T>& entries, const std::function<void(T&)>& drop) {
+    int highestIndex = -1;
+    float highestPriority = -FLT_MAX;
+    for (int i = 0; i < entries.size(); ) {
+        Resource* resource = entries.at(i).resource.data();
+        if (!resource) {
+            drop(entries[i]);
+            entries.removeAt(i);
+            continue;
+        }
+        float priority = resource->getLoadPriority();
+        if (highestIndex == -1 || priority > highestPriority) {
+            highestPriority = priority;
+            highestIndex = i;
+        }
+        i++;
+    }
+    return highestIndex;
+}
+
+float ResourceScheduler::evalScore(const glm::vec3& viewPosition, const glm::vec3& center, float radius) {
+    float distance = glm::distance(viewPosition, center);
+    return (distance <= radius) ? 1.0f : radius / distance;
+}
+
+ResourceScheduler::ResourceScheduler() :
+    _requestsPerFrame(DEFAULT_REQUESTS_PER_FRAME),
+    _uploadBytesPerFrame(DEFAULT_UPLOAD_BYTES_PER_FRAME) {
+
+    for (auto& decodes : _decodes) {
+        decodes.limit = DEFAULT_DECODE_LIMIT;
+    }
+}
+
+ResourceScheduler::~ResourceScheduler() {
+    for (auto& decodes : _decodes) {
+        foreach (const QueuedDecode& decode, decodes.queue) {
+            delete decode.job;
+        }
+    }
+}
+
+void ResourceScheduler::setDecodeLimit(DecodeKind kind, int limit) {
+    _decodes[kind].limit = limit;
+    startDecodes(kind);
+}
+
+void ResourceScheduler::beginFrame(const glm::vec3& viewPosition) {
+    _frameDriven = true;
+    _viewPosition = viewPosition;
+    _frameRequests = 0;
+    _frameUploadedBytes = 0;
+    runUploads();
+}
+
+bool ResourceScheduler::takeRequest() {
+    if (!_frameDriven) {
+        return true;
+    }
+    if (_frameRequests >= _requestsPerFrame) {
+        return false;
+    }
+    _frameRequests++;
+    return true;
+}
+
+void ResourceScheduler::startDecode(Resource* resource, DecodeKind kind, QRunnable* job) {
+    _decodes[kind].queue.append({ resource, job });
+    startDecodes(kind);
+}
+
+void ResourceScheduler::queueUpload(Resource* resource, qint64 bytes, std::function<void()> upload) {
+    if (!_frameDriven) {
+        upload();
+        return;
+    }
+    _uploads.append({ resource, bytes, upload });
+    runUploads();
+}
+
+bool ResourceScheduler::cancel(Resource* resource) {
+    bool hadWork = false;
+    for (auto& decodes : _decodes) {
+        for (int i = 0; i < decodes.queue.size(); ) {
+            if (decodes.queue.at(i).resource == resource) {
+                delete decodes.queue.at(i).job;
+                decodes.queue.removeAt(i);
+                hadWork = true;
+            } else {
+                i++;
+            }
+        }
+        hadWork |= decodes.running.contains(resource);
+    }
+    for (int i = 0; i < _uploads.size(); ) {
+        if (_uploads.at(i).resource == resource) {
+            _uploads.removeAt(i);
+            hadWork = true;
+        } else {
+            i++;
+        }
+    }
+    return hadWork;
+}
+
+void ResourceScheduler::decodeCompleted(int kind, void* resource) {
+    _decodes[kind].running.removeOne(static_cast<Resource*>(resource));
+    startDecodes((DecodeKind)kind);
+}
+
+void ResourceScheduler::startDecodes(DecodeKind kind) {
+    Decodes& decodes = _decodes[kind];
+    std::function<void(QueuedDecode&)> drop = [](QueuedDecode& decode) { delete decode.job; };
+    while (decodes.running.size() < decodes.limit) {
+        int index = takeHighestPriority(decodes.queue, drop);
+        if (index == -1) {
+            return;
+        }
+        QueuedDecode decode = decodes.queue.takeAt(index);
+        decodes.running.append(decode.resource.data());
+        QThreadPool::globalInstance()->start(new ScheduledDecode(this, kind, decode.resource.data(), decode.job));
+    }
+}
+
+void ResourceScheduler::runUploads() {
+    std::function<void(QueuedUpload&)> drop = [](QueuedUpload& upload) { };
+    while (true) {
+        int index = takeHighestPriority(_uploads, drop);
+        if (index == -1) {
+            return;
+        }
+        qint64 bytes = _uploads.at(index).bytes;
+        if (_frameUploadedBytes > 0 && _frameUploadedBytes + bytes > _uploadBytesPerFrame) {
+            return;
+        }
+        QueuedUpload upload = _uploads.takeAt(index);
+        _frameUploadedBytes += bytes;
+        upload.upload();
+    }
+}
@@ -0,0 +1,120 @@
+//
+//  ResourceScheduler.h
+//  libraries/networking/src
+//
+//  Copyright 2015 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_ResourceScheduler_h
+#define hifi_ResourceScheduler_h
+
+#include <functional>
+
+#include <QList>
+#include <QObject>
+#include <QPointer>
+#include <QRunnable>
+
+#include <glm/glm.hpp>
+
+class Resource;
+
+/// Spreads the loading of the resources over the frames. The network requests, the decoding on the worker threads and the
+/// uploads to the GPU each have a budget of their own, and each goes to the waiting resources with the highest priority
+/// first, the priorities following the view as it moves. Until the first frame begins (and in the agents, which have no
+/// frames), the requests only keep to the request limit of the cache, and the uploads run right away.
+class ResourceScheduler : public QObject {
+    Q_OBJECT
+
+public:
+    enum DecodeKind { TEXTURE_DECODE, GEOMETRY_DECODE, SOUND_DECODE, ANIMATION_DECODE, NUM_DECODE_KINDS };
+
+    static const int DEFAULT_REQUESTS_PER_FRAME;
+    static const int DEFAULT_DECODE_LIMIT;
+    static const qint64 DEFAULT_UPLOAD_BYTES_PER_FRAME;
+
+    /// The priority of a resource bounded by the sphere: the size of the sphere as seen from the view, 1 when the view is
+    /// within it
+    static float evalScore(const glm::vec3& viewPosition, const glm::vec3& center, float radius);
+
+    ResourceScheduler();
+    virtual ~ResourceScheduler();
+
+    void setRequestsPerFrame(int requestsPerFrame) { _requestsPerFrame = requestsPerFrame; }
+    int getRequestsPerFrame() const { return _requestsPerFrame; }
+
+    /// The number of decodes of the kind that run at the same time
+    void setDecodeLimit(DecodeKind kind, int limit);
+    int getDecodeLimit(DecodeKind kind) const { return _decodes[kind].limit; }
+
+    /// At least one upload runs per frame, however large
+    void setUploadBytesPerFrame(qint64 uploadBytesPerFrame) { _uploadBytesPerFrame = uploadBytesPerFrame; }
+    qint64 getUploadBytesPerFrame() const { return _uploadBytesPerFrame; }
+
+    bool isFrameDriven() const { return _frameDriven; }
+    const glm::vec3& getViewPosition() const { return _viewPosition; }
+
+    /// Moves the view and renews the budgets, running the uploads that waited for the frame
+    void beginFrame(const glm::vec3& viewPosition);
+
+    /// Spends a network request of the frame if any are left
+    bool takeRequest();
+
+    /// Runs the job on the thread pool once a decode of its kind is free. Takes ownership of the job, which is deleted
+    /// without running if the resource goes away or is cancelled before its turn.
+    void startDecode(Resource* resource, DecodeKind kind, QRunnable* job);
+
+    /// Runs the upload (on this thread) once the frame has GPU budget left for its bytes
+    void queueUpload(Resource* resource, qint64 bytes, std::function<void()> upload);
+
+    /// Drops the decodes and uploads waiting for the resource. Returns whether it had any waiting or running.
+    bool cancel(Resource* resource);
+
+    int getQueuedDecodeCount(DecodeKind kind) const { return _decodes[kind].queue.size(); }
+    int getRunningDecodeCount(DecodeKind kind) const { return _decodes[kind].running.size(); }
+    int getQueuedUploadCount() const { return _uploads.size(); }
+    qint64 getFrameUploadedBytes() const { return _frameUploadedBytes; }
+
+private slots:
+    void decodeCompleted(int kind, void* resource);
+
+private:
+    class QueuedDecode {
+    public:
+        QPointer<Resource> resource;
+        QRunnable* job;
+    };
+
+    class Decodes {
+    public:
+        int limit;
+        QList<QueuedDecode> queue;
+        QList<Resource*> running;
+    };
+
+    class QueuedUpload {
+    public:
+        QPointer<Resource> resource;
+        qint64 bytes;
+        std::function<void()> upload;
+    };
+
+    void startDecodes(DecodeKind kind);
+    void runUploads();
+
+    int _requestsPerFrame;
+    qint64 _uploadBytesPerFrame;
+
+    bool _frameDriven = false;
+    glm::vec3 _viewPosition;
+    int _frameRequests = 0;
+    qint64 _frameUploadedBytes = 0;
+
+    Decodes _decodes[NUM_DECODE_KINDS];
+    QList<QueuedUpload> _uploads;
+};
+
+#endif // hifi_ResourceScheduler_h
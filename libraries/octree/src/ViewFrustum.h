@@ -75,6 +75,9 @@ public:
     void  setKeyholeRadius(float keyholdRadius) { _keyholeRadius = keyholdRadius; }
     float getKeyholeRadius() const { return _keyholeRadius; }
 
+    // TOP_PLANE, BOTTOM_PLANE, LEFT_PLANE, RIGHT_PLANE, NEAR_PLANE, FAR_PLANE, facing inward
+    const ::Plane* getPlanes() const { return _planes; }
+
     void calculate();
 
     typedef enum {OUTSIDE, INTERSECT, INSIDE} location;
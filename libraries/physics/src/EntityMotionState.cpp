@@ -239,7 +239,9 @@ btCollisionShape* EntityMotionState::computeNewShape() {
         ShapeInfo shapeInfo;
         assert(entityTreeIsLocked());
         _entity->computeShapeInfo(shapeInfo);
-        return getShapeManager()->getShape(shapeInfo);
+        btCollisionShape* shape = getShapeManager()->getShape(shapeInfo);
+        _newShapeBuilding = !shape && getShapeManager()->isBuilding(shapeInfo);
+        return shape;
     }
     return nullptr;
 }
@@ -267,6 +269,10 @@ bool EntityMotionState::remoteSimulationOutOfSync(uint32_t simulationStep) {
         return false;
     }
 
+    // the error is 1 at the threshold of each measure, and an update that must go is forced past the budget
+    _outgoingError = 1.0f;
+    _outgoingForced = false;
+
     #ifdef WANT_DEBUG
     glm::vec3 wasPosition = _serverPosition;
     glm::quat wasRotation = _serverRotation;
@@ -287,6 +293,7 @@ bool EntityMotionState::remoteSimulationOutOfSync(uint32_t simulationStep) {
     bool isActive = _body->isActive();
     if (!isActive) {
         // object has gone inactive but our last send was moving --> send non-moving update immediately
+        _outgoingForced = true;
         return true;
     }
 
@@ -299,6 +306,7 @@ bool EntityMotionState::remoteSimulationOutOfSync(uint32_t simulationStep) {
 
     if (_serverActionData != _entity->getActionData()) {
         setOutgoingPriority(SCRIPT_EDIT_SIMULATION_PRIORITY);
+        _outgoingForced = true;
         return true;
     }
 
@@ -318,6 +326,7 @@ bool EntityMotionState::remoteSimulationOutOfSync(uint32_t simulationStep) {
 
     const float MAX_POSITION_ERROR_SQUARED = 0.000004f; //  Sqrt() - corresponds to 2 millimeters
     if (dx2 > MAX_POSITION_ERROR_SQUARED) {
+        _outgoingError = sqrtf(dx2 / MAX_POSITION_ERROR_SQUARED);
 
         #ifdef WANT_DEBUG
             qCDebug(physics) << ".... (dx2 > MAX_POSITION_ERROR_SQUARED) ....";
@@ -361,7 +370,9 @@ bool EntityMotionState::remoteSimulationOutOfSync(uint32_t simulationStep) {
         }
     #endif
 
-    return (fabsf(glm::dot(actualRotation, _serverRotation)) < MIN_ROTATION_DOT);
+    float rotationDot = fabsf(glm::dot(actualRotation, _serverRotation));
+    _outgoingError = (1.0f - rotationDot) / (1.0f - MIN_ROTATION_DOT);
+    return (rotationDot < MIN_ROTATION_DOT);
 }
 
 bool EntityMotionState::shouldSendUpdate(uint32_t simulationStep, const QUuid& sessionID) {
@@ -379,6 +390,8 @@ bool EntityMotionState::shouldSendUpdate(uint32_t simulationStep, const QUuid& s
                 _outgoingPriority = NO_PRORITY;
                 return false;
             }
+            // bids are rare and settle who simulates, so they always go
+            _outgoingForced = true;
             return usecTimestampNow() > _nextOwnershipBid;
         }
         return false;
@@ -387,9 +400,11 @@ bool EntityMotionState::shouldSendUpdate(uint32_t simulationStep, const QUuid& s
     return remoteSimulationOutOfSync(simulationStep);
 }
 
-void EntityMotionState::sendUpdate(OctreeEditPacketSender* packetSender, const QUuid& sessionID, uint32_t step) {
+int EntityMotionState::sendUpdate(OctreeEditPacketSender* packetSender, const QUuid& sessionID, uint32_t step) {
     assert(_entity);
     assert(entityTreeIsLocked());
+    int sentBytes = 0;
+    _numDeferredSteps = 0;
 
     bool active = _body->isActive();
     if (!active) {
@@ -447,17 +462,20 @@ void EntityMotionState::sendUpdate(OctreeEditPacketSender* packetSender, const Q
     _serverVelocity = _entity->getVelocity();
     _serverAcceleration = _entity->getAcceleration();
     _serverAngularVelocity = _entity->getAngularVelocity();
+    bool actionDataChanged = _serverActionData != _entity->getActionData();
     _serverActionData = _entity->getActionData();
 
     EntityItemProperties properties;
 
-    // explicitly set the properties that changed so that they will be packed
+    // explicitly set the properties that changed so that they will be packed, keeping the update terse
     properties.setPosition(_serverPosition);
     properties.setRotation(_serverRotation);
     properties.setVelocity(_serverVelocity);
     properties.setAcceleration(_serverAcceleration);
     properties.setAngularVelocity(_serverAngularVelocity);
-    properties.setActionData(_serverActionData);
+    if (actionDataChanged) {
+        properties.setActionData(_serverActionData);
+    }
 
     // set the LastEdited of the properties but NOT the entity itself
     quint64 now = usecTimestampNow();
@@ -493,7 +511,7 @@ void EntityMotionState::sendUpdate(OctreeEditPacketSender* packetSender, const Q
             qCDebug(physics) << "EntityMotionState::sendUpdate()... calling queueEditEntityMessage()...";
         #endif
 
-        entityPacketSender->queueEditEntityMessage(PacketType::EntityEdit, id, properties);
+        sentBytes = entityPacketSender->queueEditEntityMessage(PacketType::EntityEdit, id, properties);
         _entity->setLastBroadcast(usecTimestampNow());
     } else {
         #ifdef WANT_DEBUG
@@ -502,6 +520,7 @@ void EntityMotionState::sendUpdate(OctreeEditPacketSender* packetSender, const Q
     }
 
     _lastStep = step;
+    return sentBytes;
 }
 
 uint32_t EntityMotionState::getIncomingDirtyFlags() {
@@ -46,7 +46,17 @@ public:
     bool isCandidateForOwnership(const QUuid& sessionID) const;
     bool remoteSimulationOutOfSync(uint32_t simulationStep);
     bool shouldSendUpdate(uint32_t simulationStep, const QUuid& sessionID);
-    void sendUpdate(OctreeEditPacketSender* packetSender, const QUuid& sessionID, uint32_t step);
+    /// \return the number of bytes queued for the entity server
+    int sendUpdate(OctreeEditPacketSender* packetSender, const QUuid& sessionID, uint32_t step);
+
+    /// How far out of sync the remote simulation was when shouldSendUpdate() last returned true, 1 at the threshold
+    float getOutgoingError() const { return _outgoingError; }
+
+    /// Whether the update that is due must go out even past the upload budget
+    bool isOutgoingUpdateForced() const { return _outgoingForced; }
+
+    /// Counts the steps the update has been held back since it was due, until it goes out
+    uint32_t deferOutgoingUpdate() { return _numDeferredSteps++; }
 
     virtual uint32_t getIncomingDirtyFlags();
     virtual void clearIncomingDirtyFlags();
@@ -94,12 +104,14 @@ protected:
 
     virtual bool isReadyToComputeShape();
     virtual btCollisionShape* computeNewShape();
+    virtual bool isNewShapeBuilding() const { return _newShapeBuilding; }
     virtual void clearObjectBackPointer();
     virtual void setMotionType(MotionType motionType);
 
     EntityItemPointer _entity;
 
     bool _sentInactive;   // true if body was inactive when we sent last update
+    bool _newShapeBuilding = false;
 
     // these are for the prediction of the remote server's simple extrapolation
     uint32_t _lastStep; // last step of server extrapolation
@@ -120,6 +132,10 @@ protected:
     quint64 _nextOwnershipBid = NO_PRORITY;
     uint32_t _loopsWithoutOwner;
     quint8 _outgoingPriority = NO_PRORITY;
+
+    float _outgoingError = 0.0f;
+    bool _outgoingForced = false;
+    uint32_t _numDeferredSteps = 0;
 };
 
 #endif // hifi_EntityMotionState_h
@@ -167,6 +167,10 @@ bool ObjectMotionState::handleHardAndEasyChanges(uint32_t flags, PhysicsEngine*
             return false;
         }
         btCollisionShape* newShape = computeNewShape();
+        if (!newShape && isNewShapeBuilding()) {
+            // try again once the shape is built, keeping the old one meanwhile
+            return false;
+        }
         if (!newShape) {
             qCDebug(physics) << "Warning: failed to generate new shape!";
             // failed to generate new shape! --> keep old shape and remove shape-change flag
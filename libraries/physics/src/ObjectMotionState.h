@@ -135,6 +135,8 @@ public:
 protected:
     virtual bool isReadyToComputeShape() = 0;
     virtual btCollisionShape* computeNewShape() = 0;
+    /// \return true if the last computeNewShape() came back empty because the shape is still being built
+    virtual bool isNewShapeBuilding() const { return false; }
     void setMotionType(MotionType motionType);
 
     // clearObjectBackPointer() overrrides should call the base method, then actually clear the object back pointer.
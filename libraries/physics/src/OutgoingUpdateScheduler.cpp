@@ -0,0 +1,42 @@
+//
+//  OutgoingUpdateScheduler.cpp
+//  libraries/physics/src
+//
+//  Copyright 2015 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include <algorithm>
+
+#include "OutgoingUpdateScheduler.h"
+
+const int OutgoingUpdateScheduler::DEFAULT_BYTES_PER_SECOND = 96 * 1024;
+const uint32_t OutgoingUpdateScheduler::MAX_DEFERRED_STEPS = 12;
+const float OutgoingUpdateScheduler::MAX_BURST_SECONDS = 0.25f;
+
+void OutgoingUpdateScheduler::beginStep(float deltaTime) {
+    _budget = std::min(_budget + deltaTime * _bytesPerSecond, MAX_BURST_SECONDS * _bytesPerSecond);
+}
+
+void OutgoingUpdateScheduler::queueUpdate(float priority, bool forced, std::function<int()> send) {
+    _updates.push_back({ priority, forced, send });
+}
+
+void OutgoingUpdateScheduler::sendUpdates() {
+    std::stable_sort(_updates.begin(), _updates.end(), [](const Update& first, const Update& second) {
+        return first.forced != second.forced ? first.forced : first.priority > second.priority;
+    });
+    _numSentUpdates = 0;
+    _sentBytes = 0;
+    size_t i = 0;
+    for (; i < _updates.size() && (_updates[i].forced || _budget > 0.0f); i++) {
+        int bytes = _updates[i].send();
+        _budget -= bytes;
+        _sentBytes += bytes;
+        _numSentUpdates++;
+    }
+    _numDeferredUpdates = (int)(_updates.size() - i);
+    _updates.clear();
+}
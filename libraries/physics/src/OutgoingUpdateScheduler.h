@@ -0,0 +1,68 @@
+//
+//  OutgoingUpdateScheduler.h
+//  libraries/physics/src
+//
+//  Copyright 2015 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_OutgoingUpdateScheduler_h
+#define hifi_OutgoingUpdateScheduler_h
+
+#include <functional>
+#include <stdint.h>
+#include <vector>
+
+/// Picks which of the updates due in a simulation step go out to the entity server, so that a pile of objects simulated
+/// locally doesn't flood it. The upload budget fills at a steady rate (up to a short burst) as the steps go by, and the
+/// updates go largest error first while it lasts. The forced updates (ownership bids, objects coming to rest, changed
+/// actions, updates held back too long) always go, the budget they overdraw being paid back by the following steps.
+/// The updates that don't go are dropped: their objects stay out of sync, so they are due again in the next step.
+class OutgoingUpdateScheduler {
+public:
+    static const int DEFAULT_BYTES_PER_SECOND;
+
+    /// The number of steps an update can be held back before it is forced
+    static const uint32_t MAX_DEFERRED_STEPS;
+
+    /// The fraction of a second of budget that can build up while there is little to send
+    static const float MAX_BURST_SECONDS;
+
+    void setBytesPerSecond(int bytesPerSecond) { _bytesPerSecond = bytesPerSecond; }
+    int getBytesPerSecond() const { return _bytesPerSecond; }
+
+    /// Adds the budget of the time gone by since the previous step
+    void beginStep(float deltaTime);
+
+    /// Queues an update for the step. The send function queues the update and returns the number of bytes it took.
+    void queueUpdate(float priority, bool forced, std::function<int()> send);
+
+    /// Sends the forced updates, then the others by decreasing priority while budget remains, and drops the rest
+    void sendUpdates();
+
+    float getBudget() const { return _budget; }
+    int getNumSentUpdates() const { return _numSentUpdates; }
+    int getNumDeferredUpdates() const { return _numDeferredUpdates; }
+    int getSentBytes() const { return _sentBytes; }
+
+private:
+    class Update {
+    public:
+        float priority;
+        bool forced;
+        std::function<int()> send;
+    };
+
+    int _bytesPerSecond = DEFAULT_BYTES_PER_SECOND;
+    float _budget = 0.0f;
+    std::vector<Update> _updates;
+
+    // stats of the last step
+    int _numSentUpdates = 0;
+    int _numDeferredUpdates = 0;
+    int _sentBytes = 0;
+};
+
+#endif // hifi_OutgoingUpdateScheduler_h
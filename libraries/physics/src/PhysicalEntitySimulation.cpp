@@ -207,6 +207,7 @@ void PhysicalEntitySimulation::handleOutgoingChanges(VectorOfMotionStates& motio
 
     uint32_t numSubsteps = _physicsEngine->getNumSubsteps();
     if (_lastStepSendPackets != numSubsteps) {
+        _updateScheduler.beginStep((float)(numSubsteps - _lastStepSendPackets) * PHYSICS_ENGINE_FIXED_SUBSTEP);
         _lastStepSendPackets = numSubsteps;
 
         if (sessionID.isNull()) {
@@ -215,19 +216,29 @@ void PhysicalEntitySimulation::handleOutgoingChanges(VectorOfMotionStates& motio
             return;
         }
 
-        // send outgoing packets
+        // rank the updates that are due, the ones held back gaining on the others until they are forced
         QSet<EntityMotionState*>::iterator stateItr = _outgoingChanges.begin();
         while (stateItr != _outgoingChanges.end()) {
             EntityMotionState* state = *stateItr;
             if (!state->isCandidateForOwnership(sessionID)) {
                 stateItr = _outgoingChanges.erase(stateItr);
-            } else if (state->shouldSendUpdate(numSubsteps, sessionID)) {
-                state->sendUpdate(_entityPacketSender, sessionID, numSubsteps);
-                ++stateItr;
             } else {
+                if (state->shouldSendUpdate(numSubsteps, sessionID)) {
+                    uint32_t numDeferredSteps = state->deferOutgoingUpdate();
+                    bool forced = state->isOutgoingUpdateForced() ||
+                        numDeferredSteps >= OutgoingUpdateScheduler::MAX_DEFERRED_STEPS;
+                    _updateScheduler.queueUpdate(state->getOutgoingError() * (float)(numDeferredSteps + 1), forced,
+                        [=] { return state->sendUpdate(_entityPacketSender, sessionID, numSubsteps); });
+                }
                 ++stateItr;
             }
         }
+
+        // the updates of the step share packets, which go out now rather than once full
+        _updateScheduler.sendUpdates();
+        if (_updateScheduler.getNumSentUpdates() > 0) {
+            _entityPacketSender->releaseQueuedMessages();
+        }
     }
 }
 
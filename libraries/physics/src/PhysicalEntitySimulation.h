@@ -22,6 +22,7 @@
 
 #include "PhysicsEngine.h"
 #include "EntityMotionState.h"
+#include "OutgoingUpdateScheduler.h"
 
 typedef QSet<EntityMotionState*> SetOfEntityMotionStates;
 
@@ -54,6 +55,9 @@ public:
 
     EntityEditPacketSender* getPacketSender() { return _entityPacketSender; }
 
+    /// Keeps the updates sent to the entity server within an upload budget
+    OutgoingUpdateScheduler& getUpdateScheduler() { return _updateScheduler; }
+
 private:
     // incoming changes
     SetOfEntityMotionStates _pendingRemoves; // EntityMotionStates to be removed from PhysicsEngine (and deleted)
@@ -70,6 +74,7 @@ private:
     EntityEditPacketSender* _entityPacketSender = nullptr;
 
     uint32_t _lastStepSendPackets = 0;
+    OutgoingUpdateScheduler _updateScheduler;
 };
 
 #endif // hifi_PhysicalEntitySimulation_h
@@ -92,6 +92,10 @@ public:
 
     void dumpNextStats() { _dumpNextStats = true; }
 
+    /// \brief solves the independent islands of objects on up to this many threads (one keeps it on the calling thread)
+    void setNumSolverThreads(int numThreads);
+    int getNumSolverThreads() const { return _numSolverThreads; }
+
     int16_t getCollisionMask(int16_t group) const;
 
     EntityActionPointer getActionByID(const QUuid& actionID) const;
@@ -121,6 +125,7 @@ private:
     DynamicCharacterController* _characterController = NULL;
 
     bool _dumpNextStats = false;
+    int _numSolverThreads;
     bool _hasOutgoingChanges = false;
 
     QUuid _sessionID;
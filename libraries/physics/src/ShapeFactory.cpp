@@ -9,14 +9,139 @@
 //  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
 //
 
+#include <cfloat>
+
+#include <QDataStream>
+
 #include <glm/gtx/norm.hpp>
 
+#include <LinearMath/btConvexHullComputer.h>
+
+#include <ResourceDiskCache.h>
 #include <SharedUtil.h> // for MILLIMETERS_PER_METER
 
 #include "ShapeFactory.h"
 #include "BulletUtil.h"
+#include "PhysicsLogging.h"
+
+// bumped whenever the simplification changes, which invalidates the cached hulls
+static const quint32 SIMPLIFIED_HULLS_VERSION = 2;
+static const QString SIMPLIFIED_HULLS_EXTENSION = ".hulls";
+
+QVector<glm::vec3> ShapeFactory::simplifyHull(const QVector<glm::vec3>& points, int maxPoints) {
+    // only the corners of the hull matter
+    QVector<glm::vec3> corners;
+    if (points.size() >= 4) {
+        btConvexHullComputer computer;
+        computer.compute(&points[0].x, sizeof(glm::vec3), points.size(), 0.0f, 0.0f);
+        corners.resize(computer.vertices.size());
+        for (int i = 0; i < corners.size(); i++) {
+            corners[i] = bulletToGLM(computer.vertices[i]);
+        }
+    }
+    if (corners.size() < 4) {
+        // flat or degenerate, which the computer doesn't always make sense of
+        corners = points;
+    }
+    if (corners.size() <= maxPoints) {
+        return corners;
+    }
+
+    // keep the corner farthest from the center, then over and over the one farthest from those already kept
+    glm::vec3 center(0.0f);
+    foreach (const glm::vec3& corner, corners) {
+        center += corner;
+    }
+    center /= (float)corners.size();
+    QVector<float> distances(corners.size());
+    int farthest = 0;
+    for (int i = 0; i < corners.size(); i++) {
+        distances[i] = glm::distance2(corners[i], center);
+        if (distances[i] > distances[farthest]) {
+            farthest = i;
+        }
+    }
+    QVector<glm::vec3> simplified;
+    simplified.reserve(maxPoints);
+    for (int i = 0; i < corners.size(); i++) {
+        distances[i] = FLT_MAX;
+    }
+    while (simplified.size() < maxPoints) {
+        const glm::vec3 kept = corners[farthest];
+        simplified.append(kept);
+        for (int i = 0; i < corners.size(); i++) {
+            distances[i] = glm::min(distances[i], glm::distance2(corners[i], kept));
+        }
+        // only pick once all the distances are down to date, which leaves the kept corners at zero
+        farthest = 0;
+        for (int i = 1; i < corners.size(); i++) {
+            if (distances[i] > distances[farthest]) {
+                farthest = i;
+            }
+        }
+    }
+    return simplified;
+}
+
+QVector<QVector<glm::vec3>> ShapeFactory::simplifyHulls(const QVector<QVector<glm::vec3>>& points,
+                                                         ResourceDiskCache* hullCache) {
+    QString name;
+    if (hullCache) {
+        // the cached hulls go by the hash of the points they were simplified from
+        QByteArray content;
+        QDataStream stream(&content, QIODevice::WriteOnly);
+        stream << SIMPLIFIED_HULLS_VERSION << (quint32)MAX_HULL_POINTS << (quint32)points.size();
+        foreach (const QVector<glm::vec3>& hull, points) {
+            stream << (quint32)hull.size();
+            stream.writeRawData(reinterpret_cast<const char*>(hull.constData()), hull.size() * sizeof(glm::vec3));
+        }
+        name = ResourceDiskCache::getContentHash(content) + SIMPLIFIED_HULLS_EXTENSION;
+
+        QByteArray cached;
+        if (hullCache->load(name, cached)) {
+            QDataStream stream(cached);
+            quint32 numHulls = 0;
+            stream >> numHulls;
+            QVector<QVector<glm::vec3>> hulls;
+            for (quint32 i = 0; i < numHulls && stream.status() == QDataStream::Ok; i++) {
+                quint32 numPoints = 0;
+                stream >> numPoints;
+                if (numPoints > (quint32)MAX_HULL_POINTS) {
+                    stream.setStatus(QDataStream::ReadCorruptData);
+                    break;
+                }
+                QVector<glm::vec3> hull(numPoints);
+                stream.readRawData(reinterpret_cast<char*>(hull.data()), numPoints * sizeof(glm::vec3));
+                hulls.append(hull);
+            }
+            if (stream.status() == QDataStream::Ok && stream.atEnd() && numHulls == (quint32)points.size()) {
+                return hulls;
+            }
+            qCDebug(physics) << "Removing corrupt simplified hulls" << name;
+            hullCache->remove(name);
+        }
+    }
 
+    QVector<QVector<glm::vec3>> hulls;
+    hulls.reserve(points.size());
+    foreach (const QVector<glm::vec3>& hull, points) {
+        hulls.append(simplifyHull(hull));
+    }
 
+    if (hullCache) {
+        QByteArray data;
+        QDataStream stream(&data, QIODevice::WriteOnly);
+        stream << (quint32)hulls.size();
+        foreach (const QVector<glm::vec3>& hull, hulls) {
+            stream << (quint32)hull.size();
+            stream.writeRawData(reinterpret_cast<const char*>(hull.constData()), hull.size() * sizeof(glm::vec3));
+        }
+        if (!hullCache->store(name, data)) {
+            qCDebug(physics) << "Failed to store simplified hulls" << name;
+        }
+    }
+    return hulls;
+}
 
 btConvexHullShape* ShapeFactory::createConvexHull(const QVector<glm::vec3>& points) {
     assert(points.size() > 0);
@@ -68,7 +193,7 @@ btConvexHullShape* ShapeFactory::createConvexHull(const QVector<glm::vec3>& poin
     return hull;
 }
 
-btCollisionShape* ShapeFactory::createShapeFromInfo(const ShapeInfo& info) {
+btCollisionShape* ShapeFactory::createShapeFromInfo(const ShapeInfo& info, ResourceDiskCache* hullCache) {
     btCollisionShape* shape = NULL;
     int type = info.getType();
     switch(type) {
@@ -89,10 +214,9 @@ btCollisionShape* ShapeFactory::createShapeFromInfo(const ShapeInfo& info) {
         }
         break;
         case SHAPE_TYPE_COMPOUND: {
-            const QVector<QVector<glm::vec3>>& points = info.getPoints();
-            uint32_t numSubShapes = info.getNumSubShapes();
-            if (numSubShapes == 1) {
-                shape = createConvexHull(info.getPoints()[0]);
+            QVector<QVector<glm::vec3>> points = simplifyHulls(info.getPoints(), hullCache);
+            if (points.size() == 1) {
+                shape = createConvexHull(points[0]);
             } else {
                 auto compound = new btCompoundShape();
                 btTransform trans;
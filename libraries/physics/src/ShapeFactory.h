@@ -17,11 +17,24 @@
 
 #include <ShapeInfo.h>
 
+class ResourceDiskCache;
+
 // translates between ShapeInfo and btShape
 
 namespace ShapeFactory {
+    /// Bullet slows down past about a hundred points per hull, for little difference in shape
+    const int MAX_HULL_POINTS = 64;
+
+    /// \return the corners of the hull of the points, simplified to the most spread out maxPoints of them
+    QVector<glm::vec3> simplifyHull(const QVector<glm::vec3>& points, int maxPoints = MAX_HULL_POINTS);
+
+    /// \return the simplified hulls, from the cache if it has them from the same points
+    QVector<QVector<glm::vec3>> simplifyHulls(const QVector<QVector<glm::vec3>>& points, ResourceDiskCache* hullCache);
+
     btConvexHullShape* createConvexHull(const QVector<glm::vec3>& points);
-    btCollisionShape* createShapeFromInfo(const ShapeInfo& info);
+
+    /// Can be called from any thread.  The hulls are simplified, through the cache if there is one.
+    btCollisionShape* createShapeFromInfo(const ShapeInfo& info, ResourceDiskCache* hullCache = nullptr);
 };
 
 #endif // hifi_ShapeFactory_h
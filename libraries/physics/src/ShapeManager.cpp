@@ -10,12 +10,64 @@
 //
 
 #include <QDebug>
+#include <QMutex>
+#include <QRunnable>
+#include <QThreadPool>
 
 #include <glm/gtx/norm.hpp>
 
 #include "ShapeFactory.h"
 #include "ShapeManager.h"
 
+static void deleteShape(const btCollisionShape* shape) {
+    // the children of compound shapes are theirs alone
+    if (shape->getShapeType() == COMPOUND_SHAPE_PROXYTYPE) {
+        const btCompoundShape* compoundShape = static_cast<const btCompoundShape*>(shape);
+        const int numChildShapes = compoundShape->getNumChildShapes();
+        for (int i = 0; i < numChildShapes; i ++) {
+            delete compoundShape->getChildShape(i);
+        }
+    }
+    delete shape;
+}
+
+// A shape being built on the thread pool, which the manager may give up on before it's done
+class ShapeBuild {
+public:
+    ShapeBuild(const DoubleHashKey& key) : key(key) { }
+
+    const DoubleHashKey key;
+    QMutex mutex;
+    btCollisionShape* shape = nullptr;
+    bool finished = false;
+    bool abandoned = false;
+};
+
+class ShapeBuilder : public QRunnable {
+public:
+    ShapeBuilder(const ShapeInfo& info, const std::shared_ptr<ShapeBuild>& build,
+                 const QSharedPointer<ResourceDiskCache>& hullCache) :
+        _info(info), _build(build), _hullCache(hullCache) { }
+
+    virtual void run() {
+        btCollisionShape* shape = ShapeFactory::createShapeFromInfo(_info, _hullCache.data());
+        QMutexLocker locker(&_build->mutex);
+        if (_build->abandoned) {
+            if (shape) {
+                deleteShape(shape);
+            }
+        } else {
+            _build->shape = shape;
+            _build->finished = true;
+        }
+    }
+
+private:
+    ShapeInfo _info;
+    std::shared_ptr<ShapeBuild> _build;
+    QSharedPointer<ResourceDiskCache> _hullCache;
+};
+
 ShapeManager::ShapeManager() {
 }
 
@@ -26,6 +78,18 @@ ShapeManager::~ShapeManager() {
         delete shapeRef->shape;
     }
     _shapeMap.clear();
+
+    for (int i = 0; i < _builds.size(); i++) {
+        ShapeBuild* build = _builds.getAtIndex(i)->get();
+        QMutexLocker locker(&build->mutex);
+        if (build->finished) {
+            if (build->shape) {
+                deleteShape(build->shape);
+            }
+        } else {
+            build->abandoned = true;
+        }
+    }
 }
 
 btCollisionShape* ShapeManager::getShape(const ShapeInfo& info) {
@@ -40,13 +104,23 @@ btCollisionShape* ShapeManager::getShape(const ShapeInfo& info) {
         // qCDebug(physics) << "ShapeManager::getShape -- not making shape due to size" << diagonal;
         return NULL;
     }
+    takeBuiltShapes();
     DoubleHashKey key = info.getHash();
     ShapeReference* shapeRef = _shapeMap.find(key);
     if (shapeRef) {
         shapeRef->refCount++;
         return shapeRef->shape;
     }
-    btCollisionShape* shape = ShapeFactory::createShapeFromInfo(info);
+    if (info.getType() == SHAPE_TYPE_COMPOUND && _buildInBackground) {
+        // the hulls take long enough to simplify and build to hold up the simulation
+        if (!(_builds.find(key) || _failedBuilds.find(key))) {
+            std::shared_ptr<ShapeBuild> build = std::make_shared<ShapeBuild>(key);
+            _builds.insert(key, build);
+            QThreadPool::globalInstance()->start(new ShapeBuilder(info, build, _hullCache));
+        }
+        return NULL;
+    }
+    btCollisionShape* shape = ShapeFactory::createShapeFromInfo(info, _hullCache.data());
     if (shape) {
         ShapeReference newRef;
         newRef.refCount = 1;
@@ -57,6 +131,34 @@ btCollisionShape* ShapeManager::getShape(const ShapeInfo& info) {
     return shape;
 }
 
+bool ShapeManager::isBuilding(const ShapeInfo& info) const {
+    return _builds.find(info.getHash()) != NULL;
+}
+
+// private helper method
+void ShapeManager::takeBuiltShapes() {
+    for (int i = _builds.size() - 1; i >= 0; i--) {
+        ShapeBuild* build = _builds.getAtIndex(i)->get();
+        QMutexLocker locker(&build->mutex);
+        if (!build->finished) {
+            continue;
+        }
+        DoubleHashKey key = build->key;
+        if (build->shape) {
+            // nothing refers to the shape until it's asked for again, and it only becomes garbage once released after that
+            ShapeReference newRef;
+            newRef.refCount = 0;
+            newRef.shape = build->shape;
+            newRef.key = key;
+            _shapeMap.insert(key, newRef);
+        } else {
+            _failedBuilds.insert(key, true);
+        }
+        locker.unlock();
+        _builds.remove(key);
+    }
+}
+
 // private helper method
 bool ShapeManager::releaseShape(const DoubleHashKey& key) {
     ShapeReference* shapeRef = _shapeMap.find(key);
@@ -103,17 +205,7 @@ void ShapeManager::collectGarbage() {
         DoubleHashKey& key = _pendingGarbage[i];
         ShapeReference* shapeRef = _shapeMap.find(key);
         if (shapeRef && shapeRef->refCount == 0) {
-            // if the shape we're about to delete is compound, delete the children first.
-            if (shapeRef->shape->getShapeType() == COMPOUND_SHAPE_PROXYTYPE) {
-                const btCompoundShape* compoundShape = static_cast<const btCompoundShape*>(shapeRef->shape);
-                const int numChildShapes = compoundShape->getNumChildShapes();
-                for (int i = 0; i < numChildShapes; i ++) {
-                    const btCollisionShape* childShape = compoundShape->getChildShape(i);
-                    delete childShape;
-                }
-            }
-
-            delete shapeRef->shape;
+            deleteShape(shapeRef->shape);
             _shapeMap.remove(key);
         }
     }
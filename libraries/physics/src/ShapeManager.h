@@ -12,22 +12,38 @@
 #ifndef hifi_ShapeManager_h
 #define hifi_ShapeManager_h
 
+#include <memory>
+
+#include <QSharedPointer>
+
 #include <btBulletDynamicsCommon.h>
 #include <LinearMath/btHashMap.h>
 
+#include <ResourceDiskCache.h>
 #include <ShapeInfo.h>
 
 #include "DoubleHashKey.h"
 
+class ShapeBuild;
+
 class ShapeManager {
 public:
 
     ShapeManager();
     ~ShapeManager();
 
-    /// \return pointer to shape
+    /// \return pointer to shape, or null while a shape made of hulls is built in the background (or if it failed to build)
     btCollisionShape* getShape(const ShapeInfo& info);
 
+    /// \return true if the shape is being built in the background, and getShape should be asked again later
+    bool isBuilding(const ShapeInfo& info) const;
+
+    /// Builds the shapes made of hulls on the thread pool rather than in getShape (on by default)
+    void setBuildInBackground(bool buildInBackground) { _buildInBackground = buildInBackground; }
+
+    /// Keeps the simplified hulls in the cache, so that they needn't be simplified again
+    void setHullCache(const QSharedPointer<ResourceDiskCache>& hullCache) { _hullCache = hullCache; }
+
     /// \return true if shape was found and released
     bool releaseShape(const ShapeInfo& info);
     bool releaseShape(const btCollisionShape* shape);
@@ -37,12 +53,14 @@ public:
 
     // validation methods
     int getNumShapes() const { return _shapeMap.size(); }
+    int getNumBuilds() const { return _builds.size(); }
     int getNumReferences(const ShapeInfo& info) const;
     int getNumReferences(const btCollisionShape* shape) const;
     bool hasShape(const btCollisionShape* shape) const; 
 
 private:
     bool releaseShape(const DoubleHashKey& key);
+    void takeBuiltShapes();
 
     struct ShapeReference {
         int refCount;
@@ -53,6 +71,11 @@ private:
 
     btHashMap<DoubleHashKey, ShapeReference> _shapeMap;
     btAlignedObjectArray<DoubleHashKey> _pendingGarbage;
+
+    btHashMap<DoubleHashKey, std::shared_ptr<ShapeBuild>> _builds;
+    btHashMap<DoubleHashKey, bool> _failedBuilds; // the same info would fail again, so it isn't built again
+    bool _buildInBackground = true;
+    QSharedPointer<ResourceDiskCache> _hullCache;
 };
 
 #endif // hifi_ShapeManager_h
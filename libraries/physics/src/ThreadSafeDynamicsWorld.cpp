@@ -15,8 +15,15 @@
  * Copied and modified from btDiscreteDynamicsWorld.cpp by AndrewMeadows on 2014.11.12.
  * */
 
+#include <algorithm>
+#include <functional>
+#include <unordered_map>
+
+#include <BulletCollision/CollisionDispatch/btSimulationIslandManager.h>
 #include <LinearMath/btQuickprof.h>
 
+#include <tbb/parallel_for.h>
+
 #include "ThreadSafeDynamicsWorld.h"
 
 ThreadSafeDynamicsWorld::ThreadSafeDynamicsWorld(
@@ -24,7 +31,22 @@ ThreadSafeDynamicsWorld::ThreadSafeDynamicsWorld(
         btBroadphaseInterface* pairCache,
         btConstraintSolver* constraintSolver,
         btCollisionConfiguration* collisionConfiguration)
-    :   btDiscreteDynamicsWorld(dispatcher, pairCache, constraintSolver, collisionConfiguration) {
+    :   btDiscreteDynamicsWorld(dispatcher, pairCache, constraintSolver, collisionConfiguration),
+        _solvers(nullptr) {
+}
+
+ThreadSafeDynamicsWorld::~ThreadSafeDynamicsWorld() {
+    for (auto solver : _solvers) {
+        delete solver;
+    }
+}
+
+void ThreadSafeDynamicsWorld::setNumSolverThreads(int numThreads) {
+    numThreads = std::max(numThreads, 1);
+    if (numThreads != _numSolverThreads) {
+        _numSolverThreads = numThreads;
+        _arena.reset(numThreads > 1 ? new tbb::task_arena(numThreads) : nullptr);
+    }
 }
 
 int ThreadSafeDynamicsWorld::stepSimulation( btScalar timeStep, int maxSubSteps, btScalar fixedTimeStep) {
@@ -114,3 +136,196 @@ void ThreadSafeDynamicsWorld::synchronizeMotionStates() {
     }   
 }       
 
+void ThreadSafeDynamicsWorld::predictUnconstrainedMotion(btScalar timeStep) {
+    if (!_arena) {
+        btDiscreteDynamicsWorld::predictUnconstrainedMotion(timeStep);
+        return;
+    }
+    BT_PROFILE("predictUnconstrainedMotion");
+    const int BODIES_PER_TASK = 256;
+    _arena->execute([&] {
+        tbb::parallel_for(tbb::blocked_range<int>(0, m_nonStaticRigidBodies.size(), BODIES_PER_TASK),
+                [&](const tbb::blocked_range<int>& range) {
+            for (int i = range.begin(); i != range.end(); i++) {
+                btRigidBody* body = m_nonStaticRigidBodies[i];
+                if (!body->isStaticOrKinematicObject()) {
+                    // velocities are integrated by the constraint solver
+                    body->applyDamping(timeStep);
+                    body->predictIntegratedTransform(timeStep, body->getInterpolationWorldTransform());
+                }
+            }
+        });
+    });
+}
+
+// Copies out the islands that Bullet hands to the solver one at a time, so that they can be solved together
+class IslandCollector : public btSimulationIslandManager::IslandCallback {
+public:
+    typedef std::function<void(btCollisionObject**, int, btPersistentManifold**, int, int)> Collect;
+
+    IslandCollector(Collect collect) : _collect(collect) { }
+
+    virtual void processIsland(btCollisionObject** bodies, int numBodies, btPersistentManifold** manifolds,
+                               int numManifolds, int islandId) {
+        _collect(bodies, numBodies, manifolds, numManifolds, islandId);
+    }
+
+private:
+    Collect _collect;
+};
+
+void ThreadSafeDynamicsWorld::solveConstraints(btContactSolverInfo& solverInfo) {
+    if (!_arena) {
+        btDiscreteDynamicsWorld::solveConstraints(solverInfo);
+        return;
+    }
+    BT_PROFILE("solveConstraints");
+    m_constraintSolver->prepareSolve(getCollisionWorld()->getNumCollisionObjects(),
+        getCollisionWorld()->getDispatcher()->getNumManifolds());
+
+    collectIslands();
+    groupIslands();
+
+    if (_tasks.size() < 2) {
+        // nothing to share out
+        for (const auto& task : _tasks) {
+            solveTask(task, m_constraintSolver, solverInfo);
+        }
+    } else {
+        // the solvers keep scratch pools from one solve to the next, so each thread has its own
+        _arena->execute([&] {
+            tbb::parallel_for(0, (int)_tasks.size(), [&](int i) {
+                btSequentialImpulseConstraintSolver*& solver = _solvers.local();
+                if (!solver) {
+                    solver = new btSequentialImpulseConstraintSolver();
+                }
+                solveTask(_tasks[i], solver, solverInfo);
+            });
+        });
+    }
+
+    m_constraintSolver->allSolved(solverInfo, m_debugDrawer);
+}
+
+void ThreadSafeDynamicsWorld::collectIslands() {
+    BT_PROFILE("collectIslands");
+    _numIslands = 0;
+    std::unordered_map<int, int> islandIndices;
+    IslandCollector collector([&](btCollisionObject** bodies, int numBodies, btPersistentManifold** manifolds,
+                                  int numManifolds, int islandId) {
+        if (_numIslands == (int)_islands.size()) {
+            _islands.emplace_back();
+        }
+        Island& island = _islands[_numIslands];
+        island.id = islandId;
+        island.bodies.assign(bodies, bodies + numBodies);
+        island.manifolds.assign(manifolds, manifolds + numManifolds);
+        island.constraints.clear();
+        islandIndices[islandId] = _numIslands++;
+    });
+    m_islandManager->buildAndProcessIslands(getCollisionWorld()->getDispatcher(), getCollisionWorld(), &collector);
+
+    // the constraints go with the island of their first dynamic body, as in btDiscreteDynamicsWorld; those of the
+    // islands that sleep aren't solved
+    for (int i = 0; i < m_constraints.size(); i++) {
+        btTypedConstraint* constraint = m_constraints[i];
+        if (!constraint->isEnabled()) {
+            continue;
+        }
+        int tag = constraint->getRigidBodyA().getIslandTag();
+        if (tag < 0) {
+            tag = constraint->getRigidBodyB().getIslandTag();
+        }
+        if (_numIslands == 1 && _islands[0].id < 0) {
+            // the islands weren't split, so everything is in the one
+            _islands[0].constraints.push_back(constraint);
+            continue;
+        }
+        auto index = islandIndices.find(tag);
+        if (index != islandIndices.end()) {
+            _islands[index->second].constraints.push_back(constraint);
+        }
+    }
+}
+
+void ThreadSafeDynamicsWorld::groupIslands() {
+    BT_PROFILE("groupIslands");
+
+    // kinematic objects don't join islands, but the solver marks the ones it touches, so the islands that touch the
+    // same kinematic object have to be solved in turn, on the same thread
+    std::vector<int> parents(_numIslands);
+    for (int i = 0; i < _numIslands; i++) {
+        parents[i] = i;
+    }
+    auto findRoot = [&](int index) {
+        while (parents[index] != index) {
+            index = parents[index] = parents[parents[index]];
+        }
+        return index;
+    };
+    std::unordered_map<const btCollisionObject*, int> kinematicIslands;
+    auto share = [&](const btCollisionObject* object, int island) {
+        if (object->isKinematicObject()) {
+            auto found = kinematicIslands.find(object);
+            if (found == kinematicIslands.end()) {
+                kinematicIslands[object] = island;
+            } else {
+                parents[findRoot(island)] = findRoot(found->second);
+            }
+        }
+    };
+    for (int i = 0; i < _numIslands; i++) {
+        for (auto manifold : _islands[i].manifolds) {
+            share(manifold->getBody0(), i);
+            share(manifold->getBody1(), i);
+        }
+        for (auto constraint : _islands[i].constraints) {
+            share(&constraint->getRigidBodyA(), i);
+            share(&constraint->getRigidBodyB(), i);
+        }
+    }
+
+    for (auto& task : _tasks) {
+        task.clear();
+    }
+    std::vector<int> taskIndices(_numIslands, -1);
+    int numTasks = 0;
+    for (int i = 0; i < _numIslands; i++) {
+        int root = findRoot(i);
+        if (taskIndices[root] == -1) {
+            taskIndices[root] = numTasks++;
+            if (numTasks > (int)_tasks.size()) {
+                _tasks.emplace_back();
+            }
+        }
+        _tasks[taskIndices[root]].push_back(i);
+    }
+    _tasks.resize(numTasks);
+
+    // the largest tasks go first, so that the small ones fill in around them
+    std::vector<std::pair<int, int>> costs(numTasks);
+    for (int i = 0; i < numTasks; i++) {
+        int cost = 0;
+        for (int island : _tasks[i]) {
+            cost += _islands[island].cost();
+        }
+        costs[i] = std::make_pair(-cost, i);
+    }
+    std::sort(costs.begin(), costs.end());
+    std::vector<std::vector<int>> sortedTasks(numTasks);
+    for (int i = 0; i < numTasks; i++) {
+        sortedTasks[i].swap(_tasks[costs[i].second]);
+    }
+    _tasks.swap(sortedTasks);
+}
+
+void ThreadSafeDynamicsWorld::solveTask(const std::vector<int>& task, btConstraintSolver* solver,
+                                        const btContactSolverInfo& solverInfo) {
+    for (int index : task) {
+        Island& island = _islands[index];
+        solver->solveGroup(island.bodies.data(), (int)island.bodies.size(),
+            island.manifolds.data(), (int)island.manifolds.size(),
+            island.constraints.data(), (int)island.constraints.size(),
+            solverInfo, nullptr, m_dispatcher1);
+    }
+}
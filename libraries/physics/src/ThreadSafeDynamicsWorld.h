@@ -18,9 +18,16 @@
 #ifndef hifi_ThreadSafeDynamicsWorld_h
 #define hifi_ThreadSafeDynamicsWorld_h
 
+#include <memory>
+#include <vector>
+
+#include <BulletDynamics/ConstraintSolver/btSequentialImpulseConstraintSolver.h>
 #include <BulletDynamics/Dynamics/btRigidBody.h>
 #include <BulletDynamics/Dynamics/btDiscreteDynamicsWorld.h>
 
+#include <tbb/enumerable_thread_specific.h>
+#include <tbb/task_arena.h>
+
 #include "ObjectMotionState.h"
 
 ATTRIBUTE_ALIGNED16(class) ThreadSafeDynamicsWorld : public btDiscreteDynamicsWorld {
@@ -32,6 +39,7 @@ public:
             btBroadphaseInterface* pairCache,
             btConstraintSolver* constraintSolver,
             btCollisionConfiguration* collisionConfiguration);
+    ~ThreadSafeDynamicsWorld();
 
     // virtual overrides from btDiscreteDynamicsWorld
     int stepSimulation( btScalar timeStep, int maxSubSteps=1, btScalar fixedTimeStep=btScalar(1.)/btScalar(60.));
@@ -44,8 +52,44 @@ public:
 
     VectorOfMotionStates& getChangedMotionStates() { return _changedMotionStates; }
 
+    /// Simulation islands share no dynamic body, so they are solved in parallel on up to this many threads (the calling
+    /// thread included).  One solves everything on the calling thread, the way btDiscreteDynamicsWorld does.
+    void setNumSolverThreads(int numThreads);
+    int getNumSolverThreads() const { return _numSolverThreads; }
+
+    /// \return the number of islands solved by the last substep, and the number of tasks they were solved in
+    int getNumSolvedIslands() const { return _numIslands; }
+    int getNumSolverTasks() const { return (int)_tasks.size(); }
+
+protected:
+    // virtual overrides from btDiscreteDynamicsWorld
+    void predictUnconstrainedMotion(btScalar timeStep);
+    void solveConstraints(btContactSolverInfo& solverInfo);
+
 private:
+    class Island {
+    public:
+        int id;
+        std::vector<btCollisionObject*> bodies;
+        std::vector<btPersistentManifold*> manifolds;
+        std::vector<btTypedConstraint*> constraints;
+        int cost() const { return (int)(bodies.size() + manifolds.size() + constraints.size()); }
+    };
+
+    void collectIslands();
+    void groupIslands();
+    void solveTask(const std::vector<int>& task, btConstraintSolver* solver, const btContactSolverInfo& solverInfo);
+
     VectorOfMotionStates _changedMotionStates;
+
+    int _numSolverThreads = 1;
+    std::unique_ptr<tbb::task_arena> _arena;
+    tbb::enumerable_thread_specific<btSequentialImpulseConstraintSolver*> _solvers;
+
+    // reused from one substep to the next
+    std::vector<Island> _islands;
+    int _numIslands = 0;
+    std::vector<std::vector<int>> _tasks;
 };
 
 #endif // hifi_ThreadSafeDynamicsWorld_h
@@ -339,7 +339,7 @@ void AnimDebugDraw::update() {
 
         for (auto&& iter : _animNodes) {
             AnimNode::ConstPointer& animNode = std::get<0>(iter.second);
-            auto poses = animNode->getPosesInternal();
+            const AnimPoseBuffer& poses = animNode->getPosesInternal();
             numVerts += poses.size() * VERTICES_PER_BONE;
             auto skeleton = animNode->getSkeleton();
             for (size_t i = 0; i < poses.size(); i++) {
@@ -391,7 +391,7 @@ void AnimDebugDraw::update() {
             }
             glm::vec4 color = std::get<2>(iter.second);
 
-            auto poses = animNode->getPosesInternal();
+            const AnimPoseBuffer& poses = animNode->getPosesInternal();
 
             auto skeleton = animNode->getSkeleton();
 
@@ -402,9 +402,9 @@ void AnimDebugDraw::update() {
 
                 auto parentIndex = skeleton->getParentIndex(i);
                 if (parentIndex >= 0) {
-                    absAnimPose[i] = absAnimPose[parentIndex] * poses[i];
+                    absAnimPose[i] = absAnimPose[parentIndex] * poses.getPose(i);
                 } else {
-                    absAnimPose[i] = poses[i];
+                    absAnimPose[i] = poses.getPose(i);
                 }
 
                 const float radius = BONE_RADIUS / (absAnimPose[i].scale.x * rootPose.scale.x);
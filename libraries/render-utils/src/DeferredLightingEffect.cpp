@@ -26,6 +26,7 @@
 
 
 #include "simple_vert.h"
+#include "simple_instanced_vert.h"
 #include "simple_textured_frag.h"
 #include "simple_textured_emisive_frag.h"
 
@@ -50,6 +51,9 @@
 
 static const std::string glowIntensityShaderHandle = "glowIntensity";
 
+static const std::string SOLID_CUBE_INSTANCES_NAME = "DeferredLightingEffect::solidCubes";
+static const std::string SOLID_SPHERE_INSTANCES_NAME = "DeferredLightingEffect::solidSpheres";
+
 gpu::PipelinePointer DeferredLightingEffect::getPipeline(SimpleProgramKey config) {
     auto it = _simplePrograms.find(config);
     if (it != _simplePrograms.end()) {
@@ -71,7 +75,8 @@ gpu::PipelinePointer DeferredLightingEffect::getPipeline(SimpleProgramKey config
                             gpu::State::SRC_ALPHA, gpu::State::BLEND_OP_ADD, gpu::State::INV_SRC_ALPHA,
                             gpu::State::FACTOR_ALPHA, gpu::State::BLEND_OP_ADD, gpu::State::ONE);
     
-    gpu::ShaderPointer program = (config.isEmissive()) ? _emissiveShader : _simpleShader;
+    gpu::ShaderPointer program = (config.isEmissive()) ? _emissiveShader :
+        (config.isInstanced() ? _simpleInstancedShader : _simpleShader);
     gpu::PipelinePointer pipeline = gpu::PipelinePointer(gpu::Pipeline::create(program, state));
     _simplePrograms.insert(config, pipeline);
     return pipeline;
@@ -79,16 +84,19 @@ gpu::PipelinePointer DeferredLightingEffect::getPipeline(SimpleProgramKey config
 
 void DeferredLightingEffect::init(AbstractViewStateInterface* viewState) {
     auto VS = gpu::ShaderPointer(gpu::Shader::createVertex(std::string(simple_vert)));
+    auto VSInstanced = gpu::ShaderPointer(gpu::Shader::createVertex(std::string(simple_instanced_vert)));
     auto PS = gpu::ShaderPointer(gpu::Shader::createPixel(std::string(simple_textured_frag)));
     auto PSEmissive = gpu::ShaderPointer(gpu::Shader::createPixel(std::string(simple_textured_emisive_frag)));
     
     _simpleShader = gpu::ShaderPointer(gpu::Shader::createProgram(VS, PS));
     _emissiveShader = gpu::ShaderPointer(gpu::Shader::createProgram(VS, PSEmissive));
+    _simpleInstancedShader = gpu::ShaderPointer(gpu::Shader::createProgram(VSInstanced, PS));
     
     gpu::Shader::BindingSet slotBindings;
     slotBindings.insert(gpu::Shader::Binding(std::string("normalFittingMap"), DeferredLightingEffect::NORMAL_FITTING_MAP_SLOT));
     gpu::Shader::makeProgram(*_simpleShader, slotBindings);
     gpu::Shader::makeProgram(*_emissiveShader, slotBindings);
+    gpu::Shader::makeProgram(*_simpleInstancedShader, slotBindings);
 
     _viewState = viewState;
     loadLightProgram(deferred_light_vert, directional_light_frag, false, _directionalLight, _directionalLightLocations);
@@ -142,11 +150,12 @@ void DeferredLightingEffect::init(AbstractViewStateInterface* viewState) {
 
 
 void DeferredLightingEffect::bindSimpleProgram(gpu::Batch& batch, bool textured, bool culled,
-                                               bool emmisive, bool depthBias) {
-    SimpleProgramKey config{textured, culled, emmisive, depthBias};
+                                               bool emmisive, bool depthBias, bool instanced) {
+    SimpleProgramKey config{textured, culled, emmisive, depthBias, instanced};
     batch.setPipeline(getPipeline(config));
 
-    gpu::ShaderPointer program = (config.isEmissive()) ? _emissiveShader : _simpleShader;
+    gpu::ShaderPointer program = (config.isEmissive()) ? _emissiveShader :
+        (config.isInstanced() ? _simpleInstancedShader : _simpleShader);
     int glowIntensity = program->getUniforms().findLocation("glowIntensity");
     batch._glUniform1f(glowIntensity, 1.0f);
     
@@ -173,6 +182,44 @@ void DeferredLightingEffect::renderSolidCube(gpu::Batch& batch, float size, cons
     DependencyManager::get<GeometryCache>()->renderSolidCube(batch, size, color);
 }
 
+// Appends the placement and color of one instance to the named buffers of the batch
+static void appendInstance(gpu::Batch& batch, const std::string& name, const Transform& transform, const glm::vec4& color) {
+    glm::quat rotation = transform.getRotation();
+    glm::vec4 rotationData(rotation.x, rotation.y, rotation.z, rotation.w);
+    glm::vec3 scale = transform.getScale();
+    glm::vec3 translation = transform.getTranslation();
+    int compactColor = ((int(color.x * 255.0f) & 0xFF)) |
+                        ((int(color.y * 255.0f) & 0xFF) << 8) |
+                        ((int(color.z * 255.0f) & 0xFF) << 16) |
+                        ((int(color.w * 255.0f) & 0xFF) << 24);
+
+    batch.getNamedBuffer(name, GeometryCache::INSTANCE_ROTATION_BUFFER)->append(sizeof(rotationData), (gpu::Byte*) &rotationData);
+    batch.getNamedBuffer(name, GeometryCache::INSTANCE_SCALE_BUFFER)->append(sizeof(scale), (gpu::Byte*) &scale);
+    batch.getNamedBuffer(name, GeometryCache::INSTANCE_TRANSLATION_BUFFER)->append(sizeof(translation), (gpu::Byte*) &translation);
+    batch.getNamedBuffer(name, GeometryCache::INSTANCE_COLOR_BUFFER)->append(sizeof(compactColor), (gpu::Byte*) &compactColor);
+}
+
+void DeferredLightingEffect::renderSolidCubeInstance(gpu::Batch& batch, const Transform& transform, const glm::vec4& color) {
+    appendInstance(batch, SOLID_CUBE_INSTANCES_NAME, transform, color);
+    batch.setupNamedCalls(SOLID_CUBE_INSTANCES_NAME, 1, [](gpu::Batch& batch, gpu::Batch::NamedBatchData& data) {
+        DependencyManager::get<DeferredLightingEffect>()->bindSimpleProgram(batch, false, true, false, false, true);
+        batch.setModelTransform(Transform());
+        DependencyManager::get<GeometryCache>()->renderSolidCubeInstances(batch, data._count, data._buffers);
+    });
+}
+
+void DeferredLightingEffect::renderSolidSphereInstance(gpu::Batch& batch, const Transform& transform, int slices, int stacks,
+                                                       const glm::vec4& color) {
+    // spheres of different tessellations are different meshes, each gets its own draw
+    std::string name = SOLID_SPHERE_INSTANCES_NAME + "/" + std::to_string(slices) + "x" + std::to_string(stacks);
+    appendInstance(batch, name, transform, color);
+    batch.setupNamedCalls(name, 1, [slices, stacks](gpu::Batch& batch, gpu::Batch::NamedBatchData& data) {
+        DependencyManager::get<DeferredLightingEffect>()->bindSimpleProgram(batch, false, true, false, false, true);
+        batch.setModelTransform(Transform());
+        DependencyManager::get<GeometryCache>()->renderSolidSphereInstances(batch, slices, stacks, data._count, data._buffers);
+    });
+}
+
 void DeferredLightingEffect::renderWireCube(gpu::Batch& batch, float size, const glm::vec4& color) {
     bindSimpleProgram(batch);
     DependencyManager::get<GeometryCache>()->renderWireCube(batch, size, color);
@@ -36,7 +36,7 @@ public:
 
     /// Sets up the state necessary to render static untextured geometry with the simple program.
     void bindSimpleProgram(gpu::Batch& batch, bool textured = false, bool culled = true,
-                           bool emmisive = false, bool depthBias = false);
+                           bool emmisive = false, bool depthBias = false, bool instanced = false);
 
     //// Renders a solid sphere with the simple program.
     void renderSolidSphere(gpu::Batch& batch, float radius, int slices, int stacks, const glm::vec4& color);
@@ -47,6 +47,12 @@ public:
     //// Renders a solid cube with the simple program.
     void renderSolidCube(gpu::Batch& batch, float size, const glm::vec4& color);
 
+    //// Adds a unit cube placed by transform to the instances of the batch, drawn together when it is flushed.
+    void renderSolidCubeInstance(gpu::Batch& batch, const Transform& transform, const glm::vec4& color);
+
+    //// Adds a sphere of diameter 1 placed by transform to the instances of the batch, drawn together when it is flushed.
+    void renderSolidSphereInstance(gpu::Batch& batch, const Transform& transform, int slices, int stacks, const glm::vec4& color);
+
     //// Renders a wireframe cube with the simple program.
     void renderWireCube(gpu::Batch& batch, float size, const glm::vec4& color);
     
@@ -108,6 +114,7 @@ private:
     
     gpu::ShaderPointer _simpleShader;
     gpu::ShaderPointer _emissiveShader;
+    gpu::ShaderPointer _simpleInstancedShader;
     QHash<SimpleProgramKey, gpu::PipelinePointer> _simplePrograms;
 
     gpu::PipelinePointer _blitLightBuffer;
@@ -178,6 +185,7 @@ public:
         IS_CULLED_FLAG,
         IS_EMISSIVE_FLAG,
         HAS_DEPTH_BIAS_FLAG,
+        IS_INSTANCED_FLAG,
         
         NUM_FLAGS,
     };
@@ -187,6 +195,7 @@ public:
         IS_CULLED = (1 << IS_CULLED_FLAG),
         IS_EMISSIVE = (1 << IS_EMISSIVE_FLAG),
         HAS_DEPTH_BIAS = (1 << HAS_DEPTH_BIAS_FLAG),
+        IS_INSTANCED = (1 << IS_INSTANCED_FLAG),
     };
     typedef unsigned short Flags;
     
@@ -196,6 +205,7 @@ public:
     bool isCulled() const { return isFlag(IS_CULLED); }
     bool isEmissive() const { return isFlag(IS_EMISSIVE); }
     bool hasDepthBias() const { return isFlag(HAS_DEPTH_BIAS); }
+    bool isInstanced() const { return isFlag(IS_INSTANCED); }
     
     Flags _flags = 0;
     short _spare = 0;
@@ -204,9 +214,9 @@ public:
     
     
     SimpleProgramKey(bool textured = false, bool culled = true,
-                     bool emissive = false, bool depthBias = false) {
+                     bool emissive = false, bool depthBias = false, bool instanced = false) {
         _flags = (textured ? IS_TEXTURED : 0) | (culled ? IS_CULLED : 0) |
-        (emissive ? IS_EMISSIVE : 0) | (depthBias ? HAS_DEPTH_BIAS : 0);
+        (emissive ? IS_EMISSIVE : 0) | (depthBias ? HAS_DEPTH_BIAS : 0) | (instanced ? IS_INSTANCED : 0);
     }
     
     SimpleProgramKey(int bitmask) : _flags(bitmask) {}
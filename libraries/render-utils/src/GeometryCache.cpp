@@ -14,8 +14,8 @@
 #include <cmath>
 
 #include <QNetworkReply>
-#include <QThreadPool>
 
+#include <BakedGeometry.h>
 #include <FSTReader.h>
 #include <NumericalConstants.h>
 
@@ -61,6 +61,84 @@ const int NUM_TRIANGLES_PER_QUAD = 2;
 const int NUM_VERTICES_PER_TRIANGULATED_QUAD = NUM_VERTICES_PER_TRIANGLE * NUM_TRIANGLES_PER_QUAD;
 const int NUM_COORDS_PER_VERTEX = 3;
 
+static void appendSphereVertices(gpu::Buffer& buffer, float radius, int slices, int stacks) {
+    int vertices = slices * (stacks - 1) + 2;
+    GLfloat* vertexData = new GLfloat[vertices * NUM_COORDS_PER_VERTEX];
+    GLfloat* vertex = vertexData;
+
+    // south pole
+    *(vertex++) = 0.0f;
+    *(vertex++) = 0.0f;
+    *(vertex++) = -1.0f * radius;
+
+    //add stacks vertices climbing up Y axis
+    for (int i = 1; i < stacks; i++) {
+        float phi = PI * (float)i / (float)(stacks) - PI_OVER_TWO;
+        float z = sinf(phi) * radius;
+        float stackRadius = cosf(phi) * radius;
+
+        for (int j = 0; j < slices; j++) {
+            float theta = TWO_PI * (float)j / (float)slices;
+
+            *(vertex++) = sinf(theta) * stackRadius;
+            *(vertex++) = cosf(theta) * stackRadius;
+            *(vertex++) = z;
+        }
+    }
+
+    // north pole
+    *(vertex++) = 0.0f;
+    *(vertex++) = 0.0f;
+    *(vertex++) = 1.0f * radius;
+
+    buffer.append(sizeof(GLfloat) * vertices * NUM_COORDS_PER_VERTEX, (gpu::Byte*) vertexData);
+    delete[] vertexData;
+}
+
+static void appendSphereIndices(gpu::Buffer& buffer, int slices, int stacks) {
+    int indices = slices * (stacks - 1) * NUM_VERTICES_PER_TRIANGULATED_QUAD;
+    GLushort* indexData = new GLushort[indices];
+    GLushort* index = indexData;
+
+    // South cap
+    GLushort bottom = 0;
+    GLushort top = 1;
+    for (int i = 0; i < slices; i++) {
+        *(index++) = bottom;
+        *(index++) = top + i;
+        *(index++) = top + (i + 1) % slices;
+    }
+
+    // (stacks - 2) ribbons
+    for (int i = 0; i < stacks - 2; i++) {
+        bottom = i * slices + 1;
+        top = bottom + slices;
+        for (int j = 0; j < slices; j++) {
+            int next = (j + 1) % slices;
+
+            *(index++) = top + next;
+            *(index++) = bottom + j;
+            *(index++) = top + j;
+
+            *(index++) = bottom + next;
+            *(index++) = bottom + j;
+            *(index++) = top + next;
+        }
+    }
+
+    // north cap
+    bottom = (stacks - 2) * slices + 1;
+    top = bottom + slices;
+    for (int i = 0; i < slices; i++) {
+        *(index++) = bottom + (i + 1) % slices;
+        *(index++) = bottom + i;
+        *(index++) = top;
+    }
+
+    buffer.append(sizeof(GLushort) * indices, (gpu::Byte*) indexData);
+    delete[] indexData;
+}
+
 void GeometryCache::renderSphere(gpu::Batch& batch, float radius, int slices, int stacks, const glm::vec4& color, bool solid, int id) {
     bool registered = (id != UNKNOWN_ID);
 
@@ -89,36 +167,7 @@ void GeometryCache::renderSphere(gpu::Batch& batch, float radius, int slices, in
             _sphereVertices[radiusKey] = verticesBuffer;
         }
 
-        GLfloat* vertexData = new GLfloat[vertices * NUM_COORDS_PER_VERTEX];
-        GLfloat* vertex = vertexData;
-
-        // south pole
-        *(vertex++) = 0.0f;
-        *(vertex++) = 0.0f;
-        *(vertex++) = -1.0f * radius;
-
-        //add stacks vertices climbing up Y axis
-        for (int i = 1; i < stacks; i++) {
-            float phi = PI * (float)i / (float)(stacks) - PI_OVER_TWO;
-            float z = sinf(phi) * radius;
-            float stackRadius = cosf(phi) * radius;
-            
-            for (int j = 0; j < slices; j++) {
-                float theta = TWO_PI * (float)j / (float)slices;
-
-                *(vertex++) = sinf(theta) * stackRadius;
-                *(vertex++) = cosf(theta) * stackRadius;
-                *(vertex++) = z;
-            }
-        }
-
-        // north pole
-        *(vertex++) = 0.0f;
-        *(vertex++) = 0.0f;
-        *(vertex++) = 1.0f * radius;
-
-        verticesBuffer->append(sizeof(GLfloat) * vertices * NUM_COORDS_PER_VERTEX, (gpu::Byte*) vertexData);
-        delete[] vertexData;
+        appendSphereVertices(*verticesBuffer, radius, slices, stacks);
 
         #ifdef WANT_DEBUG
             qCDebug(renderutils) << "GeometryCache::renderSphere()... --- CREATING VERTICES BUFFER";
@@ -153,64 +202,13 @@ void GeometryCache::renderSphere(gpu::Batch& batch, float radius, int slices, in
             _sphereIndices[slicesStacksKey] = indicesBuffer;
         }
 
-        GLushort* indexData = new GLushort[indices];
-        GLushort* index = indexData;
-        
-        int indexCount = 0;
-
-        // South cap
-        GLushort bottom = 0;
-        GLushort top = 1;
-        for (int i = 0; i < slices; i++) {    
-            *(index++) = bottom;
-            *(index++) = top + i;
-            *(index++) = top + (i + 1) % slices;
-            
-            indexCount += 3;
-        }
-
-        // (stacks - 2) ribbons
-        for (int i = 0; i < stacks - 2; i++) {
-            bottom = i * slices + 1;
-            top = bottom + slices;
-            for (int j = 0; j < slices; j++) {
-                int next = (j + 1) % slices;
-                
-                *(index++) = top + next;
-                *(index++) = bottom + j;
-                *(index++) = top + j;
-
-                indexCount += 3;
-                
-                *(index++) = bottom + next;
-                *(index++) = bottom + j;
-                *(index++) = top + next;
-
-                indexCount += 3;
-
-            }
-        }
-        
-        // north cap
-        bottom = (stacks - 2) * slices + 1;
-        top = bottom + slices;
-        for (int i = 0; i < slices; i++) {    
-            *(index++) = bottom + (i + 1) % slices;
-            *(index++) = bottom + i;
-            *(index++) = top;
-    
-            indexCount += 3;
-
-        }
-        indicesBuffer->append(sizeof(GLushort) * indices, (gpu::Byte*) indexData);
-        delete[] indexData;
+        appendSphereIndices(*indicesBuffer, slices, stacks);
         
         #ifdef WANT_DEBUG
             qCDebug(renderutils) << "GeometryCache::renderSphere()... --- CREATING INDICES BUFFER";
             qCDebug(renderutils) << "    radius:" << radius;
             qCDebug(renderutils) << "    slices:" << slices;
             qCDebug(renderutils) << "    stacks:" << stacks;
-            qCDebug(renderutils) << "indexCount:" << indexCount;
             qCDebug(renderutils) << "   indices:" << indices;
             qCDebug(renderutils) << "    _sphereIndices.size():" << _sphereIndices.size();
         #endif
@@ -689,76 +687,84 @@ void GeometryCache::renderVertices(gpu::Batch& batch, gpu::Primitive primitiveTy
     }
 }
 
+static const int SOLID_CUBE_FLOATS_PER_VERTEX = 3;
+static const int SOLID_CUBE_VERTICES = 6 * 4; // 4 vertices per face
+static const int SOLID_CUBE_INDICES = 6 * 2 * 3; // 2 triangles per face
+static const int SOLID_CUBE_VERTEX_STRIDE = sizeof(GLfloat) * SOLID_CUBE_FLOATS_PER_VERTEX * 2; // vertices and normals
+static const int SOLID_CUBE_NORMALS_OFFSET = sizeof(GLfloat) * SOLID_CUBE_FLOATS_PER_VERTEX;
+
+static void appendSolidCubeVertices(gpu::Buffer& buffer, float size) {
+    const int vertices = SOLID_CUBE_VERTICES;
+    const int vertexPoints = vertices * SOLID_CUBE_FLOATS_PER_VERTEX;
+
+    GLfloat* vertexData = new GLfloat[vertexPoints * 2]; // vertices and normals
+    GLfloat* vertex = vertexData;
+    float halfSize = size / 2.0f;
+
+    static GLfloat cannonicalVertices[vertexPoints] = 
+                                { 1, 1, 1,  -1, 1, 1,  -1,-1, 1,   1,-1, 1,   // v0,v1,v2,v3 (front)
+                                  1, 1, 1,   1,-1, 1,   1,-1,-1,   1, 1,-1,   // v0,v3,v4,v5 (right)
+                                  1, 1, 1,   1, 1,-1,  -1, 1,-1,  -1, 1, 1,   // v0,v5,v6,v1 (top)
+                                 -1, 1, 1,  -1, 1,-1,  -1,-1,-1,  -1,-1, 1,   // v1,v6,v7,v2 (left)
+                                 -1,-1,-1,   1,-1,-1,   1,-1, 1,  -1,-1, 1,   // v7,v4,v3,v2 (bottom)
+                                  1,-1,-1,  -1,-1,-1,  -1, 1,-1,   1, 1,-1 }; // v4,v7,v6,v5 (back)
+
+    // normal array
+    static GLfloat cannonicalNormals[vertexPoints]  = 
+                              { 0, 0, 1,   0, 0, 1,   0, 0, 1,   0, 0, 1,   // v0,v1,v2,v3 (front)
+                                1, 0, 0,   1, 0, 0,   1, 0, 0,   1, 0, 0,   // v0,v3,v4,v5 (right)
+                                0, 1, 0,   0, 1, 0,   0, 1, 0,   0, 1, 0,   // v0,v5,v6,v1 (top)
+                               -1, 0, 0,  -1, 0, 0,  -1, 0, 0,  -1, 0, 0,   // v1,v6,v7,v2 (left)
+                                0,-1, 0,   0,-1, 0,   0,-1, 0,   0,-1, 0,   // v7,v4,v3,v2 (bottom)
+                                0, 0,-1,   0, 0,-1,   0, 0,-1,   0, 0,-1 }; // v4,v7,v6,v5 (back)
+
+
+    GLfloat* cannonicalVertex = &cannonicalVertices[0];
+    GLfloat* cannonicalNormal = &cannonicalNormals[0];
+
+    for (int i = 0; i < vertices; i++) {
+        // vertices
+        *(vertex++) = halfSize * *cannonicalVertex++;
+        *(vertex++) = halfSize * *cannonicalVertex++;
+        *(vertex++) = halfSize * *cannonicalVertex++;
+
+        //normals
+        *(vertex++) = *cannonicalNormal++;
+        *(vertex++) = *cannonicalNormal++;
+        *(vertex++) = *cannonicalNormal++;
+    }
+
+    buffer.append(sizeof(GLfloat) * vertexPoints * 2, (gpu::Byte*) vertexData);
+    delete[] vertexData;
+}
+
+static void appendSolidCubeIndices(gpu::Buffer& buffer) {
+    static GLubyte cannonicalIndices[SOLID_CUBE_INDICES]  = 
+                                { 0, 1, 2,   2, 3, 0,      // front
+                                  4, 5, 6,   6, 7, 4,      // right
+                                  8, 9,10,  10,11, 8,      // top
+                                 12,13,14,  14,15,12,      // left
+                                 16,17,18,  18,19,16,      // bottom
+                                 20,21,22,  22,23,20 };    // back
+
+    buffer.append(sizeof(cannonicalIndices), (gpu::Byte*) cannonicalIndices);
+}
+
 void GeometryCache::renderSolidCube(gpu::Batch& batch, float size, const glm::vec4& color) {
     Vec2Pair colorKey(glm::vec2(color.x, color.y), glm::vec2(color.z, color.y));
-    const int FLOATS_PER_VERTEX = 3;
-    const int VERTICES_PER_FACE = 4;
-    const int NUMBER_OF_FACES = 6;
-    const int TRIANGLES_PER_FACE = 2;
-    const int VERTICES_PER_TRIANGLE = 3;
-    const int vertices = NUMBER_OF_FACES * VERTICES_PER_FACE;
-    const int indices = NUMBER_OF_FACES * TRIANGLES_PER_FACE * VERTICES_PER_TRIANGLE;
-    const int vertexPoints = vertices * FLOATS_PER_VERTEX;
-    const int VERTEX_STRIDE = sizeof(GLfloat) * FLOATS_PER_VERTEX * 2; // vertices and normals
-    const int NORMALS_OFFSET = sizeof(GLfloat) * FLOATS_PER_VERTEX;
+    const int indices = SOLID_CUBE_INDICES;
+    const int VERTEX_STRIDE = SOLID_CUBE_VERTEX_STRIDE;
+    const int NORMALS_OFFSET = SOLID_CUBE_NORMALS_OFFSET;
 
     if (!_solidCubeVertices.contains(size)) {
         auto verticesBuffer = std::make_shared<gpu::Buffer>();
         _solidCubeVertices[size] = verticesBuffer;
-
-        GLfloat* vertexData = new GLfloat[vertexPoints * 2]; // vertices and normals
-        GLfloat* vertex = vertexData;
-        float halfSize = size / 2.0f;
-
-        static GLfloat cannonicalVertices[vertexPoints] = 
-                                    { 1, 1, 1,  -1, 1, 1,  -1,-1, 1,   1,-1, 1,   // v0,v1,v2,v3 (front)
-                                      1, 1, 1,   1,-1, 1,   1,-1,-1,   1, 1,-1,   // v0,v3,v4,v5 (right)
-                                      1, 1, 1,   1, 1,-1,  -1, 1,-1,  -1, 1, 1,   // v0,v5,v6,v1 (top)
-                                     -1, 1, 1,  -1, 1,-1,  -1,-1,-1,  -1,-1, 1,   // v1,v6,v7,v2 (left)
-                                     -1,-1,-1,   1,-1,-1,   1,-1, 1,  -1,-1, 1,   // v7,v4,v3,v2 (bottom)
-                                      1,-1,-1,  -1,-1,-1,  -1, 1,-1,   1, 1,-1 }; // v4,v7,v6,v5 (back)
-
-        // normal array
-        static GLfloat cannonicalNormals[vertexPoints]  = 
-                                  { 0, 0, 1,   0, 0, 1,   0, 0, 1,   0, 0, 1,   // v0,v1,v2,v3 (front)
-                                    1, 0, 0,   1, 0, 0,   1, 0, 0,   1, 0, 0,   // v0,v3,v4,v5 (right)
-                                    0, 1, 0,   0, 1, 0,   0, 1, 0,   0, 1, 0,   // v0,v5,v6,v1 (top)
-                                   -1, 0, 0,  -1, 0, 0,  -1, 0, 0,  -1, 0, 0,   // v1,v6,v7,v2 (left)
-                                    0,-1, 0,   0,-1, 0,   0,-1, 0,   0,-1, 0,   // v7,v4,v3,v2 (bottom)
-                                    0, 0,-1,   0, 0,-1,   0, 0,-1,   0, 0,-1 }; // v4,v7,v6,v5 (back)
-
-
-        GLfloat* cannonicalVertex = &cannonicalVertices[0];
-        GLfloat* cannonicalNormal = &cannonicalNormals[0];
-
-        for (int i = 0; i < vertices; i++) {
-            // vertices
-            *(vertex++) = halfSize * *cannonicalVertex++;
-            *(vertex++) = halfSize * *cannonicalVertex++;
-            *(vertex++) = halfSize * *cannonicalVertex++;
-
-            //normals
-            *(vertex++) = *cannonicalNormal++;
-            *(vertex++) = *cannonicalNormal++;
-            *(vertex++) = *cannonicalNormal++;
-        }
-
-        verticesBuffer->append(sizeof(GLfloat) * vertexPoints * 2, (gpu::Byte*) vertexData);
+        appendSolidCubeVertices(*verticesBuffer, size);
     }
 
     if (!_solidCubeIndexBuffer) {
-        static GLubyte cannonicalIndices[indices]  = 
-                                    { 0, 1, 2,   2, 3, 0,      // front
-                                      4, 5, 6,   6, 7, 4,      // right
-                                      8, 9,10,  10,11, 8,      // top
-                                     12,13,14,  14,15,12,      // left
-                                     16,17,18,  18,19,16,      // bottom
-                                     20,21,22,  22,23,20 };    // back
-        
-        auto indexBuffer = std::make_shared<gpu::Buffer>();
-        _solidCubeIndexBuffer = indexBuffer;
-    
-        _solidCubeIndexBuffer->append(sizeof(cannonicalIndices), (gpu::Byte*) cannonicalIndices);
+        _solidCubeIndexBuffer = std::make_shared<gpu::Buffer>();
+        appendSolidCubeIndices(*_solidCubeIndexBuffer);
     }
 
     if (!_solidCubeColors.contains(colorKey)) {
@@ -810,6 +816,95 @@ void GeometryCache::renderSolidCube(gpu::Batch& batch, float size, const glm::ve
     batch.drawIndexed(gpu::TRIANGLES, indices);
 }
 
+// The instanced shapes read their color and placement from the named buffers of the batch, one element per instance
+static const gpu::Stream::FormatPointer& getInstancedShapeFormat() {
+    static gpu::Stream::FormatPointer streamFormat;
+    if (!streamFormat) {
+        streamFormat = std::make_shared<gpu::Stream::Format>();
+        streamFormat->setAttribute(gpu::Stream::POSITION, 0, gpu::Element(gpu::VEC3, gpu::FLOAT, gpu::XYZ), 0);
+        streamFormat->setAttribute(gpu::Stream::NORMAL, 1, gpu::Element(gpu::VEC3, gpu::FLOAT, gpu::XYZ));
+        streamFormat->setAttribute(gpu::Stream::COLOR, 2, gpu::Element(gpu::VEC4, gpu::NUINT8, gpu::RGBA), 0,
+            gpu::Stream::PER_INSTANCE);
+        streamFormat->setAttribute(gpu::Stream::INSTANCE_XFM, 3, gpu::Element(gpu::VEC4, gpu::FLOAT, gpu::XYZW), 0,
+            gpu::Stream::PER_INSTANCE);
+        streamFormat->setAttribute(gpu::Stream::INSTANCE_SCALE, 4, gpu::Element(gpu::VEC3, gpu::FLOAT, gpu::XYZ), 0,
+            gpu::Stream::PER_INSTANCE);
+        streamFormat->setAttribute(gpu::Stream::INSTANCE_TRANSLATE, 5, gpu::Element(gpu::VEC3, gpu::FLOAT, gpu::XYZ), 0,
+            gpu::Stream::PER_INSTANCE);
+    }
+    return streamFormat;
+}
+
+static void setInstanceBuffers(gpu::Batch& batch, const gpu::Batch::NamedBatchData::BufferPointers& instanceBuffers) {
+    const auto& attributes = getInstancedShapeFormat()->getAttributes();
+    batch.setInputBuffer(2, gpu::BufferView(instanceBuffers[GeometryCache::INSTANCE_COLOR_BUFFER],
+        attributes.at(gpu::Stream::COLOR)._element));
+    batch.setInputBuffer(3, gpu::BufferView(instanceBuffers[GeometryCache::INSTANCE_ROTATION_BUFFER],
+        attributes.at(gpu::Stream::INSTANCE_XFM)._element));
+    batch.setInputBuffer(4, gpu::BufferView(instanceBuffers[GeometryCache::INSTANCE_SCALE_BUFFER],
+        attributes.at(gpu::Stream::INSTANCE_SCALE)._element));
+    batch.setInputBuffer(5, gpu::BufferView(instanceBuffers[GeometryCache::INSTANCE_TRANSLATION_BUFFER],
+        attributes.at(gpu::Stream::INSTANCE_TRANSLATE)._element));
+}
+
+void GeometryCache::renderSolidCubeInstances(gpu::Batch& batch, gpu::uint32 count,
+                                             const gpu::Batch::NamedBatchData::BufferPointers& instanceBuffers) {
+    const float UNIT_SIZE = 1.0f;
+    if (!_solidCubeVertices.contains(UNIT_SIZE)) {
+        auto verticesBuffer = std::make_shared<gpu::Buffer>();
+        _solidCubeVertices[UNIT_SIZE] = verticesBuffer;
+        appendSolidCubeVertices(*verticesBuffer, UNIT_SIZE);
+    }
+    if (!_solidCubeIndexBuffer) {
+        _solidCubeIndexBuffer = std::make_shared<gpu::Buffer>();
+        appendSolidCubeIndices(*_solidCubeIndexBuffer);
+    }
+    gpu::BufferPointer verticesBuffer = _solidCubeVertices[UNIT_SIZE];
+
+    const auto& streamFormat = getInstancedShapeFormat();
+    const auto& attributes = streamFormat->getAttributes();
+    gpu::BufferView verticesView(verticesBuffer, 0, verticesBuffer->getSize(), SOLID_CUBE_VERTEX_STRIDE,
+        attributes.at(gpu::Stream::POSITION)._element);
+    gpu::BufferView normalsView(verticesBuffer, SOLID_CUBE_NORMALS_OFFSET, verticesBuffer->getSize(), SOLID_CUBE_VERTEX_STRIDE,
+        attributes.at(gpu::Stream::NORMAL)._element);
+
+    batch.setInputFormat(streamFormat);
+    batch.setInputBuffer(0, verticesView);
+    batch.setInputBuffer(1, normalsView);
+    setInstanceBuffers(batch, instanceBuffers);
+    batch.setIndexBuffer(gpu::UINT8, _solidCubeIndexBuffer, 0);
+    batch.drawIndexedInstanced(count, gpu::TRIANGLES, SOLID_CUBE_INDICES);
+}
+
+void GeometryCache::renderSolidSphereInstances(gpu::Batch& batch, int slices, int stacks, gpu::uint32 count,
+                                               const gpu::Batch::NamedBatchData::BufferPointers& instanceBuffers) {
+    const float UNIT_RADIUS = 0.5f;
+    Vec2Pair radiusKey(glm::vec2(UNIT_RADIUS, slices), glm::vec2(stacks, 0));
+    IntPair slicesStacksKey(slices, stacks);
+    if (!_sphereVertices.contains(radiusKey)) {
+        auto verticesBuffer = std::make_shared<gpu::Buffer>();
+        _sphereVertices[radiusKey] = verticesBuffer;
+        appendSphereVertices(*verticesBuffer, UNIT_RADIUS, slices, stacks);
+    }
+    if (!_sphereIndices.contains(slicesStacksKey)) {
+        auto indicesBuffer = std::make_shared<gpu::Buffer>();
+        _sphereIndices[slicesStacksKey] = indicesBuffer;
+        appendSphereIndices(*indicesBuffer, slices, stacks);
+    }
+    gpu::BufferPointer verticesBuffer = _sphereVertices[radiusKey];
+    int indices = slices * (stacks - 1) * NUM_VERTICES_PER_TRIANGULATED_QUAD;
+
+    // the positions of a sphere centered on the origin are also its normals
+    const auto& streamFormat = getInstancedShapeFormat();
+    const auto& attributes = streamFormat->getAttributes();
+    batch.setInputFormat(streamFormat);
+    batch.setInputBuffer(0, gpu::BufferView(verticesBuffer, attributes.at(gpu::Stream::POSITION)._element));
+    batch.setInputBuffer(1, gpu::BufferView(verticesBuffer, attributes.at(gpu::Stream::NORMAL)._element));
+    setInstanceBuffers(batch, instanceBuffers);
+    batch.setIndexBuffer(gpu::UINT16, _sphereIndices[slicesStacksKey], 0);
+    batch.drawIndexedInstanced(count, gpu::TRIANGLES, indices);
+}
+
 void GeometryCache::renderWireCube(gpu::Batch& batch, float size, const glm::vec4& color) {
     Vec2Pair colorKey(glm::vec2(color.x, color.y),glm::vec2(color.z, color.y));
     const int FLOATS_PER_VERTEX = 3;
@@ -1681,7 +1776,15 @@ void GeometryCache::useSimpleDrawPipeline(gpu::Batch& batch, bool noBlend) {
 GeometryReader::GeometryReader(const QUrl& url, QNetworkReply* reply, const QVariantHash& mapping) :
     _url(url),
     _reply(reply),
-    _mapping(mapping) {
+    _mapping(mapping),
+    _diskCache(ResourceCache::getDiskCache()) {
+}
+
+GeometryReader::~GeometryReader() {
+    // the reader may be dropped by the scheduler without running
+    if (_reply) {
+        _reply->deleteLater();
+    }
 }
 
 void GeometryReader::run() {
@@ -1701,7 +1804,11 @@ void GeometryReader::run() {
             if (_url.path().toLower().endsWith(".fbx")) {
                 const bool grabLightmaps = true;
                 const float lightmapLevel = 1.0f;
-                fbxgeo = readFBX(_reply, _mapping, _url.path(), grabLightmaps, lightmapLevel);
+
+                // the processed geometry is baked ahead of time or cached on disk, under the hash of the model and of what
+                // goes into processing it
+                fbxgeo = _prebakedCache.readModel(_reply->readAll(), _mapping, _url.path(), grabLightmaps, lightmapLevel,
+                    _diskCache.data());
             } else if (_url.path().toLower().endsWith(".obj")) {
                 fbxgeo = OBJReader().readOBJ(_reply, _mapping, &_url);
             } else {
@@ -1717,7 +1824,10 @@ void GeometryReader::run() {
         qCDebug(renderutils) << "Error reading " << _url << ": " << error;
         emit onError(NetworkGeometry::ModelParseError, error);
     }
-    _reply->deleteLater();
+    if (_reply) {
+        _reply->deleteLater();
+        _reply = nullptr;
+    }
 }
 
 NetworkGeometry::NetworkGeometry(const QUrl& url, bool delayLoad, const QVariantHash& mapping, const QUrl& textureBaseUrl) :
@@ -1801,6 +1911,21 @@ void NetworkGeometry::setTextureWithNameToURL(const QString& name, const QUrl& u
     _isLoadedWithTextures = false;
 }
 
+void NetworkGeometry::setLoadBounds(const glm::vec3& center, float radius) {
+    if (_resource) {
+        _resource->setLoadBounds(this, center, radius);
+    }
+    for (auto&& mesh : _meshes) {
+        for (auto&& part : mesh->_parts) {
+            for (auto texture : { part->diffuseTexture, part->normalTexture, part->specularTexture, part->emissiveTexture }) {
+                if (texture) {
+                    texture->setLoadBounds(this, center, radius);
+                }
+            }
+        }
+    }
+}
+
 QStringList NetworkGeometry::getTextureNames() const {
     QStringList result;
     for (size_t i = 0; i < _meshes.size(); i++) {
@@ -1894,7 +2019,7 @@ void NetworkGeometry::modelRequestDone(QNetworkReply& reply) {
     connect(geometryReader, SIGNAL(onSuccess(FBXGeometry*)), SLOT(modelParseSuccess(FBXGeometry*)));
     connect(geometryReader, SIGNAL(onError(int, QString)), SLOT(modelParseError(int, QString)));
 
-    QThreadPool::globalInstance()->start(geometryReader);
+    ResourceCache::startDecode(_resource, ResourceScheduler::GEOMETRY_DECODE, geometryReader);
 }
 
 void NetworkGeometry::modelRequestError(QNetworkReply::NetworkError error) {
@@ -18,6 +18,7 @@
 #include <DependencyManager.h>
 #include <ResourceCache.h>
 
+#include "BakedGeometry.h"
 #include "FBXReader.h"
 #include "OBJReader.h"
 
@@ -140,6 +141,19 @@ public:
     void renderGrid(gpu::Batch& batch, int x, int y, int width, int height, int rows, int cols, const glm::vec4& color, int id = UNKNOWN_ID);
 
     void renderSolidCube(gpu::Batch& batch, float size, const glm::vec4& color);
+
+    // The named buffers of the instances, filled by DeferredLightingEffect::renderSolidCubeInstance and friends
+    enum InstanceBuffer {
+        INSTANCE_ROTATION_BUFFER = 0,   // glm::quat as vec4
+        INSTANCE_SCALE_BUFFER,          // vec3
+        INSTANCE_TRANSLATION_BUFFER,    // vec3
+        INSTANCE_COLOR_BUFFER,          // packed RGBA8
+        NUM_INSTANCE_BUFFERS,
+    };
+    // Draws count unit cubes (size 1) or spheres (radius 0.5) in one call, placed by the instance buffers
+    void renderSolidCubeInstances(gpu::Batch& batch, gpu::uint32 count, const gpu::Batch::NamedBatchData::BufferPointers& instanceBuffers);
+    void renderSolidSphereInstances(gpu::Batch& batch, int slices, int stacks, gpu::uint32 count,
+                                    const gpu::Batch::NamedBatchData::BufferPointers& instanceBuffers);
     void renderWireCube(gpu::Batch& batch, float size, const glm::vec4& color);
     void renderBevelCornersRect(gpu::Batch& batch, int x, int y, int width, int height, int bevelDistance, const glm::vec4& color, int id = UNKNOWN_ID);
 
@@ -333,6 +347,9 @@ public:
     void setTextureWithNameToURL(const QString& name, const QUrl& url);
     QStringList getTextureNames() const;
 
+    // the model and its textures load ahead of those that look smaller from the camera
+    void setLoadBounds(const glm::vec3& center, float radius);
+
     enum Error {
         MissingFilenameInMapping = 0,
         MappingRequestError,
@@ -387,6 +404,7 @@ class GeometryReader : public QObject, public QRunnable {
     Q_OBJECT
 public:
     GeometryReader(const QUrl& url, QNetworkReply* reply, const QVariantHash& mapping);
+    virtual ~GeometryReader();
     virtual void run();
 signals:
     void onSuccess(FBXGeometry* geometry);
@@ -395,6 +413,8 @@ private:
     QUrl _url;
     QNetworkReply* _reply;
     QVariantHash _mapping;
+    QSharedPointer<ResourceDiskCache> _diskCache;
+    BakedGeometryCache _prebakedCache;
 };
 
 /// The state associated with a single mesh part.
@@ -199,11 +199,17 @@ void Model::RenderPipelineLib::initLocations(gpu::ShaderPointer& program, Model:
 AbstractViewStateInterface* Model::_viewState = NULL;
 
 void Model::setTranslation(const glm::vec3& translation) {
-    _translation = translation;
+    if (_translation != translation) {
+        _translation = translation;
+        _renderItemsMoved = true;
+    }
 }
     
 void Model::setRotation(const glm::quat& rotation) {
-    _rotation = rotation;
+    if (_rotation != rotation) {
+        _rotation = rotation;
+        _renderItemsMoved = true;
+    }
 }   
 
 void Model::setScale(const glm::vec3& scale) {
@@ -221,11 +227,13 @@ void Model::setScaleInternal(const glm::vec3& scale) {
     if (relativeDeltaScale > ONE_PERCENT || scaleLength < EPSILON) {
         _scale = scale;
         initJointTransforms();
+        _renderItemsMoved = true;
     }
 }
 
 void Model::setOffset(const glm::vec3& offset) {
     _offset = offset;
+    _renderItemsMoved = true;
 
     // if someone manually sets our offset, then we are no longer snapped to center
     _snapModelToRegistrationPoint = false;
@@ -410,6 +418,7 @@ bool Model::updateGeometry() {
 
     if (needToRebuild) {
         const FBXGeometry& fbxGeometry = geometry->getFBXGeometry();
+        _blendshapeLayouts.clear();
         foreach (const FBXMesh& mesh, fbxGeometry.meshes) {
             MeshState state;
             state.clusterMatrices.resize(mesh.clusters.size());
@@ -1125,7 +1134,8 @@ class Blender : public QRunnable {
 public:
 
     Blender(Model* model, int blendNumber, const QWeakPointer<NetworkGeometry>& geometry,
-        const QVector<FBXMesh>& meshes, const QVector<float>& blendshapeCoefficients);
+        const QVector<FBXMesh>& meshes, const BlendshapeLayouts& layouts, const QVector<float>& blendshapeCoefficients,
+        const QVector<glm::vec3>& vertices, const QVector<glm::vec3>& normals);
 
     virtual void run();
 
@@ -1135,53 +1145,39 @@ private:
     int _blendNumber;
     QWeakPointer<NetworkGeometry> _geometry;
     QVector<FBXMesh> _meshes;
+    BlendshapeLayouts _layouts;
     QVector<float> _blendshapeCoefficients;
+    QVector<glm::vec3> _vertices;
+    QVector<glm::vec3> _normals;
 };
 
 Blender::Blender(Model* model, int blendNumber, const QWeakPointer<NetworkGeometry>& geometry,
-        const QVector<FBXMesh>& meshes, const QVector<float>& blendshapeCoefficients) :
+        const QVector<FBXMesh>& meshes, const BlendshapeLayouts& layouts, const QVector<float>& blendshapeCoefficients,
+        const QVector<glm::vec3>& vertices, const QVector<glm::vec3>& normals) :
     _model(model),
     _blendNumber(blendNumber),
     _geometry(geometry),
     _meshes(meshes),
-    _blendshapeCoefficients(blendshapeCoefficients) {
+    _layouts(layouts),
+    _blendshapeCoefficients(blendshapeCoefficients),
+    _vertices(vertices),
+    _normals(normals) {
 }
 
 void Blender::run() {
     PROFILE_RANGE(__FUNCTION__);
-    QVector<glm::vec3> vertices, normals;
     if (!_model.isNull()) {
-        int offset = 0;
-        foreach (const FBXMesh& mesh, _meshes) {
-            if (mesh.blendshapes.isEmpty()) {
-                continue;
-            }
-            vertices += mesh.vertices;
-            normals += mesh.normals;
-            glm::vec3* meshVertices = vertices.data() + offset;
-            glm::vec3* meshNormals = normals.data() + offset;
-            offset += mesh.vertices.size();
-            const float NORMAL_COEFFICIENT_SCALE = 0.01f;
-            for (int i = 0, n = qMin(_blendshapeCoefficients.size(), mesh.blendshapes.size()); i < n; i++) {
-                float vertexCoefficient = _blendshapeCoefficients.at(i);
-                if (vertexCoefficient < EPSILON) {
-                    continue;
-                }
-                float normalCoefficient = vertexCoefficient * NORMAL_COEFFICIENT_SCALE;
-                const FBXBlendshape& blendshape = mesh.blendshapes.at(i);
-                for (int j = 0; j < blendshape.indices.size(); j++) {
-                    int index = blendshape.indices.at(j);
-                    meshVertices[index] += blendshape.vertices.at(j) * vertexCoefficient;
-                    meshNormals[index] += blendshape.normals.at(j) * normalCoefficient;
-                }
-            }
-        }
+        // blends into the arrays of the previous blend of the model, when it gave them back
+        BlendshapeBlender::blend(_meshes, _layouts, _blendshapeCoefficients, _vertices, _normals);
+    } else {
+        _vertices.clear();
+        _normals.clear();
     }
     // post the result to the geometry cache, which will dispatch to the model if still alive
     QMetaObject::invokeMethod(DependencyManager::get<ModelBlender>().data(), "setBlendedVertices",
         Q_ARG(const QPointer<Model>&, _model), Q_ARG(int, _blendNumber),
-        Q_ARG(const QWeakPointer<NetworkGeometry>&, _geometry), Q_ARG(const QVector<glm::vec3>&, vertices),
-        Q_ARG(const QVector<glm::vec3>&, normals));
+        Q_ARG(const QWeakPointer<NetworkGeometry>&, _geometry), Q_ARG(const QVector<glm::vec3>&, _vertices),
+        Q_ARG(const QVector<glm::vec3>&, _normals));
 }
 
 void Model::setScaleToFit(bool scaleToFit, const glm::vec3& dimensions) {
@@ -1261,7 +1257,21 @@ void Model::snapToRegistrationPoint() {
 
 void Model::simulate(float deltaTime, bool fullUpdate) {
     PROFILE_RANGE(__FUNCTION__);
-    fullUpdate = updateGeometry() || fullUpdate || (_scaleToFit && !_scaledToFit)
+    if (beginSimulation(fullUpdate)) {
+        simulateInternal(deltaTime);
+    }
+}
+
+bool Model::beginSimulation(bool fullUpdate) {
+    if (_geometry && !_geometry->isLoadedWithTextures()) {
+        // until the geometry is there, its extents are a guess
+        const float DEFAULT_LOAD_RADIUS = 1.0f;
+        Extents extents = getMeshExtents();
+        float radius = isActive() ? 0.5f * glm::distance(extents.minimum, extents.maximum) : DEFAULT_LOAD_RADIUS;
+        _geometry->setLoadBounds(_translation, radius);
+    }
+    bool geometryChanged = updateGeometry();
+    fullUpdate = geometryChanged || fullUpdate || (_scaleToFit && !_scaledToFit)
                     || (_snapModelToRegistrationPoint && !_snappedToRegistrationPoint);
 
     if (isActive() && fullUpdate) {
@@ -1279,8 +1289,29 @@ void Model::simulate(float deltaTime, bool fullUpdate) {
         }
         if (_snapModelToRegistrationPoint && !_snappedToRegistrationPoint) {
             snapToRegistrationPoint();
+            _renderItemsMoved = true;
+        }
+        if (geometryChanged) {
+            _renderItemsMoved = true;
         }
-        simulateInternal(deltaTime);
+    }
+    updateRenderItemBounds();
+    return isActive() && fullUpdate;
+}
+
+void Model::updateRenderItemBounds() {
+    if (!_renderItemsMoved) {
+        return;
+    }
+    _renderItemsMoved = false;
+
+    // the bounds of the parts follow the transform of the model, not its joints
+    if (!_renderItems.isEmpty()) {
+        render::PendingChanges pendingChanges;
+        foreach (auto item, _renderItems.keys()) {
+            pendingChanges.updateItem(item);
+        }
+        AbstractViewStateInterface::instance()->getMain3DScene()->enqueuePendingChanges(pendingChanges);
     }
 }
 
@@ -1289,12 +1320,42 @@ void Model::updateRig(float deltaTime, glm::mat4 parentTransform) {
      _rig->updateAnimations(deltaTime, parentTransform);
 }
 void Model::simulateInternal(float deltaTime) {
+    simulateJoints(deltaTime);
+    endSimulation();
+}
+
+void Model::simulateJoints(float deltaTime) {
     // update the world space transforms for all joints
 
     const FBXGeometry& geometry = _geometry->getFBXGeometry();
     glm::mat4 parentTransform = glm::scale(_scale) * glm::translate(_offset) * geometry.offset;
     updateRig(deltaTime, parentTransform);
+    updateClusterMatrices();
+}
 
+void Model::endSimulation() {
+    // post the blender if we're not currently waiting for one to finish
+    const FBXGeometry& geometry = _geometry->getFBXGeometry();
+    if (geometry.hasBlendedMeshes() &&
+            BlendshapeBlender::coefficientsChanged(_blendedBlendshapeCoefficients, _blendshapeCoefficients)) {
+        _blendedBlendshapeCoefficients = _blendshapeCoefficients;
+        DependencyManager::get<ModelBlender>()->noteRequiresBlend(this);
+    }
+}
+
+void Model::interpolateJoints() {
+    if (!isActive()) {
+        return;
+    }
+    const FBXGeometry& geometry = _geometry->getFBXGeometry();
+    glm::mat4 parentTransform = glm::scale(_scale) * glm::translate(_offset) * geometry.offset;
+    if (_rig->interpolateAnimations(parentTransform)) {
+        updateClusterMatrices();
+    }
+}
+
+void Model::updateClusterMatrices() {
+    const FBXGeometry& geometry = _geometry->getFBXGeometry();
     glm::mat4 zeroScale(glm::vec4(0.0f, 0.0f, 0.0f, 0.0f),
                         glm::vec4(0.0f, 0.0f, 0.0f, 0.0f),
                         glm::vec4(0.0f, 0.0f, 0.0f, 0.0f),
@@ -1335,12 +1396,6 @@ void Model::simulateInternal(float deltaTime) {
             }
         }
     }
-
-    // post the blender if we're not currently waiting for one to finish
-    if (geometry.hasBlendedMeshes() && _blendshapeCoefficients != _blendedBlendshapeCoefficients) {
-        _blendedBlendshapeCoefficients = _blendshapeCoefficients;
-        DependencyManager::get<ModelBlender>()->noteRequiresBlend(this);
-    }
 }
 
 bool Model::setJointPosition(int jointIndex, const glm::vec3& position, const glm::quat& rotation, bool useRotation,
@@ -1377,8 +1432,15 @@ float Model::getLimbLength(int jointIndex) const {
 bool Model::maybeStartBlender() {
     const FBXGeometry& fbxGeometry = _geometry->getFBXGeometry();
     if (fbxGeometry.hasBlendedMeshes()) {
+        if (_blendshapeLayouts.empty()) {
+            _blendshapeLayouts = BlendshapeBlender::makeLayouts(fbxGeometry.meshes);
+        }
+        // hand the spare arrays over, so the blender is their only owner and can write them without reallocating
+        QVector<glm::vec3> vertices, normals;
+        vertices.swap(_spareBlendedVertices);
+        normals.swap(_spareBlendedNormals);
         QThreadPool::globalInstance()->start(new Blender(this, ++_blendNumber, _geometry,
-            fbxGeometry.meshes, _blendshapeCoefficients));
+            fbxGeometry.meshes, _blendshapeLayouts, _blendshapeCoefficients, vertices, normals));
         return true;
     }
     return false;
@@ -1386,7 +1448,13 @@ bool Model::maybeStartBlender() {
 
 void Model::setBlendedVertices(int blendNumber, const QWeakPointer<NetworkGeometry>& geometry,
         const QVector<glm::vec3>& vertices, const QVector<glm::vec3>& normals) {
-    if (_geometry != geometry || _blendedVertexBuffers.empty() || blendNumber < _appliedBlendNumber) {
+    if (_geometry != geometry || _blendedVertexBuffers.empty()) {
+        return;
+    }
+    // keep the arrays for the next blend
+    _spareBlendedVertices = vertices;
+    _spareBlendedNormals = normals;
+    if (blendNumber < _appliedBlendNumber) {
         return;
     }
     _appliedBlendNumber = blendNumber;
@@ -1416,6 +1484,9 @@ void Model::setGeometry(const QSharedPointer<NetworkGeometry>& newGeometry) {
 
 void Model::deleteGeometry() {
     _blendedVertexBuffers.clear();
+    _blendshapeLayouts.clear();
+    _spareBlendedVertices.clear();
+    _spareBlendedNormals.clear();
     _rig->clearJointStates();
     _meshStates.clear();
     _rig->deleteAnimations();
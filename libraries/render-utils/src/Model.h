@@ -22,6 +22,7 @@
 #include <functional>
 
 #include <AABox.h>
+#include <BlendshapeBlender.h>
 #include <DependencyManager.h>
 #include <GeometryUtil.h>
 #include <gpu/Stream.h>
@@ -83,6 +84,9 @@ public:
                     render::PendingChanges& pendingChanges,
                     render::Item::Status::Getters& statusGetters);
     void removeFromScene(std::shared_ptr<render::Scene> scene, render::PendingChanges& pendingChanges);
+
+    /// tells the scene about the parts that moved since the last call, along with the model. beginSimulation calls it
+    void updateRenderItemBounds();
     void renderSetup(RenderArgs* args);
     bool isRenderable() const { return !_meshStates.isEmpty() || (isActive() && _geometry->getMeshes().empty()); }
 
@@ -113,6 +117,23 @@ public:
 
     virtual void simulate(float deltaTime, bool fullUpdate = true);
 
+    /// simulate in three parts, for models whose joints are simulated on worker threads. beginSimulation, on the model's
+    /// thread, updates the geometry and returns whether the joints need simulating. simulateJoints then updates the rig
+    /// and the clusters on any thread, touching nothing but the model, and endSimulation posts the blender, on the
+    /// model's thread again.
+    bool beginSimulation(bool fullUpdate = true);
+    void simulateJoints(float deltaTime);
+    void endSimulation();
+
+    /// The animation LOD of the rig, see AnimationLOD.
+    void setAnimationLODTier(AnimationLOD::Tier tier) { _rig->setAnimationLODTier(tier); }
+    AnimationLOD::Tier getAnimationLODTier() const { return _rig->getAnimationLODTier(); }
+    bool advanceAnimationLOD(float deltaTime, float& animationDeltaTime) { return _rig->advanceAnimationLOD(deltaTime, animationDeltaTime); }
+
+    /// In the frames between the updates of a rig at a reduced rate, moves the joints toward the pose of the last update,
+    /// and the clusters with them.
+    void interpolateJoints();
+
     /// Returns a reference to the shared geometry.
     const QSharedPointer<NetworkGeometry>& getGeometry() const { return _geometry; }
 
@@ -275,6 +296,7 @@ protected:
     void snapToRegistrationPoint();
 
     void simulateInternal(float deltaTime);
+    void updateClusterMatrices();
     virtual void updateRig(float deltaTime, glm::mat4 parentTransform);
 
     /// \param jointIndex index of joint in model structure
@@ -334,6 +356,9 @@ private:
     QVector<float> _blendedBlendshapeCoefficients;
     int _blendNumber;
     int _appliedBlendNumber;
+    BlendshapeLayouts _blendshapeLayouts;
+    QVector<glm::vec3> _spareBlendedVertices;
+    QVector<glm::vec3> _spareBlendedNormals;
 
     class Locations {
     public:
@@ -496,6 +521,7 @@ private:
     QSet<std::shared_ptr<MeshPartPayload>> _transparentRenderItems;
     QSet<std::shared_ptr<MeshPartPayload>> _opaqueRenderItems;
     QMap<render::ItemID, render::PayloadPointer> _renderItems;
+    bool _renderItemsMoved = false;
     bool _readyWhenAdded = false;
     bool _needsReload = true;
 
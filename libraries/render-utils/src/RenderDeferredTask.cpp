@@ -69,15 +69,17 @@ RenderDeferredTask::RenderDeferredTask() : Task() {
     _jobs.push_back(Job(new DrawBackground::JobModel("DrawBackground")));
 
     _jobs.push_back(Job(new PrepareDeferred::JobModel("PrepareDeferred")));
-    _jobs.push_back(Job(new FetchItems::JobModel("FetchOpaque",
-        FetchItems(
+    _jobs.push_back(Job(new FetchSpatialItems::JobModel("FetchCullOpaque",
+        FetchSpatialItems(
             [] (const RenderContextPointer& context, int count) {
                 context->_numFeedOpaqueItems = count; 
-            }
+            },
+            RenderDetails::OPAQUE_ITEM
         )
     )));
-    _jobs.push_back(Job(new CullItems::JobModel("CullOpaque", _jobs.back().getOutput())));
+    _jobs.back().setConcurrent(true);
     _jobs.push_back(Job(new DepthSortItems::JobModel("DepthSortOpaque", _jobs.back().getOutput())));
+    _jobs.back().setConcurrent(true);
     auto& renderedOpaques = _jobs.back().getOutput();
     _jobs.push_back(Job(new DrawOpaqueDeferred::JobModel("DrawOpaqueDeferred", _jobs.back().getOutput())));
   
@@ -94,16 +96,18 @@ RenderDeferredTask::RenderDeferredTask() : Task() {
     _jobs.back().setEnabled(false);
     _antialiasingJobIndex = _jobs.size() - 1;
 
-    _jobs.push_back(Job(new FetchItems::JobModel("FetchTransparent",
-         FetchItems(
+    _jobs.push_back(Job(new FetchSpatialItems::JobModel("FetchCullTransparent",
+         FetchSpatialItems(
             ItemFilter::Builder::transparentShape().withoutLayered(),
             [] (const RenderContextPointer& context, int count) {
                 context->_numFeedTransparentItems = count; 
-            }
+            },
+            RenderDetails::TRANSLUCENT_ITEM
          )
      )));
-    _jobs.push_back(Job(new CullItems::JobModel("CullTransparent", _jobs.back().getOutput())));
+    _jobs.back().setConcurrent(true);
     _jobs.push_back(Job(new DepthSortItems::JobModel("DepthSortTransparent", _jobs.back().getOutput(), DepthSortItems(false))));
+    _jobs.back().setConcurrent(true);
     _jobs.push_back(Job(new DrawTransparentDeferred::JobModel("TransparentDeferred", _jobs.back().getOutput())));
     
     _jobs.push_back(Job(new render::DrawStatus::JobModel("DrawStatus", renderedOpaques)));
@@ -156,10 +160,7 @@ void RenderDeferredTask::run(const SceneContextPointer& sceneContext, const Rend
 
     renderContext->args->_context->syncCache();
 
-    for (auto job : _jobs) {
-        job.run(sceneContext, renderContext);
-    }
-
+    _jobGraph.run(_jobs, sceneContext, renderContext);
 };
 
 void DrawOpaqueDeferred::run(const SceneContextPointer& sceneContext, const RenderContextPointer& renderContext, const ItemIDsBounds& inItems) {
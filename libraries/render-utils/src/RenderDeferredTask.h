@@ -13,6 +13,7 @@
 #define hifi_RenderDeferredTask_h
 
 #include "render/DrawTask.h"
+#include "render/JobGraph.h"
 
 #include "gpu/Pipeline.h"
 
@@ -76,6 +77,7 @@ public:
     ~RenderDeferredTask();
 
     render::Jobs _jobs;
+    render::JobGraph _jobGraph;
 
     int _drawStatusJobIndex = -1;
     int _drawHitEffectJobIndex = -1;
@@ -19,7 +19,6 @@
 #include <QNetworkReply>
 #include <QPainter>
 #include <QRunnable>
-#include <QThreadPool>
 #include <qimagereader.h>
 #include "PathUtils.h"
 
@@ -28,6 +27,7 @@
 
 
 #include "RenderUtilsLogging.h"
+#include "TranscodedTexture.h"
 
 TextureCache::TextureCache() {
     const qint64 TEXTURE_DEFAULT_UNUSED_MAX_SIZE = DEFAULT_UNUSED_MAX_SIZE;
@@ -207,6 +207,7 @@ NetworkTexture::NetworkTexture(const QUrl& url, TextureType type, const QByteArr
     std::string theName = url.toString().toStdString();
     // if we have content, load it after we have our self pointer
     if (!content.isEmpty()) {
+        _embedded = true;
         _startedLoading = true;
         QMetaObject::invokeMethod(this, "loadContent", Qt::QueuedConnection, Q_ARG(const QByteArray&, content));
     }
@@ -215,9 +216,10 @@ NetworkTexture::NetworkTexture(const QUrl& url, TextureType type, const QByteArr
 class ImageReader : public QRunnable {
 public:
 
-    ImageReader(const QWeakPointer<Resource>& texture, TextureType type, QNetworkReply* reply, const QUrl& url = QUrl(),
-        const QByteArray& content = QByteArray());
-    
+    ImageReader(const QWeakPointer<Resource>& texture, TextureType type, int loadGeneration, QNetworkReply* reply,
+        const QUrl& url = QUrl(), const QByteArray& content = QByteArray());
+    virtual ~ImageReader();
+
     virtual void run();
 
 private:
@@ -227,24 +229,36 @@ private:
     QNetworkReply* _reply;
     QUrl _url;
     QByteArray _content;
+    QSharedPointer<ResourceDiskCache> _diskCache;
+    int _loadGeneration;
 };
 
 void NetworkTexture::downloadFinished(QNetworkReply* reply) {
     // send the reader off to the thread pool
-    QThreadPool::globalInstance()->start(new ImageReader(_self, _type, reply));
+    ResourceCache::startDecode(this, ResourceScheduler::TEXTURE_DECODE, new ImageReader(_self, _type, getLoadGeneration(), reply));
 }
 
 void NetworkTexture::loadContent(const QByteArray& content) {
-    QThreadPool::globalInstance()->start(new ImageReader(_self, _type, NULL, _url, content));
+    ResourceCache::startDecode(this, ResourceScheduler::TEXTURE_DECODE, new ImageReader(_self, _type, getLoadGeneration(), NULL,
+        _url, content));
 }
 
-ImageReader::ImageReader(const QWeakPointer<Resource>& texture, TextureType type, QNetworkReply* reply,
+ImageReader::ImageReader(const QWeakPointer<Resource>& texture, TextureType type, int loadGeneration, QNetworkReply* reply,
         const QUrl& url, const QByteArray& content) :
     _texture(texture),
     _type(type),
     _reply(reply),
     _url(url),
-    _content(content) {
+    _content(content),
+    _diskCache(ResourceCache::getDiskCache()),
+    _loadGeneration(loadGeneration) {
+}
+
+ImageReader::~ImageReader() {
+    // the reader may be dropped by the scheduler without running
+    if (_reply) {
+        _reply->deleteLater();
+    }
 }
 
 std::once_flag onceListSupportedFormatsflag;
@@ -297,19 +311,40 @@ public:
 void ImageReader::run() {
     QSharedPointer<Resource> texture = _texture.toStrongRef();
     if (texture.isNull()) {
-        if (_reply) {
-            _reply->deleteLater();
-        }
         return;
     }
     if (_reply) {
         _url = _reply->url();
         _content = _reply->readAll();
         _reply->deleteLater();
+        _reply = nullptr;
     }
 
     listSupportedImageFormats();
 
+    // The textures that go to the GPU as they are get transcoded, and come back from the disk cache once they have been.
+    // The normal maps don't survive the color compression, the cube maps are split in faces first, and the dilatable
+    // textures need the image itself.
+    auto ntex = dynamic_cast<NetworkTexture*>(&*texture);
+    bool isTranscoded = ntex && !dynamic_cast<DilatableNetworkTexture*>(ntex) &&
+        (_type != NORMAL_TEXTURE) && (_type != CUBE_TEXTURE);
+    TranscodedTextureCache transcodedCache(_diskCache);
+    QByteArray transcodedKey;
+    if (isTranscoded) {
+        transcodedKey = TranscodedTexture::getKey(_content, _type);
+        TranscodedTexture transcoded;
+        if (transcodedCache.load(transcodedKey, transcoded)) {
+            QMetaObject::invokeMethod(texture.data(), "setImage",
+                Q_ARG(const QImage&, QImage()),
+                Q_ARG(void*, transcoded.createTexture()),
+                Q_ARG(bool, transcoded.translucent),
+                Q_ARG(const QColor&, transcoded.averageColor),
+                Q_ARG(int, transcoded.originalWidth), Q_ARG(int, transcoded.originalHeight),
+                Q_ARG(int, _loadGeneration));
+            return;
+        }
+    }
+
     // try to help the QImage loader by extracting the image file format from the url filename ext
     // Some tga are not created properly for example without it
     auto filename = _url.fileName().toStdString();
@@ -331,7 +366,6 @@ void ImageReader::run() {
     }
 
     int imageArea = image.width() * image.height();
-    auto ntex = dynamic_cast<NetworkTexture*>(&*texture);
     if (ntex && (ntex->getType() == CUBE_TEXTURE)) {
         qCDebug(renderutils) << "Cube map size:" << _url << image.width() << image.height();
     }
@@ -550,6 +584,18 @@ void ImageReader::run() {
                 theTexture->generateIrradiance();
             }
 
+        } else if (isTranscoded && TranscodedTexture::isTranscodable(image)) {
+            // Compressed with its mips precomputed, instead of uploaded raw and mipmapped on the GPU
+            TranscodedTexture transcoded = TranscodedTexture::transcode(image);
+            transcoded.translucent = isTransparent;
+            transcoded.averageColor = averageColor;
+            transcoded.originalWidth = originalWidth;
+            transcoded.originalHeight = originalHeight;
+            if (!transcodedCache.store(transcodedKey, transcoded)) {
+                qCDebug(renderutils) << "Failed to cache transcoded texture" << _url;
+            }
+            theTexture = transcoded.createTexture();
+
         } else {
             theTexture = (gpu::Texture::create2D(formatGPU, image.width(), image.height(), gpu::Sampler(gpu::Sampler::FILTER_MIN_MAG_MIP_LINEAR)));
             theTexture->assignStoredMip(0, formatMip, image.byteCount(), image.constBits());
@@ -562,21 +608,37 @@ void ImageReader::run() {
         Q_ARG(void*, theTexture),
         Q_ARG(bool, isTransparent),
         Q_ARG(const QColor&, averageColor),
-        Q_ARG(int, originalWidth), Q_ARG(int, originalHeight));
+        Q_ARG(int, originalWidth), Q_ARG(int, originalHeight),
+        Q_ARG(int, _loadGeneration));
 
 
 }
 
 void NetworkTexture::setImage(const QImage& image, void* voidTexture, bool translucent, const QColor& averageColor, int originalWidth,
-                              int originalHeight) {
+                              int originalHeight, int loadGeneration) {
+    // Passing ownership
+    gpu::TexturePointer texture(static_cast<gpu::Texture*>(voidTexture));
+
+    // a decode started before the loading was cancelled leaves the texture to the one started after
+    if (loadGeneration != getLoadGeneration()) {
+        return;
+    }
+
+    // the texture goes to the GPU as soon as it is set, so it waits for the upload budget of the frame
+    qint64 bytes = texture ? (qint64)texture->getSize() : 0;
+    ResourceCache::queueUpload(this, bytes, [=] {
+        applyImage(image, texture, translucent, averageColor, originalWidth, originalHeight);
+    });
+}
+
+void NetworkTexture::applyImage(const QImage& image, const gpu::TexturePointer& texture, bool translucent,
+                                const QColor& averageColor, int originalWidth, int originalHeight) {
     _translucent = translucent;
     _averageColor = averageColor;
     _originalWidth = originalWidth;
     _originalHeight = originalHeight;
     
-    gpu::Texture* texture = static_cast<gpu::Texture*>(voidTexture);
-    // Passing ownership
-    _gpuTexture.reset(texture);
+    _gpuTexture = texture;
 
     if (_gpuTexture) {
         _width = _gpuTexture->getWidth();
@@ -594,6 +656,12 @@ void NetworkTexture::imageLoaded(const QImage& image) {
     // nothing by default
 }
 
+void NetworkTexture::cancelLoading() {
+    if (!_embedded) {
+        Resource::cancelLoading();
+    }
+}
+
 DilatableNetworkTexture::DilatableNetworkTexture(const QUrl& url, const QByteArray& content) :
     NetworkTexture(url, DEFAULT_TEXTURE, content),
     _innerRadius(0),
@@ -54,7 +54,7 @@ public:
     /// Returns the a black texture (useful for a default).
     const gpu::TexturePointer& getBlackTexture();
 
-    // Returns a map used to compress the normals through a fitting scale algorithm
+    // Returns a map used to compress the normals through a fitting scale algorithm
     const gpu::TexturePointer& getNormalFittingTexture();
 
     /// Returns a texture version of an image file
@@ -128,13 +128,21 @@ protected:
     Q_INVOKABLE void loadContent(const QByteArray& content);
     // FIXME: This void* should be a gpu::Texture* but i cannot get it to work for now, moving on...
     Q_INVOKABLE void setImage(const QImage& image, void* texture, bool translucent, const QColor& averageColor, int originalWidth,
-                              int originalHeight);
+                              int originalHeight, int loadGeneration);
+
+    /// Called once the upload budget of the frame allows for the texture
+    void applyImage(const QImage& image, const gpu::TexturePointer& texture, bool translucent, const QColor& averageColor,
+                    int originalWidth, int originalHeight);
 
     virtual void imageLoaded(const QImage& image);
 
+    /// The textures embedded in their model can't load again from their URL, so they keep loading
+    virtual void cancelLoading();
+
     TextureType _type;
 
 private:
+    bool _embedded = false;
     bool _translucent;
     QColor _averageColor;
     int _originalWidth;
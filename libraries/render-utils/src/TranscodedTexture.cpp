@@ -0,0 +1,165 @@
+//
+//  TranscodedTexture.cpp
+//  libraries/render-utils/src
+//
+//  Copyright 2015 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "TranscodedTexture.h"
+
+#include <cstring>
+
+#include <QCryptographicHash>
+#include <QDataStream>
+
+#include "RenderUtilsLogging.h"
+
+const quint32 TranscodedTexture::VERSION = 1;
+const QString TranscodedTexture::FILE_EXTENSION = ".texture";
+
+static const char MAGIC[8] = { 'H', 'F', 'T', 'E', 'X', 'T', 'U', 'R' };
+
+// written in native order, so that a file written on a big-endian machine reads as a mismatch rather than as garbage
+static const quint32 BYTE_ORDER_MARK = 0x01020304;
+
+class TranscodedReader {
+public:
+    TranscodedReader(const char* data, qint64 size) : _position(data), _end(data + size) { }
+
+    const char* take(qint64 size) {
+        if (size < 0 || size > _end - _position) {
+            throw QString("Unexpected end of transcoded texture.");
+        }
+        const char* data = _position;
+        _position += size;
+        return data;
+    }
+
+    template<class T> T read() {
+        T value;
+        memcpy(&value, take(sizeof(T)), sizeof(T));
+        return value;
+    }
+
+private:
+    const char* _position;
+    const char* _end;
+};
+
+template<class T> static void writeValue(QByteArray& data, const T& value) {
+    data.append((const char*)&value, sizeof(T));
+}
+
+QByteArray TranscodedTexture::getKey(const QByteArray& content, int type) {
+    QByteArray settings;
+    QDataStream stream(&settings, QIODevice::WriteOnly);
+    stream << VERSION << (qint32)type;
+
+    QCryptographicHash hash(QCryptographicHash::Sha1);
+    hash.addData(settings);
+    hash.addData(content);
+    return hash.result().toHex();
+}
+
+bool TranscodedTexture::isTranscodable(const QImage& image) {
+    return gpu::TextureCompressor::isCompressible(image.width(), image.height());
+}
+
+TranscodedTexture TranscodedTexture::transcode(const QImage& image) {
+    QImage rgbaImage = image.convertToFormat(QImage::Format_RGBA8888);
+    int rowSize = rgbaImage.width() * gpu::TextureCompressor::RGBA_TEXEL_SIZE;
+    gpu::TextureCompressor::Image baseLevel(rgbaImage.width(), rgbaImage.height(), rowSize * rgbaImage.height());
+    for (int y = 0; y < rgbaImage.height(); y++) {
+        memcpy(&baseLevel._bytes[y * rowSize], rgbaImage.constScanLine(y), rowSize);
+    }
+
+    TranscodedTexture texture;
+    texture.format = gpu::TextureCompressor::getCompressedFormat(image.hasAlphaChannel());
+    texture.mips = gpu::TextureCompressor::compress(gpu::TextureCompressor::generateMips(baseLevel), texture.format);
+    return texture;
+}
+
+QByteArray TranscodedTexture::write() const {
+    QByteArray data;
+    data.append(MAGIC, sizeof(MAGIC));
+    writeValue(data, BYTE_ORDER_MARK);
+    writeValue(data, VERSION);
+    writeValue<quint8>(data, format.getSemantic());
+    writeValue<quint8>(data, translucent ? 1 : 0);
+    writeValue<quint32>(data, averageColor.rgba());
+    writeValue<qint32>(data, originalWidth);
+    writeValue<qint32>(data, originalHeight);
+    writeValue<quint32>(data, mips.size());
+    for (const auto& mip : mips) {
+        writeValue(data, mip._width);
+        writeValue(data, mip._height);
+        data.append((const char*)mip._bytes.data(), (int)mip._bytes.size());
+    }
+    return data;
+}
+
+TranscodedTexture TranscodedTexture::read(const char* data, qint64 size) {
+    TranscodedReader reader(data, size);
+    if (memcmp(reader.take(sizeof(MAGIC)), MAGIC, sizeof(MAGIC)) != 0) {
+        throw QString("Not a transcoded texture.");
+    }
+    if (reader.read<quint32>() != BYTE_ORDER_MARK || reader.read<quint32>() != VERSION) {
+        throw QString("Transcoded texture of another version or byte order.");
+    }
+    TranscodedTexture texture;
+    quint8 semantic = reader.read<quint8>();
+    if (semantic != gpu::COMPRESSED_BC1 && semantic != gpu::COMPRESSED_BC3) {
+        throw QString("Unknown transcoded texture format.");
+    }
+    texture.format = gpu::TextureCompressor::getCompressedFormat(semantic == gpu::COMPRESSED_BC3);
+    texture.translucent = reader.read<quint8>() != 0;
+    texture.averageColor = QColor::fromRgba(reader.read<quint32>());
+    texture.originalWidth = reader.read<qint32>();
+    texture.originalHeight = reader.read<qint32>();
+
+    quint32 numMips = reader.read<quint32>();
+    if (numMips == 0) {
+        throw QString("Transcoded texture without mips.");
+    }
+    texture.mips.resize(numMips);
+    for (auto& mip : texture.mips) {
+        mip._width = reader.read<gpu::uint16>();
+        mip._height = reader.read<gpu::uint16>();
+        gpu::uint32 mipSize = gpu::Texture::evalImageSize(mip._width, mip._height, 1, texture.format);
+        const char* bytes = reader.take(mipSize);
+        mip._bytes.assign((const gpu::Byte*)bytes, (const gpu::Byte*)bytes + mipSize);
+    }
+    return texture;
+}
+
+gpu::Texture* TranscodedTexture::createTexture() const {
+    return gpu::TextureCompressor::createTexture(mips, format, gpu::Sampler(gpu::Sampler::FILTER_MIN_MAG_MIP_LINEAR));
+}
+
+TranscodedTextureCache::TranscodedTextureCache(const QSharedPointer<ResourceDiskCache>& diskCache) :
+    _diskCache(diskCache) {
+}
+
+bool TranscodedTextureCache::load(const QByteArray& key, TranscodedTexture& texture) const {
+    QString name = QString::fromLatin1(key) + TranscodedTexture::FILE_EXTENSION;
+    QByteArray data;
+    if (!(_diskCache && _diskCache->load(name, data))) {
+        return false;
+    }
+    try {
+        texture = TranscodedTexture::read(data.constData(), data.size());
+        return true;
+
+    } catch (const QString& error) {
+        qCDebug(renderutils) << "Removing transcoded texture" << name << ":" << error;
+        _diskCache->remove(name);
+        return false;
+    }
+}
+
+bool TranscodedTextureCache::store(const QByteArray& key, const TranscodedTexture& texture) const {
+    return _diskCache && _diskCache->store(QString::fromLatin1(key) + TranscodedTexture::FILE_EXTENSION, texture.write());
+}
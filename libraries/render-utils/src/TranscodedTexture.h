@@ -0,0 +1,70 @@
+//
+//  TranscodedTexture.h
+//  libraries/render-utils/src
+//
+//  Copyright 2015 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_TranscodedTexture_h
+#define hifi_TranscodedTexture_h
+
+#include <QColor>
+#include <QImage>
+#include <QSharedPointer>
+
+#include <gpu/TextureCompressor.h>
+#include <ResourceDiskCache.h>
+
+/// A texture transcoded for the GPU: the block compressed mip chain of its image, along with what the texture cache measures
+/// of the image, so that a transcoded texture loads without decoding the image again.
+class TranscodedTexture {
+public:
+    /// Bumped whenever the layout or the compression of the textures changes, which invalidates the cached files
+    static const quint32 VERSION;
+
+    static const QString FILE_EXTENSION;
+
+    /// Returns the key of the texture transcoded from the content of the image file, for the type of texture
+    static QByteArray getKey(const QByteArray& content, int type);
+
+    /// The compressed formats are uploaded in whole blocks, which the base level has to fill
+    static bool isTranscodable(const QImage& image);
+
+    /// Generates the mips of the image and compresses them, to BC3 if the image has alpha and to BC1 otherwise
+    static TranscodedTexture transcode(const QImage& image);
+
+    QByteArray write() const;
+
+    /// \exception QString if the data isn't a transcoded texture of this version, or is truncated
+    static TranscodedTexture read(const char* data, qint64 size);
+
+    gpu::Texture* createTexture() const;
+
+    gpu::Element format;
+    gpu::TextureCompressor::MipChain mips;
+    bool translucent = false;
+    QColor averageColor;
+    int originalWidth = 0;
+    int originalHeight = 0;
+};
+
+/// The transcoded textures in the disk cache of the resources, named after their keys.
+class TranscodedTextureCache {
+public:
+    /// Without a disk cache, nothing is cached
+    TranscodedTextureCache(const QSharedPointer<ResourceDiskCache>& diskCache);
+
+    /// Reads the texture of the key, returning false if it isn't cached (or its entry is stale or corrupt, in which case
+    /// the entry is removed).
+    bool load(const QByteArray& key, TranscodedTexture& texture) const;
+
+    bool store(const QByteArray& key, const TranscodedTexture& texture) const;
+
+private:
+    QSharedPointer<ResourceDiskCache> _diskCache;
+};
+
+#endif // hifi_TranscodedTexture_h
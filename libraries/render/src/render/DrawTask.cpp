@@ -17,8 +17,13 @@
 #include <PerfStat.h>
 #include <RenderArgs.h>
 #include <ViewFrustum.h>
+#include <gpu/BatchOptimizer.h>
 #include <gpu/Context.h>
 
+#include <tbb/task_group.h>
+
+#include "SpatialTree.h"
+
 using namespace render;
 
 DrawSceneTask::DrawSceneTask() : Task() {
@@ -52,12 +57,12 @@ Job::~Job() {
 
 
 
-void render::cullItems(const SceneContextPointer& sceneContext, const RenderContextPointer& renderContext, const ItemIDsBounds& inItems, ItemIDsBounds& outItems) {
+void render::cullItems(const SceneContextPointer& sceneContext, const RenderContextPointer& renderContext, const ItemIDsBounds& inItems, ItemIDsBounds& outItems, RenderDetails::Item* details) {
     assert(renderContext->args);
     assert(renderContext->args->_viewFrustum);
 
     RenderArgs* args = renderContext->args;
-    auto renderDetails = renderContext->args->_details._item;
+    auto renderDetails = details ? details : renderContext->args->_details._item;
 
     renderDetails->_considered += inItems.size();
     
@@ -110,6 +115,44 @@ void FetchItems::run(const SceneContextPointer& sceneContext, const RenderContex
     }
 }
 
+void FetchSpatialItems::run(const SceneContextPointer& sceneContext, const RenderContextPointer& renderContext, ItemIDsBounds& outItems) {
+    assert(renderContext->args);
+    assert(renderContext->args->_viewFrustum);
+
+    auto& scene = sceneContext->_scene;
+    RenderArgs* args = renderContext->args;
+    auto renderDetails = &args->_details.getItem(_detailsType);
+
+    outItems.clear();
+
+    ItemSpatialTree::LODTest lodTest;
+    if (args->_shouldRender) {
+        lodTest = [args](const AABox& bound) { return args->_shouldRender(args, bound); };
+    }
+    ItemSpatialTree::SelectionStats stats;
+    {
+        PerformanceTimer perfTimer("selectSpatialItems");
+        scene->getSpatialTree().select(*args->_viewFrustum, lodTest, _filter, outItems, stats);
+    }
+    renderDetails->_considered += stats.considered;
+    renderDetails->_outOfView += stats.outOfView;
+    renderDetails->_tooSmall += stats.tooSmall;
+
+    ItemIDsBounds nonSpatialItems;
+    for (auto id : scene->getNonSpatialItems()) {
+        auto& item = scene->getItem(id);
+        if (_filter.test(item.getKey())) {
+            nonSpatialItems.emplace_back(ItemIDAndBounds(id, item.getBound()));
+        }
+    }
+    // counts the rendered items of the tree as well
+    cullItems(sceneContext, renderContext, nonSpatialItems, outItems, renderDetails);
+
+    if (_probeNumItems) {
+        _probeNumItems(renderContext, stats.considered + (int)nonSpatialItems.size());
+    }
+}
+
 void CullItems::run(const SceneContextPointer& sceneContext, const RenderContextPointer& renderContext, const ItemIDsBounds& inItems, ItemIDsBounds& outItems) {
 
     outItems.clear();
@@ -145,7 +188,6 @@ void render::depthSortItems(const SceneContextPointer& sceneContext, const Rende
     assert(renderContext->args);
     assert(renderContext->args->_viewFrustum);
     
-    auto& scene = sceneContext->_scene;
     RenderArgs* args = renderContext->args;
     
 
@@ -159,8 +201,7 @@ void render::depthSortItems(const SceneContextPointer& sceneContext, const Rende
     itemBounds.reserve(outItems.size());
 
     for (auto itemDetails : inItems) {
-        auto item = scene->getItem(itemDetails.id);
-        auto bound = itemDetails.bounds; // item.getBound();
+        auto bound = itemDetails.bounds;
         float distance = args->_viewFrustum->distanceToCamera(bound.calcCenter());
 
         itemBounds.emplace_back(ItemBound(distance, distance, distance, itemDetails.id, bound));
@@ -188,11 +229,100 @@ void DepthSortItems::run(const SceneContextPointer& sceneContext, const RenderCo
     depthSortItems(sceneContext, renderContext, _frontToBack, inItems, outItems);
 }
 
-void render::renderItems(const SceneContextPointer& sceneContext, const RenderContextPointer& renderContext, const ItemIDsBounds& inItems, int maxDrawnItems) {
-    auto& scene = sceneContext->_scene;
+// Items are recorded by chunks of this size, a chunk goes to a worker thread if all of its items can be recorded there
+const int RECORDING_CHUNK_SIZE = 32;
+
+static void recordChunk(const ScenePointer& scene, RenderArgs* args, const ItemIDsBounds& items, size_t begin, size_t end) {
+    for (size_t i = begin; i < end; i++) {
+        auto item = scene->getItem(items[i].id);
+        item.render(args);
+    }
+}
+
+// Each chunk is recorded in its own batch with its own copy of the RenderArgs, then the batches are appended to
+// args->_batch in the order of the items. The chunks only depend on the list of items, not on how the workers pick
+// them, so the final batch is the same as if all the items were recorded in sequence.
+// When the batches are optimized, every chunk is optimized on a worker once recorded, including the chunks recorded on
+// the render thread
+static bool renderItemsConcurrently(const ScenePointer& scene, const RenderContextPointer& renderContext, const ItemIDsBounds& items) {
+    RenderArgs* args = renderContext->args;
+    bool optimizeBatches = renderContext->_optimizeBatches;
+    size_t numChunks = (items.size() + RECORDING_CHUNK_SIZE - 1) / RECORDING_CHUNK_SIZE;
+    if (numChunks < (optimizeBatches ? 1 : 2)) {
+        return false;
+    }
+
+    std::vector<char> isConcurrentChunk(numChunks, 1);
+    bool hasConcurrentChunks = false;
+    for (size_t chunk = 0; chunk < numChunks; chunk++) {
+        size_t end = std::min(items.size(), (chunk + 1) * RECORDING_CHUNK_SIZE);
+        for (size_t i = chunk * RECORDING_CHUNK_SIZE; i < end; i++) {
+            if (!scene->getItem(items[i].id).canRenderConcurrently(args)) {
+                isConcurrentChunk[chunk] = 0;
+                break;
+            }
+        }
+        hasConcurrentChunks = hasConcurrentChunks || isConcurrentChunk[chunk];
+    }
+    if (!hasConcurrentChunks && !optimizeBatches) {
+        return false;
+    }
+
+    std::vector<gpu::Batch> batches(numChunks);
+    std::vector<RenderArgs> chunkArgs(numChunks, *args);
+    std::vector<gpu::BatchOptimizer::Stats> chunkStats(numChunks);
+    auto recordChunkAt = [&](size_t chunk) {
+        RenderArgs& chunkArg = chunkArgs[chunk];
+        chunkArg._batch = &batches[chunk];
+        chunkArg._details._materialSwitches = 0;
+        chunkArg._details._trianglesRendered = 0;
+        chunkArg._details._quadsRendered = 0;
+        recordChunk(scene, &chunkArg, items, chunk * RECORDING_CHUNK_SIZE,
+                    std::min(items.size(), (chunk + 1) * RECORDING_CHUNK_SIZE));
+    };
+    auto optimizeChunkAt = [&](size_t chunk) {
+        chunkStats[chunk] = gpu::BatchOptimizer::optimize(batches[chunk]);
+    };
+
+    tbb::task_group workers;
+    for (size_t chunk = 0; chunk < numChunks; chunk++) {
+        if (isConcurrentChunk[chunk]) {
+            workers.run([&recordChunkAt, &optimizeChunkAt, optimizeBatches, chunk] {
+                recordChunkAt(chunk);
+                if (optimizeBatches) {
+                    optimizeChunkAt(chunk);
+                }
+            });
+        }
+    }
+    // the others stay on the render thread
+    for (size_t chunk = 0; chunk < numChunks; chunk++) {
+        if (!isConcurrentChunk[chunk]) {
+            recordChunkAt(chunk);
+            if (optimizeBatches) {
+                workers.run([&optimizeChunkAt, chunk] { optimizeChunkAt(chunk); });
+            }
+        }
+    }
+    workers.wait();
+
+    for (size_t chunk = 0; chunk < numChunks; chunk++) {
+        args->_batch->append(batches[chunk]);
+        args->_details._materialSwitches += chunkArgs[chunk]._details._materialSwitches;
+        args->_details._trianglesRendered += chunkArgs[chunk]._details._trianglesRendered;
+        args->_details._quadsRendered += chunkArgs[chunk]._details._quadsRendered;
+        renderContext->_numRemovedBatchCommands += chunkStats[chunk].getNumRemovedCommands();
+    }
+    return true;
+}
+
+static void recordItems(const ScenePointer& scene, const RenderContextPointer& renderContext, const ItemIDsBounds& inItems, int maxDrawnItems) {
     RenderArgs* args = renderContext->args;
     // render
     if ((maxDrawnItems < 0) || (maxDrawnItems > (int) inItems.size())) {
+        if (args->_batch && renderItemsConcurrently(scene, renderContext, inItems)) {
+            return;
+        }
         for (auto itemDetails : inItems) {
             auto item = scene->getItem(itemDetails.id);
             item.render(args);
@@ -214,6 +344,16 @@ void render::renderItems(const SceneContextPointer& sceneContext, const RenderCo
     }
 }
 
+void render::renderItems(const SceneContextPointer& sceneContext, const RenderContextPointer& renderContext, const ItemIDsBounds& inItems, int maxDrawnItems) {
+    RenderArgs* args = renderContext->args;
+    recordItems(sceneContext->_scene, renderContext, inItems, maxDrawnItems);
+
+    // the items gathered as named calls, like the plain shapes, are drawn together with the state of this pass
+    if (args->_batch) {
+        args->_batch->flushNamedCalls();
+    }
+}
+
 void DrawLight::run(const SceneContextPointer& sceneContext, const RenderContextPointer& renderContext) {
     assert(renderContext->args);
     assert(renderContext->args->_viewFrustum);
@@ -49,6 +49,9 @@ public:
         template <class T> T& edit() { return std::static_pointer_cast<Model<T>>(_concept)->_data; }
         template <class T> const T& get() const { return std::static_pointer_cast<const Model<T>>(_concept)->_data; }
 
+        // true if both refer to the same piece of data, the output of a job and the input of its consumers do
+        bool isSameAs(const Varying& other) const { return _concept && _concept == other._concept; }
+
     protected:
         friend class Job;
 
@@ -80,6 +83,11 @@ public:
     bool isEnabled() const { return _concept->isEnabled(); }
     void setEnabled(bool isEnabled) { _concept->setEnabled(isEnabled); }
 
+    // A concurrent job only reads the scene and its input, and only writes its output: it doesn't record or submit
+    // gpu batches. The JobGraph runs it on a worker thread as soon as its input is ready
+    bool isConcurrent() const { return _concept->isConcurrent(); }
+    void setConcurrent(bool isConcurrent) { _concept->setConcurrent(isConcurrent); }
+
     const std::string& getName() const { return _concept->getName(); }
     const Varying getInput() const { return _concept->getInput(); }
     const Varying getOutput() const { return _concept->getOutput(); }
@@ -96,6 +104,7 @@ public:
     class Concept {
         std::string _name;
         bool _isEnabled = true;
+        bool _isConcurrent = false;
     public:
         Concept() : _name() {}
         Concept(const std::string& name) : _name(name) {}
@@ -107,6 +116,9 @@ public:
         bool isEnabled() const { return _isEnabled; }
         void setEnabled(bool isEnabled) { _isEnabled = isEnabled; }
 
+        bool isConcurrent() const { return _isConcurrent; }
+        void setConcurrent(bool isConcurrent) { _isConcurrent = isConcurrent; }
+
         virtual const Varying getInput() const { return Varying(); }
         virtual const Varying getOutput() const { return Varying(); }
         virtual void run(const SceneContextPointer& sceneContext, const RenderContextPointer& renderContext) = 0;
@@ -209,7 +221,8 @@ public:
 
 typedef std::vector<Job> Jobs;
 
-void cullItems(const SceneContextPointer& sceneContext, const RenderContextPointer& renderContext, const ItemIDsBounds& inItems, ItemIDsBounds& outITems);
+// the counts go to the given details, or to the current renderContext->args->_details._item if there are none
+void cullItems(const SceneContextPointer& sceneContext, const RenderContextPointer& renderContext, const ItemIDsBounds& inItems, ItemIDsBounds& outITems, RenderDetails::Item* details = nullptr);
 void depthSortItems(const SceneContextPointer& sceneContext, const RenderContextPointer& renderContext, bool frontToBack, const ItemIDsBounds& inItems, ItemIDsBounds& outITems);
 void renderItems(const SceneContextPointer& sceneContext, const RenderContextPointer& renderContext, const ItemIDsBounds& inItems, int maxDrawnItems = -1);
 
@@ -228,6 +241,27 @@ public:
     typedef Job::ModelO<FetchItems, ItemIDsBounds> JobModel;
 };
 
+// Fetch and cull in one go: the items of the scene's spatial tree are selected by a hierarchical frustum/LOD query,
+// the few items the tree doesn't hold go through cullItems
+class FetchSpatialItems {
+public:
+    typedef FetchItems::ProbeNumItems ProbeNumItems;
+    FetchSpatialItems(const ProbeNumItems& probe, RenderDetails::Type detailsType = RenderDetails::OPAQUE_ITEM) :
+        _probeNumItems(probe), _detailsType(detailsType) {}
+    FetchSpatialItems(const ItemFilter& filter, const ProbeNumItems& probe, RenderDetails::Type detailsType) :
+        _filter(filter), _probeNumItems(probe), _detailsType(detailsType) {}
+
+    ItemFilter _filter = ItemFilter::Builder::opaqueShape().withoutLayered();
+    ProbeNumItems _probeNumItems;
+
+    // each bucket counts into its own details, so the fetches of different buckets can run concurrently
+    RenderDetails::Type _detailsType;
+
+    void run(const SceneContextPointer& sceneContext, const RenderContextPointer& renderContext, ItemIDsBounds& outItems);
+
+    typedef Job::ModelO<FetchSpatialItems, ItemIDsBounds> JobModel;
+};
+
 class CullItems {
 public:
     void run(const SceneContextPointer& sceneContext, const RenderContextPointer& renderContext, const ItemIDsBounds& inItems, ItemIDsBounds& outItems);
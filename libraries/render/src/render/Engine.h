@@ -55,6 +55,10 @@ public:
     bool _occlusionStatus = false;
     bool _fxaaStatus = false;
 
+    // Run the gpu::BatchOptimizer on the batches of the items before they are submitted
+    bool _optimizeBatches = false;
+    int _numRemovedBatchCommands = 0;
+
     RenderContext() {}
 };
 typedef std::shared_ptr<RenderContext> RenderContextPointer;
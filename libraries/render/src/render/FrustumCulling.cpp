@@ -0,0 +1,157 @@
+//
+//  FrustumCulling.cpp
+//  render/src/render
+//
+//  Copyright 2015 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "FrustumCulling.h"
+
+#if defined(__SSE__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 1)
+#define HIFI_CULLING_SSE
+#include <xmmintrin.h>
+#endif
+
+using namespace render;
+
+void ItemBoundsArray::push_back(ItemID id, const ItemKey& key, const AABox& bound) {
+    _ids.push_back(id);
+    _keys.push_back(key);
+    _bounds.push_back(bound);
+    for (int axis = 0; axis < 3; axis++) {
+        _minimum[axis].push_back(0.0f);
+        _maximum[axis].push_back(0.0f);
+    }
+    set(size() - 1, key, bound);
+}
+
+void ItemBoundsArray::set(int index, const ItemKey& key, const AABox& bound) {
+    _keys[index] = key;
+    _bounds[index] = bound;
+
+    // computed like AABox::getVertexP does, so the planes give the same distances as in boxInFrustum
+    const glm::vec3& corner = bound.getCorner();
+    const glm::vec3& scale = bound.getScale();
+    for (int axis = 0; axis < 3; axis++) {
+        _minimum[axis][index] = corner[axis];
+        _maximum[axis][index] = corner[axis] + scale[axis];
+    }
+}
+
+ItemID ItemBoundsArray::removeAt(int index) {
+    int last = size() - 1;
+    if (index != last) {
+        _ids[index] = _ids[last];
+        _keys[index] = _keys[last];
+        _bounds[index] = _bounds[last];
+        for (int axis = 0; axis < 3; axis++) {
+            _minimum[axis][index] = _minimum[axis][last];
+            _maximum[axis][index] = _maximum[axis][last];
+        }
+    }
+    ItemID moved = _ids[index];
+
+    _ids.pop_back();
+    _keys.pop_back();
+    _bounds.pop_back();
+    for (int axis = 0; axis < 3; axis++) {
+        _minimum[axis].pop_back();
+        _maximum[axis].pop_back();
+    }
+    return moved;
+}
+
+FrustumPlanes::FrustumPlanes(const ViewFrustum& frustum) :
+    frustum(frustum)
+{
+    const ::Plane* planes = frustum.getPlanes();
+    for (int i = 0; i < 6; i++) {
+        normals[i] = planes[i].getNormal();
+        distances[i] = planes[i].getDCoefficient();
+    }
+
+    // same cube as the ViewFrustum's keyhole bounding cube
+    float radius = frustum.getKeyholeRadius();
+    hasKeyhole = (radius >= 0.0f);
+    keyholeMinimum = frustum.getPosition() - radius;
+    keyholeMaximum = keyholeMinimum + glm::vec3(radius * 2.0f);
+}
+
+// the keyhole only keeps boxes that are inside its bounding cube, so anything not touching the cube is rejected
+static bool touchesKeyhole(const FrustumPlanes& planes, const ItemBoundsArray& bounds, int index) {
+    for (int axis = 0; axis < 3; axis++) {
+        if (bounds.getMaximum(axis)[index] < planes.keyholeMinimum[axis] ||
+            bounds.getMinimum(axis)[index] > planes.keyholeMaximum[axis]) {
+            return false;
+        }
+    }
+    return true;
+}
+
+void render::cullBounds(const FrustumPlanes& planes, const ItemBoundsArray& bounds, std::vector<uint8_t>& outInView) {
+    int numBounds = bounds.size();
+    outInView.resize(numBounds);
+
+    // the vertex of a box furthest along a plane normal takes the max or the min on each axis depending only on the
+    // signs of the normal, so it is picked once per plane rather than once per box
+    const float* vertexP[6][3];
+    for (int i = 0; i < 6; i++) {
+        for (int axis = 0; axis < 3; axis++) {
+            vertexP[i][axis] = (planes.normals[i][axis] > 0.0f) ? bounds.getMaximum(axis) : bounds.getMinimum(axis);
+        }
+    }
+
+    int index = 0;
+#ifdef HIFI_CULLING_SSE
+    __m128 normalX[6], normalY[6], normalZ[6], distance[6];
+    for (int i = 0; i < 6; i++) {
+        normalX[i] = _mm_set1_ps(planes.normals[i].x);
+        normalY[i] = _mm_set1_ps(planes.normals[i].y);
+        normalZ[i] = _mm_set1_ps(planes.normals[i].z);
+        distance[i] = _mm_set1_ps(planes.distances[i]);
+    }
+    const __m128 zero = _mm_setzero_ps();
+
+    for (; index + 4 <= numBounds; index += 4) {
+        __m128 inside = _mm_cmpeq_ps(zero, zero);
+        for (int i = 0; i < 6; i++) {
+            __m128 dot = _mm_add_ps(_mm_add_ps(_mm_mul_ps(normalX[i], _mm_loadu_ps(vertexP[i][0] + index)),
+                                               _mm_mul_ps(normalY[i], _mm_loadu_ps(vertexP[i][1] + index))),
+                                    _mm_mul_ps(normalZ[i], _mm_loadu_ps(vertexP[i][2] + index)));
+            // not less than rather than greater or equal, a NaN distance is not outside in boxInFrustum either
+            inside = _mm_and_ps(inside, _mm_cmpnlt_ps(_mm_add_ps(distance[i], dot), zero));
+        }
+        int mask = _mm_movemask_ps(inside);
+        outInView[index] = mask & 1;
+        outInView[index + 1] = (mask >> 1) & 1;
+        outInView[index + 2] = (mask >> 2) & 1;
+        outInView[index + 3] = (mask >> 3) & 1;
+    }
+#endif
+
+    for (; index < numBounds; index++) {
+        bool inside = true;
+        for (int i = 0; i < 6; i++) {
+            const glm::vec3& normal = planes.normals[i];
+            float dot = normal.x * vertexP[i][0][index] + normal.y * vertexP[i][1][index] +
+                normal.z * vertexP[i][2][index];
+            if (planes.distances[i] + dot < 0.0f) {
+                inside = false;
+                break;
+            }
+        }
+        outInView[index] = inside ? 1 : 0;
+    }
+
+    // boxes outside of the planes can still be in the keyhole around the eye
+    if (planes.hasKeyhole) {
+        for (index = 0; index < numBounds; index++) {
+            if (!outInView[index] && touchesKeyhole(planes, bounds, index)) {
+                outInView[index] = (planes.frustum.boxInFrustum(bounds.getBound(index)) != ViewFrustum::OUTSIDE) ? 1 : 0;
+            }
+        }
+    }
+}
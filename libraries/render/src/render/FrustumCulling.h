@@ -0,0 +1,74 @@
+//
+//  FrustumCulling.h
+//  render/src/render
+//
+//  Copyright 2015 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_render_FrustumCulling_h
+#define hifi_render_FrustumCulling_h
+
+#include <stdint.h>
+#include <vector>
+
+#include <ViewFrustum.h>
+
+#include "Scene.h"
+
+namespace render {
+
+// Structure of arrays of item ids, keys and bounds.
+//
+// The corners of the bounds are split per axis so that the culling kernel streams through contiguous floats, the
+// bounds themselves are kept as well so the selected items can be handed out exactly as they were given.
+class ItemBoundsArray {
+public:
+    int size() const { return (int)_ids.size(); }
+    bool empty() const { return _ids.empty(); }
+
+    void push_back(ItemID id, const ItemKey& key, const AABox& bound);
+    void set(int index, const ItemKey& key, const AABox& bound);
+
+    /// removes the entry by moving the last one in its place, returns the id of the moved entry
+    ItemID removeAt(int index);
+
+    ItemID getID(int index) const { return _ids[index]; }
+    const ItemKey& getKey(int index) const { return _keys[index]; }
+    const AABox& getBound(int index) const { return _bounds[index]; }
+
+    const float* getMinimum(int axis) const { return _minimum[axis].data(); }
+    const float* getMaximum(int axis) const { return _maximum[axis].data(); }
+
+private:
+    std::vector<ItemID> _ids;
+    std::vector<ItemKey> _keys;
+    std::vector<AABox> _bounds;
+    std::vector<float> _minimum[3];
+    std::vector<float> _maximum[3];
+};
+
+// The planes and keyhole of a ViewFrustum, laid out for cullBounds
+class FrustumPlanes {
+public:
+    FrustumPlanes(const ViewFrustum& frustum);
+
+    const ViewFrustum& frustum;
+    glm::vec3 normals[6];
+    float distances[6];
+
+    bool hasKeyhole;
+    glm::vec3 keyholeMinimum;
+    glm::vec3 keyholeMaximum;
+};
+
+/// Sets outInView[i] to 1 for the bounds that ViewFrustum::boxInFrustum would not find OUTSIDE, to 0 for the others.
+/// The six planes are tested against four bounds at a time with SSE where available, only the bounds that fail the
+/// planes but reach the keyhole go through the full scalar test.
+void cullBounds(const FrustumPlanes& planes, const ItemBoundsArray& bounds, std::vector<uint8_t>& outInView);
+
+}
+
+#endif // hifi_render_FrustumCulling_h
@@ -0,0 +1,155 @@
+//
+//  JobGraph.cpp
+//  render/src/render
+//
+//  Copyright 2015 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "JobGraph.h"
+
+#include <assert.h>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+
+#include <tbb/task_group.h>
+
+using namespace render;
+
+// the state of one run of the graph
+class JobGraph::Frame {
+public:
+    Frame(const Jobs& jobs, const SceneContextPointer& sceneContext, const RenderContextPointer& renderContext) :
+        jobs(jobs), sceneContext(sceneContext), renderContext(renderContext), done(jobs.size(), false) {}
+
+    const Jobs& jobs;
+    const SceneContextPointer& sceneContext;
+    const RenderContextPointer& renderContext;
+
+    tbb::task_group workers;
+
+    // the concurrent jobs whose input is ready, taken by the worker tasks or by the calling thread while it waits
+    std::mutex doneMutex;
+    std::condition_variable doneCondition;
+    std::deque<int> ready;      // guarded by doneMutex
+    std::vector<char> done;     // guarded by doneMutex
+    int numDone = 0;            // guarded by doneMutex
+};
+
+JobGraph::JobGraph() {
+}
+
+JobGraph::~JobGraph() {
+}
+
+void JobGraph::build(const Jobs& jobs) {
+    _nodes.clear();
+    _nodes.resize(jobs.size());
+
+    for (int i = 0; i < (int)jobs.size(); i++) {
+        Job::Varying input = jobs[i].getInput();
+        // the jobs are listed after the ones producing their input, that's the only way to get hold of the output
+        for (int j = 0; j < i; j++) {
+            if (jobs[j].getOutput().isSameAs(input)) {
+                _nodes[i].producer = j;
+                _nodes[j].consumers.push_back(i);
+                break;
+            }
+        }
+    }
+}
+
+void JobGraph::run(const Jobs& jobs, const SceneContextPointer& sceneContext, const RenderContextPointer& renderContext) {
+    if (_nodes.size() != jobs.size()) {
+        build(jobs);
+    }
+    Frame frame(jobs, sceneContext, renderContext);
+
+    for (int i = 0; i < (int)jobs.size(); i++) {
+        if (jobs[i].isConcurrent() && _nodes[i].producer < 0) {
+            spawnJob(frame, i);
+        }
+    }
+
+    for (int i = 0; i < (int)jobs.size(); i++) {
+        if (jobs[i].isConcurrent()) {
+            continue;
+        }
+        int producer = _nodes[i].producer;
+        if (producer >= 0) {
+            waitForJobs(frame, [&] { return frame.done[producer] != 0; });
+        }
+        runJob(frame, i);
+    }
+
+    // the outputs nobody waited for
+    waitForJobs(frame, [&] { return frame.numDone == (int)frame.jobs.size(); });
+    frame.workers.wait();
+}
+
+void JobGraph::waitForJobs(Frame& frame, const std::function<bool()>& isDone) {
+    // the calling thread is not a tbb worker, and there may be no worker free to take the ready jobs (a single core, a
+    // busy arena), so it runs them itself rather than block on them
+    std::unique_lock<std::mutex> lock(frame.doneMutex);
+    while (!isDone()) {
+        if (frame.ready.empty()) {
+            // what's left is running on a worker, which notifies when it's done or has made a job ready
+            frame.doneCondition.wait(lock);
+        } else {
+            int jobIndex = frame.ready.front();
+            frame.ready.pop_front();
+            lock.unlock();
+            runJob(frame, jobIndex);
+            lock.lock();
+        }
+    }
+}
+
+void JobGraph::runReadyJob(Frame& frame) {
+    int jobIndex;
+    {
+        std::lock_guard<std::mutex> lock(frame.doneMutex);
+        if (frame.ready.empty()) {
+            // the calling thread took it
+            return;
+        }
+        jobIndex = frame.ready.front();
+        frame.ready.pop_front();
+    }
+    runJob(frame, jobIndex);
+}
+
+void JobGraph::runJob(Frame& frame, int jobIndex) {
+    Job job = frame.jobs[jobIndex];
+    job.run(frame.sceneContext, frame.renderContext);
+
+    {
+        std::lock_guard<std::mutex> lock(frame.doneMutex);
+        frame.done[jobIndex] = true;
+        frame.numDone++;
+    }
+    frame.doneCondition.notify_all();
+
+    for (int consumer : _nodes[jobIndex].consumers) {
+        if (frame.jobs[consumer].isConcurrent()) {
+            spawnJob(frame, consumer);
+        }
+    }
+}
+
+void JobGraph::spawnJob(Frame& frame, int jobIndex) {
+    assert(frame.jobs[jobIndex].isConcurrent());
+    {
+        std::lock_guard<std::mutex> lock(frame.doneMutex);
+        frame.ready.push_back(jobIndex);
+    }
+    frame.doneCondition.notify_all();
+
+    // a task per ready job, though whichever thread gets there first runs it
+    frame.workers.run([this, &frame] {
+        runReadyJob(frame);
+    });
+}
@@ -0,0 +1,60 @@
+//
+//  JobGraph.h
+//  render/src/render
+//
+//  Copyright 2015 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_render_JobGraph_h
+#define hifi_render_JobGraph_h
+
+#include <functional>
+#include <vector>
+
+#include "DrawTask.h"
+
+namespace render {
+
+// Runs a list of Jobs as a graph.
+//
+// A job depends on the job whose output is its input. Concurrent jobs (see Job::isConcurrent) run on the tbb worker
+// threads as soon as their input is ready; the other jobs run on the calling thread, where the gpu context lives, in
+// the order of the list, each one after its input is ready. So the cull and sort of different buckets overlap each
+// other and the setup jobs, and only the jobs recording batches are serialized. While the calling thread waits for an
+// input, it runs the ready concurrent jobs itself, so the graph completes without any worker.
+//
+// The graph is built on the first run and rebuilt when the number of jobs changes.
+class JobGraph {
+public:
+    JobGraph();
+    ~JobGraph();
+
+    void run(const Jobs& jobs, const SceneContextPointer& sceneContext, const RenderContextPointer& renderContext);
+
+    // index of the job producing the input of the given job, or -1 if the job has no input or nobody produces it
+    int getProducer(int jobIndex) const { return _nodes[jobIndex].producer; }
+
+private:
+    class Node {
+    public:
+        int producer = -1;
+        std::vector<int> consumers;
+    };
+
+    class Frame;
+
+    void build(const Jobs& jobs);
+    void runJob(Frame& frame, int jobIndex);
+    void runReadyJob(Frame& frame);
+    void spawnJob(Frame& frame, int jobIndex);
+    void waitForJobs(Frame& frame, const std::function<bool()>& isDone);
+
+    std::vector<Node> _nodes;
+};
+
+}
+
+#endif // hifi_render_JobGraph_h
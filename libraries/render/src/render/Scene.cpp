@@ -13,6 +13,8 @@
 #include <numeric>
 #include "gpu/Batch.h"
 
+#include "SpatialTree.h"
+
 using namespace render;
 
 void ItemBucketMap::insert(const ItemID& id, const ItemKey& key) {
@@ -142,11 +144,16 @@ void PendingChanges::merge(PendingChanges& changes) {
     _updateFunctors.insert(_updateFunctors.end(), changes._updateFunctors.begin(), changes._updateFunctors.end());
 }
 
-Scene::Scene() {
+Scene::Scene() :
+    _spatialTree(new ItemSpatialTree())
+{
     _items.push_back(Item()); // add the itemID #0 to nothing
     _masterBucketMap.allocateStandardOpaqueTranparentBuckets();
 }
 
+Scene::~Scene() {
+}
+
 ItemID Scene::allocateID() {
     // Just increment and return the proevious value initialized at 0
     return _IDAllocator.fetch_add(1);
@@ -187,6 +194,8 @@ void Scene::processPendingChangesQueue() {
         updateItems(consolidatedPendingChanges._updatedItems, consolidatedPendingChanges._updateFunctors);
         removeItems(consolidatedPendingChanges._removedItems);
 
+        updateDynamicItems();
+
      // ready to go back to rendering activities
     _itemsMutex.unlock();
 }
@@ -200,6 +209,7 @@ void Scene::resetItems(const ItemIDs& ids, Payloads& payloads) {
         item.resetPayload(*resetPayload);
 
         _masterBucketMap.reset((*resetID), oldKey, item.getKey());
+        updateSpatialTree(*resetID);
     }
 
 }
@@ -208,6 +218,7 @@ void Scene::removeItems(const ItemIDs& ids) {
     for (auto removedID :ids) {
         _masterBucketMap.erase(removedID, _items[removedID].getKey());
         _items[removedID].kill();
+        updateSpatialTree(removedID);
     }
 }
 
@@ -215,6 +226,51 @@ void Scene::updateItems(const ItemIDs& ids, UpdateFunctors& functors) {
     auto updateID = ids.begin();
     auto updateFunctor = functors.begin();
     for (;updateID != ids.end(); updateID++, updateFunctor++) {
-        _items[(*updateID)].update((*updateFunctor));
+        // no functor means the item just moved
+        if (*updateFunctor && _items[(*updateID)]._payload) {
+            _items[(*updateID)].update((*updateFunctor));
+        }
+        updateSpatialTree(*updateID);
+    }
+}
+
+void Scene::updateSpatialTree(ItemID id) {
+    const auto& item = _items[id];
+    if (!item._payload) {
+        _spatialTree->remove(id);
+        _nonSpatialItems.erase(id);
+        _dynamicItems.erase(id);
+        return;
+    }
+
+    const auto& key = item.getKey();
+    if (key.isDynamic()) {
+        _dynamicItems.insert(id);
+    } else {
+        _dynamicItems.erase(id);
+    }
+
+    // view space items have no place in a world space tree
+    Item::Bound bound = key.isWorldSpace() ? item.getBound() : Item::Bound();
+    if (!bound.isNull()) {
+        _spatialTree->update(id, key, bound);
+        _nonSpatialItems.erase(id);
+    } else {
+        _spatialTree->remove(id);
+        _nonSpatialItems.insert(id);
+    }
+}
+
+void Scene::updateDynamicItems() {
+    PROFILE_RANGE(__FUNCTION__);
+    for (auto id : _dynamicItems) {
+        const auto& item = _items[id];
+        Item::Bound bound = item.getBound();
+        if (!bound.isNull() && _spatialTree->contains(id)) {
+            // the common case, the item is already in the tree and just moved within it
+            _spatialTree->update(id, item.getKey(), bound);
+        } else {
+            updateSpatialTree(id);
+        }
     }
 }
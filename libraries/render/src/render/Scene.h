@@ -256,6 +256,7 @@ public:
         virtual int getLayer() const = 0;
 
         virtual void render(RenderArgs* args) = 0;
+        virtual bool canRenderConcurrently(const RenderArgs* args) const = 0;
 
         virtual const model::MaterialKey getMaterialKey() const = 0;
 
@@ -296,6 +297,10 @@ public:
     // Render call for the item
     void render(RenderArgs* args) { _payload->render(args); }
 
+    // True if the render call with these args can record into its own batch on a worker thread, see
+    // payloadCanRenderConcurrently
+    bool canRenderConcurrently(const RenderArgs* args) const { return _payload->canRenderConcurrently(args); }
+
     // Shape Type Interface
     const model::MaterialKey getMaterialKey() const { return _payload->getMaterialKey(); }
 
@@ -338,6 +343,10 @@ template <class T> const ItemKey payloadGetKey(const std::shared_ptr<T>& payload
 template <class T> const Item::Bound payloadGetBound(const std::shared_ptr<T>& payloadData) { return Item::Bound(); }
 template <class T> int payloadGetLayer(const std::shared_ptr<T>& payloadData) { return 0; }
 template <class T> void payloadRender(const std::shared_ptr<T>& payloadData, RenderArgs* args) { }
+
+// A payload may only say yes if its render call with these args records into args->_batch and touches nothing but its
+// own data and read only state: it can then run on a worker thread, alongside other payloads, with a copy of the RenderArgs
+template <class T> bool payloadCanRenderConcurrently(const std::shared_ptr<T>& payloadData, const RenderArgs* args) { return false; }
     
 // Shape type interface
 template <class T> const model::MaterialKey shapeGetMaterialKey(const std::shared_ptr<T>& payloadData) { return model::MaterialKey(); }
@@ -356,6 +365,7 @@ public:
 
 
     virtual void render(RenderArgs* args) { payloadRender<T>(_data, args); } 
+    virtual bool canRenderConcurrently(const RenderArgs* args) const { return payloadCanRenderConcurrently<T>(_data, args); }
 
     // Shape Type interface
     virtual const model::MaterialKey getMaterialKey() const { return shapeGetMaterialKey<T>(_data); }
@@ -453,6 +463,9 @@ public:
 
     void updateItem(ItemID id, const UpdateFunctorPointer& functor);
 
+    // the item moved or resized, so the scene refreshes its place in the spatial tree
+    void updateItem(ItemID id) { updateItem(id, UpdateFunctorPointer()); }
+
     void merge(PendingChanges& changes);
 
     Payloads _resetPayloads;
@@ -465,16 +478,18 @@ protected:
 };
 typedef std::queue<PendingChanges> PendingChangesQueue;
 
+class ItemSpatialTree;
+
 
 // Scene is a container for Items
 // Items are introduced, modified or erased in the scene through PendingChanges
 // Once per Frame, the PendingChanges are all flushed
-// During the flush the standard buckets are updated
+// During the flush the standard buckets and the spatial tree are updated
 // Items are notified accordingly on any update message happening
 class Scene {
 public:
     Scene();
-    ~Scene() {}
+    ~Scene();
 
     /// This call is thread safe, can be called from anywhere to allocate a new ID
     ItemID allocateID();
@@ -491,6 +506,11 @@ public:
 
     unsigned int getNumItems() const { return _items.size(); }
 
+    /// Access the spatial tree holding the world space items with a bound, see ItemSpatialTree
+    const ItemSpatialTree& getSpatialTree() const { return *_spatialTree; }
+
+    /// Access the items which are not in the spatial tree: view space items and items without a bound
+    const ItemIDSet& getNonSpatialItems() const { return _nonSpatialItems; }
 
     void processPendingChangesQueue();
 
@@ -506,10 +526,20 @@ protected:
     Item::Vector _items;
     ItemBucketMap _masterBucketMap;
 
+    // Items are placed in the spatial tree when they are reset or updated, so whatever moves an item tells the scene
+    // through PendingChanges::updateItem. Only the dynamic items, which move nearly every frame (avatars), are
+    // re-placed every frame instead
+    std::unique_ptr<ItemSpatialTree> _spatialTree;
+    ItemIDSet _nonSpatialItems;
+    ItemIDSet _dynamicItems;
+
     void resetItems(const ItemIDs& ids, Payloads& payloads);
     void removeItems(const ItemIDs& ids);
     void updateItems(const ItemIDs& ids, UpdateFunctors& functors);
 
+    void updateSpatialTree(ItemID id);
+    void updateDynamicItems();
+
     friend class Engine;
 };
 
@@ -0,0 +1,291 @@
+//
+//  SpatialTree.cpp
+//  render/src/render
+//
+//  Copyright 2015 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include <algorithm>
+
+#include "SpatialTree.h"
+
+using namespace render;
+
+class ItemSpatialTree::Query {
+public:
+    Query(const ViewFrustum& frustum, const LODTest& lodTest, const ItemFilter& filter) :
+        frustum(frustum), planes(frustum), lodTest(lodTest), filter(filter), eye(frustum.getPosition()) {}
+
+    const ViewFrustum& frustum;
+    FrustumPlanes planes;
+    const LODTest& lodTest;
+    const ItemFilter& filter;
+    glm::vec3 eye;
+
+    std::vector<uint8_t> inView;    // scratch for cullBounds
+};
+
+ItemSpatialTree::ItemSpatialTree(const glm::vec3& corner, float size, int maxDepth) :
+    _maxDepth(maxDepth)
+{
+    allocateNode(INVALID_NODE, corner, size, 0);
+}
+
+int ItemSpatialTree::allocateNode(int parent, const glm::vec3& corner, float size, int depth) {
+    int nodeIndex;
+    if (_freeNodes.empty()) {
+        nodeIndex = (int)_nodes.size();
+        _nodes.push_back(Node());
+    } else {
+        nodeIndex = _freeNodes.back();
+        _freeNodes.pop_back();
+    }
+
+    Node& node = _nodes[nodeIndex];
+    node.corner = corner;
+    node.size = size;
+    node.depth = depth;
+    node.parent = parent;
+    for (int i = 0; i < 8; i++) {
+        node.children[i] = INVALID_NODE;
+    }
+    node.numItemsInSubtree = 0;
+    node.keyCountsInSubtree.clear();
+    node.entries.clear();
+    return nodeIndex;
+}
+
+int ItemSpatialTree::findNode(const AABox& bound) {
+    glm::vec3 center = bound.calcCenter();
+    float extent = bound.getLargestDimension();
+
+    // the comparisons are written so that a NaN ends up outside
+    const Node& root = _nodes[0];
+    glm::vec3 rootMaximum = root.corner + glm::vec3(root.size);
+    if (!(extent <= root.size &&
+          center.x >= root.corner.x && center.y >= root.corner.y && center.z >= root.corner.z &&
+          center.x < rootMaximum.x && center.y < rootMaximum.y && center.z < rootMaximum.z)) {
+        return OUTSIDE_NODE;
+    }
+
+    // go down as long as the item still fits in the children
+    int nodeIndex = 0;
+    for (int depth = 0; depth < _maxDepth; depth++) {
+        float childSize = 0.5f * _nodes[nodeIndex].size;
+        if (extent > childSize) {
+            break;
+        }
+
+        glm::vec3 middle = _nodes[nodeIndex].corner + glm::vec3(childSize);
+        int octant = (center.x >= middle.x ? 1 : 0) | (center.y >= middle.y ? 2 : 0) | (center.z >= middle.z ? 4 : 0);
+
+        int child = _nodes[nodeIndex].children[octant];
+        if (child == INVALID_NODE) {
+            glm::vec3 childCorner = _nodes[nodeIndex].corner + childSize *
+                glm::vec3((octant & 1) ? 1.0f : 0.0f, (octant & 2) ? 1.0f : 0.0f, (octant & 4) ? 1.0f : 0.0f);
+            // careful, this may reallocate _nodes
+            child = allocateNode(nodeIndex, childCorner, childSize, depth + 1);
+            _nodes[nodeIndex].children[octant] = child;
+        }
+        nodeIndex = child;
+    }
+    return nodeIndex;
+}
+
+bool ItemSpatialTree::belongsTo(int nodeIndex, const AABox& bound) const {
+    // true if findNode would pick this node for the bound
+    const Node& node = _nodes[nodeIndex];
+    glm::vec3 center = bound.calcCenter();
+    float extent = bound.getLargestDimension();
+    glm::vec3 maximum = node.corner + glm::vec3(node.size);
+    return extent <= node.size && (extent > 0.5f * node.size || node.depth == _maxDepth) &&
+        center.x >= node.corner.x && center.y >= node.corner.y && center.z >= node.corner.z &&
+        center.x < maximum.x && center.y < maximum.y && center.z < maximum.z;
+}
+
+void ItemSpatialTree::addToSubtreeCounts(int nodeIndex, const ItemKey& key, int count) {
+    while (nodeIndex != INVALID_NODE) {
+        Node& node = _nodes[nodeIndex];
+        node.numItemsInSubtree += count;
+
+        auto keyCount = std::find_if(node.keyCountsInSubtree.begin(), node.keyCountsInSubtree.end(),
+                                     [&](const KeyCount& keyCount) { return keyCount.key._flags == key._flags; });
+        if (keyCount == node.keyCountsInSubtree.end()) {
+            KeyCount newKeyCount = { key, count };
+            node.keyCountsInSubtree.push_back(newKeyCount);
+        } else {
+            keyCount->count += count;
+            if (keyCount->count == 0) {
+                node.keyCountsInSubtree.erase(keyCount);
+            }
+        }
+        nodeIndex = node.parent;
+    }
+}
+
+int ItemSpatialTree::countSubtreeItems(int nodeIndex, const ItemFilter& filter) const {
+    int count = 0;
+    for (const auto& keyCount : _nodes[nodeIndex].keyCountsInSubtree) {
+        if (filter.test(keyCount.key)) {
+            count += keyCount.count;
+        }
+    }
+    return count;
+}
+
+void ItemSpatialTree::pruneNode(int nodeIndex) {
+    // an empty subtree has no items and, once pruned, no children either. the root always stays
+    while (nodeIndex > 0 && _nodes[nodeIndex].numItemsInSubtree == 0) {
+        int parent = _nodes[nodeIndex].parent;
+        for (int i = 0; i < 8; i++) {
+            if (_nodes[parent].children[i] == nodeIndex) {
+                _nodes[parent].children[i] = INVALID_NODE;
+            }
+        }
+        _nodes[nodeIndex].entries = Entries();
+        _freeNodes.push_back(nodeIndex);
+        nodeIndex = parent;
+    }
+}
+
+void ItemSpatialTree::update(ItemID id, const ItemKey& key, const AABox& bound) {
+    if (id >= _locations.size()) {
+        _locations.resize(id + 1);
+    }
+
+    if (contains(id)) {
+        const Location& location = _locations[id];
+
+        // most moves stay within the same cell
+        if (location.node != OUTSIDE_NODE && belongsTo(location.node, bound)) {
+            Entries& entries = getEntries(location.node);
+            ItemKey oldKey = entries.getKey(location.index);
+            if (oldKey._flags != key._flags) {
+                addToSubtreeCounts(location.node, oldKey, -1);
+                addToSubtreeCounts(location.node, key, 1);
+            }
+            entries.set(location.index, key, bound);
+            return;
+        }
+
+        // remove before looking for the new node, the removal may prune it
+        remove(id);
+    }
+
+    int nodeIndex = findNode(bound);
+    Entries& entries = getEntries(nodeIndex);
+    _locations[id].node = nodeIndex;
+    _locations[id].index = entries.size();
+    entries.push_back(id, key, bound);
+
+    if (nodeIndex != OUTSIDE_NODE) {
+        addToSubtreeCounts(nodeIndex, key, 1);
+    }
+    _numItems++;
+}
+
+void ItemSpatialTree::remove(ItemID id) {
+    if (!contains(id)) {
+        return;
+    }
+
+    Location location = _locations[id];
+    Entries& entries = getEntries(location.node);
+    ItemKey key = entries.getKey(location.index);
+
+    // the last entry fills the hole
+    ItemID moved = entries.removeAt(location.index);
+    if (moved != id) {
+        _locations[moved].index = location.index;
+    }
+    _locations[id].node = INVALID_NODE;
+    _numItems--;
+
+    if (location.node != OUTSIDE_NODE) {
+        addToSubtreeCounts(location.node, key, -1);
+        pruneNode(location.node);
+    }
+}
+
+void ItemSpatialTree::select(const ViewFrustum& frustum, const LODTest& lodTest, const ItemFilter& filter,
+                             ItemIDsBounds& outItems, SelectionStats& stats) const {
+    Query query(frustum, lodTest, filter);
+
+    selectEntries(query, _outside, false, outItems, stats);
+    selectNode(query, 0, false, outItems, stats);
+}
+
+void ItemSpatialTree::selectNode(Query& query, int nodeIndex, bool insideView,
+                                 ItemIDsBounds& outItems, SelectionStats& stats) const {
+    const Node& node = _nodes[nodeIndex];
+    if (node.numItemsInSubtree == 0) {
+        return;
+    }
+    stats.nodesVisited++;
+
+    // once a node is fully in view, so are all of its descendants
+    if (!insideView) {
+        stats.boundsTested++;
+        ViewFrustum::location location = query.frustum.boxInFrustum(node.getLooseBound());
+        if (location == ViewFrustum::OUTSIDE) {
+            int count = countSubtreeItems(nodeIndex, query.filter);
+            stats.considered += count;
+            stats.outOfView += count;
+            return;
+        }
+        insideView = (location == ViewFrustum::INSIDE);
+    }
+
+    // no item of this subtree is bigger than the cell, or has its center outside of it. if even the biggest one at
+    // the closest possible position is too small, they all are
+    if (query.lodTest) {
+        glm::vec3 closestCenter = glm::clamp(query.eye, node.corner, node.corner + glm::vec3(node.size));
+        AABox biggestItem(closestCenter - glm::vec3(0.5f * node.size), node.size);
+        if (!query.lodTest(biggestItem)) {
+            int count = countSubtreeItems(nodeIndex, query.filter);
+            stats.considered += count;
+            stats.tooSmall += count;
+            return;
+        }
+    }
+
+    selectEntries(query, node.entries, insideView, outItems, stats);
+
+    for (int i = 0; i < 8; i++) {
+        if (node.children[i] != INVALID_NODE) {
+            selectNode(query, node.children[i], insideView, outItems, stats);
+        }
+    }
+}
+
+void ItemSpatialTree::selectEntries(Query& query, const Entries& entries, bool insideView,
+                                    ItemIDsBounds& outItems, SelectionStats& stats) const {
+    if (entries.empty()) {
+        return;
+    }
+    if (!insideView) {
+        stats.boundsTested += entries.size();
+        cullBounds(query.planes, entries, query.inView);
+    }
+
+    for (int i = 0; i < entries.size(); i++) {
+        if (!query.filter.test(entries.getKey(i))) {
+            continue;
+        }
+        stats.considered++;
+
+        if (!insideView && !query.inView[i]) {
+            stats.outOfView++;
+            continue;
+        }
+        const AABox& bound = entries.getBound(i);
+        if (query.lodTest && !query.lodTest(bound)) {
+            stats.tooSmall++;
+            continue;
+        }
+        outItems.emplace_back(ItemIDAndBounds(entries.getID(i), bound));
+    }
+}
@@ -0,0 +1,127 @@
+//
+//  SpatialTree.h
+//  render/src/render
+//
+//  Copyright 2015 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_render_SpatialTree_h
+#define hifi_render_SpatialTree_h
+
+#include <functional>
+#include <vector>
+
+#include <OctreeConstants.h>
+#include <ViewFrustum.h>
+
+#include "FrustumCulling.h"
+#include "Scene.h"
+
+namespace render {
+
+// Loose octree of the world space items of a Scene.
+//
+// Every cell of the tree owns the items whose bound center falls in it and whose largest dimension is at most the
+// cell size, so an item is always contained by the loose bound of its cell (the cell grown by half its size on every
+// side). That makes insertion a direct descent to the right depth, and lets a query reject or accept a whole subtree
+// with a single test of its loose bound.
+//
+// The tree keeps a copy of the key and bound of its items, laid out as a structure of arrays per cell, so a query never
+// touches the payloads and culls the items of a cell with the SIMD kernel of cullBounds.
+class ItemSpatialTree {
+public:
+    // LOD test, true if the bound is big enough to render. Must be monotonic: a bigger or closer bound passes too
+    typedef std::function<bool(const AABox& bound)> LODTest;
+
+    class SelectionStats {
+    public:
+        // only the items passing the filter count, whether they are tested one by one or with their subtree
+        int considered = 0;
+        int outOfView = 0;
+        int tooSmall = 0;
+
+        // work done, for profiling
+        int nodesVisited = 0;
+        int boundsTested = 0;
+    };
+
+    const static int DEFAULT_MAX_DEPTH = 16;  // cells of 0.5m for the default size
+
+    ItemSpatialTree(const glm::vec3& corner = glm::vec3((float)-HALF_TREE_SCALE), float size = (float)TREE_SCALE,
+                    int maxDepth = DEFAULT_MAX_DEPTH);
+
+    /// inserts the item, or moves it if it is already in the tree
+    void update(ItemID id, const ItemKey& key, const AABox& bound);
+    void remove(ItemID id);
+
+    bool contains(ItemID id) const { return id < _locations.size() && _locations[id].node != INVALID_NODE; }
+    int getNumItems() const { return _numItems; }
+    int getNumNodes() const { return (int)(_nodes.size() - _freeNodes.size()); }
+
+    /// appends the items passing the filter that are in view and big enough to render
+    void select(const ViewFrustum& frustum, const LODTest& lodTest, const ItemFilter& filter,
+                ItemIDsBounds& outItems, SelectionStats& stats) const;
+
+private:
+    const static int INVALID_NODE = -1;
+    const static int OUTSIDE_NODE = -2;   // the pseudo node holding the items that don't fit in the root
+
+    typedef ItemBoundsArray Entries;
+
+    // the number of items of a key in a subtree. A scene has few distinct keys, so a node keeps a short list of them
+    class KeyCount {
+    public:
+        ItemKey key;
+        int count;
+    };
+    typedef std::vector<KeyCount> KeyCounts;
+
+    class Node {
+    public:
+        glm::vec3 corner;
+        float size;
+        int depth;
+        int parent;
+        int children[8];
+        int numItemsInSubtree;
+        KeyCounts keyCountsInSubtree;
+        Entries entries;
+
+        AABox getLooseBound() const { return AABox(corner - glm::vec3(0.5f * size), 2.0f * size); }
+    };
+
+    class Location {
+    public:
+        int node = INVALID_NODE;
+        int index = 0;
+    };
+
+    int findNode(const AABox& bound);
+    int allocateNode(int parent, const glm::vec3& corner, float size, int depth);
+    bool belongsTo(int nodeIndex, const AABox& bound) const;
+    void pruneNode(int nodeIndex);
+    void addToSubtreeCounts(int nodeIndex, const ItemKey& key, int count);
+    int countSubtreeItems(int nodeIndex, const ItemFilter& filter) const;
+    Entries& getEntries(int nodeIndex) { return (nodeIndex == OUTSIDE_NODE) ? _outside : _nodes[nodeIndex].entries; }
+
+    class Query;
+    void selectNode(Query& query, int nodeIndex, bool insideView, ItemIDsBounds& outItems, SelectionStats& stats) const;
+    void selectEntries(Query& query, const Entries& entries, bool insideView, ItemIDsBounds& outItems,
+                       SelectionStats& stats) const;
+
+    int _maxDepth;
+
+    std::vector<Node> _nodes;   // _nodes[0] is the root
+    std::vector<int> _freeNodes;
+    Entries _outside;
+
+    std::vector<Location> _locations;   // indexed by ItemID
+    int _numItems = 0;
+};
+
+}
+
+#endif // hifi_render_SpatialTree_h
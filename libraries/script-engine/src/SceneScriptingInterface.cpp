@@ -161,4 +161,5 @@ void SceneScriptingInterface::clearEngineCounters() {
     _numDrawnTransparentItems = 0;
     _numFeedOverlay3DItems = 0;
     _numDrawnOverlay3DItems = 0;
+    _numRemovedBatchCommands = 0;
 }
@@ -113,6 +113,11 @@ public:
     Q_INVOKABLE void setEngineDisplayHitEffect(bool display) { _drawHitEffect = display; }
     Q_INVOKABLE bool doEngineDisplayHitEffect() { return _drawHitEffect; }
 
+    Q_INVOKABLE void setEngineOptimizeBatches(bool optimize) { _optimizeBatches = optimize; }
+    Q_INVOKABLE bool doEngineOptimizeBatches() { return _optimizeBatches; }
+    void setEngineRemovedBatchCommands(int count) { _numRemovedBatchCommands = count; }
+    Q_INVOKABLE int getEngineNumRemovedBatchCommands() { return _numRemovedBatchCommands; }
+
 signals:
     void shouldRenderAvatarsChanged(bool shouldRenderAvatars);
     void shouldRenderEntitiesChanged(bool shouldRenderEntities);
@@ -138,6 +143,7 @@ protected:
     int _numDrawnTransparentItems = 0;
     int _numFeedOverlay3DItems = 0;
     int _numDrawnOverlay3DItems = 0;
+    int _numRemovedBatchCommands = 0;
 
     int _maxDrawnOpaqueItems = -1;
     int _maxDrawnTransparentItems = -1;
@@ -147,6 +153,7 @@ protected:
     
     bool _drawHitEffect = false;
 
+    bool _optimizeBatches = false;
 };
 
 #endif // hifi_SceneScriptingInterface_h
@@ -24,6 +24,8 @@
 #include <string>
 #include <map>
 
+#include <QtCore/QMutex>
+
 class PerformanceWarning {
 private:
     quint64 _start;
@@ -89,6 +91,7 @@ private:
     quint64 _start = 0;
     QString _name;
     static std::atomic<bool> _isActive;
+    static QMutex _mutex;   // timers also run on the render job threads
     static QHash<QThread*, QString> _fullNames;
     static QMap<QString, PerformanceTimerRecord> _records;
 };
@@ -51,19 +51,18 @@ public:
     
     Item* _item = &_other;
     
-    void pointTo(Type type) {
+    Item& getItem(Type type) {
         switch (type) {
             case OPAQUE_ITEM:
-                _item = &_opaque;
-                break;
+                return _opaque;
             case TRANSLUCENT_ITEM:
-                _item = &_translucent;
-                break;
-            case OTHER_ITEM:
-                _item = &_other;
-                break;
+                return _translucent;
+            default:
+                return _other;
         }
     }
+
+    void pointTo(Type type) { _item = &getItem(type); }
 };
 
 class RenderArgs {
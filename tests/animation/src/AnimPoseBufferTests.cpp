@@ -0,0 +1,262 @@
+//
+//  AnimPoseBufferTests.cpp
+//  tests/animation/src
+//
+//  Copyright 2015 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "AnimPoseBufferTests.h"
+
+#include <memory>
+
+#include <AnimBlendLinear.h>
+#include <AnimClip.h>
+#include <AnimOverlay.h>
+#include <AnimPoseBuffer.h>
+#include <AnimUtil.h>
+#include <AnimationCache.h>
+#include <FBXReader.h>
+#include <OBJReader.h>
+#include <SharedUtil.h>
+
+#include <../QTestExtensions.h>
+
+QTEST_MAIN(AnimPoseBufferTests)
+
+const float EPSILON = 0.0001f;
+
+static AnimPose makeRandomPose() {
+    glm::quat rot = glm::normalize(glm::quat(randFloatInRange(-1.0f, 1.0f), randFloatInRange(-1.0f, 1.0f),
+                                             randFloatInRange(-1.0f, 1.0f), randFloatInRange(-1.0f, 1.0f)));
+    return AnimPose(glm::vec3(randFloatInRange(0.5f, 2.0f)), rot,
+                    glm::vec3(randFloatInRange(-1.0f, 1.0f), randFloatInRange(-1.0f, 1.0f), randFloatInRange(-1.0f, 1.0f)));
+}
+
+static AnimPoseVec makeRandomPoses(size_t numPoses) {
+    AnimPoseVec poses;
+    for (size_t i = 0; i < numPoses; i++) {
+        poses.push_back(makeRandomPose());
+    }
+    return poses;
+}
+
+static void comparePoses(const AnimPoseBuffer& buffer, const AnimPoseVec& expected) {
+    QCOMPARE(buffer.size(), expected.size());
+    for (size_t i = 0; i < expected.size(); i++) {
+        AnimPose pose = buffer.getPose(i);
+        QCOMPARE_WITH_ABS_ERROR(pose.trans, expected[i].trans, EPSILON);
+        QCOMPARE_WITH_ABS_ERROR(pose.rot, expected[i].rot, EPSILON);
+        QCOMPARE_WITH_ABS_ERROR(pose.scale, expected[i].scale, EPSILON);
+    }
+}
+
+void AnimPoseBufferTests::initTestCase() {
+    DependencyManager::set<AnimationCache>();
+    DependencyManager::set<ResourceCacheSharedItems>();
+}
+
+void AnimPoseBufferTests::cleanupTestCase() {
+    DependencyManager::destroy<AnimationCache>();
+}
+
+void AnimPoseBufferTests::testBuffer() {
+    AnimPoseBuffer buffer(5);
+    QCOMPARE(buffer.size(), (size_t)5);
+    QCOMPARE(buffer.getStride(), (size_t)8);
+    for (size_t i = 0; i < buffer.getStride(); i++) {
+        QCOMPARE(buffer.getStream(AnimPoseBuffer::RotW)[i], 1.0f);
+        QCOMPARE(buffer.getStream(AnimPoseBuffer::ScaleY)[i], 1.0f);
+        QCOMPARE(buffer.getStream(AnimPoseBuffer::TransZ)[i], 0.0f);
+    }
+
+    AnimPoseVec poses = makeRandomPoses(5);
+    for (size_t i = 0; i < poses.size(); i++) {
+        buffer.setPose(i, poses[i]);
+    }
+    comparePoses(buffer, poses);
+
+    // growing moves the streams apart but keeps the poses
+    buffer.resize(11);
+    QCOMPARE(buffer.getStride(), (size_t)12);
+    AnimPoseVec grown = poses;
+    grown.resize(11, AnimPose::identity);
+    comparePoses(buffer, grown);
+
+    // shrinking keeps the memory, and the dropped joints become identity padding
+    const float* data = buffer.getStream(AnimPoseBuffer::TransX);
+    buffer.resize(3);
+    QCOMPARE(buffer.getStride(), (size_t)12);
+    QVERIFY(buffer.getStream(AnimPoseBuffer::TransX) == data);
+    QCOMPARE(buffer.getStream(AnimPoseBuffer::RotW)[4], 1.0f);
+    QCOMPARE(buffer.getStream(AnimPoseBuffer::TransX)[4], 0.0f);
+
+    AnimPoseVec converted;
+    AnimPoseBuffer(poses).toPoses(converted);
+    QCOMPARE(converted.size(), poses.size());
+    comparePoses(AnimPoseBuffer(converted), poses);
+}
+
+void AnimPoseBufferTests::testBlendMatchesScalar() {
+    const size_t NUM_POSES = 37;
+    AnimPoseVec a = makeRandomPoses(NUM_POSES);
+    AnimPoseVec b = makeRandomPoses(NUM_POSES);
+
+    // rotations on the far hemisphere take the short way
+    b[0].rot = -a[0].rot;
+    b[1].rot = -glm::normalize(a[1].rot + glm::quat(0.1f, 0.0f, 0.1f, 0.0f));
+
+    // the result had a larger stride before
+    AnimPoseBuffer result(100);
+    for (float alpha : { 0.0f, 0.3f, 0.5f, 1.0f }) {
+        AnimPoseVec expected(NUM_POSES);
+        ::blend(NUM_POSES, &a[0], &b[0], alpha, &expected[0]);
+        ::blend(AnimPoseBuffer(a), AnimPoseBuffer(b), alpha, result);
+        comparePoses(result, expected);
+    }
+    QCOMPARE_WITH_ABS_ERROR(result.getRotation(0), a[0].rot, EPSILON);
+
+    // in place
+    AnimPoseVec expected(NUM_POSES);
+    ::blend(NUM_POSES, &a[0], &b[0], 0.7f, &expected[0]);
+    AnimPoseBuffer inPlace(a);
+    ::blend(inPlace, AnimPoseBuffer(b), 0.7f, inPlace);
+    comparePoses(inPlace, expected);
+}
+
+void AnimPoseBufferTests::testBlendPerJoint() {
+    const size_t NUM_POSES = 23;
+    const float ALPHA_SCALE = 0.8f;
+    AnimPoseVec a = makeRandomPoses(NUM_POSES);
+    AnimPoseVec b = makeRandomPoses(NUM_POSES);
+    std::vector<float> alphas;
+    for (size_t i = 0; i < NUM_POSES; i++) {
+        alphas.push_back(i % 3 == 0 ? 0.0f : randFloat());
+    }
+
+    AnimPoseVec expected(NUM_POSES);
+    for (size_t i = 0; i < NUM_POSES; i++) {
+        ::blend(1, &a[i], &b[i], alphas[i] * ALPHA_SCALE, &expected[i]);
+    }
+    AnimPoseBuffer result;
+    ::blend(AnimPoseBuffer(a), AnimPoseBuffer(b), &alphas[0], ALPHA_SCALE, result);
+    comparePoses(result, expected);
+}
+
+void AnimPoseBufferTests::testPool() {
+    AnimPosePool pool;
+    AnimPoseBuffer* first;
+    {
+        AnimPosePool::Handle handle = pool.acquire(10);
+        QCOMPARE(handle->size(), (size_t)10);
+        QCOMPARE(pool.getNumFree(), (size_t)0);
+        first = handle.get();
+    }
+    QCOMPARE(pool.getNumFree(), (size_t)1);
+
+    // the buffers come back, resized
+    AnimPosePool::Handle handle = pool.acquire(20);
+    QVERIFY(handle.get() == first);
+    QCOMPARE(handle->size(), (size_t)20);
+    AnimPosePool::Handle other = pool.acquire(20);
+    QVERIFY(other.get() != first);
+    handle.reset();
+    other.reset();
+    QCOMPARE(pool.getNumFree(), (size_t)2);
+    pool.clear();
+    QCOMPARE(pool.getNumFree(), (size_t)0);
+}
+
+// waits for the animation to download, which the clips copy their frames from
+static bool waitForLoad(const AnimationPointer& animation) {
+    const int TIMEOUT_MSECS = 30000;
+    QElapsedTimer timer;
+    timer.start();
+    while (!animation->isLoaded() && timer.elapsed() < TIMEOUT_MSECS) {
+        QTest::qWait(10);
+    }
+    return animation->isLoaded();
+}
+
+void AnimPoseBufferTests::benchmarkRigs() {
+    const int NUM_RIGS = 100;
+    const int NUM_FRAMES = 100;
+    const float DT = 1.0f / 60.0f;
+
+    QUrl skeletonURL("https://s3.amazonaws.com/hifi-public/models/skeletons/Zack/Zack.fbx");
+    QNetworkReply* reply = OBJReader().request(skeletonURL, false); // synchronous
+    if (!reply->isFinished() || reply->attribute(QNetworkRequest::HttpStatusCodeAttribute).toInt() != 200) {
+        QSKIP("No avatar skeleton");
+    }
+    std::unique_ptr<FBXGeometry> geometry(readFBX(reply->readAll(), QVariantHash()));
+    std::vector<FBXJoint> joints;
+    for (auto& joint : geometry->joints) {
+        joints.push_back(joint);
+    }
+    auto skeleton = std::make_shared<AnimSkeleton>(joints, AnimPose(geometry->offset));
+
+    QString animationURL = "https://hifi-public.s3.amazonaws.com/ozan/support/FightClubBotTest1/Animations/standard_idle.fbx";
+    AnimationPointer animation = DependencyManager::get<AnimationCache>()->getAnimation(animationURL);
+    if (!waitForLoad(animation)) {
+        QSKIP("No animation");
+    }
+    float endFrame = (float)(animation->getFramesReference().size() - 1);
+
+    // each rig overlays a clip on the upper body of a blend of two clips, all playing at different rates
+    std::vector<AnimNode::Pointer> rigs;
+    std::string url = animationURL.toStdString();
+    for (int i = 0; i < NUM_RIGS; i++) {
+        auto blend = std::make_shared<AnimBlendLinear>("blend", 0.4f);
+        blend->addChild(std::make_shared<AnimClip>("idle", url, 0.0f, endFrame, 1.0f, true));
+        blend->addChild(std::make_shared<AnimClip>("fastIdle", url, 0.0f, endFrame, 1.3f, true));
+        auto overlay = std::make_shared<AnimOverlay>("overlay", AnimOverlay::UpperBodyBoneSet, 0.6f);
+        overlay->addChild(std::make_shared<AnimClip>("slowIdle", url, 0.0f, endFrame, 0.7f, true));
+        overlay->addChild(blend);
+        overlay->setSkeleton(skeleton);
+        rigs.push_back(overlay);
+    }
+
+    // the first frame maps the joints of the shared animation
+    AnimVariantMap vars;
+    AnimNode::Triggers triggers;
+    for (auto& rig : rigs) {
+        QCOMPARE(rig->evaluate(vars, DT, triggers).size(), (size_t)skeleton->getNumJoints());
+    }
+
+    quint64 start = usecTimestampNow();
+    for (int frame = 0; frame < NUM_FRAMES; frame++) {
+        for (auto& rig : rigs) {
+            triggers.clear();
+            rig->evaluate(vars, DT, triggers);
+        }
+    }
+    quint64 graphUsecs = usecTimestampNow() - start;
+
+    // the five blends of a rig, with the scalar kernel over arrays of poses and the SIMD one over pose buffers
+    const int BLENDS_PER_RIG = 5;
+    AnimPoseVec a = makeRandomPoses(skeleton->getNumJoints());
+    AnimPoseVec b = makeRandomPoses(skeleton->getNumJoints());
+    AnimPoseVec result(a.size());
+    start = usecTimestampNow();
+    for (int i = 0; i < NUM_FRAMES * NUM_RIGS * BLENDS_PER_RIG; i++) {
+        ::blend(a.size(), &a[0], &b[0], 0.5f, &result[0]);
+    }
+    quint64 scalarUsecs = usecTimestampNow() - start;
+
+    AnimPoseBuffer aBuffer(a);
+    AnimPoseBuffer bBuffer(b);
+    AnimPoseBuffer resultBuffer;
+    start = usecTimestampNow();
+    for (int i = 0; i < NUM_FRAMES * NUM_RIGS * BLENDS_PER_RIG; i++) {
+        ::blend(aBuffer, bBuffer, 0.5f, resultBuffer);
+    }
+    quint64 bufferUsecs = usecTimestampNow() - start;
+    comparePoses(resultBuffer, result);
+
+    qDebug() << "Anim graph:" << graphUsecs / (float)NUM_FRAMES << "usecs per frame of" << NUM_RIGS << "rigs of"
+             << skeleton->getNumJoints() << "joints";
+    qDebug() << "Scalar blends:" << scalarUsecs / (float)NUM_FRAMES << "usecs per frame";
+    qDebug() << "Pose buffer blends:" << bufferUsecs / (float)NUM_FRAMES << "usecs per frame";
+}
@@ -0,0 +1,218 @@
+//
+//  AnimationLODTests.cpp
+//  tests/animation/src
+//
+//  Copyright 2015 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "AnimationLODTests.h"
+
+#include <AnimationLOD.h>
+#include <AvatarRig.h>
+#include <GLMHelpers.h>
+#include <NumericalConstants.h>
+#include <SharedUtil.h>
+
+#include <../QTestExtensions.h>
+
+QTEST_MAIN(AnimationLODTests)
+
+const float EPSILON = 0.0001f;
+const float PRIORITY = 1.0f;
+
+// a chain of joints, each a tenth of a meter above its parent and free to turn
+static RigPointer makeChainRig(int numJoints) {
+    QVector<JointState> states;
+    for (int i = 0; i < numJoints; i++) {
+        FBXJoint joint;
+        joint.isFree = true;
+        joint.parentIndex = i - 1;
+        joint.distanceToParent = (i == 0) ? 0.0f : 0.1f;
+        joint.boneRadius = 0.01f;
+        joint.translation = glm::vec3(0.0f, joint.distanceToParent, 0.0f);
+        joint.rotationMin = glm::vec3(-PI);
+        joint.rotationMax = glm::vec3(PI);
+        joint.name = QString("joint%1").arg(i);
+        joint.isSkeletonJoint = true;
+        joint.bindTransformFoundInCluster = false;
+        states.append(JointState(joint));
+    }
+    RigPointer rig = std::make_shared<AvatarRig>();
+    rig->initJointStates(states, glm::mat4(), 0, -1, -1, -1, -1, -1, -1);
+    return rig;
+}
+
+// the end of the chain and the joints above it that IK may turn
+static QVector<int> getEndLineage(int numJoints, int length) {
+    QVector<int> lineage;
+    for (int i = numJoints - 1; i >= 0 && lineage.size() < length; i--) {
+        lineage.append(i);
+    }
+    return lineage;
+}
+
+static void setJoints(RigPointer rig, const glm::quat& rotation) {
+    for (int i = 0; i < rig->getJointStateCount(); i++) {
+        rig->setJointState(i, true, rotation, PRIORITY);
+    }
+}
+
+static void compareJoints(RigPointer rig, const glm::quat& rotation) {
+    for (int i = 0; i < rig->getJointStateCount(); i++) {
+        QCOMPARE_WITH_ABS_ERROR(rig->getJointState(i).getRotationInConstrainedFrame(), rotation, EPSILON);
+    }
+}
+
+void AnimationLODTests::testTiers() {
+    const float FIELD_OF_VIEW = 45.0f;
+    const float RADIUS = 1.0f;
+    float nearSize = AnimationLOD::computeProjectedSize(RADIUS, 2.0f, FIELD_OF_VIEW);
+    float middleSize = AnimationLOD::computeProjectedSize(RADIUS, 50.0f, FIELD_OF_VIEW);
+    float farSize = AnimationLOD::computeProjectedSize(RADIUS, 200.0f, FIELD_OF_VIEW);
+    QVERIFY(nearSize > middleSize && middleSize > farSize);
+
+    // a wider view makes everything smaller
+    QVERIFY(AnimationLOD::computeProjectedSize(RADIUS, 50.0f, 90.0f) < middleSize);
+
+    for (auto previousTier : { AnimationLOD::FULL_TIER, AnimationLOD::REDUCED_TIER, AnimationLOD::FAR_TIER }) {
+        QCOMPARE(AnimationLOD::computeTier(nearSize, previousTier), AnimationLOD::FULL_TIER);
+        QCOMPARE(AnimationLOD::computeTier(middleSize, previousTier), AnimationLOD::REDUCED_TIER);
+        QCOMPARE(AnimationLOD::computeTier(farSize, previousTier), AnimationLOD::FAR_TIER);
+    }
+
+    // just past a threshold, the rigs keep their tier until clearly past it
+    float justBelow = AnimationLOD::REDUCED_TIER_SIZE * (1.0f - 0.5f * AnimationLOD::HYSTERESIS_PROPORTION);
+    float justAbove = AnimationLOD::REDUCED_TIER_SIZE * (1.0f + 0.5f * AnimationLOD::HYSTERESIS_PROPORTION);
+    QCOMPARE(AnimationLOD::computeTier(justBelow, AnimationLOD::FULL_TIER), AnimationLOD::FULL_TIER);
+    QCOMPARE(AnimationLOD::computeTier(justAbove, AnimationLOD::REDUCED_TIER), AnimationLOD::REDUCED_TIER);
+    justBelow = AnimationLOD::FAR_TIER_SIZE * (1.0f - 0.5f * AnimationLOD::HYSTERESIS_PROPORTION);
+    justAbove = AnimationLOD::FAR_TIER_SIZE * (1.0f + 0.5f * AnimationLOD::HYSTERESIS_PROPORTION);
+    QCOMPARE(AnimationLOD::computeTier(justBelow, AnimationLOD::REDUCED_TIER), AnimationLOD::REDUCED_TIER);
+    QCOMPARE(AnimationLOD::computeTier(justAbove, AnimationLOD::FAR_TIER), AnimationLOD::FAR_TIER);
+}
+
+void AnimationLODTests::testUpdateRate() {
+    const float DT = 1.0f / 60.0f;
+    RigPointer rig = makeChainRig(2);
+    float animationDeltaTime = 0.0f;
+    for (int i = 0; i < 10; i++) {
+        QVERIFY(rig->advanceAnimationLOD(DT, animationDeltaTime));
+        QCOMPARE(animationDeltaTime, DT);
+    }
+
+    // the reduced tier updates about every fourth frame, with the time since the last update
+    rig->setAnimationLODTier(AnimationLOD::REDUCED_TIER);
+    int numUpdates = 0;
+    const int NUM_FRAMES = 60;
+    for (int i = 0; i < NUM_FRAMES; i++) {
+        if (rig->advanceAnimationLOD(DT, animationDeltaTime)) {
+            numUpdates++;
+            QVERIFY(animationDeltaTime >= AnimationLOD::getUpdatePeriod(AnimationLOD::REDUCED_TIER));
+        }
+    }
+    QVERIFY(numUpdates >= 12 && numUpdates <= 15);
+
+    rig->setAnimationLODTier(AnimationLOD::FAR_TIER);
+    numUpdates = 0;
+    for (int i = 0; i < NUM_FRAMES; i++) {
+        if (rig->advanceAnimationLOD(DT, animationDeltaTime)) {
+            numUpdates++;
+        }
+    }
+    QVERIFY(numUpdates >= 3 && numUpdates <= 4);
+}
+
+void AnimationLODTests::testInterpolation() {
+    const float PERIOD = AnimationLOD::getUpdatePeriod(AnimationLOD::REDUCED_TIER);
+    const glm::quat FIRST = glm::angleAxis(0.5f, Vectors::UNIT_Z);
+    const glm::quat SECOND = glm::angleAxis(-0.5f, Vectors::UNIT_X);
+    RigPointer rig = makeChainRig(4);
+    rig->setAnimationLODTier(AnimationLOD::REDUCED_TIER);
+
+    // the first update has nothing to move from
+    float animationDeltaTime;
+    QVERIFY(rig->advanceAnimationLOD(PERIOD, animationDeltaTime));
+    setJoints(rig, FIRST);
+    rig->updateAnimations(animationDeltaTime, glm::mat4());
+    compareJoints(rig, FIRST);
+
+    // the next starts from the last, then moves toward its own pose until the update after
+    QVERIFY(rig->advanceAnimationLOD(PERIOD, animationDeltaTime));
+    setJoints(rig, SECOND);
+    rig->updateAnimations(animationDeltaTime, glm::mat4());
+    compareJoints(rig, FIRST);
+
+    QVERIFY(!rig->advanceAnimationLOD(0.5f * PERIOD, animationDeltaTime));
+    QVERIFY(rig->interpolateAnimations(glm::mat4()));
+    compareJoints(rig, safeMix(FIRST, SECOND, 0.5f));
+
+    // the transforms follow
+    glm::vec3 position;
+    QVERIFY(rig->getJointPosition(3, position));
+    QVERIFY(glm::length(position) > 0.0f);
+
+    // the far tier holds the pose
+    rig->setAnimationLODTier(AnimationLOD::FAR_TIER);
+    QVERIFY(!rig->advanceAnimationLOD(0.25f * PERIOD, animationDeltaTime));
+    QVERIFY(!rig->interpolateAnimations(glm::mat4()));
+    compareJoints(rig, safeMix(FIRST, SECOND, 0.5f));
+}
+
+void AnimationLODTests::testFarTierSkipsIK() {
+    const int NUM_JOINTS = 6;
+    const glm::vec3 TARGET(0.2f, 0.3f, 0.0f);
+    QVector<int> lineage = getEndLineage(NUM_JOINTS, 4);
+
+    RigPointer rig = makeChainRig(NUM_JOINTS);
+    rig->setAnimationLODTier(AnimationLOD::FAR_TIER);
+    rig->inverseKinematics(NUM_JOINTS - 1, TARGET, glm::quat(), PRIORITY, lineage, glm::mat4());
+    compareJoints(rig, glm::quat());
+    QVERIFY(!rig->setJointPosition(NUM_JOINTS - 1, TARGET, glm::quat(), false, -1, false, glm::vec3(), PRIORITY,
+                                   lineage, glm::mat4()));
+
+    rig->setAnimationLODTier(AnimationLOD::FULL_TIER);
+    rig->inverseKinematics(NUM_JOINTS - 1, TARGET, glm::quat(), PRIORITY, lineage, glm::mat4());
+    bool moved = false;
+    for (int i = 0; i < NUM_JOINTS; i++) {
+        moved = moved || glm::abs(glm::dot(rig->getJointState(i).getRotationInConstrainedFrame(), glm::quat())) < 1.0f - EPSILON;
+    }
+    QVERIFY(moved);
+}
+
+void AnimationLODTests::benchmarkTiers() {
+    const int NUM_RIGS = 100;
+    const int NUM_JOINTS = 64;
+    const int NUM_FRAMES = 120;
+    const float DT = 1.0f / 60.0f;
+    QVector<int> lineage = getEndLineage(NUM_JOINTS, 4);
+
+    // the rigs of other avatars: new joint rotations with each update, and IK on the end of the chain
+    for (auto tier : { AnimationLOD::FULL_TIER, AnimationLOD::REDUCED_TIER, AnimationLOD::FAR_TIER }) {
+        std::vector<RigPointer> rigs;
+        for (int i = 0; i < NUM_RIGS; i++) {
+            rigs.push_back(makeChainRig(NUM_JOINTS));
+            rigs.back()->setAnimationLODTier(tier);
+        }
+        quint64 start = usecTimestampNow();
+        for (int frame = 0; frame < NUM_FRAMES; frame++) {
+            glm::quat rotation = glm::angleAxis(0.1f * sinf(frame * DT * TWO_PI), Vectors::UNIT_Z);
+            for (auto& rig : rigs) {
+                float animationDeltaTime;
+                if (rig->advanceAnimationLOD(DT, animationDeltaTime)) {
+                    setJoints(rig, rotation);
+                    rig->updateAnimations(animationDeltaTime, glm::mat4());
+                    rig->inverseKinematics(NUM_JOINTS - 1, glm::vec3(0.1f, 5.0f, 0.0f), glm::quat(), PRIORITY, lineage,
+                                           glm::mat4());
+                } else {
+                    rig->interpolateAnimations(glm::mat4());
+                }
+            }
+        }
+        quint64 usecs = usecTimestampNow() - start;
+        qDebug() << AnimationLOD::getTierName(tier) << "tier:" << usecs / (float)NUM_FRAMES << "usecs per frame of"
+                 << NUM_RIGS << "rigs of" << NUM_JOINTS << "joints";
+    }
+}
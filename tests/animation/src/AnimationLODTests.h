@@ -0,0 +1,26 @@
+//
+//  AnimationLODTests.h
+//  tests/animation/src
+//
+//  Copyright 2015 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_AnimationLODTests_h
+#define hifi_AnimationLODTests_h
+
+#include <QtTest/QtTest>
+
+class AnimationLODTests : public QObject {
+    Q_OBJECT
+private slots:
+    void testTiers();
+    void testUpdateRate();
+    void testInterpolation();
+    void testFarTierSkipsIK();
+    void benchmarkTiers();
+};
+
+#endif // hifi_AnimationLODTests_h
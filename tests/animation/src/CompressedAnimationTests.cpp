@@ -0,0 +1,151 @@
+//
+//  CompressedAnimationTests.cpp
+//  tests/animation/src
+//
+//  Copyright 2015 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "CompressedAnimationTests.h"
+
+#include <AnimClip.h>
+#include <AnimationCache.h>
+#include <CompressedAnimation.h>
+#include <GLMHelpers.h>
+#include <SharedUtil.h>
+
+#include <../QTestExtensions.h>
+
+QTEST_MAIN(CompressedAnimationTests)
+
+static glm::quat makeRandomRotation() {
+    return glm::normalize(glm::quat(randFloatInRange(-1.0f, 1.0f), randFloatInRange(-1.0f, 1.0f),
+                                    randFloatInRange(-1.0f, 1.0f), randFloatInRange(-1.0f, 1.0f)));
+}
+
+// the angle between the rotations
+static float angleBetween(const glm::quat& a, const glm::quat& b) {
+    return 2.0f * acosf(glm::min(fabsf(glm::dot(a, b)), 1.0f));
+}
+
+static QVector<FBXJoint> makeJoints(int numJoints) {
+    QVector<FBXJoint> joints(numJoints);
+    for (int i = 0; i < numJoints; i++) {
+        joints[i].name = QString("joint%1").arg(i);
+    }
+    return joints;
+}
+
+void CompressedAnimationTests::initTestCase() {
+    DependencyManager::set<AnimationCache>();
+    DependencyManager::set<ResourceCacheSharedItems>();
+}
+
+void CompressedAnimationTests::cleanupTestCase() {
+    DependencyManager::destroy<AnimationCache>();
+}
+
+void CompressedAnimationTests::testQuantize() {
+    const float MAX_ERROR = 0.0005f;
+    for (int i = 0; i < 1000; i++) {
+        glm::quat rotation = makeRandomRotation();
+        glm::quat decoded = CompressedAnimation::dequantize(CompressedAnimation::quantize(rotation));
+        QVERIFY(angleBetween(rotation, decoded) < MAX_ERROR);
+
+        // the rotation is the same either way round
+        decoded = CompressedAnimation::dequantize(CompressedAnimation::quantize(-rotation));
+        QVERIFY(angleBetween(rotation, decoded) < MAX_ERROR);
+    }
+    glm::quat identity = CompressedAnimation::dequantize(CompressedAnimation::quantize(glm::quat()));
+    QCOMPARE_WITH_ABS_ERROR(identity, glm::quat(), 0.0001f);
+    QCOMPARE(sizeof(CompressedAnimation::QuantizedRotation), (size_t)6);
+}
+
+void CompressedAnimationTests::testConstantTracks() {
+    const int NUM_FRAMES = 300;
+    const glm::quat HELD = glm::angleAxis(0.7f, Vectors::UNIT_Y);
+    QVector<FBXAnimationFrame> frames(NUM_FRAMES);
+    for (auto& frame : frames) {
+        frame.rotations.append(glm::quat());
+        frame.rotations.append(HELD);
+    }
+    CompressedAnimation animation(makeJoints(2), frames);
+    QCOMPARE(animation.getNumFrames(), NUM_FRAMES);
+    QCOMPARE(animation.getNumKeys(0), 1);
+    QCOMPARE(animation.getNumKeys(1), 1);
+    QCOMPARE_WITH_ABS_ERROR(animation.sample(1, 0), HELD, 0.0001f);
+    QCOMPARE_WITH_ABS_ERROR(animation.sample(1, NUM_FRAMES - 1), HELD, 0.0001f);
+    QVERIFY(animation.getByteSize() * 10 < animation.getUncompressedByteSize());
+}
+
+void CompressedAnimationTests::testKeyReduction() {
+    const int NUM_FRAMES = 240;
+    const float TOLERANCE = CompressedAnimation::DEFAULT_TOLERANCE;
+
+    // a joint that swings slowly back and forth, one that turns at a steady rate, and one that jitters
+    QVector<FBXAnimationFrame> frames(NUM_FRAMES);
+    for (int i = 0; i < NUM_FRAMES; i++) {
+        float time = i / 30.0f;
+        frames[i].rotations.append(glm::angleAxis(0.5f * sinf(0.25f * time * TWO_PI), Vectors::UNIT_X));
+        frames[i].rotations.append(glm::angleAxis(0.5f * time, Vectors::UNIT_Z));
+        frames[i].rotations.append(makeRandomRotation());
+    }
+    CompressedAnimation animation(makeJoints(3), frames);
+
+    for (int joint = 0; joint < animation.getNumJoints(); joint++) {
+        for (int i = 0; i < NUM_FRAMES; i++) {
+            // the keys are quantized, and the frames between them within the tolerance of them
+            float error = angleBetween(animation.sample(joint, i), frames[i].rotations[joint]);
+            QVERIFY2(error < TOLERANCE * 1.1f + 0.0005f, qPrintable(QString("joint %1 frame %2 error %3").arg(joint).arg(i).arg(error)));
+        }
+    }
+    QVERIFY(animation.getNumKeys(0) < NUM_FRAMES / 3);
+    QVERIFY(animation.getNumKeys(1) < NUM_FRAMES / 8);
+    QCOMPARE(animation.getNumKeys(2), NUM_FRAMES);
+
+    // past the ends, the tracks hold
+    QCOMPARE_WITH_ABS_ERROR(animation.sample(1, NUM_FRAMES + 10), animation.sample(1, NUM_FRAMES - 1), 0.0001f);
+    QCOMPARE_WITH_ABS_ERROR(animation.sample(1, -10), animation.sample(1, 0), 0.0001f);
+
+    qDebug() << "Compressed" << animation.getUncompressedByteSize() << "bytes to" << animation.getByteSize();
+}
+
+// waits for the animation to download and compress
+static bool waitForLoad(const AnimationPointer& animation) {
+    const int TIMEOUT_MSECS = 30000;
+    QElapsedTimer timer;
+    timer.start();
+    while (!animation->isLoaded() && timer.elapsed() < TIMEOUT_MSECS) {
+        QTest::qWait(10);
+    }
+    return animation->isLoaded();
+}
+
+void CompressedAnimationTests::testSharedClips() {
+    QString url = "https://hifi-public.s3.amazonaws.com/ozan/support/FightClubBotTest1/Animations/standard_idle.fbx";
+    auto animationCache = DependencyManager::get<AnimationCache>();
+    AnimationPointer animation = animationCache->getAnimation(url);
+    if (!waitForLoad(animation)) {
+        QSKIP("No animation");
+    }
+
+    // every clip of the url gets the same animation, and with it the same compressed rotations
+    QCOMPARE(animationCache->getAnimation(url), animation);
+    std::shared_ptr<const CompressedAnimation> compressed = animation->getCompressedAnimation();
+    QVERIFY((bool)compressed);
+    QCOMPARE(compressed->getNumFrames(), animation->getFramesReference().size());
+    QCOMPARE(compressed->getJointNames(), animation->getJointNames());
+    QVERIFY(compressed->getByteSize() < compressed->getUncompressedByteSize());
+
+    // the compressed frames stay within the tolerance, plus the quantization, of the originals
+    const QVector<FBXAnimationFrame>& frames = animation->getFramesReference();
+    for (int i = 0; i < frames.size(); i++) {
+        for (int joint = 0; joint < frames[i].rotations.size(); joint++) {
+            QVERIFY(angleBetween(compressed->sample(joint, i), frames[i].rotations[joint]) <
+                    CompressedAnimation::DEFAULT_TOLERANCE * 1.1f + 0.0005f);
+        }
+    }
+    qDebug() << "Compressed" << compressed->getUncompressedByteSize() << "bytes to" << compressed->getByteSize();
+}
@@ -0,0 +1,27 @@
+//
+//  CompressedAnimationTests.h
+//  tests/animation/src
+//
+//  Copyright 2015 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_CompressedAnimationTests_h
+#define hifi_CompressedAnimationTests_h
+
+#include <QtTest/QtTest>
+
+class CompressedAnimationTests : public QObject {
+    Q_OBJECT
+private slots:
+    void initTestCase();
+    void cleanupTestCase();
+    void testQuantize();
+    void testConstantTracks();
+    void testKeyReduction();
+    void testSharedClips();
+};
+
+#endif // hifi_CompressedAnimationTests_h
@@ -0,0 +1,237 @@
+//
+//  ParallelSimulationTests.cpp
+//  tests/animation/src
+//
+//  Copyright 2015 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "ParallelSimulationTests.h"
+
+#include <atomic>
+#include <memory>
+
+#include <AvatarRig.h>
+#include <Extents.h>
+#include <GLMHelpers.h>
+#include <NumericalConstants.h>
+#include <ParallelSimulation.h>
+#include <SharedUtil.h>
+
+#include <../QTestExtensions.h>
+
+QTEST_MAIN(ParallelSimulationTests)
+
+const float DT = 1.0f / 60.0f;
+const float PRIORITY = 1.0f;
+
+// An avatar driven by a script, headless: each frame the script poses its spine, as the joint data from the avatar mixer
+// would, and has its end reach for a target, as the IK of the scripts would. The avatars go through the phases of the
+// avatar manager: begin reads the script clock, simulate updates the rig and its bounds, and end commits the bounds to
+// the scene.
+class ScriptedAvatar {
+public:
+    ScriptedAvatar(int numJoints, float phase);
+
+    void begin(float time);
+    void simulate(float deltaTime);
+    void end(Extents& scene);
+
+    RigPointer getRig() const { return _rig; }
+    const Extents& getBounds() const { return _bounds; }
+
+private:
+    RigPointer _rig;
+    QVector<int> _reachLineage;
+    float _phase;
+    glm::quat _pose;
+    glm::vec3 _target;
+    Extents _bounds;
+};
+
+ScriptedAvatar::ScriptedAvatar(int numJoints, float phase) :
+    _phase(phase) {
+
+    // a chain of joints, each a tenth of a meter above its parent and free to turn
+    QVector<JointState> states;
+    for (int i = 0; i < numJoints; i++) {
+        FBXJoint joint;
+        joint.isFree = true;
+        joint.parentIndex = i - 1;
+        joint.distanceToParent = (i == 0) ? 0.0f : 0.1f;
+        joint.boneRadius = 0.01f;
+        joint.translation = glm::vec3(0.0f, joint.distanceToParent, 0.0f);
+        joint.rotationMin = glm::vec3(-PI);
+        joint.rotationMax = glm::vec3(PI);
+        joint.name = QString("joint%1").arg(i);
+        joint.isSkeletonJoint = true;
+        joint.bindTransformFoundInCluster = false;
+        states.append(JointState(joint));
+    }
+    _rig = std::make_shared<AvatarRig>();
+    _rig->initJointStates(states, glm::mat4(), 0, -1, -1, -1, -1, -1, -1);
+
+    const int REACH_LENGTH = 4;
+    for (int i = numJoints - 1; i >= 0 && _reachLineage.size() < REACH_LENGTH; i--) {
+        _reachLineage.append(i);
+    }
+}
+
+void ScriptedAvatar::begin(float time) {
+    float angle = time * TWO_PI + _phase;
+    _pose = glm::angleAxis(0.05f * sinf(angle), Vectors::UNIT_Z) * glm::angleAxis(0.03f * cosf(angle), Vectors::UNIT_X);
+    _target = glm::vec3(0.5f * cosf(angle), 0.1f * (_rig->getJointStateCount() - 2), 0.5f * sinf(angle));
+}
+
+void ScriptedAvatar::simulate(float deltaTime) {
+    for (int i = 0; i < _rig->getJointStateCount(); i++) {
+        _rig->setJointState(i, true, _pose, PRIORITY);
+    }
+    _rig->updateAnimations(deltaTime, glm::mat4());
+    _rig->inverseKinematics(_reachLineage.first(), _target, glm::quat(), PRIORITY, _reachLineage, glm::mat4());
+
+    _bounds.reset();
+    for (int i = 0; i < _rig->getJointStateCount(); i++) {
+        glm::vec3 position;
+        _rig->getJointPosition(i, position);
+        _bounds.addPoint(position);
+    }
+}
+
+void ScriptedAvatar::end(Extents& scene) {
+    scene.addExtents(_bounds);
+}
+
+typedef std::vector<std::unique_ptr<ScriptedAvatar>> ScriptedAvatars;
+
+static void makeAvatars(ScriptedAvatars& avatars, int numAvatars, int numJoints) {
+    for (int i = 0; i < numAvatars; i++) {
+        avatars.emplace_back(new ScriptedAvatar(numJoints, i * 0.37f));
+    }
+}
+
+static void runFrame(ParallelSimulation& simulation, ScriptedAvatars& avatars, float time, Extents& scene) {
+    scene.reset();
+    simulation.run(avatars.size(), [&](size_t i) {
+        avatars[i]->begin(time);
+    }, [&](size_t i) {
+        avatars[i]->simulate(DT);
+    }, [&](size_t i) {
+        avatars[i]->end(scene);
+    });
+}
+
+void ParallelSimulationTests::testPhaseOrder() {
+    const size_t NUM_AVATARS = 64;
+    std::atomic<int> numBegun(0);
+    std::atomic<int> numSimulated(0);
+    std::atomic<int> numEnded(0);
+    std::atomic<bool> inOrder(true);
+    std::vector<int> simulated(NUM_AVATARS, 0);
+
+    ParallelSimulation simulation;
+    simulation.run(NUM_AVATARS, [&](size_t i) {
+        numBegun++;
+    }, [&](size_t i) {
+        // all begin before any simulates, and none ends before all have simulated
+        if (numBegun != (int)NUM_AVATARS || numEnded != 0) {
+            inOrder = false;
+        }
+        simulated[i]++;
+        numSimulated++;
+    }, [&](size_t i) {
+        if (numSimulated != (int)NUM_AVATARS) {
+            inOrder = false;
+        }
+        numEnded++;
+    });
+    QVERIFY(simulation.ranInParallel());
+    QVERIFY(inOrder);
+    QCOMPARE((int)numEnded, (int)NUM_AVATARS);
+    for (auto count : simulated) {
+        QCOMPARE(count, 1);
+    }
+}
+
+void ParallelSimulationTests::testSerialFallback() {
+    ParallelSimulation simulation;
+    int numSimulated = 0;
+    auto nothing = [](size_t i) {};
+    auto count = [&](size_t i) { numSimulated++; };
+
+    // a single avatar isn't worth a task
+    simulation.run(1, nothing, count, nothing);
+    QVERIFY(!simulation.ranInParallel());
+
+    simulation.setEnabled(false);
+    simulation.run(10, nothing, count, nothing);
+    QVERIFY(!simulation.ranInParallel());
+    QCOMPARE(numSimulated, 11);
+
+    // nothing to simulate is fine too
+    simulation.setEnabled(true);
+    simulation.run(0, nothing, count, nothing);
+    QCOMPARE(numSimulated, 11);
+}
+
+void ParallelSimulationTests::testMatchesSerial() {
+    const int NUM_AVATARS = 24;
+    const int NUM_JOINTS = 20;
+    const int NUM_FRAMES = 30;
+    ScriptedAvatars parallelAvatars;
+    ScriptedAvatars serialAvatars;
+    makeAvatars(parallelAvatars, NUM_AVATARS, NUM_JOINTS);
+    makeAvatars(serialAvatars, NUM_AVATARS, NUM_JOINTS);
+
+    ParallelSimulation parallel;
+    ParallelSimulation serial;
+    serial.setEnabled(false);
+    Extents parallelScene;
+    Extents serialScene;
+    for (int frame = 0; frame < NUM_FRAMES; frame++) {
+        runFrame(parallel, parallelAvatars, frame * DT, parallelScene);
+        runFrame(serial, serialAvatars, frame * DT, serialScene);
+    }
+    QVERIFY(parallel.ranInParallel());
+
+    // the avatars only touch their own state, so the threads change nothing
+    QCOMPARE(parallelScene.minimum, serialScene.minimum);
+    QCOMPARE(parallelScene.maximum, serialScene.maximum);
+    for (int i = 0; i < NUM_AVATARS; i++) {
+        for (int j = 0; j < NUM_JOINTS; j++) {
+            glm::vec3 parallelPosition;
+            glm::vec3 serialPosition;
+            QVERIFY(parallelAvatars[i]->getRig()->getJointPosition(j, parallelPosition));
+            QVERIFY(serialAvatars[i]->getRig()->getJointPosition(j, serialPosition));
+            QCOMPARE(parallelPosition, serialPosition);
+        }
+    }
+}
+
+void ParallelSimulationTests::benchmarkAvatars() {
+    const int NUM_JOINTS = 64;
+    const int NUM_FRAMES = 60;
+    for (int numAvatars : { 10, 50, 200 }) {
+        ScriptedAvatars avatars;
+        makeAvatars(avatars, numAvatars, NUM_JOINTS);
+        Extents scene;
+        for (bool enabled : { false, true }) {
+            ParallelSimulation simulation;
+            simulation.setEnabled(enabled);
+            quint64 serialUsecs = 0;
+            quint64 parallelUsecs = 0;
+            quint64 start = usecTimestampNow();
+            for (int frame = 0; frame < NUM_FRAMES; frame++) {
+                runFrame(simulation, avatars, frame * DT, scene);
+                serialUsecs += simulation.getSerialUsecs();
+                parallelUsecs += simulation.getParallelUsecs();
+            }
+            quint64 usecs = usecTimestampNow() - start;
+            qDebug() << numAvatars << "avatars," << (enabled ? "parallel:" : "serial:") << usecs / (float)NUM_FRAMES
+                     << "usecs per frame," << serialUsecs / (float)NUM_FRAMES << "in the serial phases,"
+                     << parallelUsecs / (float)NUM_FRAMES << "in the skeletons";
+        }
+    }
+}
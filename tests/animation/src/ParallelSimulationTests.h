@@ -0,0 +1,25 @@
+//
+//  ParallelSimulationTests.h
+//  tests/animation/src
+//
+//  Copyright 2015 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_ParallelSimulationTests_h
+#define hifi_ParallelSimulationTests_h
+
+#include <QtTest/QtTest>
+
+class ParallelSimulationTests : public QObject {
+    Q_OBJECT
+private slots:
+    void testPhaseOrder();
+    void testSerialFallback();
+    void testMatchesSerial();
+    void benchmarkAvatars();
+};
+
+#endif // hifi_ParallelSimulationTests_h
@@ -0,0 +1,85 @@
+//
+//  AudioHRTFTests.cpp
+//  tests/audio/src
+//
+//  Copyright 2015 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "AudioHRTFTests.h"
+
+#include <AudioHRTF.h>
+#include <NumericalConstants.h>
+
+QTEST_MAIN(AudioHRTFTests)
+
+const int NUM_FRAMES = AudioConstants::NETWORK_FRAME_SAMPLES_PER_CHANNEL;
+
+// renders a single impulse and returns the peak position and energy of both ears
+static void renderImpulse(float azimuth, int peakIndex[2], float energy[2]) {
+    int16_t input[NUM_FRAMES] = { 0 };
+    int16_t output[2 * NUM_FRAMES] = { 0 };
+    input[0] = 10000;
+
+    AudioHRTF hrtf;
+    hrtf.render(input, output, NUM_FRAMES, azimuth, 1.0f);
+
+    for (int ear = 0; ear < HRTF_NUM_EARS; ++ear) {
+        peakIndex[ear] = 0;
+        energy[ear] = 0.0f;
+        for (int i = 0; i < NUM_FRAMES; ++i) {
+            float sample = output[2 * i + ear];
+            energy[ear] += sample * sample;
+            if (abs(output[2 * i + ear]) > abs(output[2 * peakIndex[ear] + ear])) {
+                peakIndex[ear] = i;
+            }
+        }
+    }
+}
+
+void AudioHRTFTests::testFrontalSymmetry() {
+    int peakIndex[2];
+    float energy[2];
+
+    // straight ahead and straight behind reach both ears identically
+    renderImpulse(0.0f, peakIndex, energy);
+    QCOMPARE(peakIndex[HRTF_LEFT], peakIndex[HRTF_RIGHT]);
+    QVERIFY(fabsf(energy[HRTF_LEFT] - energy[HRTF_RIGHT]) < 0.01f * energy[HRTF_LEFT]);
+
+    renderImpulse(PI, peakIndex, energy);
+    QCOMPARE(peakIndex[HRTF_LEFT], peakIndex[HRTF_RIGHT]);
+    QVERIFY(fabsf(energy[HRTF_LEFT] - energy[HRTF_RIGHT]) < 0.01f * energy[HRTF_LEFT]);
+}
+
+void AudioHRTFTests::testLateralLevelAndDelay() {
+    int peakIndex[2];
+    float energy[2];
+
+    // positive azimuth is to the left: the left ear hears it first and louder
+    renderImpulse(PI_OVER_TWO, peakIndex, energy);
+    QVERIFY(peakIndex[HRTF_LEFT] < peakIndex[HRTF_RIGHT]);
+    QVERIFY(energy[HRTF_LEFT] > 2.0f * energy[HRTF_RIGHT]);
+
+    renderImpulse(-PI_OVER_TWO, peakIndex, energy);
+    QVERIFY(peakIndex[HRTF_RIGHT] < peakIndex[HRTF_LEFT]);
+    QVERIFY(energy[HRTF_RIGHT] > 2.0f * energy[HRTF_LEFT]);
+}
+
+void AudioHRTFTests::testRenderCost() {
+    int16_t input[NUM_FRAMES] = { 0 };
+    int16_t output[2 * NUM_FRAMES] = { 0 };
+
+    AudioHRTF hrtf;
+    hrtf.render(input, output, NUM_FRAMES, 0.0f, 1.0f);
+    QCOMPARE(hrtf.getLastRenderCost(), AudioHRTF::getFrameCost());
+
+    // a static source costs the same every frame
+    hrtf.render(input, output, NUM_FRAMES, 0.0f, 1.0f);
+    QCOMPARE(hrtf.getLastRenderCost(), AudioHRTF::getFrameCost());
+
+    // a moving source crossfades its first block, which runs the convolution twice
+    hrtf.render(input, output, NUM_FRAMES, PI_OVER_TWO, 1.0f);
+    QVERIFY(hrtf.getLastRenderCost() > AudioHRTF::getFrameCost());
+}
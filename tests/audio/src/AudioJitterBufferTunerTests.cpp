@@ -0,0 +1,99 @@
+//
+//  AudioJitterBufferTunerTests.cpp
+//  tests/audio/src
+//
+//  Copyright 2015 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "AudioJitterBufferTunerTests.h"
+
+#include <AudioConstants.h>
+#include <AudioJitterBufferTuner.h>
+
+QTEST_MAIN(AudioJitterBufferTunerTests)
+
+const int PACKETS_PER_SECOND = 94;
+const quint64 FRAME_USECS = AudioConstants::NETWORK_FRAME_USECS;
+
+// feeds one second of packets, with one of them arriving late by lateFrames frames
+static int simulateSecond(AudioJitterBufferTuner& tuner, int lateFrames, int starves = 0) {
+    for (int i = 0; i < PACKETS_PER_SECOND; ++i) {
+        tuner.packetReceived(FRAME_USECS);
+    }
+    tuner.packetReceived((lateFrames + 1) * FRAME_USECS);
+    for (int i = 0; i < starves; ++i) {
+        tuner.starved();
+    }
+    return tuner.update();
+}
+
+void AudioJitterBufferTunerTests::testSteadyStream() {
+    AudioJitterBufferTuner tuner;
+    for (int second = 0; second < JITTER_BUFFER_TUNER_WINDOW_SECONDS; ++second) {
+        simulateSecond(tuner, 0);
+    }
+
+    QCOMPARE(tuner.getDesiredFrames(), 1);
+    QCOMPARE(tuner.getMarginFrames(), 0);
+    QCOMPARE(tuner.getStarvesPerMinute(), 0.0f);
+}
+
+void AudioJitterBufferTunerTests::testJitteryStream() {
+    // a gap of 5 frames every second has to be covered
+    AudioJitterBufferTuner tuner;
+    for (int second = 0; second < JITTER_BUFFER_TUNER_WINDOW_SECONDS; ++second) {
+        simulateSecond(tuner, 4);
+    }
+    QCOMPARE(tuner.getDesiredFrames(), 5);
+
+    // a single outlier in the window is worth a starve at the default target, and must not be buffered for
+    simulateSecond(tuner, 20);
+    QCOMPARE(tuner.getDesiredFrames(), 5);
+
+    // with no starves allowed, it has to be
+    AudioJitterBufferTuner strictTuner(0.0f);
+    for (int second = 0; second < JITTER_BUFFER_TUNER_WINDOW_SECONDS; ++second) {
+        simulateSecond(strictTuner, 4);
+    }
+    simulateSecond(strictTuner, 20);
+    QCOMPARE(strictTuner.getDesiredFrames(), 21);
+}
+
+void AudioJitterBufferTunerTests::testStarvesRaiseMargin() {
+    AudioJitterBufferTuner tuner;
+    simulateSecond(tuner, 0);
+
+    // one starve per minute is on target
+    simulateSecond(tuner, 0, 1);
+    QCOMPARE(tuner.getMarginFrames(), 0);
+
+    // more than that raises the margin, and the desired frames right away
+    int increases = tuner.getIncreases();
+    simulateSecond(tuner, 0, 1);
+    QCOMPARE(tuner.getMarginFrames(), 1);
+    QCOMPARE(tuner.getDesiredFrames(), 2);
+    QCOMPARE(tuner.getIncreases(), increases + 1);
+}
+
+void AudioJitterBufferTunerTests::testRecovery() {
+    AudioJitterBufferTuner tuner;
+    for (int second = 0; second < 5; ++second) {
+        simulateSecond(tuner, 0, 2);
+    }
+    int peakFrames = tuner.getDesiredFrames();
+    QVERIFY(peakFrames > 1);
+
+    // once the network calms down, latency is given back one frame at a time
+    int previousFrames = peakFrames;
+    for (int second = 0; second < 10 * JITTER_BUFFER_TUNER_WINDOW_SECONDS; ++second) {
+        int desiredFrames = simulateSecond(tuner, 0);
+        QVERIFY(desiredFrames >= previousFrames - 1);
+        previousFrames = desiredFrames;
+    }
+    QCOMPARE(tuner.getDesiredFrames(), 1);
+    QCOMPARE(tuner.getMarginFrames(), 0);
+    QVERIFY(tuner.getDecreases() >= peakFrames - 1);
+}
@@ -0,0 +1,25 @@
+//
+//  AudioJitterBufferTunerTests.h
+//  tests/audio/src
+//
+//  Copyright 2015 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_AudioJitterBufferTunerTests_h
+#define hifi_AudioJitterBufferTunerTests_h
+
+#include <QtTest/QtTest>
+
+class AudioJitterBufferTunerTests : public QObject {
+    Q_OBJECT
+private slots:
+    void testSteadyStream();
+    void testJitteryStream();
+    void testStarvesRaiseMargin();
+    void testRecovery();
+};
+
+#endif // hifi_AudioJitterBufferTunerTests_h
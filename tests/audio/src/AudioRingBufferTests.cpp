@@ -125,3 +125,31 @@ void AudioRingBufferTests::runAllTests() {
         assertBufferSize(ringBuffer, 0);
     }
 }
+
+void AudioRingBufferTests::testFramePointer() {
+    const int FRAME_SAMPLES = 10;
+    const int WRITE_SAMPLES = 7;
+
+    int16_t writeData[WRITE_SAMPLES];
+    int16_t nextSample = 0;
+
+    AudioRingBuffer ringBuffer(FRAME_SAMPLES, false, 10);
+
+    // write in chunks that are not a multiple of the frame size, so frames straddle the end of the ring
+    for (int T = 0; T < 300; T++) {
+        for (int i = 0; i < WRITE_SAMPLES; i++) {
+            writeData[i] = nextSample++;
+        }
+        ringBuffer.writeSamples(writeData, WRITE_SAMPLES);
+
+        if (ringBuffer.samplesAvailable() >= FRAME_SAMPLES) {
+            AudioRingBuffer::ConstIterator frame = ringBuffer.lastFrameWritten();
+            const int16_t* framePointer = frame.getFramePointer();
+            for (int i = 0; i < FRAME_SAMPLES; i++) {
+                QCOMPARE(framePointer[i], (int16_t)(nextSample - FRAME_SAMPLES + i));
+            }
+        }
+
+        ringBuffer.shiftReadPosition(std::min(ringBuffer.samplesAvailable(), WRITE_SAMPLES - 1));
+    }
+}
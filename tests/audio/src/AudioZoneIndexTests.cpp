@@ -0,0 +1,107 @@
+//
+//  AudioZoneIndexTests.cpp
+//  tests/audio/src
+//
+//  Copyright 2015 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "AudioZoneIndexTests.h"
+
+#include <AudioZoneIndex.h>
+
+QTEST_MAIN(AudioZoneIndexTests)
+
+const int NUM_ZONES = 40;
+const int SPREAD = 12;
+
+static int randomInt(int minimum, int maximum) {
+    return minimum + rand() % (maximum - minimum + 1);
+}
+
+// zones and positions on a grid of whole meters, so that plenty of the positions lie exactly on zone faces
+static glm::vec3 randomGridPoint() {
+    return glm::vec3(randomInt(-SPREAD, SPREAD), randomInt(-SPREAD, SPREAD), randomInt(-SPREAD, SPREAD));
+}
+
+static QVector<AABox> randomZones() {
+    QVector<AABox> zones;
+    for (int i = 0; i < NUM_ZONES; ++i) {
+        zones.append(AABox(randomGridPoint(), glm::vec3(randomInt(1, 8), randomInt(1, 8), randomInt(1, 8))));
+    }
+    return zones;
+}
+
+// the zones containing the position, by testing every zone
+static AudioZoneMask scanZones(const QVector<AABox>& zones, const glm::vec3& position) {
+    AudioZoneMask mask = 0;
+    for (int i = 0; i < zones.size(); ++i) {
+        if (zones.at(i).contains(position)) {
+            mask |= audioZoneBit(i);
+        }
+    }
+    return mask;
+}
+
+void AudioZoneIndexTests::testAdjacentZones() {
+    // two zones sharing a face, and a listener right on it, which is in both
+    QVector<AABox> zones;
+    zones << AABox(glm::vec3(0.0f), glm::vec3(2.0f)) << AABox(glm::vec3(2.0f, 0.0f, 0.0f), glm::vec3(2.0f));
+    AudioZoneIndex index;
+    index.build(zones);
+
+    AudioZoneMembership membership;
+    index.query(glm::vec3(2.0f, 1.0f, 1.0f), membership);
+    QCOMPARE(membership.zones, audioZoneBit(0) | audioZoneBit(1));
+    QCOMPARE(membership.safeDistance, 0.0f);
+
+    // and off the face, in only one of them
+    QVERIFY(index.update(glm::vec3(2.5f, 1.0f, 1.0f), membership));
+    QCOMPARE(membership.zones, audioZoneBit(1));
+    QCOMPARE(membership.safeDistance, 0.5f);
+}
+
+void AudioZoneIndexTests::testQueryMatchesScan() {
+    srand(7);
+    for (int build = 0; build < 10; ++build) {
+        QVector<AABox> zones = randomZones();
+        AudioZoneIndex index;
+        index.build(zones);
+
+        // the corners of the zones, then positions on the grid
+        QVector<glm::vec3> positions;
+        foreach (const AABox& zone, zones) {
+            positions << zone.getMinimumPoint() << zone.getMaximumPoint();
+        }
+        for (int i = 0; i < 1000; ++i) {
+            positions << randomGridPoint();
+        }
+        foreach (const glm::vec3& position, positions) {
+            AudioZoneMembership membership;
+            index.query(position, membership);
+            QCOMPARE(membership.zones, scanZones(zones, position));
+        }
+    }
+}
+
+void AudioZoneIndexTests::testUpdateMatchesScan() {
+    srand(11);
+    QVector<AABox> zones = randomZones();
+    AudioZoneIndex index;
+    index.build(zones);
+
+    // walk in steps of a quarter meter, which stop on the faces now and then
+    glm::vec3 position = randomGridPoint();
+    AudioZoneMembership membership;
+    index.query(position, membership);
+    for (int step = 0; step < 10000; ++step) {
+        position[rand() % 3] += (rand() % 2) ? 0.25f : -0.25f;
+        position = glm::clamp(position, glm::vec3((float)-SPREAD), glm::vec3((float)SPREAD));
+        AudioZoneMask previousZones = membership.zones;
+        bool changed = index.update(position, membership);
+        QCOMPARE(membership.zones, scanZones(zones, position));
+        QCOMPARE(changed, membership.zones != previousZones);
+    }
+}
@@ -0,0 +1,24 @@
+//
+//  AudioZoneIndexTests.h
+//  tests/audio/src
+//
+//  Copyright 2015 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_AudioZoneIndexTests_h
+#define hifi_AudioZoneIndexTests_h
+
+#include <QtTest/QtTest>
+
+class AudioZoneIndexTests : public QObject {
+    Q_OBJECT
+private slots:
+    void testAdjacentZones();
+    void testQueryMatchesScan();
+    void testUpdateMatchesScan();
+};
+
+#endif // hifi_AudioZoneIndexTests_h
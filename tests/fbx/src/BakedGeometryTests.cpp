@@ -0,0 +1,235 @@
+//
+//  BakedGeometryTests.cpp
+//  tests/fbx/src
+//
+//  Copyright 2015 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "BakedGeometryTests.h"
+
+#include <memory>
+
+#include <QTemporaryDir>
+
+#include <BakedGeometry.h>
+#include <ResourceDiskCache.h>
+#include <SharedUtil.h>
+
+QTEST_MAIN(BakedGeometryTests)
+
+static QByteArray readTestModel() {
+    QDir path(__FILE__);
+    path.cdUp();
+    QFile file(path.cleanPath(path.absoluteFilePath("../../../interface/resources/meshes/defaultAvatar/head.fbx")));
+    return file.open(QIODevice::ReadOnly) ? file.readAll() : QByteArray();
+}
+
+static void compareTextures(const FBXTexture& actual, const FBXTexture& expected) {
+    QCOMPARE(actual.name, expected.name);
+    QCOMPARE(actual.filename, expected.filename);
+    QCOMPARE(actual.content, expected.content);
+    QCOMPARE(actual.transform.isIdentity(), expected.transform.isIdentity());
+    QCOMPARE(actual.texcoordSet, expected.texcoordSet);
+}
+
+static void compareGeometries(const FBXGeometry& actual, const FBXGeometry& expected) {
+    QCOMPARE(actual.author, expected.author);
+    QCOMPARE(actual.joints.size(), expected.joints.size());
+    for (int i = 0; i < expected.joints.size(); i++) {
+        QCOMPARE(actual.joints.at(i).name, expected.joints.at(i).name);
+        QCOMPARE(actual.joints.at(i).parentIndex, expected.joints.at(i).parentIndex);
+        QVERIFY(actual.joints.at(i).bindTransform == expected.joints.at(i).bindTransform);
+        QVERIFY(actual.joints.at(i).inverseBindRotation == expected.joints.at(i).inverseBindRotation);
+    }
+    QCOMPARE(actual.jointIndices, expected.jointIndices);
+    QCOMPARE(actual.headJointIndex, expected.headJointIndex);
+    QCOMPARE(actual.leftEyeJointIndex, expected.leftEyeJointIndex);
+    QCOMPARE(actual.humanIKJointIndices, expected.humanIKJointIndices);
+    QVERIFY(actual.meshExtents.minimum == expected.meshExtents.minimum);
+    QVERIFY(actual.meshExtents.maximum == expected.meshExtents.maximum);
+    QCOMPARE(actual.blendshapeChannelNames, expected.blendshapeChannelNames);
+    QCOMPARE(actual.meshIndicesToModelNames, expected.meshIndicesToModelNames);
+
+    QCOMPARE(actual.meshes.size(), expected.meshes.size());
+    for (int i = 0; i < expected.meshes.size(); i++) {
+        const FBXMesh& mesh = actual.meshes.at(i);
+        const FBXMesh& expectedMesh = expected.meshes.at(i);
+        QCOMPARE(mesh.vertices, expectedMesh.vertices);
+        QCOMPARE(mesh.normals, expectedMesh.normals);
+        QCOMPARE(mesh.tangents, expectedMesh.tangents);
+        QCOMPARE(mesh.texCoords, expectedMesh.texCoords);
+        QCOMPARE(mesh.clusterIndices, expectedMesh.clusterIndices);
+        QCOMPARE(mesh.clusterWeights, expectedMesh.clusterWeights);
+        QCOMPARE(mesh.clusters.size(), expectedMesh.clusters.size());
+        QCOMPARE(mesh.meshIndex, expectedMesh.meshIndex);
+        QCOMPARE(mesh.isEye, expectedMesh.isEye);
+        QCOMPARE(mesh.blendshapes.size(), expectedMesh.blendshapes.size());
+        for (int j = 0; j < expectedMesh.blendshapes.size(); j++) {
+            QCOMPARE(mesh.blendshapes.at(j).indices, expectedMesh.blendshapes.at(j).indices);
+            QCOMPARE(mesh.blendshapes.at(j).vertices, expectedMesh.blendshapes.at(j).vertices);
+        }
+        QCOMPARE(mesh.parts.size(), expectedMesh.parts.size());
+        for (int j = 0; j < expectedMesh.parts.size(); j++) {
+            const FBXMeshPart& part = mesh.parts.at(j);
+            const FBXMeshPart& expectedPart = expectedMesh.parts.at(j);
+            QCOMPARE(part.quadIndices, expectedPart.quadIndices);
+            QCOMPARE(part.triangleIndices, expectedPart.triangleIndices);
+            QCOMPARE(part.materialID, expectedPart.materialID);
+            QCOMPARE((bool)part._material, (bool)expectedPart._material);
+            compareTextures(part.diffuseTexture, expectedPart.diffuseTexture);
+            compareTextures(part.normalTexture, expectedPart.normalTexture);
+        }
+#       if USE_MODEL_MESH
+        QCOMPARE(mesh._mesh.getNumVertices(), expectedMesh._mesh.getNumVertices());
+        QCOMPARE(mesh._mesh.getNumIndices(), expectedMesh._mesh.getNumIndices());
+#       endif
+    }
+}
+
+void BakedGeometryTests::testKey() {
+    QByteArray model = readTestModel();
+    QVariantHash mapping;
+    mapping.insert("scale", 2.0f);
+    mapping.insert("joint", "jointRoot = Hips");
+
+    QByteArray key = BakedGeometry::getKey(model, mapping, "/models/model.fbx", true, 1.0f);
+    QCOMPARE(key.size(), 40);
+
+    // the same mapping built in another order
+    QVariantHash sameMapping;
+    sameMapping.insert("joint", "jointRoot = Hips");
+    sameMapping.insert("scale", 2.0f);
+    QCOMPARE(BakedGeometry::getKey(model, sameMapping, "/models/model.fbx", true, 1.0f), key);
+
+    QVERIFY(BakedGeometry::getKey(model, QVariantHash(), "/models/model.fbx", true, 1.0f) != key);
+    QVERIFY(BakedGeometry::getKey(model, mapping, "/models/model.fbx", false, 1.0f) != key);
+    QVERIFY(BakedGeometry::getKey(model + " ", mapping, "/models/model.fbx", true, 1.0f) != key);
+
+    // the texture filenames are resolved against the directory of the URL
+    QCOMPARE(BakedGeometry::getKey(model, mapping, "/models/copy.fbx", true, 1.0f), key);
+    QVERIFY(BakedGeometry::getKey(model, mapping, "/other/model.fbx", true, 1.0f) != key);
+}
+
+void BakedGeometryTests::testRoundTrip() {
+    QByteArray model = readTestModel();
+    if (model.isEmpty()) {
+        QSKIP("No test model");
+    }
+    std::unique_ptr<FBXGeometry> expected(readFBX(model, QVariantHash()));
+    QByteArray baked = BakedGeometry::write(*expected);
+    std::unique_ptr<FBXGeometry> actual(BakedGeometry::read(baked.constData(), baked.size()));
+    compareGeometries(*actual, *expected);
+}
+
+void BakedGeometryTests::testRejectsCorruptData() {
+    FBXGeometry geometry;
+    FBXMesh mesh;
+    mesh.vertices.append(glm::vec3(1.0f, 2.0f, 3.0f));
+    geometry.meshes.append(mesh);
+    QByteArray baked = BakedGeometry::write(geometry);
+
+    for (int size : { 0, 8, baked.size() / 2, baked.size() - 1 }) {
+        bool threw = false;
+        try {
+            delete BakedGeometry::read(baked.constData(), size);
+        } catch (const QString&) {
+            threw = true;
+        }
+        QVERIFY(threw);
+    }
+
+    QByteArray otherVersion = baked;
+    otherVersion[8] = otherVersion[8] + 1;
+    bool threw = false;
+    try {
+        delete BakedGeometry::read(otherVersion.constData(), otherVersion.size());
+    } catch (const QString&) {
+        threw = true;
+    }
+    QVERIFY(threw);
+}
+
+void BakedGeometryTests::testCache() {
+    QTemporaryDir directory;
+    QVERIFY(directory.isValid());
+    BakedGeometryCache cache(directory.path() + "/geometry");
+
+    FBXGeometry geometry;
+    geometry.author = "baker";
+    QByteArray key = BakedGeometry::getKey("model", QVariantHash(), "model.fbx", true, 1.0f);
+    QVERIFY(!cache.load(key));
+    QVERIFY(cache.store(key, geometry));
+
+    std::unique_ptr<FBXGeometry> loaded(cache.load(key));
+    QVERIFY(loaded.get());
+    QCOMPARE(loaded->author, geometry.author);
+
+    // a corrupt file is a miss, and goes away
+    QFile file(cache.getFilePath(key));
+    QVERIFY(file.open(QIODevice::WriteOnly | QIODevice::Truncate));
+    file.write("garbage");
+    file.close();
+    QVERIFY(!cache.load(key));
+    QVERIFY(!QFile::exists(cache.getFilePath(key)));
+}
+
+void BakedGeometryTests::testPrebaked() {
+    QByteArray model = readTestModel();
+    if (model.isEmpty()) {
+        QSKIP("No test model");
+    }
+    QTemporaryDir directory;
+    QVERIFY(directory.isValid());
+
+    // bake the model as the baker does for the URL it's served from, marked so that the baked version tells apart
+    const QString SERVED_PATH = "/models/head.fbx";
+    const QString PREBAKED_AUTHOR = "prebaked";
+    BakedGeometryCache prebaked(directory.path() + "/geometry");
+    std::unique_ptr<FBXGeometry> geometry(readFBX(model, QVariantHash(), SERVED_PATH, true, 1.0f));
+    geometry->author = PREBAKED_AUTHOR;
+    QVERIFY(prebaked.store(BakedGeometry::getKey(model, QVariantHash(), SERVED_PATH, true, 1.0f), *geometry));
+
+    // the client loads the baked version for that URL, without baking it again into its disk cache
+    ResourceDiskCache diskCache(directory.path() + "/cache");
+    std::unique_ptr<FBXGeometry> loaded(prebaked.readModel(model, QVariantHash(), SERVED_PATH, true, 1.0f, &diskCache));
+    QVERIFY(loaded.get());
+    QCOMPARE(loaded->author, PREBAKED_AUTHOR);
+    QCOMPARE(diskCache.getEntryCount(), 0);
+
+    // and reads the model served from elsewhere, baking it into the disk cache for the next time
+    loaded.reset(prebaked.readModel(model, QVariantHash(), "/other/head.fbx", true, 1.0f, &diskCache));
+    QVERIFY(loaded.get());
+    QVERIFY(loaded->author != PREBAKED_AUTHOR);
+    QCOMPARE(diskCache.getEntryCount(), 1);
+    loaded.reset(prebaked.readModel(model, QVariantHash(), "/other/head.fbx", true, 1.0f, &diskCache));
+    QVERIFY(loaded.get());
+    QCOMPARE(diskCache.getEntryCount(), 1);
+}
+
+void BakedGeometryTests::benchmarkLoad() {
+    const int NUM_LOADS = 10;
+
+    QByteArray model = readTestModel();
+    if (model.isEmpty()) {
+        QSKIP("No test model");
+    }
+    quint64 start = usecTimestampNow();
+    std::unique_ptr<FBXGeometry> geometry;
+    for (int i = 0; i < NUM_LOADS; i++) {
+        geometry.reset(readFBX(model, QVariantHash()));
+    }
+    quint64 readUsecs = usecTimestampNow() - start;
+
+    QByteArray baked = BakedGeometry::write(*geometry);
+    start = usecTimestampNow();
+    for (int i = 0; i < NUM_LOADS; i++) {
+        geometry.reset(BakedGeometry::read(baked.constData(), baked.size()));
+    }
+    quint64 loadUsecs = usecTimestampNow() - start;
+
+    qDebug() << "Model:" << model.size() / 1024 << "KB, read in" << readUsecs / NUM_LOADS << "usecs";
+    qDebug() << "Baked:" << baked.size() / 1024 << "KB, loaded in" << loadUsecs / NUM_LOADS << "usecs";
+}
@@ -0,0 +1,208 @@
+//
+//  BlendshapeBlenderTests.cpp
+//  tests/fbx/src
+//
+//  Copyright 2015 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "BlendshapeBlenderTests.h"
+
+#include <memory>
+#include <thread>
+
+#include <BlendshapeBlender.h>
+#include <NumericalConstants.h>
+#include <SharedUtil.h>
+
+QTEST_MAIN(BlendshapeBlenderTests)
+
+// the blend as Model did it before, one delta after the other
+static void blendScalar(const QVector<FBXMesh>& meshes, const QVector<float>& coefficients,
+                        QVector<glm::vec3>& vertices, QVector<glm::vec3>& normals) {
+    vertices.clear();
+    normals.clear();
+    int offset = 0;
+    foreach (const FBXMesh& mesh, meshes) {
+        if (mesh.blendshapes.isEmpty()) {
+            continue;
+        }
+        vertices += mesh.vertices;
+        normals += mesh.normals;
+        glm::vec3* meshVertices = vertices.data() + offset;
+        glm::vec3* meshNormals = normals.data() + offset;
+        offset += mesh.vertices.size();
+        for (int i = 0, n = qMin(coefficients.size(), mesh.blendshapes.size()); i < n; i++) {
+            float vertexCoefficient = coefficients.at(i);
+            if (vertexCoefficient < EPSILON) {
+                continue;
+            }
+            float normalCoefficient = vertexCoefficient * BlendshapeBlender::NORMAL_COEFFICIENT_SCALE;
+            const FBXBlendshape& blendshape = mesh.blendshapes.at(i);
+            for (int j = 0; j < blendshape.indices.size(); j++) {
+                int index = blendshape.indices.at(j);
+                meshVertices[index] += blendshape.vertices.at(j) * vertexCoefficient;
+                meshNormals[index] += blendshape.normals.at(j) * normalCoefficient;
+            }
+        }
+    }
+}
+
+static glm::vec3 randVec3() {
+    return glm::vec3(randFloatInRange(-1.0f, 1.0f), randFloatInRange(-1.0f, 1.0f), randFloatInRange(-1.0f, 1.0f));
+}
+
+static FBXMesh makeMesh(int numVertices, int numShapes, int deltasPerShape) {
+    FBXMesh mesh;
+    for (int i = 0; i < numVertices; i++) {
+        mesh.vertices.append(randVec3());
+        mesh.normals.append(glm::normalize(randVec3() + glm::vec3(0.0f, 0.0f, 2.0f)));
+    }
+    for (int i = 0; i < numShapes; i++) {
+        FBXBlendshape blendshape;
+        for (int j = 0; j < deltasPerShape; j++) {
+            // unsorted, and the same vertex can come back in a shape
+            blendshape.indices.append(randIntInRange(0, numVertices - 1));
+            blendshape.vertices.append(randVec3() * 0.1f);
+            blendshape.normals.append(randVec3());
+        }
+        mesh.blendshapes.append(blendshape);
+    }
+    return mesh;
+}
+
+static QVector<float> makeCoefficients(int numShapes, float activeFraction) {
+    QVector<float> coefficients;
+    for (int i = 0; i < numShapes; i++) {
+        coefficients.append(randFloat() < activeFraction ? randFloat() : 0.0f);
+    }
+    return coefficients;
+}
+
+static void compareBlends(const QVector<glm::vec3>& actual, const QVector<glm::vec3>& expected) {
+    QCOMPARE(actual.size(), expected.size());
+    const float TOLERANCE = 1.0e-4f;
+    for (int i = 0; i < actual.size(); i++) {
+        if (glm::distance(actual.at(i), expected.at(i)) > TOLERANCE) {
+            QFAIL(qPrintable(QString("blends differ at %1").arg(i)));
+        }
+    }
+}
+
+// the avatar head, which has the blendshapes of the face
+static std::unique_ptr<FBXGeometry> readTestHead() {
+    QDir path(__FILE__);
+    path.cdUp();
+    QString fileName = path.cleanPath(path.absoluteFilePath("../../../interface/resources/meshes/defaultAvatar/head.fbx"));
+    QFile file(fileName);
+    if (!file.open(QIODevice::ReadOnly)) {
+        return std::unique_ptr<FBXGeometry>();
+    }
+    return std::unique_ptr<FBXGeometry>(readFBX(file.readAll(), QVariantHash(), fileName));
+}
+
+void BlendshapeBlenderTests::testCoefficientsChanged() {
+    QVector<float> blended = { 0.0f, 0.5f, 1.0f };
+    QVERIFY(!BlendshapeBlender::coefficientsChanged(blended, blended));
+    QVERIFY(!BlendshapeBlender::coefficientsChanged(blended, { 0.0f, 0.5f + BlendshapeBlender::COEFFICIENT_THRESHOLD * 0.5f, 1.0f }));
+    QVERIFY(BlendshapeBlender::coefficientsChanged(blended, { 0.0f, 0.5f + BlendshapeBlender::COEFFICIENT_THRESHOLD * 2.0f, 1.0f }));
+    QVERIFY(BlendshapeBlender::coefficientsChanged(blended, { 0.0f, 0.5f }));
+    QVERIFY(BlendshapeBlender::coefficientsChanged(QVector<float>(), blended));
+}
+
+void BlendshapeBlenderTests::testBlendMatchesScalar() {
+    QVector<FBXMesh> meshes;
+    meshes.append(makeMesh(100, 5, 30));
+    meshes.append(makeMesh(50, 0, 0));
+    // more than one range, and enough deltas to go parallel
+    meshes.append(makeMesh(3 * BlendshapeLayout::DEFAULT_VERTICES_PER_RANGE + 17, 40, 4000));
+    auto layouts = BlendshapeBlender::makeLayouts(meshes);
+    QCOMPARE((int)layouts.size(), 3);
+    QVERIFY(layouts[0] && !layouts[1] && layouts[2]);
+    QCOMPARE((int)layouts[2]->getRanges().size(), 4);
+
+    for (float activeFraction : { 0.0f, 0.1f, 1.0f }) {
+        // with fewer coefficients than shapes too
+        for (int numCoefficients : { 40, 3 }) {
+            QVector<float> coefficients = makeCoefficients(numCoefficients, activeFraction);
+            QVector<glm::vec3> expectedVertices, expectedNormals;
+            blendScalar(meshes, coefficients, expectedVertices, expectedNormals);
+
+            QVector<glm::vec3> vertices, normals;
+            BlendshapeBlender::blend(meshes, layouts, coefficients, vertices, normals);
+            compareBlends(vertices, expectedVertices);
+            compareBlends(normals, expectedNormals);
+        }
+    }
+}
+
+void BlendshapeBlenderTests::testBlendReusesArrays() {
+    QVector<FBXMesh> meshes;
+    meshes.append(makeMesh(1000, 10, 200));
+    auto layouts = BlendshapeBlender::makeLayouts(meshes);
+
+    QVector<glm::vec3> vertices, normals;
+    BlendshapeBlender::blend(meshes, layouts, makeCoefficients(10, 0.5f), vertices, normals);
+    const glm::vec3* vertexData = vertices.constData();
+    const glm::vec3* normalData = normals.constData();
+
+    QVector<float> coefficients = makeCoefficients(10, 0.5f);
+    BlendshapeBlender::blend(meshes, layouts, coefficients, vertices, normals);
+    QVERIFY(vertices.constData() == vertexData);
+    QVERIFY(normals.constData() == normalData);
+
+    // and the previous blend doesn't leak into the next
+    QVector<glm::vec3> expectedVertices, expectedNormals;
+    blendScalar(meshes, coefficients, expectedVertices, expectedNormals);
+    compareBlends(vertices, expectedVertices);
+    compareBlends(normals, expectedNormals);
+}
+
+void BlendshapeBlenderTests::benchmarkBlend() {
+    const int NUM_BLENDS = 100;
+    const float ACTIVE_FRACTION = 0.3f;
+
+    QVector<FBXMesh> meshes;
+    auto head = readTestHead();
+    if (head && head->hasBlendedMeshes()) {
+        meshes = head->meshes;
+    } else {
+        qDebug() << "No test head, benchmarking a generated face";
+        meshes.append(makeMesh(10000, 50, 3000));
+    }
+
+    int numShapes = 0;
+    foreach (const FBXMesh& mesh, meshes) {
+        numShapes = qMax(numShapes, mesh.blendshapes.size());
+    }
+    std::vector<QVector<float>> coefficients;
+    for (int i = 0; i < NUM_BLENDS; i++) {
+        coefficients.push_back(makeCoefficients(numShapes, ACTIVE_FRACTION));
+    }
+
+    QVector<glm::vec3> expectedVertices, expectedNormals;
+    quint64 start = usecTimestampNow();
+    for (int i = 0; i < NUM_BLENDS; i++) {
+        blendScalar(meshes, coefficients[i], expectedVertices, expectedNormals);
+    }
+    quint64 scalarUsecs = usecTimestampNow() - start;
+
+    start = usecTimestampNow();
+    auto layouts = BlendshapeBlender::makeLayouts(meshes);
+    quint64 layoutUsecs = usecTimestampNow() - start;
+
+    QVector<glm::vec3> vertices, normals;
+    start = usecTimestampNow();
+    for (int i = 0; i < NUM_BLENDS; i++) {
+        BlendshapeBlender::blend(meshes, layouts, coefficients[i], vertices, normals);
+    }
+    quint64 blendUsecs = usecTimestampNow() - start;
+    compareBlends(vertices, expectedVertices);
+
+    qDebug() << "Scalar blend:" << scalarUsecs / (float)NUM_BLENDS << "usecs per blend of" << numShapes << "shapes";
+    qDebug() << "Layout:" << layoutUsecs << "usecs, once per geometry";
+    qDebug() << "Blender:" << blendUsecs / (float)NUM_BLENDS << "usecs per blend,"
+             << std::thread::hardware_concurrency() << "hardware threads";
+}
@@ -0,0 +1,25 @@
+//
+//  BlendshapeBlenderTests.h
+//  tests/fbx/src
+//
+//  Copyright 2015 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_BlendshapeBlenderTests_h
+#define hifi_BlendshapeBlenderTests_h
+
+#include <QtTest/QtTest>
+
+class BlendshapeBlenderTests : public QObject {
+    Q_OBJECT
+private slots:
+    void testCoefficientsChanged();
+    void testBlendMatchesScalar();
+    void testBlendReusesArrays();
+    void benchmarkBlend();
+};
+
+#endif // hifi_BlendshapeBlenderTests_h
@@ -0,0 +1,256 @@
+//
+//  FBXReaderTests.cpp
+//  tests/fbx/src
+//
+//  Copyright 2015 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "FBXReaderTests.h"
+
+#include <iostream>
+#include <memory>
+
+#ifndef Q_OS_WIN
+#include <sys/resource.h>
+#endif
+
+#include <FBXBinaryParser.h>
+#include <FBXReader.h>
+#include <SharedUtil.h>
+
+QTEST_MAIN(FBXReaderTests)
+
+static QStringList getTestFileNames() {
+    QDir path(__FILE__);
+    path.cdUp();
+    QStringList fileNames;
+    for (const char* name : { "defaultAvatar/head.fbx", "defaultAvatar/body.fbx", "defaultAvatar_full/defaultAvatar_full.fbx" }) {
+        QString fileName = path.cleanPath(path.absoluteFilePath(QString("../../../interface/resources/meshes/") + name));
+        if (QFileInfo(fileName).exists()) {
+            fileNames.append(fileName);
+        }
+    }
+    return fileNames;
+}
+
+static QByteArray readTestFile(const QString& fileName) {
+    QFile file(fileName);
+    return file.open(QIODevice::ReadOnly) ? file.readAll() : QByteArray();
+}
+
+// the peak resident size of the process in KB, or zero where it isn't available
+static qint64 getPeakResidentKB() {
+#if defined(Q_OS_WIN)
+    return 0;
+#else
+    struct rusage usage;
+    if (getrusage(RUSAGE_SELF, &usage) != 0) {
+        return 0;
+    }
+#ifdef Q_OS_MAC
+    return usage.ru_maxrss / 1024; // in bytes on OS X
+#else
+    return usage.ru_maxrss;
+#endif
+#endif
+}
+
+// what measurePeakResident loads: nothing, for the baseline of the process, or one of the ways of loading the model
+static const char* PEAK_FILE_VARIABLE = "HIFI_FBX_PEAK_FILE";
+static const char* PEAK_LOAD_VARIABLE = "HIFI_FBX_PEAK_LOAD";
+static const QByteArray PEAK_OUTPUT_PREFIX = "Peak resident KB: ";
+
+// runs measurePeakResident in a process of its own, since the peak of a process only grows
+static qint64 measurePeakResidentKB(const QString& fileName, const QString& load) {
+    QProcessEnvironment environment = QProcessEnvironment::systemEnvironment();
+    environment.insert(PEAK_FILE_VARIABLE, fileName);
+    environment.insert(PEAK_LOAD_VARIABLE, load);
+    QProcess process;
+    process.setProcessEnvironment(environment);
+    process.start(QCoreApplication::applicationFilePath(), QStringList() << "measurePeakResident");
+    if (!process.waitForFinished()) {
+        return 0;
+    }
+    foreach (const QByteArray& line, process.readAllStandardOutput().split('\n')) {
+        if (line.startsWith(PEAK_OUTPUT_PREFIX)) {
+            return line.mid(PEAK_OUTPUT_PREFIX.size()).trimmed().toLongLong();
+        }
+    }
+    return 0;
+}
+
+template<class T> static bool compareArray(const QVariant& expected, const FBXArrayProperty& array) {
+    QVector<T> expectedValues = expected.value<QVector<T> >();
+    QVector<double> values;
+    if (!array.read(values) || values.size() != expectedValues.size()) {
+        return false;
+    }
+    for (int i = 0; i < values.size(); i++) {
+        if (values.at(i) != (double)expectedValues.at(i)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+static bool compareProperty(const QVariant& expected, const QVariant& actual) {
+    if (actual.userType() != qMetaTypeId<FBXArrayProperty>()) {
+        return actual == expected;
+    }
+    FBXArrayProperty array = actual.value<FBXArrayProperty>();
+    switch (array.type) {
+        case 'f':
+            return compareArray<float>(expected, array);
+        case 'd':
+            return compareArray<double>(expected, array);
+        case 'l':
+            return compareArray<qint64>(expected, array);
+        case 'i':
+            return compareArray<qint32>(expected, array);
+        case 'b':
+            return compareArray<bool>(expected, array);
+        default:
+            return false;
+    }
+}
+
+static void compareNodes(const FBXNode& expected, const FBXNode& actual, const QByteArray& path) {
+    QCOMPARE(actual.name, expected.name);
+    QCOMPARE(actual.properties.size(), expected.properties.size());
+    for (int i = 0; i < expected.properties.size(); i++) {
+        if (!compareProperty(expected.properties.at(i), actual.properties.at(i))) {
+            QFAIL(qPrintable(QString("property %1 of %2 differs").arg(i).arg(QString(path))));
+        }
+    }
+    QCOMPARE(actual.children.size(), expected.children.size());
+    for (int i = 0; i < expected.children.size(); i++) {
+        compareNodes(expected.children.at(i), actual.children.at(i), path + "/" + expected.children.at(i).name);
+    }
+}
+
+static void compareGeometries(const FBXGeometry& expected, const FBXGeometry& actual) {
+    QCOMPARE(actual.joints.size(), expected.joints.size());
+    QCOMPARE(actual.meshes.size(), expected.meshes.size());
+    for (int i = 0; i < expected.meshes.size(); i++) {
+        const FBXMesh& expectedMesh = expected.meshes.at(i);
+        const FBXMesh& mesh = actual.meshes.at(i);
+        QCOMPARE(mesh.vertices, expectedMesh.vertices);
+        QCOMPARE(mesh.normals, expectedMesh.normals);
+        QCOMPARE(mesh.colors, expectedMesh.colors);
+        QCOMPARE(mesh.texCoords, expectedMesh.texCoords);
+        QCOMPARE(mesh.blendshapes.size(), expectedMesh.blendshapes.size());
+        QCOMPARE(mesh.parts.size(), expectedMesh.parts.size());
+    }
+}
+
+void FBXReaderTests::testBinaryMatchesStreamParser() {
+    QStringList fileNames = getTestFileNames();
+    if (fileNames.isEmpty()) {
+        QSKIP("No test models");
+    }
+    foreach (const QString& fileName, fileNames) {
+        QByteArray model = readTestFile(fileName);
+        QVERIFY(isBinaryFBX(model.constData(), model.size()));
+
+        QBuffer buffer(&model);
+        buffer.open(QIODevice::ReadOnly);
+        FBXNode expected = parseFBX(&buffer);
+        FBXNode actual = parseBinaryFBX(model.constData(), model.size());
+        compareNodes(expected, actual, QFileInfo(fileName).fileName().toUtf8());
+    }
+}
+
+void FBXReaderTests::testReadFromFile() {
+    QStringList fileNames = getTestFileNames();
+    if (fileNames.isEmpty()) {
+        QSKIP("No test models");
+    }
+    foreach (const QString& fileName, fileNames) {
+        QByteArray model = readTestFile(fileName);
+        QBuffer buffer(&model);
+        buffer.open(QIODevice::ReadOnly);
+        std::unique_ptr<FBXGeometry> expected(extractFBXGeometry(parseFBX(&buffer), QVariantHash(), fileName));
+
+        // mapped from the file, and parsed in place from memory
+        QFile file(fileName);
+        QVERIFY(file.open(QIODevice::ReadOnly));
+        std::unique_ptr<FBXGeometry> mapped(readFBX(&file, QVariantHash(), fileName));
+        compareGeometries(*expected, *mapped);
+
+        std::unique_ptr<FBXGeometry> read(readFBX(model, QVariantHash(), fileName));
+        compareGeometries(*expected, *read);
+    }
+}
+
+void FBXReaderTests::benchmarkLoad() {
+    const int NUM_LOADS = 10;
+
+    QStringList fileNames = getTestFileNames();
+    if (fileNames.isEmpty()) {
+        QSKIP("No test models");
+    }
+    foreach (const QString& fileName, fileNames) {
+        QByteArray model = readTestFile(fileName);
+
+        quint64 start = usecTimestampNow();
+        for (int i = 0; i < NUM_LOADS; i++) {
+            QBuffer buffer(&model);
+            buffer.open(QIODevice::ReadOnly);
+            parseFBX(&buffer);
+        }
+        quint64 streamUsecs = usecTimestampNow() - start;
+        start = usecTimestampNow();
+        for (int i = 0; i < NUM_LOADS; i++) {
+            parseBinaryFBX(model.constData(), model.size());
+        }
+        quint64 binaryUsecs = usecTimestampNow() - start;
+
+        start = usecTimestampNow();
+        for (int i = 0; i < NUM_LOADS; i++) {
+            QFile file(fileName);
+            file.open(QIODevice::ReadOnly);
+            delete readFBX(&file, QVariantHash(), fileName);
+        }
+        quint64 mappedUsecs = usecTimestampNow() - start;
+        start = usecTimestampNow();
+        for (int i = 0; i < NUM_LOADS; i++) {
+            QBuffer buffer(&model);
+            buffer.open(QIODevice::ReadOnly);
+            delete extractFBXGeometry(parseFBX(&buffer), QVariantHash(), fileName);
+        }
+        quint64 legacyUsecs = usecTimestampNow() - start;
+
+        qint64 baselinePeakKB = measurePeakResidentKB(fileName, "none");
+        qint64 mappedPeakKB = measurePeakResidentKB(fileName, "mapped");
+        qint64 legacyPeakKB = measurePeakResidentKB(fileName, "stream");
+
+        qDebug() << QFileInfo(fileName).fileName() << model.size() / 1024 << "KB";
+        qDebug() << "  Parse: stream" << streamUsecs / NUM_LOADS << "usecs, in place" << binaryUsecs / NUM_LOADS << "usecs";
+        qDebug() << "  Load: stream" << legacyUsecs / NUM_LOADS << "usecs, mapped" << mappedUsecs / NUM_LOADS << "usecs";
+        qDebug() << "  Peak resident of a load: stream" << legacyPeakKB - baselinePeakKB << "KB, mapped"
+            << mappedPeakKB - baselinePeakKB << "KB, over" << baselinePeakKB << "KB";
+    }
+}
+
+void FBXReaderTests::measurePeakResident() {
+    QString fileName = QString::fromLocal8Bit(qgetenv(PEAK_FILE_VARIABLE));
+    if (fileName.isEmpty()) {
+        QSKIP("Run by benchmarkLoad");
+    }
+    QByteArray load = qgetenv(PEAK_LOAD_VARIABLE);
+    if (load == "mapped") {
+        QFile file(fileName);
+        QVERIFY(file.open(QIODevice::ReadOnly));
+        delete readFBX(&file, QVariantHash(), fileName);
+
+    } else if (load == "stream") {
+        QByteArray model = readTestFile(fileName);
+        QBuffer buffer(&model);
+        buffer.open(QIODevice::ReadOnly);
+        delete extractFBXGeometry(parseFBX(&buffer), QVariantHash(), fileName);
+    }
+    std::cout << PEAK_OUTPUT_PREFIX.constData() << getPeakResidentKB() << std::endl;
+}
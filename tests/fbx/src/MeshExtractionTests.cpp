@@ -0,0 +1,151 @@
+//
+//  MeshExtractionTests.cpp
+//  tests/fbx/src
+//
+//  Copyright 2015 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "MeshExtractionTests.h"
+
+#include <algorithm>
+#include <memory>
+
+#include <tbb/task_arena.h>
+
+#include <FBXReader.h>
+#include <VertexIndexTable.h>
+
+QTEST_MAIN(MeshExtractionTests)
+
+static Vertex makeVertex(int originalIndex, const glm::vec2& texCoord, const glm::vec2& texCoord1 = glm::vec2()) {
+    Vertex vertex = { originalIndex, texCoord, texCoord1 };
+    return vertex;
+}
+
+void MeshExtractionTests::testVertexIndexTable() {
+    VertexIndexTable table;
+    QCOMPARE(table.insert(makeVertex(0, glm::vec2(0.0f, 0.0f)), 0), 0);
+    QCOMPARE(table.insert(makeVertex(1, glm::vec2(0.5f, 0.0f)), 1), 1);
+
+    // the same vertex keeps its index, whatever index it is offered
+    QCOMPARE(table.insert(makeVertex(0, glm::vec2(0.0f, 0.0f)), 2), 0);
+    QCOMPARE(table.insert(makeVertex(1, glm::vec2(0.5f, 0.0f)), 2), 1);
+
+    // on a seam, the same original vertex with other texture coordinates is another vertex
+    QCOMPARE(table.insert(makeVertex(0, glm::vec2(1.0f, 0.0f)), 2), 2);
+    QCOMPARE(table.insert(makeVertex(0, glm::vec2(0.0f, 0.0f), glm::vec2(0.25f, 0.0f)), 3), 3);
+    QCOMPARE(table.insert(makeVertex(0, glm::vec2(1.0f, 0.0f)), 4), 2);
+
+    // -0.0 equals 0.0, so it has to find the same vertex
+    QCOMPARE(table.insert(makeVertex(0, glm::vec2(-0.0f, 0.0f)), 4), 0);
+}
+
+void MeshExtractionTests::testVertexIndexTableGrows() {
+    const int NUM_ORIGINAL_VERTICES = 1000;
+    const int NUM_SEAMS = 3;
+
+    // starting small, so that the table is rehashed many times while it fills
+    VertexIndexTable table;
+    table.reserve(1);
+    int nextIndex = 0;
+    for (int seam = 0; seam < NUM_SEAMS; seam++) {
+        for (int i = 0; i < NUM_ORIGINAL_VERTICES; i++) {
+            QCOMPARE(table.insert(makeVertex(i, glm::vec2((float)seam, 0.0f)), nextIndex), nextIndex);
+            nextIndex++;
+        }
+    }
+    for (int seam = 0; seam < NUM_SEAMS; seam++) {
+        for (int i = 0; i < NUM_ORIGINAL_VERTICES; i++) {
+            QCOMPARE(table.insert(makeVertex(i, glm::vec2((float)seam, 0.0f)), nextIndex), seam * NUM_ORIGINAL_VERTICES + i);
+        }
+    }
+}
+
+static QStringList getTestFileNames() {
+    QDir path(__FILE__);
+    path.cdUp();
+    QStringList fileNames;
+    for (const char* name : { "defaultAvatar/head.fbx", "defaultAvatar/body.fbx", "defaultAvatar_full/defaultAvatar_full.fbx" }) {
+        QString fileName = path.cleanPath(path.absoluteFilePath(QString("../../../interface/resources/meshes/") + name));
+        if (QFileInfo(fileName).exists()) {
+            fileNames.append(fileName);
+        }
+    }
+    return fileNames;
+}
+
+static void compareMeshes(const FBXMesh& actual, const FBXMesh& expected) {
+    QCOMPARE(actual.meshIndex, expected.meshIndex);
+
+    // the vertices in the same order, which is the order they were found by the index remap
+    QCOMPARE(actual.vertices, expected.vertices);
+    QCOMPARE(actual.normals, expected.normals);
+    QCOMPARE(actual.tangents, expected.tangents);
+    QCOMPARE(actual.colors, expected.colors);
+    QCOMPARE(actual.texCoords, expected.texCoords);
+    QCOMPARE(actual.texCoords1, expected.texCoords1);
+
+    // the remapped indices of the parts
+    QCOMPARE(actual.parts.size(), expected.parts.size());
+    for (int i = 0; i < expected.parts.size(); i++) {
+        QCOMPARE(actual.parts.at(i).materialID, expected.parts.at(i).materialID);
+        QCOMPARE(actual.parts.at(i).quadIndices, expected.parts.at(i).quadIndices);
+        QCOMPARE(actual.parts.at(i).triangleIndices, expected.parts.at(i).triangleIndices);
+    }
+
+    QCOMPARE(actual.clusterIndices, expected.clusterIndices);
+    QCOMPARE(actual.clusterWeights, expected.clusterWeights);
+    QCOMPARE(actual.clusters.size(), expected.clusters.size());
+    for (int i = 0; i < expected.clusters.size(); i++) {
+        QCOMPARE(actual.clusters.at(i).jointIndex, expected.clusters.at(i).jointIndex);
+        QVERIFY(actual.clusters.at(i).inverseBindMatrix == expected.clusters.at(i).inverseBindMatrix);
+    }
+
+    QCOMPARE(actual.blendshapes.size(), expected.blendshapes.size());
+    for (int i = 0; i < expected.blendshapes.size(); i++) {
+        QCOMPARE(actual.blendshapes.at(i).indices, expected.blendshapes.at(i).indices);
+        QCOMPARE(actual.blendshapes.at(i).vertices, expected.blendshapes.at(i).vertices);
+        QCOMPARE(actual.blendshapes.at(i).normals, expected.blendshapes.at(i).normals);
+    }
+
+    QCOMPARE(actual.isEye, expected.isEye);
+    QVERIFY(actual.modelTransform == expected.modelTransform);
+    QVERIFY(actual.meshExtents.minimum == expected.meshExtents.minimum);
+    QVERIFY(actual.meshExtents.maximum == expected.meshExtents.maximum);
+}
+
+void MeshExtractionTests::testParallelMatchesSerial() {
+    QStringList fileNames = getTestFileNames();
+    if (fileNames.isEmpty()) {
+        QSKIP("No test models");
+    }
+    int maxMeshes = 0;
+    foreach (const QString& fileName, fileNames) {
+        QFile file(fileName);
+        QVERIFY(file.open(QIODevice::ReadOnly));
+        QByteArray model = file.readAll();
+
+        // an arena with room for the calling thread only, so the meshes are extracted one after the other
+        std::unique_ptr<FBXGeometry> serial;
+        tbb::task_arena arena(1);
+        arena.execute([&] {
+            serial.reset(readFBX(model, QVariantHash(), fileName));
+        });
+        std::unique_ptr<FBXGeometry> parallel(readFBX(model, QVariantHash(), fileName));
+
+        QCOMPARE(parallel->meshes.size(), serial->meshes.size());
+        for (int i = 0; i < serial->meshes.size(); i++) {
+            compareMeshes(parallel->meshes.at(i), serial->meshes.at(i));
+        }
+        QCOMPARE(parallel->meshIndicesToModelNames, serial->meshIndicesToModelNames);
+        QCOMPARE(parallel->leftEyeSize, serial->leftEyeSize);
+        QCOMPARE(parallel->rightEyeSize, serial->rightEyeSize);
+        maxMeshes = std::max(maxMeshes, serial->meshes.size());
+    }
+
+    // the order of the meshes only shows with more than one
+    QVERIFY(maxMeshes > 1);
+}
@@ -0,0 +1,24 @@
+//
+//  MeshExtractionTests.h
+//  tests/fbx/src
+//
+//  Copyright 2015 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_MeshExtractionTests_h
+#define hifi_MeshExtractionTests_h
+
+#include <QtTest/QtTest>
+
+class MeshExtractionTests : public QObject {
+    Q_OBJECT
+private slots:
+    void testVertexIndexTable();
+    void testVertexIndexTableGrows();
+    void testParallelMatchesSerial();
+};
+
+#endif // hifi_MeshExtractionTests_h
@@ -0,0 +1,346 @@
+//
+//  BatchOptimizerTests.cpp
+//  tests/gpu/src
+//
+//  Copyright 2015 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "BatchOptimizerTests.h"
+
+#include <map>
+
+#include <gpu/BatchOptimizer.h>
+
+QTEST_MAIN(BatchOptimizerTests)
+
+using namespace gpu;
+
+static PipelinePointer makePipeline(const std::string& vertexCode) {
+    auto vertexShader = ShaderPointer(Shader::createVertex(vertexCode));
+    auto pixelShader = ShaderPointer(Shader::createPixel(std::string("void main() { gl_FragColor = vec4(1.0); }")));
+    auto program = ShaderPointer(Shader::createProgram(vertexShader, pixelShader));
+    return PipelinePointer(Pipeline::create(program, std::make_shared<State>()));
+}
+
+static PipelinePointer makeInstancingPipeline() {
+    return makePipeline("void main() { gl_Position = gl_Vertex; }");
+}
+
+static PipelinePointer makeInstanceIDPipeline() {
+    return makePipeline("void main() { gl_Position = gl_Vertex + vec4(float(gl_InstanceID)); }");
+}
+
+static std::vector<Batch::Command> getCommands(const Batch& batch) {
+    return std::vector<Batch::Command>(batch.getCommands().begin(), batch.getCommands().end());
+}
+
+void BatchOptimizerTests::testRedundantState() {
+    auto pipeline = makeInstancingPipeline();
+    auto format = std::make_shared<Stream::Format>();
+    auto buffer = std::make_shared<Buffer>();
+    auto texture = TexturePointer(Texture::create2D(Element(VEC4, UINT8, RGBA), 1, 1));
+
+    Batch batch;
+    batch.setPipeline(pipeline);
+    batch.setPipeline(pipeline);                    // removed
+    batch.setInputFormat(format);
+    batch.setInputFormat(format);                   // removed
+    batch.setInputBuffer(0, buffer, 0, 12);
+    batch.setInputBuffer(0, buffer, 0, 12);         // removed
+    batch.setInputBuffer(0, buffer, 12, 12);
+    batch.setInputBuffer(1, buffer, 12, 12);
+    batch.setUniformBuffer(0, buffer, 0, 64);
+    batch.setUniformBuffer(0, buffer, 0, 64);       // removed
+    batch.setUniformBuffer(0, buffer, 64, 64);
+    batch.setResourceTexture(0, texture);
+    batch.setResourceTexture(0, texture);           // removed
+    batch.setResourceTexture(1, texture);
+    batch.setResourceTexture(1, TexturePointer());
+    batch.setResourceTexture(1, TexturePointer());  // removed
+    batch.drawIndexed(TRIANGLES, 3, 0);
+    batch.setPipeline(pipeline);                    // removed
+    batch.setResourceTexture(0, texture);           // removed
+    batch.drawIndexed(TRIANGLES, 3, 0);
+    batch.resetStages();
+    batch.setPipeline(pipeline);                    // the backend state is unknown again
+    batch.setResourceTexture(0, texture);
+    batch._glActiveBindTexture(0, 0, 0);
+    batch.setResourceTexture(0, texture);           // bound behind the backend
+
+    auto stats = BatchOptimizer::optimize(batch);
+
+    QCOMPARE(stats._numRemovedPipelines, 2);
+    QCOMPARE(stats._numRemovedInputFormats, 1);
+    QCOMPARE(stats._numRemovedInputBuffers, 1);
+    QCOMPARE(stats._numRemovedUniformBuffers, 1);
+    QCOMPARE(stats._numRemovedResourceTextures, 3);
+    QCOMPARE(stats._numCoalescedDraws, 0);
+    QCOMPARE(stats.getNumRemovedCommands(), 8);
+
+    std::vector<Batch::Command> expected = {
+        Batch::COMMAND_setPipeline,
+        Batch::COMMAND_setInputFormat,
+        Batch::COMMAND_setInputBuffer,
+        Batch::COMMAND_setInputBuffer,
+        Batch::COMMAND_setInputBuffer,
+        Batch::COMMAND_setUniformBuffer,
+        Batch::COMMAND_setUniformBuffer,
+        Batch::COMMAND_setResourceTexture,
+        Batch::COMMAND_setResourceTexture,
+        Batch::COMMAND_setResourceTexture,
+        Batch::COMMAND_drawIndexed,
+        Batch::COMMAND_drawIndexed,
+        Batch::COMMAND_resetStages,
+        Batch::COMMAND_setPipeline,
+        Batch::COMMAND_setResourceTexture,
+        Batch::COMMAND_glActiveBindTexture,
+        Batch::COMMAND_setResourceTexture,
+    };
+    QVERIFY(getCommands(batch) == expected);
+    QCOMPARE(batch.getCommands().size(), batch.getCommandOffsets().size());
+
+    // the kept commands still point at their params
+    QCOMPARE(batch._params[batch._commandOffsets[4] + 1]._uint, (uint32)12);
+    QCOMPARE(batch._params[batch._commandOffsets[6] + 1]._uint, (uint32)64);
+}
+
+void BatchOptimizerTests::testCoalesceDraws() {
+    auto pipeline = makeInstancingPipeline();
+    auto texture = TexturePointer(Texture::create2D(Element(VEC4, UINT8, RGBA), 1, 1));
+
+    {
+        // the redundant state between the draws goes first, then the draws merge
+        Batch batch;
+        batch.setPipeline(pipeline);
+        for (int i = 0; i < 3; i++) {
+            batch.setResourceTexture(0, texture);
+            batch.draw(TRIANGLES, 36, 6);
+        }
+        batch.drawInstanced(2, TRIANGLES, 36, 6);
+        batch.draw(TRIANGLES, 36, 0);                   // not the same draw
+
+        auto stats = BatchOptimizer::optimize(batch);
+        QCOMPARE(stats._numRemovedResourceTextures, 2);
+        QCOMPARE(stats._numCoalescedDraws, 3);
+
+        std::vector<Batch::Command> expected = {
+            Batch::COMMAND_setPipeline,
+            Batch::COMMAND_setResourceTexture,
+            Batch::COMMAND_drawInstanced,
+            Batch::COMMAND_draw,
+        };
+        QVERIFY(getCommands(batch) == expected);
+        const Batch::Param* params = batch._params.data() + batch._commandOffsets[2];
+        QCOMPARE(params[0]._uint, (uint32)0);       // start instance
+        QCOMPARE(params[1]._uint, (uint32)6);       // start vertex
+        QCOMPARE(params[2]._uint, (uint32)36);      // vertices
+        QCOMPARE(params[3]._uint, (uint32)TRIANGLES);
+        QCOMPARE(params[4]._uint, (uint32)5);       // instances
+    }
+    {
+        // anything else kept between the draws can change what they draw
+        Batch batch;
+        batch.setPipeline(pipeline);
+        batch.draw(TRIANGLES, 3, 0);
+        batch.setModelTransform(Transform());
+        batch.draw(TRIANGLES, 3, 0);
+        batch._glUniform1f(0, 1.0f);
+        batch.draw(TRIANGLES, 3, 0);
+        batch.setResourceTexture(0, texture);
+        batch.draw(TRIANGLES, 3, 0);
+
+        auto stats = BatchOptimizer::optimize(batch);
+        QCOMPARE(stats.getNumRemovedCommands(), 0);
+        QCOMPARE((int)batch.getCommands().size(), 8);
+    }
+    {
+        // nor when the shaders read the instance id, or the pipeline isn't known
+        Batch batch;
+        batch.draw(TRIANGLES, 3, 0);
+        batch.draw(TRIANGLES, 3, 0);
+        batch.setPipeline(makeInstanceIDPipeline());
+        batch.draw(TRIANGLES, 3, 0);
+        batch.draw(TRIANGLES, 3, 0);
+        batch.setPipeline(PipelinePointer());
+        batch.draw(TRIANGLES, 3, 0);
+        batch.draw(TRIANGLES, 3, 0);
+
+        auto stats = BatchOptimizer::optimize(batch);
+        QCOMPARE(stats.getNumRemovedCommands(), 0);
+        QCOMPARE((int)batch.getCommands().size(), 8);
+    }
+}
+
+// What a draw sees of the state, replayed from the commands like the backend does
+class DrawState {
+public:
+    typedef std::pair<const void*, std::pair<uint32, uint32>> BufferBinding;
+
+    const void* _pipeline = nullptr;
+    const void* _format = nullptr;
+    std::map<uint32, BufferBinding> _inputBuffers;
+    std::map<uint32, BufferBinding> _uniformBuffers;
+    std::map<uint32, const void*> _textures;
+    glm::vec3 _model;
+    float _uniform = 0.0f;
+    uint32 _primitive = 0;
+    uint32 _numVertices = 0;
+    uint32 _startVertex = 0;
+
+    bool operator==(const DrawState& other) const {
+        return _pipeline == other._pipeline && _format == other._format && _inputBuffers == other._inputBuffers &&
+            _uniformBuffers == other._uniformBuffers && _textures == other._textures && _model == other._model &&
+            _uniform == other._uniform && _primitive == other._primitive && _numVertices == other._numVertices &&
+            _startVertex == other._startVertex;
+    }
+};
+
+static std::vector<DrawState> replay(Batch& batch) {
+    std::vector<DrawState> draws;
+    DrawState state;
+    for (size_t i = 0; i < batch._commands.size(); i++) {
+        const Batch::Param* params = batch._params.data() + batch._commandOffsets[i];
+        switch (batch._commands[i]) {
+            case Batch::COMMAND_setPipeline:
+                state._pipeline = batch._pipelines.get(params[0]._uint).get();
+                break;
+            case Batch::COMMAND_setInputFormat:
+                state._format = batch._streamFormats.get(params[0]._uint).get();
+                break;
+            case Batch::COMMAND_setInputBuffer:
+                state._inputBuffers[params[3]._uint] = DrawState::BufferBinding(batch._buffers.get(params[2]._uint).get(),
+                    std::make_pair(params[1]._uint, params[0]._uint));
+                break;
+            case Batch::COMMAND_setUniformBuffer:
+                state._uniformBuffers[params[3]._uint] = DrawState::BufferBinding(batch._buffers.get(params[2]._uint).get(),
+                    std::make_pair(params[1]._uint, params[0]._uint));
+                break;
+            case Batch::COMMAND_setResourceTexture:
+                state._textures[params[1]._uint] = batch._textures.get(params[0]._uint).get();
+                break;
+            case Batch::COMMAND_setModelTransform:
+                state._model = batch._transforms.get(params[0]._uint).getTranslation();
+                break;
+            case Batch::COMMAND_glUniform1f:
+                state._uniform = params[0]._float;
+                break;
+            case Batch::COMMAND_resetStages:
+                state = DrawState();
+                break;
+            case Batch::COMMAND_draw:
+                state._startVertex = params[0]._uint;
+                state._numVertices = params[1]._uint;
+                state._primitive = params[2]._uint;
+                draws.push_back(state);
+                break;
+            case Batch::COMMAND_drawInstanced:
+                state._startVertex = params[1]._uint;
+                state._numVertices = params[2]._uint;
+                state._primitive = params[3]._uint;
+                for (uint32 instance = 0; instance < params[4]._uint; instance++) {
+                    draws.push_back(state);
+                }
+                break;
+            default:
+                break;
+        }
+    }
+    return draws;
+}
+
+class Objects {
+public:
+    std::vector<PipelinePointer> pipelines;
+    std::vector<Stream::FormatPointer> formats;
+    std::vector<BufferPointer> buffers;
+    std::vector<TexturePointer> textures;
+
+    Objects() {
+        pipelines = { makeInstancingPipeline(), makeInstancingPipeline(), makeInstanceIDPipeline(), PipelinePointer() };
+        formats = { std::make_shared<Stream::Format>(), std::make_shared<Stream::Format>() };
+        buffers = { std::make_shared<Buffer>(), std::make_shared<Buffer>(), BufferPointer() };
+        for (int i = 0; i < 3; i++) {
+            textures.push_back(TexturePointer(Texture::create2D(Element(VEC4, UINT8, RGBA), 1, 1)));
+        }
+        textures.push_back(TexturePointer());
+    }
+};
+
+// few objects and slots, so that the same states come back often
+static void recordRandomBatch(Batch& batch, const Objects& objects, unsigned int seed, int numCommands) {
+    srand(seed);
+    for (int i = 0; i < numCommands; i++) {
+        switch (rand() % 12) {
+            case 0:
+                batch.setPipeline(objects.pipelines[rand() % objects.pipelines.size()]);
+                break;
+            case 1:
+                batch.setInputFormat(objects.formats[rand() % objects.formats.size()]);
+                break;
+            case 2:
+                batch.setInputBuffer(rand() % 2, objects.buffers[rand() % objects.buffers.size()], 16 * (rand() % 2), 12);
+                break;
+            case 3:
+                batch.setUniformBuffer(rand() % 2, objects.buffers[rand() % objects.buffers.size()], 0, 64 * (1 + rand() % 2));
+                break;
+            case 4:
+            case 5:
+                batch.setResourceTexture(rand() % 3, objects.textures[rand() % objects.textures.size()]);
+                break;
+            case 6:
+                batch.setModelTransform(Transform().setTranslation(glm::vec3((float)(rand() % 2))));
+                break;
+            case 7:
+                batch._glUniform1f(0, (float)(rand() % 2));
+                break;
+            case 8:
+            case 9:
+                batch.draw(TRIANGLES, 3, 3 * (rand() % 2));
+                break;
+            case 10:
+                batch.drawInstanced(1 + rand() % 3, TRIANGLES, 3, 3 * (rand() % 2));
+                break;
+            case 11:
+                if (rand() % 10 == 0) {
+                    batch.resetStages();
+                }
+                break;
+        }
+    }
+}
+
+void BatchOptimizerTests::testOptimizedBatchDrawsTheSame() {
+    const int NUM_BATCHES = 200;
+    const int NUM_COMMANDS = 1000;
+
+    Objects objects;
+    BatchOptimizer::Stats totalStats;
+    int totalCommands = 0;
+    for (int i = 0; i < NUM_BATCHES; i++) {
+        Batch expected;
+        recordRandomBatch(expected, objects, i, NUM_COMMANDS);
+        Batch batch;
+        recordRandomBatch(batch, objects, i, NUM_COMMANDS);
+
+        size_t numCommands = batch.getCommands().size();
+        auto stats = BatchOptimizer::optimize(batch);
+        QCOMPARE((int)(numCommands - batch.getCommands().size()), stats.getNumRemovedCommands());
+
+        auto expectedDraws = replay(expected);
+        auto draws = replay(batch);
+        QCOMPARE(draws.size(), expectedDraws.size());
+        QVERIFY(draws == expectedDraws);
+
+        totalStats += stats;
+        totalCommands += (int)numCommands;
+    }
+
+    QVERIFY(totalStats._numRemovedPipelines > 0);
+    QVERIFY(totalStats._numRemovedResourceTextures > 0);
+    QVERIFY(totalStats._numCoalescedDraws > 0);
+    qDebug() << "Removed" << totalStats.getNumRemovedCommands() << "of" << totalCommands << "commands,"
+             << totalStats._numCoalescedDraws << "by merging draws";
+}
@@ -0,0 +1,24 @@
+//
+//  BatchOptimizerTests.h
+//  tests/gpu/src
+//
+//  Copyright 2015 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_BatchOptimizerTests_h
+#define hifi_BatchOptimizerTests_h
+
+#include <QtTest/QtTest>
+
+class BatchOptimizerTests : public QObject {
+    Q_OBJECT
+private slots:
+    void testRedundantState();
+    void testCoalesceDraws();
+    void testOptimizedBatchDrawsTheSame();
+};
+
+#endif // hifi_BatchOptimizerTests_h
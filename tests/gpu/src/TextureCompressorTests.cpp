@@ -0,0 +1,187 @@
+//
+//  TextureCompressorTests.cpp
+//  tests/gpu/src
+//
+//  Copyright 2015 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "TextureCompressorTests.h"
+
+#include <algorithm>
+#include <cmath>
+#include <memory>
+#include <thread>
+
+#include <gpu/TextureCompressor.h>
+#include <NumericalConstants.h>
+#include <SharedUtil.h>
+
+QTEST_MAIN(TextureCompressorTests)
+
+using namespace gpu;
+
+// Smooth gradients with some noise and sharp edges, the way diffuse maps look, and an alpha ramp with a cut out
+static TextureCompressor::Image makeImage(uint16 width, uint16 height) {
+    TextureCompressor::Image image(width, height, width * height * TextureCompressor::RGBA_TEXEL_SIZE);
+    Byte* texel = image._bytes.data();
+    for (uint16 y = 0; y < height; y++) {
+        for (uint16 x = 0; x < width; x++) {
+            float u = (float)x / width;
+            float v = (float)y / height;
+            int noise = (int)(randFloat() * 8.0f);
+            bool isStripe = ((x / 32) % 4) == 0;
+            texel[0] = (Byte)std::min(255, (int)(u * 200.0f) + noise + (isStripe ? 40 : 0));
+            texel[1] = (Byte)std::min(255, (int)(v * 220.0f) + noise);
+            texel[2] = (Byte)std::min(255, (int)((1.0f - u) * v * 255.0f) + noise);
+            texel[3] = (u < 0.1f) ? 0 : (Byte)(v * 255.0f);
+            texel += TextureCompressor::RGBA_TEXEL_SIZE;
+        }
+    }
+    return image;
+}
+
+static float evalPSNR(const TextureCompressor::Image& expected, const TextureCompressor::Image& actual,
+                      int firstChannel, int numChannels) {
+    double squaredError = 0.0;
+    for (size_t i = 0; i < expected._bytes.size(); i += TextureCompressor::RGBA_TEXEL_SIZE) {
+        for (int c = firstChannel; c < firstChannel + numChannels; c++) {
+            double error = (double)expected._bytes[i + c] - actual._bytes[i + c];
+            squaredError += error * error;
+        }
+    }
+    double meanSquaredError = squaredError / (expected._width * expected._height * numChannels);
+    const double PERFECT_PSNR = 100.0;
+    return (meanSquaredError == 0.0) ? PERFECT_PSNR : (float)(10.0 * log10(255.0 * 255.0 / meanSquaredError));
+}
+
+void TextureCompressorTests::testMipChain() {
+    auto mips = TextureCompressor::generateMips(makeImage(64, 16));
+    QCOMPARE((int)mips.size(), 7);
+    for (size_t level = 0; level < mips.size(); level++) {
+        QCOMPARE((int)mips[level]._width, std::max(64 >> level, 1));
+        QCOMPARE((int)mips[level]._height, std::max(16 >> level, 1));
+        QCOMPARE((int)mips[level]._bytes.size(), mips[level]._width * mips[level]._height * 4);
+    }
+
+    // a checkerboard filters down to its average
+    TextureCompressor::Image checkerboard(8, 8, 8 * 8 * 4);
+    for (int i = 0; i < 8 * 8; i++) {
+        Byte value = ((i % 8 + i / 8) % 2) ? 255 : 0;
+        std::fill(&checkerboard._bytes[i * 4], &checkerboard._bytes[i * 4 + 4], value);
+    }
+    auto checkerMips = TextureCompressor::generateMips(checkerboard);
+    for (Byte value : checkerMips[1]._bytes) {
+        QCOMPARE((int)value, 128);
+    }
+}
+
+void TextureCompressorTests::testCompressedSizes() {
+    Element bc1 = TextureCompressor::getCompressedFormat(false);
+    Element bc3 = TextureCompressor::getCompressedFormat(true);
+    QVERIFY(bc1.isCompressed() && bc3.isCompressed());
+    QVERIFY(!Element::COLOR_RGBA_32.isCompressed());
+
+    QCOMPARE((int)TextureCompressor::compress(makeImage(16, 8), bc1)._bytes.size(), 8 * 8);
+    QCOMPARE((int)TextureCompressor::compress(makeImage(16, 8), bc3)._bytes.size(), 8 * 16);
+
+    // the small mips take a whole block
+    QCOMPARE((int)Texture::evalImageSize(2, 1, 1, bc1), 8);
+    QCOMPARE((int)TextureCompressor::compress(makeImage(2, 1), bc3)._bytes.size(), 16);
+
+    QVERIFY(TextureCompressor::isCompressible(256, 64));
+    QVERIFY(!TextureCompressor::isCompressible(256, 66));
+}
+
+void TextureCompressorTests::testCompressionQuality() {
+    const float MIN_COLOR_PSNR = 33.0f;
+    const float MIN_ALPHA_PSNR = 38.0f;
+
+    TextureCompressor::Image image = makeImage(256, 256);
+    for (bool hasAlpha : { false, true }) {
+        Element format = TextureCompressor::getCompressedFormat(hasAlpha);
+        TextureCompressor::Image decompressed = TextureCompressor::decompress(TextureCompressor::compress(image, format), format);
+        float colorPSNR = evalPSNR(image, decompressed, 0, 3);
+        QVERIFY2(colorPSNR > MIN_COLOR_PSNR, qPrintable(QString("color PSNR %1").arg(colorPSNR)));
+        if (hasAlpha) {
+            float alphaPSNR = evalPSNR(image, decompressed, 3, 1);
+            QVERIFY2(alphaPSNR > MIN_ALPHA_PSNR, qPrintable(QString("alpha PSNR %1").arg(alphaPSNR)));
+        } else {
+            for (size_t i = 3; i < decompressed._bytes.size(); i += 4) {
+                QCOMPARE((int)decompressed._bytes[i], 255);
+            }
+        }
+    }
+
+    // two color blocks are exact up to the 565 quantization, whatever the axis of their colors
+    TextureCompressor::Image twoColors(4, 4, 4 * 4 * 4);
+    for (int i = 0; i < 16; i++) {
+        Byte* texel = &twoColors._bytes[i * 4];
+        bool isFirst = (i % 3) == 0;
+        texel[0] = isFirst ? 248 : 0;
+        texel[1] = isFirst ? 0 : 252;
+        texel[2] = 132;
+        texel[3] = 255;
+    }
+    Element bc1 = TextureCompressor::getCompressedFormat(false);
+    TextureCompressor::Image decompressed = TextureCompressor::decompress(TextureCompressor::compress(twoColors, bc1), bc1);
+    for (size_t i = 0; i < decompressed._bytes.size(); i++) {
+        QVERIFY(std::abs(decompressed._bytes[i] - twoColors._bytes[i]) <= 4);
+    }
+}
+
+void TextureCompressorTests::testCreateTexture() {
+    Element format = TextureCompressor::getCompressedFormat(true);
+    auto mips = TextureCompressor::compress(TextureCompressor::generateMips(makeImage(64, 32)), format);
+    std::unique_ptr<Texture> texture(TextureCompressor::createTexture(mips, format));
+    QVERIFY(texture);
+    QVERIFY(texture->getTexelFormat() == format);
+    QVERIFY(!texture->isAutogenerateMips());
+    QCOMPARE((int)texture->maxMip(), (int)mips.size() - 1);
+    QCOMPARE((int)texture->getSize(), 16 * 8 * 16);
+    for (uint16 level = 0; level < mips.size(); level++) {
+        QVERIFY(texture->isStoredMipFaceAvailable(level));
+        QCOMPARE((int)texture->getStoredMipSize(level), (int)mips[level]._bytes.size());
+    }
+}
+
+void TextureCompressorTests::benchmarkCompression() {
+    const uint16 SIZE = 2048;
+    const int NUM_RUNS = 3;
+    TextureCompressor::Image image = makeImage(SIZE, SIZE);
+    float megatexels = (float)SIZE * SIZE / (1024.0f * 1024.0f);
+
+    quint64 mipUsecs = 0;
+    quint64 bc1Usecs = 0;
+    quint64 bc3Usecs = 0;
+    Element bc1 = TextureCompressor::getCompressedFormat(false);
+    Element bc3 = TextureCompressor::getCompressedFormat(true);
+    TextureCompressor::MipChain compressed;
+    for (int i = 0; i < NUM_RUNS; i++) {
+        quint64 start = usecTimestampNow();
+        auto mips = TextureCompressor::generateMips(image);
+        quint64 mipped = usecTimestampNow();
+        TextureCompressor::compress(mips, bc1);
+        quint64 compressedBC1 = usecTimestampNow();
+        compressed = TextureCompressor::compress(mips, bc3);
+        mipUsecs += mipped - start;
+        bc1Usecs += compressedBC1 - mipped;
+        bc3Usecs += usecTimestampNow() - compressedBC1;
+    }
+    TextureCompressor::Image decompressed = TextureCompressor::decompress(compressed[0], bc3);
+
+    size_t uncompressedSize = 0;
+    size_t compressedSize = 0;
+    for (const auto& mip : compressed) {
+        compressedSize += mip._bytes.size();
+        uncompressedSize += mip._width * mip._height * TextureCompressor::RGBA_TEXEL_SIZE;
+    }
+    qDebug() << "Mips:" << mipUsecs / NUM_RUNS << "usecs for" << megatexels << "megatexels";
+    qDebug() << "BC1:" << megatexels * NUM_RUNS * USECS_PER_SECOND / bc1Usecs << "megatexels per second";
+    qDebug() << "BC3:" << megatexels * NUM_RUNS * USECS_PER_SECOND / bc3Usecs << "megatexels per second,"
+             << std::thread::hardware_concurrency() << "hardware threads";
+    qDebug() << "BC3 PSNR:" << evalPSNR(image, decompressed, 0, 3) << "dB color," << evalPSNR(image, decompressed, 3, 1)
+             << "dB alpha," << compressedSize << "bytes instead of" << uncompressedSize;
+}
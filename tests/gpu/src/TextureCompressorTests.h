@@ -0,0 +1,26 @@
+//
+//  TextureCompressorTests.h
+//  tests/gpu/src
+//
+//  Copyright 2015 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_TextureCompressorTests_h
+#define hifi_TextureCompressorTests_h
+
+#include <QtTest/QtTest>
+
+class TextureCompressorTests : public QObject {
+    Q_OBJECT
+private slots:
+    void testMipChain();
+    void testCompressedSizes();
+    void testCompressionQuality();
+    void testCreateTexture();
+    void benchmarkCompression();
+};
+
+#endif // hifi_TextureCompressorTests_h
@@ -0,0 +1,180 @@
+//
+//  ResourceDiskCacheTests.cpp
+//  tests/networking/src
+//
+//  Copyright 2015 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "ResourceDiskCacheTests.h"
+
+#include <QTemporaryDir>
+
+#include "CachedReply.h"
+#include "ResourceDiskCache.h"
+
+QTEST_MAIN(ResourceDiskCacheTests)
+
+static ResourceDiskCache::Content makeContent(const QByteArray& data, const QByteArray& etag) {
+    ResourceDiskCache::Content content;
+    content.data = data;
+    content.contentType = "text/plain";
+    content.etag = etag;
+    return content;
+}
+
+void ResourceDiskCacheTests::testStoreLoad() {
+    QTemporaryDir directory;
+    ResourceDiskCache cache(directory.path());
+    QByteArray data;
+    QVERIFY(!cache.load("entry", data));
+
+    QVERIFY(cache.store("entry", "some data"));
+    QVERIFY(cache.contains("entry"));
+    QVERIFY(cache.load("entry", data));
+    QCOMPARE(data, QByteArray("some data"));
+    QCOMPARE(cache.getSize(), (qint64)9);
+
+    // storing again replaces the entry
+    QVERIFY(cache.store("entry", "more"));
+    QCOMPARE(cache.getSize(), (qint64)4);
+    QCOMPARE(cache.getEntryCount(), 1);
+
+    cache.remove("entry");
+    QVERIFY(!cache.contains("entry"));
+    QVERIFY(!cache.load("entry", data));
+    QCOMPARE(cache.getSize(), (qint64)0);
+}
+
+void ResourceDiskCacheTests::testEviction() {
+    QTemporaryDir directory;
+    ResourceDiskCache cache(directory.path(), 30);
+    QByteArray data(10, 'x');
+    QVERIFY(cache.store("first", data));
+    QVERIFY(cache.store("second", data));
+    QVERIFY(cache.store("third", data));
+
+    // using the first entry makes the second the least recently used
+    QVERIFY(cache.load("first", data));
+    QVERIFY(cache.store("fourth", data));
+    QVERIFY(cache.contains("first"));
+    QVERIFY(!cache.contains("second"));
+    QVERIFY(cache.contains("third"));
+    QVERIFY(cache.contains("fourth"));
+    QCOMPARE(cache.getSize(), (qint64)30);
+
+    // an entry larger than the cache stays until the next one
+    QVERIFY(cache.store("large", QByteArray(100, 'x')));
+    QCOMPARE(cache.getEntryCount(), 1);
+    QVERIFY(cache.contains("large"));
+
+    cache.setMaximumSize(0);
+    QVERIFY(cache.contains("large"));
+    cache.clear();
+    QCOMPARE(cache.getEntryCount(), 0);
+}
+
+void ResourceDiskCacheTests::testIndex() {
+    QTemporaryDir directory;
+    QByteArray data(10, 'x');
+    {
+        ResourceDiskCache cache(directory.path());
+        QVERIFY(cache.store("first", data));
+        QVERIFY(cache.store("second", data));
+        QVERIFY(cache.load("first", data));
+    }
+
+    // the order of use survives the cache, and the files the index doesn't know of are the oldest
+    QVERIFY(ResourceDiskCache(directory.path()).store("third", data));
+    QFile unknown(directory.path() + "/unknown");
+    QVERIFY(unknown.open(QIODevice::WriteOnly));
+    unknown.write(data);
+    unknown.close();
+
+    ResourceDiskCache cache(directory.path(), 20);
+    QCOMPARE(cache.getEntryCount(), 4);
+    QCOMPARE(cache.getSize(), (qint64)40);
+    QVERIFY(cache.store("fourth", QByteArray()));
+    QVERIFY(!cache.contains("unknown"));
+    QVERIFY(!cache.contains("second"));
+    QVERIFY(cache.contains("first"));
+    QVERIFY(cache.contains("third"));
+}
+
+void ResourceDiskCacheTests::testContent() {
+    QTemporaryDir directory;
+    ResourceDiskCache cache(directory.path());
+    QUrl url("http://example.com/model.fbx");
+    QUrl mirror("http://mirror.example.com/model.fbx");
+    ResourceDiskCache::Content content;
+    QVERIFY(!cache.hasContent(url));
+    QVERIFY(!cache.loadContent(url, content));
+
+    // content without validators isn't kept
+    QVERIFY(!cache.storeContent(url, makeContent("model", QByteArray())));
+    QVERIFY(!cache.hasContent(url));
+
+    QVERIFY(cache.storeContent(url, makeContent("model", "\"1\"")));
+    QVERIFY(cache.hasContent(url));
+    QVERIFY(cache.loadContent(url, content));
+    QCOMPARE(content.data, QByteArray("model"));
+    QCOMPARE(content.contentType, QByteArray("text/plain"));
+    QCOMPARE(content.etag, QByteArray("\"1\""));
+
+    // the URLs of the same content share it
+    QVERIFY(cache.storeContent(mirror, makeContent("model", "\"2\"")));
+    QCOMPARE(cache.getEntryCount(), 3);
+
+    cache.removeContent(url);
+    QVERIFY(!cache.hasContent(url));
+    QVERIFY(cache.loadContent(mirror, content));
+    QCOMPARE(content.data, QByteArray("model"));
+    QCOMPARE(content.etag, QByteArray("\"2\""));
+}
+
+void ResourceDiskCacheTests::testCorruptContent() {
+    QTemporaryDir directory;
+    ResourceDiskCache cache(directory.path());
+    QUrl url("http://example.com/texture.png");
+    QVERIFY(cache.storeContent(url, makeContent("texture", "\"1\"")));
+
+    QFile file(directory.path() + "/" + ResourceDiskCache::getContentHash("texture") + ".content");
+    QVERIFY(file.open(QIODevice::WriteOnly));
+    file.write("damaged");
+    file.close();
+
+    ResourceDiskCache::Content content;
+    QVERIFY(!cache.loadContent(url, content));
+    QVERIFY(!cache.hasContent(url));
+    QCOMPARE(cache.getEntryCount(), 0);
+}
+
+void ResourceDiskCacheTests::testCachedReply() {
+    QTemporaryDir directory;
+    QSharedPointer<ResourceDiskCache> cache(new ResourceDiskCache(directory.path()));
+    QUrl url("http://example.com/sound.wav");
+    ResourceDiskCache::Content stored = makeContent("sound", "\"1\"");
+    stored.lastModified = "Mon, 01 Jun 2015 00:00:00 GMT";
+    QVERIFY(cache->storeContent(url, stored));
+
+    // the reply finishes like a download does
+    CachedReply reply((QNetworkRequest(url)), cache);
+    QSignalSpy finished(&reply, SIGNAL(finished()));
+    QVERIFY(finished.wait());
+    QCOMPARE(reply.error(), QNetworkReply::NoError);
+    QCOMPARE(reply.attribute(QNetworkRequest::HttpStatusCodeAttribute).toInt(), 200);
+    QVERIFY(reply.attribute(QNetworkRequest::SourceIsFromCacheAttribute).toBool());
+    QCOMPARE(reply.rawHeader("ETag"), stored.etag);
+    QCOMPARE(reply.rawHeader("Last-Modified"), stored.lastModified);
+    QCOMPARE(ResourceDiskCache::Content::fromReply(&reply).data, stored.data);
+    QCOMPARE(reply.readAll(), stored.data);
+
+    // and fails like one when the content is gone
+    cache->removeContent(url);
+    CachedReply missing((QNetworkRequest(url)), cache);
+    QSignalSpy missingFinished(&missing, SIGNAL(finished()));
+    QVERIFY(missingFinished.wait());
+    QCOMPARE(missing.error(), QNetworkReply::ContentNotFoundError);
+}
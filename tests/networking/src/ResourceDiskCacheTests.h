@@ -0,0 +1,27 @@
+//
+//  ResourceDiskCacheTests.h
+//  tests/networking/src
+//
+//  Copyright 2015 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_ResourceDiskCacheTests_h
+#define hifi_ResourceDiskCacheTests_h
+
+#include <QtTest/QtTest>
+
+class ResourceDiskCacheTests : public QObject {
+    Q_OBJECT
+private slots:
+    void testStoreLoad();
+    void testEviction();
+    void testIndex();
+    void testContent();
+    void testCorruptContent();
+    void testCachedReply();
+};
+
+#endif // hifi_ResourceDiskCacheTests_h
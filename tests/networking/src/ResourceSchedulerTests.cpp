@@ -0,0 +1,203 @@
+//
+//  ResourceSchedulerTests.cpp
+//  tests/networking/src
+//
+//  Copyright 2015 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "ResourceSchedulerTests.h"
+
+#include <QMutex>
+#include <QSemaphore>
+
+#include "DependencyManager.h"
+#include "ResourceCache.h"
+
+QTEST_MAIN(ResourceSchedulerTests)
+
+// Records the order in which the decodes run, the first one possibly holding the others back until released
+class TestDecode : public QRunnable {
+public:
+    TestDecode(int id, QList<int>& order, QMutex& mutex, QSemaphore* gate = nullptr, bool* deleted = nullptr) :
+        _id(id), _order(order), _mutex(mutex), _gate(gate), _deleted(deleted) { }
+
+    virtual ~TestDecode() {
+        if (_deleted) {
+            *_deleted = true;
+        }
+    }
+
+    virtual void run() {
+        if (_gate) {
+            _gate->acquire();
+        }
+        QMutexLocker locker(&_mutex);
+        _order.append(_id);
+    }
+
+private:
+    int _id;
+    QList<int>& _order;
+    QMutex& _mutex;
+    QSemaphore* _gate;
+    bool* _deleted;
+};
+
+// Resources without a URL, which never make a request, at 2, 10 and 100 meters from the origin
+class TestResources {
+public:
+    TestResources() : close(QUrl()), middle(QUrl()), distant(QUrl()) {
+        close.setLoadBounds(&owner, glm::vec3(2.0f, 0.0f, 0.0f), 1.0f);
+        middle.setLoadBounds(&owner, glm::vec3(10.0f, 0.0f, 0.0f), 1.0f);
+        distant.setLoadBounds(&owner, glm::vec3(100.0f, 0.0f, 0.0f), 1.0f);
+    }
+
+    QObject owner;
+    Resource close;
+    Resource middle;
+    Resource distant;
+};
+
+void ResourceSchedulerTests::initTestCase() {
+    DependencyManager::set<ResourceCacheSharedItems>();
+}
+
+void ResourceSchedulerTests::testScore() {
+    glm::vec3 view(0.0f, 0.0f, 0.0f);
+    QCOMPARE(ResourceScheduler::evalScore(view, glm::vec3(0.5f, 0.0f, 0.0f), 1.0f), 1.0f);
+    QCOMPARE(ResourceScheduler::evalScore(view, glm::vec3(0.0f, 4.0f, 0.0f), 1.0f), 0.25f);
+    QCOMPARE(ResourceScheduler::evalScore(view, glm::vec3(0.0f, 0.0f, 8.0f), 2.0f), 0.25f);
+    QVERIFY(ResourceScheduler::evalScore(view, glm::vec3(0.0f, 0.0f, 100.0f), 1.0f) <
+            ResourceScheduler::evalScore(view, glm::vec3(0.0f, 0.0f, 10.0f), 1.0f));
+
+    // the priority follows the view
+    TestResources resources;
+    ResourceCache::getScheduler().beginFrame(glm::vec3(0.0f, 0.0f, 0.0f));
+    QVERIFY(resources.close.getLoadPriority() > resources.distant.getLoadPriority());
+    ResourceCache::getScheduler().beginFrame(glm::vec3(99.0f, 0.0f, 0.0f));
+    QCOMPARE(resources.distant.getLoadPriority(), 1.0f);
+    QVERIFY(resources.close.getLoadPriority() < resources.distant.getLoadPriority());
+}
+
+void ResourceSchedulerTests::testWithoutFrames() {
+    ResourceScheduler scheduler;
+    QVERIFY(!scheduler.isFrameDriven());
+    for (int i = 0; i < 2 * scheduler.getRequestsPerFrame(); i++) {
+        QVERIFY(scheduler.takeRequest());
+    }
+    bool uploaded = false;
+    scheduler.queueUpload(nullptr, 2 * scheduler.getUploadBytesPerFrame(), [&] { uploaded = true; });
+    QVERIFY(uploaded);
+}
+
+void ResourceSchedulerTests::testRequestBudget() {
+    ResourceScheduler scheduler;
+    scheduler.setRequestsPerFrame(3);
+    for (int frame = 0; frame < 2; frame++) {
+        scheduler.beginFrame(glm::vec3(0.0f, 0.0f, 0.0f));
+        for (int i = 0; i < 3; i++) {
+            QVERIFY(scheduler.takeRequest());
+        }
+        QVERIFY(!scheduler.takeRequest());
+    }
+}
+
+void ResourceSchedulerTests::testUploadBudget() {
+    ResourceCache::getScheduler().beginFrame(glm::vec3(0.0f, 0.0f, 0.0f));
+    TestResources resources;
+    ResourceScheduler scheduler;
+    scheduler.setUploadBytesPerFrame(100);
+    scheduler.beginFrame(glm::vec3(0.0f, 0.0f, 0.0f));
+
+    QStringList uploads;
+    scheduler.queueUpload(&resources.distant, 100, [&] { uploads << "first"; });
+    scheduler.queueUpload(&resources.distant, 60, [&] { uploads << "far"; });
+    scheduler.queueUpload(&resources.close, 60, [&] { uploads << "close"; });
+    scheduler.queueUpload(&resources.middle, 60, [&] { uploads << "mid"; });
+    QCOMPARE(uploads, QStringList() << "first");
+    QCOMPARE(scheduler.getQueuedUploadCount(), 3);
+
+    scheduler.beginFrame(glm::vec3(0.0f, 0.0f, 0.0f));
+    QCOMPARE(uploads, QStringList() << "first" << "close");
+    scheduler.beginFrame(glm::vec3(0.0f, 0.0f, 0.0f));
+    scheduler.beginFrame(glm::vec3(0.0f, 0.0f, 0.0f));
+    QCOMPARE(uploads, QStringList() << "first" << "close" << "mid" << "far");
+    QCOMPARE(scheduler.getQueuedUploadCount(), 0);
+
+    // an upload larger than the budget gets a frame of its own
+    scheduler.queueUpload(&resources.close, 1000, [&] { uploads << "large"; });
+    QCOMPARE(uploads.size(), 4);
+    scheduler.beginFrame(glm::vec3(0.0f, 0.0f, 0.0f));
+    QCOMPARE(uploads.last(), QString("large"));
+    QCOMPARE(scheduler.getFrameUploadedBytes(), (qint64)1000);
+}
+
+void ResourceSchedulerTests::testDecodeOrder() {
+    ResourceCache::getScheduler().beginFrame(glm::vec3(0.0f, 0.0f, 0.0f));
+    TestResources resources;
+    ResourceScheduler scheduler;
+    scheduler.setDecodeLimit(ResourceScheduler::TEXTURE_DECODE, 1);
+
+    QList<int> order;
+    QMutex mutex;
+    QSemaphore gate;
+    scheduler.startDecode(&resources.distant, ResourceScheduler::TEXTURE_DECODE, new TestDecode(0, order, mutex, &gate));
+    scheduler.startDecode(&resources.distant, ResourceScheduler::TEXTURE_DECODE, new TestDecode(3, order, mutex));
+    scheduler.startDecode(&resources.close, ResourceScheduler::TEXTURE_DECODE, new TestDecode(1, order, mutex));
+    scheduler.startDecode(&resources.middle, ResourceScheduler::TEXTURE_DECODE, new TestDecode(2, order, mutex));
+    QCOMPARE(scheduler.getRunningDecodeCount(ResourceScheduler::TEXTURE_DECODE), 1);
+    QCOMPARE(scheduler.getQueuedDecodeCount(ResourceScheduler::TEXTURE_DECODE), 3);
+
+    // the other kinds have budgets of their own
+    scheduler.startDecode(&resources.distant, ResourceScheduler::SOUND_DECODE, new TestDecode(4, order, mutex));
+    QTRY_COMPARE(scheduler.getRunningDecodeCount(ResourceScheduler::SOUND_DECODE), 0);
+
+    gate.release();
+    QTRY_COMPARE(scheduler.getRunningDecodeCount(ResourceScheduler::TEXTURE_DECODE), 0);
+    QCOMPARE(order, QList<int>() << 4 << 0 << 1 << 2 << 3);
+}
+
+void ResourceSchedulerTests::testCancel() {
+    TestResources resources;
+    ResourceScheduler scheduler;
+    scheduler.setDecodeLimit(ResourceScheduler::GEOMETRY_DECODE, 1);
+
+    QList<int> order;
+    QMutex mutex;
+    QSemaphore gate;
+    bool cancelledDeleted = false;
+    bool releasedDeleted = false;
+    scheduler.startDecode(&resources.close, ResourceScheduler::GEOMETRY_DECODE, new TestDecode(0, order, mutex, &gate));
+    scheduler.startDecode(&resources.middle, ResourceScheduler::GEOMETRY_DECODE,
+        new TestDecode(1, order, mutex, nullptr, &cancelledDeleted));
+    Resource* released = new Resource(QUrl());
+    scheduler.startDecode(released, ResourceScheduler::GEOMETRY_DECODE,
+        new TestDecode(2, order, mutex, nullptr, &releasedDeleted));
+    scheduler.startDecode(&resources.distant, ResourceScheduler::GEOMETRY_DECODE, new TestDecode(3, order, mutex));
+
+    bool uploaded = false;
+    scheduler.beginFrame(glm::vec3(0.0f, 0.0f, 0.0f));
+    scheduler.queueUpload(&resources.close, scheduler.getUploadBytesPerFrame(), [] { });
+    scheduler.queueUpload(&resources.middle, 1, [&] { uploaded = true; });
+
+    // cancelling drops the queued work, and reports the running work it can't stop
+    QVERIFY(scheduler.cancel(&resources.middle));
+    QVERIFY(cancelledDeleted);
+    QCOMPARE(scheduler.getQueuedUploadCount(), 0);
+    QVERIFY(scheduler.cancel(&resources.close));
+    QVERIFY(!scheduler.cancel(&resources.middle));
+
+    // the work of the resources that went away is dropped when its turn comes
+    delete released;
+    gate.release();
+    QTRY_COMPARE(scheduler.getRunningDecodeCount(ResourceScheduler::GEOMETRY_DECODE), 0);
+    QCOMPARE(scheduler.getQueuedDecodeCount(ResourceScheduler::GEOMETRY_DECODE), 0);
+    QVERIFY(releasedDeleted);
+    QCOMPARE(order, QList<int>() << 0 << 3);
+
+    scheduler.beginFrame(glm::vec3(0.0f, 0.0f, 0.0f));
+    QVERIFY(!uploaded);
+}
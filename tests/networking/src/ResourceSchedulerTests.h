@@ -0,0 +1,28 @@
+//
+//  ResourceSchedulerTests.h
+//  tests/networking/src
+//
+//  Copyright 2015 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_ResourceSchedulerTests_h
+#define hifi_ResourceSchedulerTests_h
+
+#include <QtTest/QtTest>
+
+class ResourceSchedulerTests : public QObject {
+    Q_OBJECT
+private slots:
+    void initTestCase();
+    void testScore();
+    void testWithoutFrames();
+    void testRequestBudget();
+    void testUploadBudget();
+    void testDecodeOrder();
+    void testCancel();
+};
+
+#endif // hifi_ResourceSchedulerTests_h
@@ -8,6 +8,10 @@
 //
 
 #include <QNetworkDiskCache>
+#include <QTcpServer>
+#include <QTcpSocket>
+#include <QTemporaryDir>
+#include <QThreadPool>
 
 #include "ResourceCache.h"
 #include "NetworkAccessManager.h"
@@ -93,3 +97,133 @@ void ResourceTests::downloadAgain() {
     QVERIFY(resource->isLoaded());
 
 }
+
+// A local stand-in for an HTTP server with a single resource, which answers the requests matching its ETag with a 304
+class HttpStandIn {
+public:
+    HttpStandIn() {
+        _server.listen(QHostAddress::LocalHost);
+        QObject::connect(&_server, &QTcpServer::newConnection, [this] {
+            while (QTcpSocket* socket = _server.nextPendingConnection()) {
+                QObject::connect(socket, &QTcpSocket::readyRead, [this, socket] { respond(socket); });
+                QObject::connect(socket, &QTcpSocket::disconnected, socket, &QObject::deleteLater);
+            }
+        });
+    }
+
+    QUrl getURL() const { return QUrl(QString("http://127.0.0.1:%1/resource.txt").arg(_server.serverPort())); }
+
+    QByteArray content;
+    QByteArray etag;
+
+    int requestCount = 0;
+    QByteArray lastIfNoneMatch;
+
+private:
+    void respond(QTcpSocket* socket) {
+        QByteArray& request = _requests[socket];
+        request += socket->readAll();
+        int end = request.indexOf("\r\n\r\n");
+        if (end == -1) {
+            return;
+        }
+        QByteArray ifNoneMatch;
+        foreach (const QByteArray& line, request.left(end).split('\n')) {
+            int colon = line.indexOf(':');
+            if (colon != -1 && line.left(colon).trimmed().toLower() == "if-none-match") {
+                ifNoneMatch = line.mid(colon + 1).trimmed();
+            }
+        }
+        _requests.remove(socket);
+        requestCount++;
+        lastIfNoneMatch = ifNoneMatch;
+
+        QByteArray response;
+        if (!ifNoneMatch.isEmpty() && ifNoneMatch == etag) {
+            response = "HTTP/1.1 304 Not Modified\r\nETag: " + etag + "\r\nConnection: close\r\n\r\n";
+        } else {
+            response = "HTTP/1.1 200 OK\r\nContent-Type: text/plain\r\nETag: " + etag + "\r\nContent-Length: " +
+                QByteArray::number(content.size()) + "\r\nConnection: close\r\n\r\n" + content;
+        }
+        socket->write(response);
+        socket->disconnectFromHost();
+    }
+
+    QTcpServer _server;
+    QHash<QTcpSocket*, QByteArray> _requests;
+};
+
+static const int STAND_IN_TIMEOUT_MS = 5000;
+
+// Downloads the resource once, so that both the disk cache and the HTTP cache of the network access manager have it
+static void downloadToCaches(const QUrl& url) {
+    Resource* download = new Resource(url, false);
+    QVERIFY(waitForSignal(download, SIGNAL(loaded(QNetworkReply&)), STAND_IN_TIMEOUT_MS));
+    QThreadPool::globalInstance()->waitForDone();
+    QVERIFY(ResourceCache::getDiskCache()->hasContent(url));
+    delete download;
+}
+
+void ResourceTests::revalidateUnchanged() {
+    HttpStandIn server;
+    server.content = "unchanged";
+    server.etag = "\"1\"";
+    QTemporaryDir directory;
+    ResourceCache::setDiskCache(QSharedPointer<ResourceDiskCache>(new ResourceDiskCache(directory.path())));
+    downloadToCaches(server.getURL());
+    QCOMPARE(server.requestCount, 1);
+
+    // loads from the disk, then checks with the server, whose 304 the HTTP cache turns into its cached 200
+    Resource* resource = new Resource(server.getURL(), false);
+    QList<QByteArray> loads;
+    QObject::connect(resource, &Resource::loaded, [&](QNetworkReply& reply) {
+        loads.append(reply.peek(reply.bytesAvailable()));
+    });
+    QTRY_COMPARE_WITH_TIMEOUT(server.requestCount, 2, STAND_IN_TIMEOUT_MS);
+    QCOMPARE(server.lastIfNoneMatch, server.etag);
+
+    // and stays loaded
+    const int SETTLE_MS = 500;
+    QTest::qWait(SETTLE_MS);
+    QCOMPARE(server.requestCount, 2);
+    QCOMPARE(loads, QList<QByteArray>() << "unchanged");
+    QVERIFY(resource->isLoaded());
+
+    delete resource;
+    ResourceCache::setDiskCache(QSharedPointer<ResourceDiskCache>());
+}
+
+void ResourceTests::revalidateChanged() {
+    HttpStandIn server;
+    server.content = "before";
+    server.etag = "\"1\"";
+    QTemporaryDir directory;
+    ResourceCache::setDiskCache(QSharedPointer<ResourceDiskCache>(new ResourceDiskCache(directory.path())));
+    downloadToCaches(server.getURL());
+
+    server.content = "after";
+    server.etag = "\"2\"";
+
+    // loads the old content from the disk, gets the new one when checking with the server, and loads again, once
+    Resource* resource = new Resource(server.getURL(), false);
+    QList<QByteArray> loads;
+    QObject::connect(resource, &Resource::loaded, [&](QNetworkReply& reply) {
+        loads.append(reply.peek(reply.bytesAvailable()));
+    });
+    QTRY_COMPARE_WITH_TIMEOUT(loads.size(), 2, STAND_IN_TIMEOUT_MS);
+    QTRY_COMPARE_WITH_TIMEOUT(server.requestCount, 3, STAND_IN_TIMEOUT_MS);
+    QCOMPARE(server.lastIfNoneMatch, server.etag);
+
+    const int SETTLE_MS = 500;
+    QTest::qWait(SETTLE_MS);
+    QCOMPARE(server.requestCount, 3);
+    QCOMPARE(loads, QList<QByteArray>() << "before" << "after");
+
+    ResourceDiskCache::Content content;
+    QVERIFY(ResourceCache::getDiskCache()->loadContent(server.getURL(), content));
+    QCOMPARE(content.data, QByteArray("after"));
+    QCOMPARE(content.etag, server.etag);
+
+    delete resource;
+    ResourceCache::setDiskCache(QSharedPointer<ResourceDiskCache>());
+}
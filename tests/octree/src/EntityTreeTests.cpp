@@ -0,0 +1,89 @@
+//
+//  EntityTreeTests.cpp
+//  tests/octree/src
+//
+//  Copyright 2015 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "EntityTreeTests.h"
+
+#include <glm/gtc/matrix_transform.hpp>
+
+#include <EntityTree.h>
+#include <EntityTreeElement.h>
+#include <NodeList.h>
+#include <OctreePacketData.h>
+#include <SharedUtil.h>
+#include <udt/PacketHeaders.h>
+#include <render/SpatialTree.h>
+
+QTEST_MAIN(EntityTreeTests)
+
+void EntityTreeTests::initTestCase() {
+    // the entities read from the buffers check whether this node owns their simulation
+    DependencyManager::set<NodeList>(NodeType::Unassigned);
+}
+
+void EntityTreeTests::movedByServerUpdate() {
+    const glm::vec3 START(10.0f, 0.0f, 0.0f);
+    const glm::vec3 DESTINATION(-50.0f, 20.0f, 30.0f);
+    EntityItemID entityID(QUuid::createUuid());
+    EntityItemProperties properties;
+    properties.setType(EntityTypes::Box);
+    properties.setPosition(START);
+    properties.setDimensions(glm::vec3(1.0f));
+
+    // the client's copy of the entity, with a render item where it starts
+    EntityTree tree;
+    tree.setTrackMovedEntities(true);
+    EntityItemPointer entity = tree.addEntity(entityID, properties);
+    QVERIFY(entity);
+    entity->clearDirtyFlags();
+    QSet<EntityItemID> movedEntities;
+    tree.takeMovedEntities(movedEntities);
+
+    const render::ItemID ITEM_ID = 0;
+    const render::ItemKey ITEM_KEY = render::ItemKey::Builder::opaqueShape().build();
+    render::ItemSpatialTree spatialTree;
+    spatialTree.update(ITEM_ID, ITEM_KEY, entity->getAABox());
+
+    // the entity server's copy, moved since
+    EntityTree serverTree;
+    serverTree.setIsServer(true);
+    properties.setPosition(DESTINATION);
+    EntityItemPointer serverEntity = serverTree.addEntity(entityID, properties);
+    QVERIFY(serverEntity);
+    serverEntity->setLastEdited(usecTimestampNow());
+
+    OctreePacketData packetData;
+    EncodeBitstreamParams encodeParams;
+    EntityTreeElementExtraEncodeData extraEncodeData;
+    QVERIFY(packetData.appendValue((uint16_t)1));
+    QCOMPARE(serverEntity->appendEntityData(&packetData, encodeParams, &extraEncodeData), OctreeElement::COMPLETED);
+
+    ReadBitstreamToTreeParams readParams;
+    readParams.bitstreamVersion = versionForPacketType(PacketType::EntityData);
+    EntityTreeElement* element = tree.getContainingElement(entityID);
+    QVERIFY(element);
+    element->readElementDataFromBuffer(packetData.getUncompressedData(), packetData.getUncompressedSize(), readParams);
+    QVERIFY(entity->getPosition() == DESTINATION);
+
+    // the moved entity is noted, so its render item follows it, as EntityTreeRenderer::moveEntitiesInScene does
+    tree.takeMovedEntities(movedEntities);
+    QVERIFY(movedEntities.contains(entityID));
+    spatialTree.update(ITEM_ID, ITEM_KEY, entity->getAABox());
+
+    ViewFrustum frustum;
+    frustum.setProjection(glm::perspective(glm::radians(45.0f), 1.0f, 0.1f, 100.0f));
+    frustum.setPosition(DESTINATION + glm::vec3(0.0f, 0.0f, 10.0f));
+    frustum.calculate();
+    render::ItemIDsBounds selected;
+    render::ItemSpatialTree::SelectionStats stats;
+    spatialTree.select(frustum, [](const AABox& bound) { return true; }, render::ItemFilter::Builder::opaqueShape(),
+                       selected, stats);
+    QCOMPARE((int)selected.size(), 1);
+    QCOMPARE(selected.front().id, ITEM_ID);
+}
@@ -0,0 +1,24 @@
+//
+//  EntityTreeTests.h
+//  tests/octree/src
+//
+//  Copyright 2015 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_EntityTreeTests_h
+#define hifi_EntityTreeTests_h
+
+#include <QtTest/QtTest>
+
+class EntityTreeTests : public QObject {
+    Q_OBJECT
+
+private slots:
+    void initTestCase();
+    void movedByServerUpdate();
+};
+
+#endif // hifi_EntityTreeTests_h
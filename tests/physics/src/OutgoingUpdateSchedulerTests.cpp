@@ -0,0 +1,93 @@
+//
+//  OutgoingUpdateSchedulerTests.cpp
+//  tests/physics/src
+//
+//  Copyright 2015 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "OutgoingUpdateSchedulerTests.h"
+
+#include <OutgoingUpdateScheduler.h>
+
+QTEST_MAIN(OutgoingUpdateSchedulerTests)
+
+const int UPDATE_BYTES = 100;
+
+// Queues an update that records its name when it is sent
+static void queueUpdate(OutgoingUpdateScheduler& scheduler, QStringList& sent, const QString& name, float priority,
+                        bool forced = false) {
+    scheduler.queueUpdate(priority, forced, [&sent, name] {
+        sent << name;
+        return UPDATE_BYTES;
+    });
+}
+
+void OutgoingUpdateSchedulerTests::testPriorityOrder() {
+    OutgoingUpdateScheduler scheduler;
+    scheduler.setBytesPerSecond(10 * UPDATE_BYTES);
+    scheduler.beginStep(0.2f);
+    QCOMPARE(scheduler.getBudget(), 2.0f * UPDATE_BYTES);
+
+    QStringList sent;
+    queueUpdate(scheduler, sent, "small", 1.0f);
+    queueUpdate(scheduler, sent, "large", 5.0f);
+    queueUpdate(scheduler, sent, "medium", 2.0f);
+    scheduler.sendUpdates();
+    QCOMPARE(sent, QStringList() << "large" << "medium");
+    QCOMPARE(scheduler.getNumSentUpdates(), 2);
+    QCOMPARE(scheduler.getNumDeferredUpdates(), 1);
+    QCOMPARE(scheduler.getSentBytes(), 2 * UPDATE_BYTES);
+
+    // the dropped update isn't sent later unless queued again
+    sent.clear();
+    scheduler.beginStep(0.2f);
+    scheduler.sendUpdates();
+    QVERIFY(sent.isEmpty());
+    QCOMPARE(scheduler.getNumDeferredUpdates(), 0);
+}
+
+void OutgoingUpdateSchedulerTests::testForcedUpdates() {
+    OutgoingUpdateScheduler scheduler;
+    scheduler.setBytesPerSecond(10 * UPDATE_BYTES);
+    scheduler.beginStep(0.1f);
+
+    // the forced updates go first and past the budget, which the next steps pay back
+    QStringList sent;
+    queueUpdate(scheduler, sent, "error", 100.0f);
+    queueUpdate(scheduler, sent, "bid", 0.0f, true);
+    queueUpdate(scheduler, sent, "stop", 0.0f, true);
+    scheduler.sendUpdates();
+    QCOMPARE(sent, QStringList() << "bid" << "stop");
+    QCOMPARE(scheduler.getBudget(), -1.0f * UPDATE_BYTES);
+
+    sent.clear();
+    scheduler.beginStep(0.1f);
+    queueUpdate(scheduler, sent, "error", 100.0f);
+    scheduler.sendUpdates();
+    QVERIFY(sent.isEmpty());
+
+    scheduler.beginStep(0.1f);
+    queueUpdate(scheduler, sent, "error", 100.0f);
+    scheduler.sendUpdates();
+    QCOMPARE(sent, QStringList() << "error");
+}
+
+void OutgoingUpdateSchedulerTests::testBudgetRefill() {
+    OutgoingUpdateScheduler scheduler;
+    scheduler.setBytesPerSecond(10 * UPDATE_BYTES);
+
+    // idle time builds up no more than a short burst
+    scheduler.beginStep(60.0f);
+    QCOMPARE(scheduler.getBudget(), OutgoingUpdateScheduler::MAX_BURST_SECONDS * 10 * UPDATE_BYTES);
+
+    QStringList sent;
+    for (int i = 0; i < 10; i++) {
+        queueUpdate(scheduler, sent, QString::number(i), 1.0f);
+    }
+    scheduler.sendUpdates();
+    QCOMPARE(scheduler.getNumSentUpdates(), 3);
+    QCOMPARE(sent, QStringList() << "0" << "1" << "2");
+}
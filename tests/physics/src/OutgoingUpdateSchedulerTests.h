@@ -0,0 +1,24 @@
+//
+//  OutgoingUpdateSchedulerTests.h
+//  tests/physics/src
+//
+//  Copyright 2015 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_OutgoingUpdateSchedulerTests_h
+#define hifi_OutgoingUpdateSchedulerTests_h
+
+#include <QtTest/QtTest>
+
+class OutgoingUpdateSchedulerTests : public QObject {
+    Q_OBJECT
+private slots:
+    void testPriorityOrder();
+    void testForcedUpdates();
+    void testBudgetRefill();
+};
+
+#endif // hifi_OutgoingUpdateSchedulerTests_h
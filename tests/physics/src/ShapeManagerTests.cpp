@@ -9,8 +9,16 @@
 //  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
 //
 
+#include <cfloat>
 #include <iostream>
+
+#include <QTemporaryDir>
+#include <QThreadPool>
+
+#include <ResourceDiskCache.h>
+#include <ShapeFactory.h>
 #include <ShapeManager.h>
+#include <SharedUtil.h>
 #include <StreamUtils.h>
 
 #include "ShapeManagerTests.h"
@@ -183,3 +191,141 @@ void ShapeManagerTests::addCapsuleShape() {
     QCOMPARE(shape, otherShape);
     */
 }
+
+// A ball of points on the surface, with as many again inside
+static QVector<glm::vec3> makeBall(int numPoints, float radius) {
+    QVector<glm::vec3> points;
+    for (int i = 0; i < numPoints; i++) {
+        glm::vec3 direction = glm::normalize(glm::vec3(randFloat() - 0.5f, randFloat() - 0.5f, randFloat() - 0.5f));
+        points << direction * radius << direction * radius * randFloat();
+    }
+    return points;
+}
+
+static ShapeInfo makeCompoundInfo(const QVector<QVector<glm::vec3>>& hulls) {
+    ShapeInfo info;
+    info.setParams(SHAPE_TYPE_COMPOUND, glm::vec3(1.0f), "http://example.com/hulls.obj");
+    info.setConvexHulls(hulls);
+    return info;
+}
+
+void ShapeManagerTests::simplifyHull() {
+    // the inside points go
+    QVector<glm::vec3> cube;
+    for (int i = 0; i < 8; i++) {
+        cube << glm::vec3(i & 1 ? 1.0f : -1.0f, i & 2 ? 1.0f : -1.0f, i & 4 ? 1.0f : -1.0f);
+    }
+    QVector<glm::vec3> points = cube;
+    for (int i = 0; i < 100; i++) {
+        points << glm::vec3(randFloat(), randFloat(), randFloat()) - glm::vec3(0.5f);
+    }
+    QVector<glm::vec3> corners = ShapeFactory::simplifyHull(points);
+    QCOMPARE(corners.size(), cube.size());
+    const float EPSILON = 1.0e-3f;
+    foreach (const glm::vec3& corner, cube) {
+        float closest = FLT_MAX;
+        foreach (const glm::vec3& point, corners) {
+            closest = glm::min(closest, glm::distance(corner, point));
+        }
+        QVERIFY(closest < EPSILON);
+    }
+
+    // and the hulls with too many corners keep the most spread out of them
+    const float RADIUS = 2.0f;
+    QVector<glm::vec3> simplified = ShapeFactory::simplifyHull(makeBall(1000, RADIUS));
+    QCOMPARE(simplified.size(), ShapeFactory::MAX_HULL_POINTS);
+    foreach (const glm::vec3& point, simplified) {
+        QVERIFY(fabsf(glm::length(point) - RADIUS) < EPSILON);
+    }
+    for (int axis = 0; axis < 3; axis++) {
+        float minimum = FLT_MAX, maximum = -FLT_MAX;
+        foreach (const glm::vec3& point, simplified) {
+            minimum = glm::min(minimum, point[axis]);
+            maximum = glm::max(maximum, point[axis]);
+        }
+        QVERIFY(maximum - minimum > RADIUS * 1.5f);
+    }
+
+    // without keeping any point twice, including on the small hulls
+    QVector<glm::vec3> fewer = ShapeFactory::simplifyHull(cube, 4);
+    QCOMPARE(fewer.size(), 4);
+    foreach (const QVector<glm::vec3>& kept, QVector<QVector<glm::vec3>>() << simplified << fewer) {
+        for (int i = 0; i < kept.size(); i++) {
+            for (int j = i + 1; j < kept.size(); j++) {
+                QVERIFY(kept.at(i) != kept.at(j));
+            }
+        }
+    }
+}
+
+void ShapeManagerTests::addCompoundShape() {
+    QVector<QVector<glm::vec3>> hulls;
+    hulls << makeBall(200, 1.0f) << makeBall(200, 0.5f);
+    ShapeInfo info = makeCompoundInfo(hulls);
+
+    // the shape isn't there until it's built in the background
+    ShapeManager shapeManager;
+    QVERIFY(!shapeManager.getShape(info));
+    QVERIFY(shapeManager.isBuilding(info));
+    QVERIFY(!shapeManager.getShape(info));
+    QCOMPARE(shapeManager.getNumBuilds(), 1);
+
+    btCollisionShape* shape = nullptr;
+    QTRY_VERIFY((shape = shapeManager.getShape(info)) != nullptr);
+    QVERIFY(!shapeManager.isBuilding(info));
+    QCOMPARE(shape->getShapeType(), (int)COMPOUND_SHAPE_PROXYTYPE);
+    btCompoundShape* compound = static_cast<btCompoundShape*>(shape);
+    QCOMPARE(compound->getNumChildShapes(), hulls.size());
+    for (int i = 0; i < compound->getNumChildShapes(); i++) {
+        const btConvexHullShape* hull = static_cast<const btConvexHullShape*>(compound->getChildShape(i));
+        QVERIFY(hull->getNumPoints() <= ShapeFactory::MAX_HULL_POINTS);
+    }
+    QCOMPARE(shapeManager.getNumReferences(info), 1);
+    QCOMPARE(shapeManager.getShape(info), shape);
+    QCOMPARE(shapeManager.getNumReferences(info), 2);
+
+    // and without the background, it's built right away
+    ShapeManager synchronousManager;
+    synchronousManager.setBuildInBackground(false);
+    QVERIFY(synchronousManager.getShape(info));
+    QVERIFY(!synchronousManager.isBuilding(info));
+
+    // the built shapes outlast the garbage collected before they're asked for, and go once released
+    ShapeManager collectingManager;
+    ShapeInfo box;
+    box.setBox(glm::vec3(1.0f));
+    QVERIFY(!collectingManager.getShape(info));
+    QThreadPool::globalInstance()->waitForDone();
+    QVERIFY(collectingManager.getShape(box));
+    collectingManager.collectGarbage();
+    QVERIFY(collectingManager.getShape(info));
+    QCOMPARE(collectingManager.getNumBuilds(), 0);
+    QVERIFY(collectingManager.releaseShape(info));
+    collectingManager.collectGarbage();
+    QCOMPARE(collectingManager.getNumShapes(), 1);
+
+    // a manager that goes away before its shapes are built leaves them to the builders
+    {
+        ShapeManager abandoningManager;
+        QVERIFY(!abandoningManager.getShape(info));
+    }
+    QThreadPool::globalInstance()->waitForDone();
+}
+
+void ShapeManagerTests::cacheSimplifiedHulls() {
+    QTemporaryDir directory;
+    ResourceDiskCache cache(directory.path());
+    QVector<QVector<glm::vec3>> hulls;
+    hulls << makeBall(300, 1.0f) << makeBall(10, 0.5f);
+
+    QVector<QVector<glm::vec3>> simplified = ShapeFactory::simplifyHulls(hulls, &cache);
+    QCOMPARE(cache.getEntryCount(), 1);
+    QCOMPARE(ShapeFactory::simplifyHulls(hulls, &cache), simplified);
+    QCOMPARE(cache.getEntryCount(), 1);
+
+    // other points are simplified apart
+    hulls[1][0] *= 2.0f;
+    QVector<QVector<glm::vec3>> other = ShapeFactory::simplifyHulls(hulls, &cache);
+    QCOMPARE(cache.getEntryCount(), 2);
+    QCOMPARE(other[0], simplified[0]);
+}
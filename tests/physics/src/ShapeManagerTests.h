@@ -24,6 +24,9 @@ private slots:
     void addSphereShape();
     void addCylinderShape();
     void addCapsuleShape();
+    void simplifyHull();
+    void addCompoundShape();
+    void cacheSimplifiedHulls();
 };
 
 #endif // hifi_ShapeManagerTests_h
@@ -0,0 +1,182 @@
+//
+//  ThreadSafeDynamicsWorldTests.cpp
+//  tests/physics/src
+//
+//  Copyright 2015 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "ThreadSafeDynamicsWorldTests.h"
+
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include <NumericalConstants.h>
+#include <SharedUtil.h>
+#include <ThreadSafeDynamicsWorld.h>
+
+QTEST_MAIN(ThreadSafeDynamicsWorldTests)
+
+const float SUBSTEP = 1.0f / 60.0f;
+
+// Stacks of boxes dropped on the ground, in a grid three meters apart, the first two optionally on a kinematic platform
+class Stacks {
+public:
+    Stacks(int numStacks, int height, int numThreads, bool platform = false, bool keepAwake = false);
+    ~Stacks();
+
+    void step(int numSubsteps);
+
+    std::unique_ptr<ThreadSafeDynamicsWorld> world;
+    std::vector<btRigidBody*> boxes;
+
+private:
+    btRigidBody* addBody(btCollisionShape* shape, float mass, const btVector3& position);
+
+    btDefaultCollisionConfiguration _config;
+    btCollisionDispatcher _dispatcher;
+    btDbvtBroadphase _broadphase;
+    btSequentialImpulseConstraintSolver _solver;
+    btBoxShape _box;
+    btBoxShape _platform;
+    btStaticPlaneShape _ground;
+    std::vector<btRigidBody*> _bodies;
+};
+
+Stacks::Stacks(int numStacks, int height, int numThreads, bool platform, bool keepAwake) :
+    _dispatcher(&_config),
+    _box(btVector3(0.5f, 0.5f, 0.5f)),
+    _platform(btVector3(2.5f, 0.5f, 0.5f)),
+    _ground(btVector3(0.0f, 1.0f, 0.0f), 0.0f) {
+
+    world.reset(new ThreadSafeDynamicsWorld(&_dispatcher, &_broadphase, &_solver, &_config));
+    world->setGravity(btVector3(0.0f, -9.8f, 0.0f));
+    world->setNumSolverThreads(numThreads);
+
+    addBody(&_ground, 0.0f, btVector3(0.0f, 0.0f, 0.0f));
+    if (platform) {
+        btRigidBody* body = addBody(&_platform, 0.0f, btVector3(1.5f, -0.5f, 0.0f));
+        body->setCollisionFlags(body->getCollisionFlags() | btCollisionObject::CF_KINEMATIC_OBJECT);
+        body->setActivationState(DISABLE_DEACTIVATION);
+    }
+    const float SPACING = 3.0f;
+    const float GAP = 0.01f;
+    int width = (int)ceilf(sqrtf((float)numStacks));
+    for (int i = 0; i < numStacks; i++) {
+        float x = (i % width) * SPACING;
+        float z = (i / width) * SPACING;
+        for (int j = 0; j < height; j++) {
+            btRigidBody* box = addBody(&_box, 1.0f, btVector3(x, 0.5f + j * (1.0f + GAP), z));
+            if (keepAwake) {
+                box->setActivationState(DISABLE_DEACTIVATION);
+            }
+            boxes.push_back(box);
+        }
+    }
+}
+
+Stacks::~Stacks() {
+    for (auto body : _bodies) {
+        world->removeRigidBody(body);
+        delete body;
+    }
+}
+
+void Stacks::step(int numSubsteps) {
+    for (int i = 0; i < numSubsteps; i++) {
+        world->stepSimulation(SUBSTEP, 1, SUBSTEP);
+    }
+}
+
+btRigidBody* Stacks::addBody(btCollisionShape* shape, float mass, const btVector3& position) {
+    btVector3 inertia(0.0f, 0.0f, 0.0f);
+    if (mass > 0.0f) {
+        shape->calculateLocalInertia(mass, inertia);
+    }
+    btRigidBody* body = new btRigidBody(mass, nullptr, shape, inertia);
+    body->setWorldTransform(btTransform(btQuaternion::getIdentity(), position));
+    world->addRigidBody(body);
+    _bodies.push_back(body);
+    return body;
+}
+
+void ThreadSafeDynamicsWorldTests::testIslands() {
+    const int NUM_STACKS = 9;
+    Stacks stacks(NUM_STACKS, 4, 4);
+    stacks.step(10);
+
+    // the ground is static, so each stack is an island of its own
+    QCOMPARE(stacks.world->getNumSolvedIslands(), NUM_STACKS);
+    QCOMPARE(stacks.world->getNumSolverTasks(), NUM_STACKS);
+
+    // sleeping islands aren't solved
+    stacks.step(300);
+    QCOMPARE(stacks.world->getNumSolvedIslands(), 0);
+
+    // serially, nothing is collected
+    Stacks serial(NUM_STACKS, 4, 1);
+    serial.step(10);
+    QCOMPARE(serial.world->getNumSolvedIslands(), 0);
+}
+
+void ThreadSafeDynamicsWorldTests::testKinematicSharing() {
+    const int NUM_STACKS = 4;
+    Stacks stacks(NUM_STACKS, 3, 4, true);
+    stacks.step(10);
+
+    // the stacks on the kinematic platform are still islands of their own, but they're solved in the same task
+    QCOMPARE(stacks.world->getNumSolvedIslands(), NUM_STACKS);
+    QCOMPARE(stacks.world->getNumSolverTasks(), NUM_STACKS - 1);
+
+    // and they rest on the platform
+    stacks.step(60);
+    QVERIFY(fabsf(stacks.boxes[0]->getWorldTransform().getOrigin().getY() - 0.5f) < 0.05f);
+}
+
+void ThreadSafeDynamicsWorldTests::testParallelMatchesSerial() {
+    const int NUM_STACKS = 16;
+    const int HEIGHT = 5;
+    const int NUM_SUBSTEPS = 90;
+    Stacks serial(NUM_STACKS, HEIGHT, 1, true);
+    Stacks parallel(NUM_STACKS, HEIGHT, 4, true);
+
+    // give the stacks something to do
+    for (size_t i = 0; i < serial.boxes.size(); i += HEIGHT + 1) {
+        btVector3 push(1.0f, 0.0f, 0.5f);
+        serial.boxes[i]->setLinearVelocity(push);
+        parallel.boxes[i]->setLinearVelocity(push);
+    }
+    serial.step(NUM_SUBSTEPS);
+    parallel.step(NUM_SUBSTEPS);
+
+    // the islands don't interact, so solving them apart only changes the order of the work
+    const float EPSILON = 1.0e-3f;
+    for (size_t i = 0; i < serial.boxes.size(); i++) {
+        btVector3 serialPosition = serial.boxes[i]->getWorldTransform().getOrigin();
+        btVector3 parallelPosition = parallel.boxes[i]->getWorldTransform().getOrigin();
+        QVERIFY((serialPosition - parallelPosition).length() < EPSILON);
+    }
+}
+
+void ThreadSafeDynamicsWorldTests::benchmarkStacks() {
+    const int NUM_STACKS = 64;
+    const int HEIGHT = 8;
+    const int NUM_SUBSTEPS = 300;
+
+    std::vector<int> threadCounts = { 1, 2, 4 };
+    int hardwareThreads = (int)std::thread::hardware_concurrency();
+    if (hardwareThreads > threadCounts.back()) {
+        threadCounts.push_back(hardwareThreads);
+    }
+    for (int numThreads : threadCounts) {
+        Stacks stacks(NUM_STACKS, HEIGHT, numThreads, false, true);
+        quint64 start = usecTimestampNow();
+        stacks.step(NUM_SUBSTEPS);
+        quint64 usecs = usecTimestampNow() - start;
+        qDebug() << numThreads << "threads:" << NUM_SUBSTEPS * (float)USECS_PER_SECOND / usecs << "substeps/sec for"
+                 << NUM_STACKS << "stacks of" << HEIGHT << "boxes";
+    }
+}
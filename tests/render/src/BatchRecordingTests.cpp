@@ -0,0 +1,432 @@
+//
+//  BatchRecordingTests.cpp
+//  tests/render/src
+//
+//  Copyright 2015 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "BatchRecordingTests.h"
+
+#include <thread>
+
+#include <SharedUtil.h>
+#include <gpu/Batch.h>
+#include <render/DrawTask.h>
+
+QTEST_MAIN(BatchRecordingTests)
+
+using namespace render;
+
+// A shape recording a few commands of each kind of reference
+class TestShape {
+public:
+    typedef Payload<TestShape> Payload;
+    typedef std::shared_ptr<TestShape> Pointer;
+
+    TestShape(int index, bool concurrent, const gpu::TexturePointer& texture) :
+        index(index), concurrent(concurrent), texture(texture) {}
+
+    int index;
+    bool concurrent;
+    gpu::TexturePointer texture;
+};
+
+namespace render {
+    template <> const ItemKey payloadGetKey(const TestShape::Pointer& shape) {
+        return ItemKey::Builder::opaqueShape();
+    }
+    template <> const Item::Bound payloadGetBound(const TestShape::Pointer& shape) {
+        return AABox(glm::vec3((float)shape->index), 1.0f);
+    }
+    template <> void payloadRender(const TestShape::Pointer& shape, RenderArgs* args) {
+        gpu::Batch& batch = *args->_batch;
+        float value = (float)shape->index;
+
+        Transform transform;
+        transform.setTranslation(glm::vec3(value, 0.0f, 0.0f));
+        batch.setModelTransform(transform);
+        batch.setProjectionTransform(glm::mat4(value));
+        batch.setResourceTexture(0, shape->texture);
+        glm::mat4 matrices[2] = { glm::mat4(value), glm::mat4(-value) };
+        batch._glUniformMatrix4fv(1, 2, false, (const float*)matrices);
+        batch.draw(gpu::TRIANGLES, 3, shape->index);
+
+        args->_details._trianglesRendered++;
+    }
+    template <> bool payloadCanRenderConcurrently(const TestShape::Pointer& shape, const RenderArgs* args) {
+        return shape->concurrent;
+    }
+}
+
+// A shape drawn like the plain box and sphere entities: it only adds its instance to the named buffers of the batch, and
+// records concurrently unless debugging
+class TestInstance {
+public:
+    typedef Payload<TestInstance> Payload;
+    typedef std::shared_ptr<TestInstance> Pointer;
+
+    TestInstance(int index) : index(index) {}
+
+    int index;
+    std::thread::id recordingThread;
+};
+
+namespace render {
+    template <> const ItemKey payloadGetKey(const TestInstance::Pointer& instance) {
+        return ItemKey::Builder::opaqueShape();
+    }
+    template <> const Item::Bound payloadGetBound(const TestInstance::Pointer& instance) {
+        return AABox(glm::vec3((float)instance->index), 1.0f);
+    }
+    template <> void payloadRender(const TestInstance::Pointer& instance, RenderArgs* args) {
+        gpu::Batch& batch = *args->_batch;
+        std::string name = (instance->index % 2) ? "cubes" : "spheres";
+        glm::vec3 translation((float)instance->index);
+        batch.getNamedBuffer(name)->append(sizeof(translation), (const gpu::Byte*)&translation);
+        batch.setupNamedCalls(name, 1, [](gpu::Batch& batch, gpu::Batch::NamedBatchData& data) {
+            batch.drawInstanced(data._count, gpu::TRIANGLES, 3);
+        });
+        instance->recordingThread = std::this_thread::get_id();
+    }
+    template <> bool payloadCanRenderConcurrently(const TestInstance::Pointer& instance, const RenderArgs* args) {
+        return !(args->_debugFlags & RenderArgs::RENDER_DEBUG_SIMULATION_OWNERSHIP);
+    }
+}
+
+static void compareBatches(const gpu::Batch& batch, const gpu::Batch& expected) {
+    QVERIFY(batch._commands == expected._commands);
+    QVERIFY(batch._commandOffsets == expected._commandOffsets);
+    QCOMPARE(batch._params.size(), expected._params.size());
+    for (size_t i = 0; i < batch._params.size(); i++) {
+        QCOMPARE(batch._params[i]._uint, expected._params[i]._uint);
+    }
+    QVERIFY(batch._data == expected._data);
+
+    QCOMPARE(batch._buffers._items.size(), expected._buffers._items.size());
+    for (size_t i = 0; i < batch._buffers._items.size(); i++) {
+        QVERIFY(batch._buffers._items[i]._data == expected._buffers._items[i]._data);
+    }
+    QCOMPARE(batch._textures._items.size(), expected._textures._items.size());
+    for (size_t i = 0; i < batch._textures._items.size(); i++) {
+        QVERIFY(batch._textures._items[i]._data == expected._textures._items[i]._data);
+    }
+    QCOMPARE(batch._transforms._items.size(), expected._transforms._items.size());
+    for (size_t i = 0; i < batch._transforms._items.size(); i++) {
+        QVERIFY(batch._transforms._items[i]._data.getTranslation() == expected._transforms._items[i]._data.getTranslation());
+    }
+    QCOMPARE(batch._framebuffers._items.size(), expected._framebuffers._items.size());
+    QCOMPARE(batch._queries._items.size(), expected._queries._items.size());
+    QCOMPARE(batch._pipelines._items.size(), expected._pipelines._items.size());
+    QCOMPARE(batch._streamFormats._items.size(), expected._streamFormats._items.size());
+}
+
+// records the commands referencing every cache, so appending has something to rebase everywhere
+static void recordEverything(gpu::Batch& batch, int seed) {
+    auto buffer = std::make_shared<gpu::Buffer>();
+    auto texture = gpu::TexturePointer(gpu::Texture::create2D(gpu::Element(gpu::VEC4, gpu::UINT8, gpu::RGBA), 1, 1));
+    auto framebuffer = gpu::FramebufferPointer();
+    auto query = gpu::QueryPointer();
+
+    batch.setViewportTransform(glm::ivec4(seed, 0, 10, 10));
+    batch.setStateScissorRect(glm::ivec4(0, seed, 10, 10));
+    batch.setFramebuffer(framebuffer);
+    batch.setPipeline(gpu::PipelinePointer());
+    batch.setInputFormat(gpu::Stream::FormatPointer());
+    batch.setInputBuffer(0, buffer, seed, 12);
+    batch.setIndexBuffer(gpu::UINT32, buffer, seed);
+    batch.setUniformBuffer(2, buffer, 0, seed);
+    batch.setResourceTexture(3, texture);
+    batch.setViewTransform(Transform().setTranslation(glm::vec3((float)seed)));
+    batch.setModelTransform(Transform().setTranslation(glm::vec3((float)-seed)));
+    batch.setProjectionTransform(glm::mat4((float)seed));
+    float values[8] = { (float)seed, 1.0f, 2.0f, 3.0f, 4.0f, 5.0f, 6.0f, 7.0f };
+    batch._glUniform3fv(1, 2, values);
+    batch._glUniform4fv(2, 2, values);
+    int intValues[4] = { seed, 1, 2, 3 };
+    batch._glUniform4iv(3, 1, intValues);
+    batch.beginQuery(query);
+    batch.drawIndexed(gpu::TRIANGLES, 3 * seed, 0);
+    batch.endQuery(query);
+    batch.getQuery(query);
+    batch.blit(framebuffer, glm::ivec4(0, 0, seed, seed), framebuffer, glm::ivec4(0, 0, 1, 1));
+    batch.clearColorFramebuffer(gpu::Framebuffer::BUFFER_COLOR0, glm::vec4((float)seed));
+    batch._glColor4f(1.0f, 0.0f, (float)seed, 1.0f);
+    batch.resetStages();
+}
+
+void BatchRecordingTests::testAppend() {
+    // recording the same commands twice in one batch must give the same batch as appending two batches
+    gpu::Batch expected;
+    recordEverything(expected, 1);
+    recordEverything(expected, 2);
+    recordEverything(expected, 3);
+
+    gpu::Batch first;
+    recordEverything(first, 1);
+    gpu::Batch second;
+    recordEverything(second, 2);
+    recordEverything(second, 3);
+
+    gpu::Batch merged;
+    merged.append(first);
+    merged.append(second);
+
+    // buffers and textures are created per call, only their positions can be compared
+    QCOMPARE(merged._commands.size(), expected._commands.size());
+    QVERIFY(merged._commands == expected._commands);
+    QVERIFY(merged._commandOffsets == expected._commandOffsets);
+    QCOMPARE(merged._params.size(), expected._params.size());
+    for (size_t i = 0; i < merged._params.size(); i++) {
+        QCOMPARE(merged._params[i]._uint, expected._params[i]._uint);
+    }
+    QVERIFY(merged._data == expected._data);
+    QCOMPARE(merged._buffers.size(), expected._buffers.size());
+    QCOMPARE(merged._textures.size(), expected._textures.size());
+    QCOMPARE(merged._transforms.size(), expected._transforms.size());
+    QCOMPARE(merged._framebuffers.size(), expected._framebuffers.size());
+    QCOMPARE(merged._queries.size(), expected._queries.size());
+    QCOMPARE(merged._pipelines.size(), expected._pipelines.size());
+    QCOMPARE(merged._streamFormats.size(), expected._streamFormats.size());
+
+    // and the objects are the ones of the appended batches
+    QVERIFY(merged._buffers._items.back()._data == second._buffers._items.back()._data);
+    QVERIFY(merged._textures._items.back()._data == second._textures._items.back()._data);
+    QVERIFY(merged._transforms._items.front()._data.getTranslation() == glm::vec3(1.0f));
+
+    // appending to an empty batch is a copy
+    gpu::Batch copy;
+    copy.append(expected);
+    compareBatches(copy, expected);
+}
+
+// one instance of the named call, with its index as the data of the first buffer
+static void recordInstance(gpu::Batch& batch, const std::string& name, int value, std::vector<std::string>& calls) {
+    batch.getNamedBuffer(name)->append(sizeof(value), (const gpu::Byte*)&value);
+    batch.setupNamedCalls(name, 1, [name, &calls](gpu::Batch& batch, gpu::Batch::NamedBatchData& data) {
+        calls.push_back(name);
+        batch.drawInstanced(data._count, gpu::TRIANGLES, 3);
+    });
+}
+
+void BatchRecordingTests::testNamedCalls() {
+    std::vector<std::string> calls;
+    gpu::Batch first;
+    recordInstance(first, "spheres", 0, calls);
+    recordInstance(first, "cubes", 1, calls);
+    recordInstance(first, "spheres", 2, calls);
+    gpu::Batch second;
+    recordInstance(second, "cubes", 3, calls);
+    recordInstance(second, "spheres", 4, calls);
+
+    gpu::Batch merged;
+    merged.append(first);
+    merged.append(second);
+    QVERIFY(merged._commands.empty());
+    QCOMPARE(merged._namedData["spheres"]._count, (gpu::uint32)3);
+    QCOMPARE(merged._namedData["cubes"]._count, (gpu::uint32)2);
+
+    // the instance data of the appended batches follows the data of the batch
+    auto spheres = merged._namedData["spheres"]._buffers[0];
+    QCOMPARE(spheres->getSize(), (gpu::Resource::Size)(3 * sizeof(int)));
+    const int* sphereValues = (const int*)spheres->getData();
+    QCOMPARE(sphereValues[0], 0);
+    QCOMPARE(sphereValues[1], 2);
+    QCOMPARE(sphereValues[2], 4);
+
+    // flushing draws each name once, in the order of the names, and forgets them
+    merged.flushNamedCalls();
+    QVERIFY(calls == std::vector<std::string>({ "cubes", "spheres" }));
+    QCOMPARE(merged._commands.size(), (size_t)2);
+    QCOMPARE(merged._params[merged._commandOffsets[0] + 4]._uint, (gpu::uint32)2);
+    QCOMPARE(merged._params[merged._commandOffsets[1] + 4]._uint, (gpu::uint32)3);
+    QVERIFY(merged._namedData.empty());
+
+    merged.flushNamedCalls();
+    QCOMPARE(merged._commands.size(), (size_t)2);
+}
+
+void BatchRecordingTests::testNamedCallsKeepDrawOrder() {
+    std::vector<std::string> calls;
+    gpu::Batch first;
+    recordInstance(first, "cubes", 0, calls);
+
+    // a blended draw recorded after an instance, which must cover the instances recorded before it
+    gpu::Batch second;
+    recordInstance(second, "cubes", 1, calls);
+    second.flushNamedCalls();
+    second.draw(gpu::TRIANGLES, 3);
+    recordInstance(second, "cubes", 2, calls);
+
+    gpu::Batch merged;
+    merged.append(first);
+    merged.append(second);
+
+    // the instance of the first batch is drawn before the commands of the second one, the last instance stays pending
+    QCOMPARE(merged._commands.size(), (size_t)3);
+    QVERIFY(merged._commands[0] == gpu::Batch::COMMAND_drawInstanced);
+    QCOMPARE(merged._params[merged._commandOffsets[0] + 4]._uint, (gpu::uint32)1);
+    QVERIFY(merged._commands[1] == gpu::Batch::COMMAND_drawInstanced);
+    QCOMPARE(merged._params[merged._commandOffsets[1] + 4]._uint, (gpu::uint32)1);
+    QVERIFY(merged._commands[2] == gpu::Batch::COMMAND_draw);
+    QCOMPARE(merged._namedData["cubes"]._count, (gpu::uint32)1);
+    const int* cubeValues = (const int*)merged._namedData["cubes"]._buffers[0]->getData();
+    QCOMPARE(cubeValues[0], 2);
+
+    // batches that never flushed their named calls still merge all their instances in one draw
+    gpu::Batch third;
+    recordInstance(third, "cubes", 3, calls);
+    merged.append(third);
+    QCOMPARE(merged._commands.size(), (size_t)3);
+    QCOMPARE(merged._namedData["cubes"]._count, (gpu::uint32)2);
+}
+
+static void makeScene(const ScenePointer& scene, int numItems, int serialEvery, ItemIDsBounds& outItems) {
+    auto texture = gpu::TexturePointer(gpu::Texture::create2D(gpu::Element(gpu::VEC4, gpu::UINT8, gpu::RGBA), 1, 1));
+    PendingChanges pendingChanges;
+    for (int i = 0; i < numItems; i++) {
+        bool concurrent = (serialEvery == 0) || (i % serialEvery != 0);
+        auto shape = std::make_shared<TestShape>(i, concurrent, texture);
+        ItemID id = scene->allocateID();
+        pendingChanges.resetItem(id, std::make_shared<TestShape::Payload>(shape));
+        outItems.emplace_back(ItemIDAndBounds(id, payloadGetBound(shape)));
+    }
+    scene->enqueuePendingChanges(pendingChanges);
+    scene->processPendingChangesQueue();
+}
+
+static void recordSequentially(const ScenePointer& scene, const ItemIDsBounds& items, RenderArgs* args) {
+    for (auto& item : items) {
+        auto sceneItem = scene->getItem(item.id);
+        sceneItem.render(args);
+    }
+}
+
+void BatchRecordingTests::testRenderItemsMatchesSequential() {
+    // all concurrent, one serial item every chunk or so, and a count that doesn't fill the last chunk
+    for (int serialEvery : { 0, 37, 1000 }) {
+        auto sceneContext = std::make_shared<SceneContext>();
+        sceneContext->_scene = std::make_shared<Scene>();
+        ItemIDsBounds items;
+        makeScene(sceneContext->_scene, 1001, serialEvery, items);
+
+        gpu::Batch expected;
+        RenderArgs expectedArgs;
+        expectedArgs._batch = &expected;
+        recordSequentially(sceneContext->_scene, items, &expectedArgs);
+
+        for (int run = 0; run < 10; run++) {
+            gpu::Batch batch;
+            RenderArgs args;
+            args._batch = &batch;
+            auto renderContext = std::make_shared<RenderContext>();
+            renderContext->args = &args;
+
+            renderItems(sceneContext, renderContext, items);
+
+            compareBatches(batch, expected);
+            QCOMPARE(args._details._trianglesRendered, expectedArgs._details._trianglesRendered);
+        }
+    }
+}
+
+void BatchRecordingTests::benchmarkRenderItems() {
+    const int NUM_ITEMS = 50000;
+    const int NUM_FRAMES = 10;
+
+    auto sceneContext = std::make_shared<SceneContext>();
+    sceneContext->_scene = std::make_shared<Scene>();
+    ItemIDsBounds items;
+    makeScene(sceneContext->_scene, NUM_ITEMS, 0, items);
+
+    quint64 sequentialUsecs = 0;
+    quint64 concurrentUsecs = 0;
+    for (int frame = 0; frame < NUM_FRAMES; frame++) {
+        gpu::Batch expected;
+        RenderArgs expectedArgs;
+        expectedArgs._batch = &expected;
+        quint64 start = usecTimestampNow();
+        recordSequentially(sceneContext->_scene, items, &expectedArgs);
+        quint64 end = usecTimestampNow();
+        sequentialUsecs += end - start;
+
+        gpu::Batch batch;
+        RenderArgs args;
+        args._batch = &batch;
+        auto renderContext = std::make_shared<RenderContext>();
+        renderContext->args = &args;
+        start = usecTimestampNow();
+        renderItems(sceneContext, renderContext, items);
+        end = usecTimestampNow();
+        concurrentUsecs += end - start;
+
+        QCOMPARE(batch._commands.size(), expected._commands.size());
+    }
+
+    qDebug() << "Sequential recording:" << sequentialUsecs / (1000.0f * NUM_FRAMES) << "msecs per" << NUM_ITEMS << "items";
+    qDebug() << "Concurrent recording and merge:" << concurrentUsecs / (1000.0f * NUM_FRAMES) << "msecs per"
+             << NUM_ITEMS << "items," << std::thread::hardware_concurrency() << "hardware threads";
+}
+
+void BatchRecordingTests::testInstancedShapesRecordConcurrently() {
+    const int NUM_ITEMS = 1001;
+    auto sceneContext = std::make_shared<SceneContext>();
+    sceneContext->_scene = std::make_shared<Scene>();
+    ItemIDsBounds items;
+    std::vector<TestInstance::Pointer> instances;
+    PendingChanges pendingChanges;
+    for (int i = 0; i < NUM_ITEMS; i++) {
+        instances.push_back(std::make_shared<TestInstance>(i));
+        ItemID id = sceneContext->_scene->allocateID();
+        pendingChanges.resetItem(id, std::make_shared<TestInstance::Payload>(instances.back()));
+        items.emplace_back(ItemIDAndBounds(id, payloadGetBound(instances.back())));
+    }
+    sceneContext->_scene->enqueuePendingChanges(pendingChanges);
+    sceneContext->_scene->processPendingChangesQueue();
+
+    gpu::Batch expected;
+    RenderArgs expectedArgs;
+    expectedArgs._batch = &expected;
+    recordSequentially(sceneContext->_scene, items, &expectedArgs);
+    auto expectedCubes = expected._namedData["cubes"]._buffers[0];
+    auto expectedSpheres = expected._namedData["spheres"]._buffers[0];
+    QVERIFY(expectedCubes->getSize() == (gpu::Resource::Size)((NUM_ITEMS / 2) * sizeof(glm::vec3)));
+    QVERIFY(expectedSpheres->getSize() == (gpu::Resource::Size)((NUM_ITEMS - NUM_ITEMS / 2) * sizeof(glm::vec3)));
+    expected.flushNamedCalls();
+
+    // the chunks go to the workers, which the render thread helps while it waits, so a run may not use them
+    const int MAX_RUNS = 10;
+    bool recordedElsewhere = false;
+    for (int run = 0; run < MAX_RUNS && !recordedElsewhere; run++) {
+        gpu::Batch batch;
+        RenderArgs args;
+        args._batch = &batch;
+        auto renderContext = std::make_shared<RenderContext>();
+        renderContext->args = &args;
+        renderItems(sceneContext, renderContext, items);
+
+        // the instances merge in the order of the items, into one draw per name
+        compareBatches(batch, expected);
+        for (auto& instance : instances) {
+            recordedElsewhere = recordedElsewhere || (instance->recordingThread != std::this_thread::get_id());
+        }
+    }
+    if (std::thread::hardware_concurrency() >= 2) {
+        QVERIFY(recordedElsewhere);
+    }
+
+    // the debug shapes keep them on the render thread
+    gpu::Batch debugBatch;
+    RenderArgs debugArgs;
+    debugArgs._batch = &debugBatch;
+    debugArgs._debugFlags = RenderArgs::RENDER_DEBUG_SIMULATION_OWNERSHIP;
+    auto renderContext = std::make_shared<RenderContext>();
+    renderContext->args = &debugArgs;
+    renderItems(sceneContext, renderContext, items);
+    compareBatches(debugBatch, expected);
+    for (auto& instance : instances) {
+        QVERIFY(instance->recordingThread == std::this_thread::get_id());
+    }
+}
@@ -0,0 +1,27 @@
+//
+//  BatchRecordingTests.h
+//  tests/render/src
+//
+//  Copyright 2015 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_BatchRecordingTests_h
+#define hifi_BatchRecordingTests_h
+
+#include <QtTest/QtTest>
+
+class BatchRecordingTests : public QObject {
+    Q_OBJECT
+private slots:
+    void testAppend();
+    void testNamedCalls();
+    void testNamedCallsKeepDrawOrder();
+    void testRenderItemsMatchesSequential();
+    void testInstancedShapesRecordConcurrently();
+    void benchmarkRenderItems();
+};
+
+#endif // hifi_BatchRecordingTests_h
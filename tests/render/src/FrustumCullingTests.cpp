@@ -0,0 +1,172 @@
+//
+//  FrustumCullingTests.cpp
+//  tests/render/src
+//
+//  Copyright 2015 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "FrustumCullingTests.h"
+
+#include <glm/gtc/matrix_transform.hpp>
+
+#include <NumericalConstants.h>
+#include <SharedUtil.h>
+#include <render/FrustumCulling.h>
+
+QTEST_MAIN(FrustumCullingTests)
+
+using namespace render;
+
+static float randomFloat(float minimum, float maximum) {
+    return minimum + (maximum - minimum) * (rand() / (float)RAND_MAX);
+}
+
+static AABox randomBound(float spread, float maxSize) {
+    glm::vec3 corner(randomFloat(-spread, spread), randomFloat(-spread, spread), randomFloat(-spread, spread));
+    glm::vec3 dimensions(randomFloat(0.0f, maxSize), randomFloat(0.0f, maxSize), randomFloat(0.0f, maxSize));
+    return AABox(corner, dimensions);
+}
+
+static void setupFrustum(ViewFrustum& frustum, const glm::vec3& position, const glm::quat& orientation) {
+    frustum.setProjection(glm::perspective(glm::radians(60.0f), 16.0f / 9.0f, 0.1f, 200.0f));
+    frustum.setPosition(position);
+    frustum.setOrientation(orientation);
+    frustum.calculate();
+}
+
+static glm::quat randomOrientation() {
+    return glm::normalize(glm::quat(randomFloat(-1.0f, 1.0f), randomFloat(-1.0f, 1.0f), randomFloat(-1.0f, 1.0f),
+                                    randomFloat(-1.0f, 1.0f)));
+}
+
+static void checkAgainstBoxInFrustum(const ViewFrustum& frustum, const ItemBoundsArray& bounds) {
+    std::vector<uint8_t> inView;
+    cullBounds(FrustumPlanes(frustum), bounds, inView);
+    QCOMPARE((int)inView.size(), bounds.size());
+    for (int i = 0; i < bounds.size(); i++) {
+        bool expected = frustum.boxInFrustum(bounds.getBound(i)) != ViewFrustum::OUTSIDE;
+        QCOMPARE((bool)inView[i], expected);
+    }
+}
+
+void FrustumCullingTests::testBoundsArray() {
+    ItemBoundsArray bounds;
+    QVERIFY(bounds.empty());
+
+    for (ItemID id = 0; id < 5; id++) {
+        bounds.push_back(id, ItemKey::Builder::opaqueShape(), AABox(glm::vec3((float)id), 1.0f));
+    }
+    QCOMPARE(bounds.size(), 5);
+    QCOMPARE(bounds.getMinimum(1)[3], 3.0f);
+    QCOMPARE(bounds.getMaximum(2)[3], 4.0f);
+
+    bounds.set(2, ItemKey::Builder::transparentShape(), AABox(glm::vec3(-1.0f), glm::vec3(1.0f, 2.0f, 3.0f)));
+    QVERIFY(bounds.getKey(2).isTransparent());
+    QCOMPARE(bounds.getMaximum(2)[2], 2.0f);
+
+    // the last one fills the hole
+    QCOMPARE(bounds.removeAt(1), (ItemID)4);
+    QCOMPARE(bounds.size(), 4);
+    QCOMPARE(bounds.getID(1), (ItemID)4);
+    QCOMPARE(bounds.getMinimum(0)[1], 4.0f);
+    QCOMPARE(bounds.getBound(1).getCorner(), glm::vec3(4.0f));
+
+    QCOMPARE(bounds.removeAt(3), (ItemID)3);
+    QCOMPARE(bounds.size(), 3);
+}
+
+void FrustumCullingTests::testCullMatchesBoxInFrustum() {
+    srand(1);
+
+    // every count up to a few SIMD widths, for the tail of the kernel
+    for (int numBounds = 0; numBounds < 20; numBounds++) {
+        ViewFrustum frustum;
+        setupFrustum(frustum, glm::vec3(0.0f), randomOrientation());
+        ItemBoundsArray bounds;
+        for (int i = 0; i < numBounds; i++) {
+            bounds.push_back(i, ItemKey(), randomBound(50.0f, 10.0f));
+        }
+        checkAgainstBoxInFrustum(frustum, bounds);
+    }
+
+    const int NUM_VIEWS = 20;
+    const int NUM_BOUNDS = 10000;
+    for (int view = 0; view < NUM_VIEWS; view++) {
+        ViewFrustum frustum;
+        setupFrustum(frustum, glm::vec3(randomFloat(-100.0f, 100.0f)), randomOrientation());
+        ItemBoundsArray bounds;
+        for (int i = 0; i < NUM_BOUNDS; i++) {
+            bounds.push_back(i, ItemKey(), randomBound(300.0f, 20.0f));
+        }
+        checkAgainstBoxInFrustum(frustum, bounds);
+    }
+}
+
+void FrustumCullingTests::testKeyhole() {
+    srand(2);
+    const int NUM_BOUNDS = 2000;
+
+    // small bounds all around the eye, many of them behind it but in the keyhole
+    ViewFrustum frustum;
+    setupFrustum(frustum, glm::vec3(1.0f, 2.0f, 3.0f), randomOrientation());
+    ItemBoundsArray bounds;
+    for (int i = 0; i < NUM_BOUNDS; i++) {
+        AABox bound = randomBound(DEFAULT_KEYHOLE_RADIUS * 1.5f, 0.5f);
+        bounds.push_back(i, ItemKey(), AABox(bound.getCorner() + frustum.getPosition(), bound.getScale()));
+    }
+    checkAgainstBoxInFrustum(frustum, bounds);
+
+    // and without a keyhole
+    frustum.setKeyholeRadius(-1.0f);
+    frustum.calculate();
+    checkAgainstBoxInFrustum(frustum, bounds);
+}
+
+void FrustumCullingTests::benchmarkCullBounds() {
+    srand(3);
+    const int NUM_BOUNDS = 1000000;
+    const int NUM_FRAMES = 10;
+
+    ItemBoundsArray bounds;
+    for (int i = 0; i < NUM_BOUNDS; i++) {
+        bounds.push_back(i, ItemKey(), randomBound(1000.0f, 20.0f));
+    }
+
+    quint64 scalarUsecs = 0;
+    quint64 kernelUsecs = 0;
+    int numInView = 0;
+    std::vector<uint8_t> inView;
+    for (int frame = 0; frame < NUM_FRAMES; frame++) {
+        ViewFrustum frustum;
+        setupFrustum(frustum, glm::vec3(0.0f), glm::angleAxis(frame * TWO_PI / NUM_FRAMES, glm::vec3(0.0f, 1.0f, 0.0f)));
+
+        int expectedInView = 0;
+        quint64 start = usecTimestampNow();
+        for (int i = 0; i < NUM_BOUNDS; i++) {
+            if (frustum.boxInFrustum(bounds.getBound(i)) != ViewFrustum::OUTSIDE) {
+                expectedInView++;
+            }
+        }
+        quint64 end = usecTimestampNow();
+        scalarUsecs += end - start;
+
+        start = usecTimestampNow();
+        cullBounds(FrustumPlanes(frustum), bounds, inView);
+        end = usecTimestampNow();
+        kernelUsecs += end - start;
+
+        int frameInView = 0;
+        for (int i = 0; i < NUM_BOUNDS; i++) {
+            frameInView += inView[i];
+        }
+        QCOMPARE(frameInView, expectedInView);
+        numInView += frameInView;
+    }
+
+    qDebug() << "boxInFrustum:" << scalarUsecs / (1000.0f * NUM_FRAMES) << "msecs per" << NUM_BOUNDS << "bounds";
+    qDebug() << "cullBounds:" << kernelUsecs / (1000.0f * NUM_FRAMES) << "msecs per" << NUM_BOUNDS << "bounds,"
+             << numInView / NUM_FRAMES << "in view";
+}
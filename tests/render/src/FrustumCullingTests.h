@@ -0,0 +1,25 @@
+//
+//  FrustumCullingTests.h
+//  tests/render/src
+//
+//  Copyright 2015 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_FrustumCullingTests_h
+#define hifi_FrustumCullingTests_h
+
+#include <QtTest/QtTest>
+
+class FrustumCullingTests : public QObject {
+    Q_OBJECT
+private slots:
+    void testBoundsArray();
+    void testCullMatchesBoxInFrustum();
+    void testKeyhole();
+    void benchmarkCullBounds();
+};
+
+#endif // hifi_FrustumCullingTests_h
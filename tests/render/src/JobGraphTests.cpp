@@ -0,0 +1,270 @@
+//
+//  JobGraphTests.cpp
+//  tests/render/src
+//
+//  Copyright 2015 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "JobGraphTests.h"
+
+#include <algorithm>
+#include <functional>
+#include <mutex>
+#include <thread>
+
+#include <tbb/task_arena.h>
+
+#include <NumericalConstants.h>
+#include <SharedUtil.h>
+#include <render/JobGraph.h>
+
+QTEST_MAIN(JobGraphTests)
+
+using namespace render;
+
+typedef std::vector<int> Values;
+
+// what the jobs did, in order
+class Log {
+public:
+    void add(const std::string& name, const Values& values = Values()) {
+        std::lock_guard<std::mutex> lock(mutex);
+        names.push_back(name);
+        threads.push_back(std::this_thread::get_id());
+        this->values.push_back(values);
+    }
+
+    int indexOf(const std::string& name) const {
+        auto found = std::find(names.begin(), names.end(), name);
+        return (found == names.end()) ? -1 : (int)(found - names.begin());
+    }
+
+    std::mutex mutex;
+    std::vector<std::string> names;
+    std::vector<std::thread::id> threads;
+    std::vector<Values> values;
+};
+
+static Log* currentLog = nullptr;
+
+class Produce {
+public:
+    Produce(const std::string& name = std::string(), int count = 0) : _name(name), _count(count) {}
+    std::string _name;
+    int _count;
+
+    void run(const SceneContextPointer& sceneContext, const RenderContextPointer& renderContext, Values& outValues) {
+        outValues.clear();
+        for (int i = 0; i < _count; i++) {
+            outValues.push_back(_count - i);
+        }
+        currentLog->add(_name, outValues);
+    }
+
+    typedef Job::ModelO<Produce, Values> JobModel;
+};
+
+class Sort {
+public:
+    Sort(const std::string& name = std::string()) : _name(name) {}
+    std::string _name;
+
+    void run(const SceneContextPointer& sceneContext, const RenderContextPointer& renderContext, const Values& inValues, Values& outValues) {
+        outValues = inValues;
+        std::sort(outValues.begin(), outValues.end());
+        currentLog->add(_name, outValues);
+    }
+
+    typedef Job::ModelIO<Sort, Values, Values> JobModel;
+};
+
+class Draw {
+public:
+    Draw(const std::string& name = std::string()) : _name(name) {}
+    std::string _name;
+
+    void run(const SceneContextPointer& sceneContext, const RenderContextPointer& renderContext, const Values& inValues) {
+        currentLog->add(_name, inValues);
+    }
+
+    typedef Job::ModelI<Draw, Values> JobModel;
+};
+
+class Setup {
+public:
+    std::function<void()> _action;
+
+    void run(const SceneContextPointer& sceneContext, const RenderContextPointer& renderContext) {
+        if (_action) {
+            _action();
+        }
+        currentLog->add("Setup");
+    }
+
+    typedef Job::Model<Setup> JobModel;
+};
+
+// the standard shape of a deferred frame: a setup, then fetch, sort and draw per bucket
+static Jobs makeBucketJobs(int numA, int numB) {
+    Jobs jobs;
+    jobs.push_back(Job(new Setup::JobModel("Setup")));
+
+    jobs.push_back(Job(new Produce::JobModel("ProduceA", Produce("ProduceA", numA))));
+    jobs.back().setConcurrent(true);
+    jobs.push_back(Job(new Sort::JobModel("SortA", jobs.back().getOutput(), Sort("SortA"))));
+    jobs.back().setConcurrent(true);
+    auto sortedA = jobs.back().getOutput();
+    jobs.push_back(Job(new Draw::JobModel("DrawA", sortedA)));
+
+    jobs.push_back(Job(new Produce::JobModel("ProduceB", Produce("ProduceB", numB))));
+    jobs.back().setConcurrent(true);
+    jobs.push_back(Job(new Sort::JobModel("SortB", jobs.back().getOutput(), Sort("SortB"))));
+    jobs.back().setConcurrent(true);
+    jobs.push_back(Job(new Draw::JobModel("DrawB", jobs.back().getOutput())));
+
+    // a second consumer of the same output
+    jobs.push_back(Job(new Draw::JobModel("DrawStatusA", sortedA)));
+    return jobs;
+}
+
+static void setDrawNames(Jobs& jobs) {
+    // ModelI has no constructor taking both the input and the data, name the draws through their data
+    for (auto& job : jobs) {
+        auto draw = dynamic_cast<Draw::JobModel*>(job._concept.get());
+        if (draw) {
+            draw->_data._name = job.getName();
+        }
+    }
+}
+
+void JobGraphTests::testDependencies() {
+    Jobs jobs = makeBucketJobs(1, 1);
+    JobGraph graph;
+    Log log;
+    currentLog = &log;
+    setDrawNames(jobs);
+    graph.run(jobs, std::make_shared<SceneContext>(), std::make_shared<RenderContext>());
+    currentLog = nullptr;
+
+    QCOMPARE(graph.getProducer(0), -1);     // Setup
+    QCOMPARE(graph.getProducer(1), -1);     // ProduceA
+    QCOMPARE(graph.getProducer(2), 1);      // SortA
+    QCOMPARE(graph.getProducer(3), 2);      // DrawA
+    QCOMPARE(graph.getProducer(4), -1);     // ProduceB
+    QCOMPARE(graph.getProducer(5), 4);      // SortB
+    QCOMPARE(graph.getProducer(6), 5);      // DrawB
+    QCOMPARE(graph.getProducer(7), 2);      // DrawStatusA
+    QCOMPARE((int)log.names.size(), (int)jobs.size());
+}
+
+void JobGraphTests::testBuckets() {
+    const int NUM_FRAMES = 200;
+    Jobs jobs = makeBucketJobs(100, 50);
+    setDrawNames(jobs);
+    JobGraph graph;
+    auto sceneContext = std::make_shared<SceneContext>();
+    auto renderContext = std::make_shared<RenderContext>();
+
+    Values expectedA;
+    for (int i = 1; i <= 100; i++) {
+        expectedA.push_back(i);
+    }
+    Values expectedB;
+    for (int i = 1; i <= 50; i++) {
+        expectedB.push_back(i);
+    }
+
+    for (int frame = 0; frame < NUM_FRAMES; frame++) {
+        Log log;
+        currentLog = &log;
+        graph.run(jobs, sceneContext, renderContext);
+        currentLog = nullptr;
+
+        QCOMPARE((int)log.names.size(), (int)jobs.size());
+
+        // every job ran once, after its input
+        QVERIFY(log.indexOf("ProduceA") < log.indexOf("SortA"));
+        QVERIFY(log.indexOf("SortA") < log.indexOf("DrawA"));
+        QVERIFY(log.indexOf("SortA") < log.indexOf("DrawStatusA"));
+        QVERIFY(log.indexOf("ProduceB") < log.indexOf("SortB"));
+        QVERIFY(log.indexOf("SortB") < log.indexOf("DrawB"));
+
+        // the other jobs ran in order on this thread
+        std::vector<std::string> serialNames;
+        for (size_t i = 0; i < log.names.size(); i++) {
+            if (log.names[i] == "Setup" || log.names[i].compare(0, 4, "Draw") == 0) {
+                QVERIFY(log.threads[i] == std::this_thread::get_id());
+                serialNames.push_back(log.names[i]);
+            }
+        }
+        std::vector<std::string> expectedSerialNames = { "Setup", "DrawA", "DrawB", "DrawStatusA" };
+        QVERIFY(serialNames == expectedSerialNames);
+
+        QVERIFY(log.values[log.indexOf("DrawA")] == expectedA);
+        QVERIFY(log.values[log.indexOf("DrawStatusA")] == expectedA);
+        QVERIFY(log.values[log.indexOf("DrawB")] == expectedB);
+    }
+}
+
+void JobGraphTests::testOverlap() {
+    if (std::thread::hardware_concurrency() < 2) {
+        QSKIP("needs a worker thread");
+    }
+
+    // the setup waits for a concurrent job to start, which can only happen on another thread
+    Jobs jobs = makeBucketJobs(10, 10);
+    setDrawNames(jobs);
+    auto setup = dynamic_cast<Setup::JobModel*>(jobs[0]._concept.get());
+    QVERIFY(setup);
+
+    bool overlapped = false;
+    setup->_data._action = [&] {
+        const quint64 TIMEOUT = 5 * USECS_PER_SECOND;
+        quint64 start = usecTimestampNow();
+        while (usecTimestampNow() - start < TIMEOUT) {
+            {
+                std::lock_guard<std::mutex> lock(currentLog->mutex);
+                if (std::find(currentLog->names.begin(), currentLog->names.end(), "SortA") != currentLog->names.end()) {
+                    overlapped = true;
+                    break;
+                }
+            }
+            std::this_thread::yield();
+        }
+    };
+
+    Log log;
+    currentLog = &log;
+    JobGraph graph;
+    graph.run(jobs, std::make_shared<SceneContext>(), std::make_shared<RenderContext>());
+    currentLog = nullptr;
+
+    QVERIFY(overlapped);
+    QVERIFY(log.indexOf("SortA") < log.indexOf("Setup"));
+}
+
+void JobGraphTests::testNoWorkers() {
+    // an arena with room for the calling thread only, so no worker takes the concurrent jobs
+    Jobs jobs = makeBucketJobs(20, 10);
+    setDrawNames(jobs);
+    JobGraph graph;
+    Log log;
+    currentLog = &log;
+    tbb::task_arena arena(1);
+    arena.execute([&] {
+        graph.run(jobs, std::make_shared<SceneContext>(), std::make_shared<RenderContext>());
+    });
+    currentLog = nullptr;
+
+    QCOMPARE((int)log.names.size(), (int)jobs.size());
+    QVERIFY(log.indexOf("ProduceA") < log.indexOf("SortA"));
+    QVERIFY(log.indexOf("SortA") < log.indexOf("DrawA"));
+    QVERIFY(log.indexOf("ProduceB") < log.indexOf("SortB"));
+    QVERIFY(log.indexOf("SortB") < log.indexOf("DrawB"));
+    for (auto thread : log.threads) {
+        QVERIFY(thread == std::this_thread::get_id());
+    }
+}
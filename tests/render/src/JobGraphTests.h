@@ -0,0 +1,25 @@
+//
+//  JobGraphTests.h
+//  tests/render/src
+//
+//  Copyright 2015 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_JobGraphTests_h
+#define hifi_JobGraphTests_h
+
+#include <QtTest/QtTest>
+
+class JobGraphTests : public QObject {
+    Q_OBJECT
+private slots:
+    void testDependencies();
+    void testBuckets();
+    void testOverlap();
+    void testNoWorkers();
+};
+
+#endif // hifi_JobGraphTests_h
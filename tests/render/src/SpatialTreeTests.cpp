@@ -0,0 +1,251 @@
+//
+//  SpatialTreeTests.cpp
+//  tests/render/src
+//
+//  Copyright 2015 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "SpatialTreeTests.h"
+
+#include <algorithm>
+
+#include <glm/gtc/matrix_transform.hpp>
+
+#include <NumericalConstants.h>
+#include <SharedUtil.h>
+#include <render/SpatialTree.h>
+
+QTEST_MAIN(SpatialTreeTests)
+
+using namespace render;
+
+const float SCENE_SPREAD = 1000.0f;
+
+static float randomFloat(float minimum, float maximum) {
+    return minimum + (maximum - minimum) * (rand() / (float)RAND_MAX);
+}
+
+// items from 10cm to 20m, spread over a cube of 2km
+static AABox randomBound() {
+    glm::vec3 center(randomFloat(-SCENE_SPREAD, SCENE_SPREAD), randomFloat(-SCENE_SPREAD, SCENE_SPREAD),
+                     randomFloat(-SCENE_SPREAD, SCENE_SPREAD));
+    glm::vec3 dimensions(expf(randomFloat(logf(0.1f), logf(20.0f))), expf(randomFloat(logf(0.1f), logf(20.0f))),
+                         expf(randomFloat(logf(0.1f), logf(20.0f))));
+    return AABox(center - 0.5f * dimensions, dimensions);
+}
+
+static ItemKey randomKey() {
+    return (rand() % 4) ? ItemKey::Builder::opaqueShape().build() : ItemKey::Builder::transparentShape().build();
+}
+
+static void setupFrustum(ViewFrustum& frustum, const glm::vec3& position, float yaw) {
+    frustum.setProjection(glm::perspective(glm::radians(45.0f), 16.0f / 9.0f, 0.1f, 500.0f));
+    frustum.setPosition(position);
+    frustum.setOrientation(glm::angleAxis(yaw, glm::vec3(0.0f, 1.0f, 0.0f)));
+    frustum.calculate();
+}
+
+// size over distance, the same shape of test as the LODManager's
+static ItemSpatialTree::LODTest makeLODTest(const glm::vec3& eye) {
+    return [eye](const AABox& bound) {
+        return bound.getLargestDimension() > 0.005f * glm::distance(bound.calcCenter(), eye);
+    };
+}
+
+// what FetchItems + CullItems do, on bounds that are already fetched
+static void linearCull(const std::vector<AABox>& bounds, const std::vector<ItemKey>& keys, const ItemFilter& filter,
+                       const ViewFrustum& frustum, const ItemSpatialTree::LODTest& lodTest, ItemIDsBounds& outItems) {
+    for (ItemID id = 1; id < bounds.size(); id++) {
+        if (!filter.test(keys[id])) {
+            continue;
+        }
+        if (frustum.boxInFrustum(bounds[id]) != ViewFrustum::OUTSIDE && lodTest(bounds[id])) {
+            outItems.emplace_back(ItemIDAndBounds(id, bounds[id]));
+        }
+    }
+}
+
+static std::vector<ItemID> sortedIDs(const ItemIDsBounds& items) {
+    std::vector<ItemID> ids;
+    for (auto& item : items) {
+        ids.push_back(item.id);
+    }
+    std::sort(ids.begin(), ids.end());
+    return ids;
+}
+
+static int countPassing(const std::vector<ItemKey>& keys, const ItemFilter& filter) {
+    int count = 0;
+    for (ItemID id = 1; id < keys.size(); id++) {
+        if (filter.test(keys[id])) {
+            count++;
+        }
+    }
+    return count;
+}
+
+static void fillScene(int numItems, ItemSpatialTree& tree, std::vector<AABox>& bounds, std::vector<ItemKey>& keys) {
+    bounds.resize(numItems + 1);
+    keys.resize(numItems + 1);
+    for (ItemID id = 1; id <= (ItemID)numItems; id++) {
+        bounds[id] = randomBound();
+        keys[id] = randomKey();
+        tree.update(id, keys[id], bounds[id]);
+    }
+}
+
+void SpatialTreeTests::testInsertRemove() {
+    ItemSpatialTree tree;
+    QCOMPARE(tree.getNumNodes(), 1);
+
+    tree.update(1, ItemKey::Builder::opaqueShape(), AABox(glm::vec3(10.0f), 1.0f));
+    tree.update(2, ItemKey::Builder::opaqueShape(), AABox(glm::vec3(-10.0f), 0.1f));
+    // too big for the root
+    tree.update(3, ItemKey::Builder::opaqueShape(), AABox(glm::vec3(0.0f), (float)TREE_SCALE * 2.0f));
+    // outside of the root
+    tree.update(4, ItemKey::Builder::opaqueShape(), AABox(glm::vec3((float)TREE_SCALE), 1.0f));
+    QCOMPARE(tree.getNumItems(), 4);
+    QVERIFY(tree.contains(1) && tree.contains(2) && tree.contains(3) && tree.contains(4));
+    QVERIFY(!tree.contains(5));
+    QVERIFY(tree.getNumNodes() > 1);
+
+    tree.remove(1);
+    tree.remove(2);
+    tree.remove(3);
+    tree.remove(4);
+    tree.remove(4);
+    QCOMPARE(tree.getNumItems(), 0);
+    QVERIFY(!tree.contains(1));
+
+    // empty cells are given back
+    QCOMPARE(tree.getNumNodes(), 1);
+}
+
+void SpatialTreeTests::testSelectMatchesLinearCull() {
+    srand(1);
+    const int NUM_ITEMS = 20000;
+    ItemSpatialTree tree;
+    std::vector<AABox> bounds;
+    std::vector<ItemKey> keys;
+    fillScene(NUM_ITEMS, tree, bounds, keys);
+
+    const int NUM_VIEWS = 10;
+    for (int view = 0; view < NUM_VIEWS; view++) {
+        ViewFrustum frustum;
+        glm::vec3 eye(randomFloat(-SCENE_SPREAD, SCENE_SPREAD), 0.0f, randomFloat(-SCENE_SPREAD, SCENE_SPREAD));
+        setupFrustum(frustum, eye, randomFloat(0.0f, TWO_PI));
+        auto lodTest = makeLODTest(eye);
+
+        for (auto filter : { ItemFilter(ItemFilter::Builder::opaqueShape()), ItemFilter(ItemFilter::Builder::transparentShape()) }) {
+            ItemIDsBounds expected;
+            linearCull(bounds, keys, filter, frustum, lodTest, expected);
+
+            ItemIDsBounds selected;
+            ItemSpatialTree::SelectionStats stats;
+            tree.select(frustum, lodTest, filter, selected, stats);
+
+            QVERIFY(sortedIDs(selected) == sortedIDs(expected));
+            QCOMPARE(stats.considered - stats.outOfView - stats.tooSmall, (int)selected.size());
+            QVERIFY(stats.boundsTested < NUM_ITEMS);
+
+            // the items of the other buckets don't count, even in rejected subtrees
+            QCOMPARE(stats.considered, countPassing(keys, filter));
+        }
+    }
+}
+
+void SpatialTreeTests::testMovingItems() {
+    srand(2);
+    const int NUM_ITEMS = 5000;
+    ItemSpatialTree tree;
+    std::vector<AABox> bounds;
+    std::vector<ItemKey> keys;
+    fillScene(NUM_ITEMS, tree, bounds, keys);
+
+    // small moves mostly stay in their cell, big moves and resizes don't
+    for (int step = 0; step < 4; step++) {
+        for (ItemID id = 1; id <= (ItemID)NUM_ITEMS; id++) {
+            if (id % 3 == 0) {
+                bounds[id] = randomBound();
+            } else if (id % 5 == 0) {
+                // the item stays but changes bucket
+                keys[id] = randomKey();
+            } else {
+                bounds[id] = AABox(bounds[id].getCorner() + glm::vec3(randomFloat(-1.0f, 1.0f)), bounds[id].getDimensions());
+            }
+            tree.update(id, keys[id], bounds[id]);
+        }
+        // and some come and go
+        for (ItemID id = 1 + step; id <= (ItemID)NUM_ITEMS; id += 7) {
+            tree.remove(id);
+            tree.update(id, keys[id], bounds[id]);
+        }
+    }
+    QCOMPARE(tree.getNumItems(), NUM_ITEMS);
+
+    ViewFrustum frustum;
+    glm::vec3 eye(0.0f);
+    setupFrustum(frustum, eye, 0.0f);
+    auto lodTest = makeLODTest(eye);
+    ItemFilter filter = ItemFilter::Builder::opaqueShape();
+
+    ItemIDsBounds expected;
+    linearCull(bounds, keys, filter, frustum, lodTest, expected);
+    ItemIDsBounds selected;
+    ItemSpatialTree::SelectionStats stats;
+    tree.select(frustum, lodTest, filter, selected, stats);
+    QVERIFY(sortedIDs(selected) == sortedIDs(expected));
+    QCOMPARE(stats.considered, countPassing(keys, filter));
+}
+
+void SpatialTreeTests::benchmarkFetchAndCull() {
+    srand(3);
+    const int NUM_ITEMS = 200000;
+    ItemSpatialTree tree;
+    std::vector<AABox> bounds;
+    std::vector<ItemKey> keys;
+
+    quint64 start = usecTimestampNow();
+    fillScene(NUM_ITEMS, tree, bounds, keys);
+    quint64 end = usecTimestampNow();
+    qDebug() << "Inserted" << NUM_ITEMS << "items in" << (end - start) / 1000.0f << "msecs," << tree.getNumNodes() << "nodes";
+
+    const int NUM_FRAMES = 20;
+    ItemFilter filter = ItemFilter::Builder::opaqueShape();
+    quint64 linearUsecs = 0;
+    quint64 treeUsecs = 0;
+    int numSelected = 0;
+    int numTested = 0;
+    for (int frame = 0; frame < NUM_FRAMES; frame++) {
+        ViewFrustum frustum;
+        glm::vec3 eye(0.0f, 0.0f, 0.0f);
+        setupFrustum(frustum, eye, frame * TWO_PI / NUM_FRAMES);
+        auto lodTest = makeLODTest(eye);
+
+        ItemIDsBounds expected;
+        expected.reserve(NUM_ITEMS);
+        start = usecTimestampNow();
+        linearCull(bounds, keys, filter, frustum, lodTest, expected);
+        end = usecTimestampNow();
+        linearUsecs += end - start;
+
+        ItemIDsBounds selected;
+        selected.reserve(NUM_ITEMS);
+        ItemSpatialTree::SelectionStats stats;
+        start = usecTimestampNow();
+        tree.select(frustum, lodTest, filter, selected, stats);
+        end = usecTimestampNow();
+        treeUsecs += end - start;
+
+        QCOMPARE(selected.size(), expected.size());
+        numSelected += (int)selected.size();
+        numTested += stats.boundsTested;
+    }
+
+    qDebug() << "Linear fetch and cull:" << linearUsecs / (1000.0f * NUM_FRAMES) << "msecs per frame";
+    qDebug() << "Spatial tree select:" << treeUsecs / (1000.0f * NUM_FRAMES) << "msecs per frame,"
+             << numTested / NUM_FRAMES << "bounds tested," << numSelected / NUM_FRAMES << "items selected";
+}
@@ -0,0 +1,25 @@
+//
+//  SpatialTreeTests.h
+//  tests/render/src
+//
+//  Copyright 2015 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_SpatialTreeTests_h
+#define hifi_SpatialTreeTests_h
+
+#include <QtTest/QtTest>
+
+class SpatialTreeTests : public QObject {
+    Q_OBJECT
+private slots:
+    void testInsertRemove();
+    void testSelectMatchesLinearCull();
+    void testMovingItems();
+    void benchmarkFetchAndCull();
+};
+
+#endif // hifi_SpatialTreeTests_h
@@ -0,0 +1,127 @@
+//
+//  ModelBakerApp.cpp
+//  tools/model-baker/src
+//
+//  Copyright 2015 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "ModelBakerApp.h"
+
+#include <iostream>
+#include <memory>
+
+#include <QCommandLineParser>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+
+#include <BakedGeometry.h>
+#include <FSTReader.h>
+#include <NumericalConstants.h>
+#include <SharedUtil.h>
+
+// as GeometryReader reads the models, which the keys depend on
+const bool LOAD_LIGHTMAPS = true;
+const float LIGHTMAP_LEVEL = 1.0f;
+
+ModelBakerApp::ModelBakerApp(int argc, char* argv[]) :
+    QCoreApplication(argc, argv)
+{
+    QCommandLineParser parser;
+    parser.setApplicationDescription("High Fidelity Model Baker");
+    parser.addHelpOption();
+
+    const QCommandLineOption outputDirectoryOption("o", "output directory", "directory", ".");
+    parser.addOption(outputDirectoryOption);
+
+    const QCommandLineOption baseURLOption("base-url", "the URL of the directory the files are served from", "url");
+    parser.addOption(baseURLOption);
+
+    parser.addPositionalArgument("files", "the .fbx models and .fst mappings to bake", "files...");
+
+    if (!parser.parse(QCoreApplication::arguments())) {
+        std::cerr << qPrintable(parser.errorText()) << std::endl;
+        parser.showHelp();
+        Q_UNREACHABLE();
+    }
+    if (parser.isSet("help") || parser.positionalArguments().isEmpty() || !parser.isSet(baseURLOption)) {
+        parser.showHelp();
+        Q_UNREACHABLE();
+    }
+
+    QString outputDirectory = parser.value(outputDirectoryOption);
+    QString baseURL = parser.value(baseURLOption);
+    if (!baseURL.endsWith("/")) {
+        baseURL += "/";
+    }
+    foreach (const QString& fileName, parser.positionalArguments()) {
+        QUrl url = QUrl(baseURL).resolved(QUrl(QFileInfo(fileName).fileName()));
+        bool baked = fileName.toLower().endsWith(".fst") ? bakeMapping(fileName, url, outputDirectory) :
+            bake(fileName, QVariantHash(), url, outputDirectory);
+        if (!baked) {
+            _exitCode = 1;
+        }
+    }
+}
+
+bool ModelBakerApp::bake(const QString& fileName, const QVariantHash& mapping, const QUrl& url,
+                         const QString& outputDirectory) {
+    QFile file(fileName);
+    if (!file.open(QIODevice::ReadOnly)) {
+        std::cerr << "Unable to read " << qPrintable(fileName) << std::endl;
+        return false;
+    }
+    QByteArray model = file.readAll();
+
+    // the clients read the models from the network, so the keys go by the path they're served from
+    QByteArray key = BakedGeometry::getKey(model, mapping, url.path(), LOAD_LIGHTMAPS, LIGHTMAP_LEVEL);
+
+    quint64 start = usecTimestampNow();
+    std::unique_ptr<FBXGeometry> geometry;
+    try {
+        geometry.reset(readFBX(model, mapping, url.path(), LOAD_LIGHTMAPS, LIGHTMAP_LEVEL));
+
+    } catch (const QString& error) {
+        std::cerr << "Error reading " << qPrintable(fileName) << ": " << qPrintable(error) << std::endl;
+        return false;
+    }
+    quint64 readUsecs = usecTimestampNow() - start;
+
+    BakedGeometryCache cache(outputDirectory);
+    if (!cache.store(key, *geometry)) {
+        std::cerr << "Unable to write " << qPrintable(cache.getFilePath(key)) << std::endl;
+        return false;
+    }
+
+    // time the load the clients will do instead of reading the model
+    start = usecTimestampNow();
+    std::unique_ptr<FBXGeometry> loaded(cache.load(key, url.path()));
+    quint64 loadUsecs = usecTimestampNow() - start;
+    if (!loaded) {
+        std::cerr << "Unable to load " << qPrintable(cache.getFilePath(key)) << std::endl;
+        return false;
+    }
+    std::cout << qPrintable(fileName) << " -> " << qPrintable(cache.getFilePath(key)) << " (read in "
+        << readUsecs / USECS_PER_MSEC << " ms, loads in " << loadUsecs / USECS_PER_MSEC << " ms)" << std::endl;
+    return true;
+}
+
+bool ModelBakerApp::bakeMapping(const QString& fileName, const QUrl& url, const QString& outputDirectory) {
+    QFile file(fileName);
+    if (!file.open(QIODevice::ReadOnly)) {
+        std::cerr << "Unable to read " << qPrintable(fileName) << std::endl;
+        return false;
+    }
+    QVariantHash mapping = FSTReader::readMapping(file.readAll());
+    QString modelFileName = mapping.value("filename").toString();
+    if (modelFileName.isEmpty()) {
+        std::cerr << qPrintable(fileName) << " has no filename entry" << std::endl;
+        return false;
+    }
+    // the clients resolve the model against the URL of the mapping
+    return bake(QFileInfo(fileName).dir().filePath(modelFileName), mapping, url.resolved(QUrl(modelFileName)),
+        outputDirectory);
+}
@@ -0,0 +1,35 @@
+//
+//  ModelBakerApp.h
+//  tools/model-baker/src
+//
+//  Copyright 2015 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_ModelBakerApp_h
+#define hifi_ModelBakerApp_h
+
+#include <QCoreApplication>
+#include <QUrl>
+#include <QVariantHash>
+
+/// Bakes FBX models (or the models of FST mappings) into baked geometry files, named after the keys the clients look them
+/// up with, so that they can be shipped with the assets to seed the baked geometry directories of the clients. The keys
+/// depend on the URL the models are served from, which is the base URL joined with the names of the files.
+class ModelBakerApp : public QCoreApplication {
+    Q_OBJECT
+public:
+    ModelBakerApp(int argc, char* argv[]);
+
+    int getExitCode() const { return _exitCode; }
+
+private:
+    bool bake(const QString& fileName, const QVariantHash& mapping, const QUrl& url, const QString& outputDirectory);
+    bool bakeMapping(const QString& fileName, const QUrl& url, const QString& outputDirectory);
+
+    int _exitCode = 0;
+};
+
+#endif // hifi_ModelBakerApp_h
@@ -35,12 +35,12 @@ bool vhacd::VHACDUtil::loadFBX(const QString filename, FBXGeometry& result) {
     }
     std::cout << "Reading FBX.....\n";
 
-    QByteArray fbxContents = fbx.readAll();
     FBXGeometry* geom;
     if (filename.toLower().endsWith(".obj")) {
-        geom = OBJReader().readOBJ(fbxContents, QVariantHash());
+        geom = OBJReader().readOBJ(fbx.readAll(), QVariantHash());
     } else if (filename.toLower().endsWith(".fbx")) {
-        geom = readFBX(fbxContents, QVariantHash(), filename);
+        // binary files are mapped rather than read in whole
+        geom = readFBX(&fbx, QVariantHash(), filename);
     } else {
         qDebug() << "unknown file extension";
         return false;